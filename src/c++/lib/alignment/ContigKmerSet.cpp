@@ -0,0 +1,72 @@
+//
+// Manta - Structural Variant and Indel Caller
+// Copyright (c) 2013-2017 Illumina, Inc.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+//
+
+/// \file
+/// \author Chris Saunders
+///
+
+#include "ContigKmerSet.hh"
+
+
+
+ContigKmerSet::
+ContigKmerSet(
+    const std::string& contig,
+    const unsigned kmerSize)
+    : _kmerSize(kmerSize)
+{
+    static const unsigned maxKmerSize(12);
+    assert((kmerSize > 0) && (kmerSize <= maxKmerSize));
+
+    const uint64_t kmerCount(1ull << (2*kmerSize));
+    _packedKmers.resize((kmerCount+63)/64,0);
+
+    const unsigned contigSize(contig.size());
+    if (contigSize < kmerSize) return;
+
+    const uint32_t codeMask(static_cast<uint32_t>(kmerCount-1));
+
+    // roll the packed code along the contig, tracking the number of symbols since the last non-ACGT
+    // symbol to determine when the current k-mer can be packed:
+    uint32_t code(0);
+    unsigned validSymbolCount(0);
+    for (unsigned contigIndex(0); contigIndex<contigSize; ++contigIndex)
+    {
+        const uint8_t symCode(getSymbolCode(contig[contigIndex]));
+        if (symCode > 3)
+        {
+            validSymbolCount=0;
+        }
+        else
+        {
+            code = (((code << 2) | symCode) & codeMask);
+            validSymbolCount++;
+        }
+
+        if ((contigIndex+1) < kmerSize) continue;
+        if (validSymbolCount >= kmerSize)
+        {
+            _packedKmers[code >> 6] |= (1ull << (code & 0x3f));
+        }
+        else
+        {
+            _unpackedKmers.insert(contig.substr(contigIndex+1-kmerSize,kmerSize));
+        }
+    }
+}
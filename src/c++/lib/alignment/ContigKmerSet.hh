@@ -0,0 +1,113 @@
+//
+// Manta - Structural Variant and Indel Caller
+// Copyright (c) 2013-2017 Illumina, Inc.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+//
+
+/// \file
+/// \author Chris Saunders
+///
+
+#pragma once
+
+#include <cassert>
+#include <cstdint>
+
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+
+/// \brief Set of all k-mers found in a contig, used to quickly find reference positions sharing a k-mer with the contig
+///
+/// k-mers composed only of ACGT are stored as 2-bit packed codes in a bit vector covering all possible
+/// k-mers, so each lookup is a fixed number of shift/or operations with no allocation. The rare k-mers
+/// containing any other symbol are stored as strings, so that lookup results are always identical to
+/// an exact match against the set of contig k-mer strings.
+///
+class ContigKmerSet
+{
+public:
+    /// \param[in] kmerSize k-mer length, limited to a range where the packed bit vector size is reasonable
+    ContigKmerSet(
+        const std::string& contig,
+        const unsigned kmerSize);
+
+    unsigned
+    getKmerSize() const
+    {
+        return _kmerSize;
+    }
+
+    /// \return True if the k-mer starting at kmerBegin is found in the contig
+    ///
+    /// Caller is responsible for ensuring that kmerSize symbols are available starting from kmerBegin
+    template <typename SymIter>
+    bool
+    isKmerInContig(SymIter kmerBegin) const
+    {
+        uint32_t code(0);
+        SymIter symIter(kmerBegin);
+        for (unsigned symIndex(0); symIndex<_kmerSize; ++symIndex, ++symIter)
+        {
+            const uint8_t symCode(getSymbolCode(*symIter));
+            if (symCode > 3)
+            {
+                if (_unpackedKmers.empty()) return false;
+                return (_unpackedKmers.count(std::string(kmerBegin, kmerBegin+_kmerSize)) != 0);
+            }
+            code = ((code << 2) | symCode);
+        }
+        return isPackedKmerSet(code);
+    }
+
+private:
+
+    /// \return 2-bit code for ACGT symbols, or 4 for any other symbol
+    static
+    uint8_t
+    getSymbolCode(const char sym)
+    {
+        switch (sym)
+        {
+        case 'A':
+            return 0;
+        case 'C':
+            return 1;
+        case 'G':
+            return 2;
+        case 'T':
+            return 3;
+        default:
+            return 4;
+        }
+    }
+
+    bool
+    isPackedKmerSet(const uint32_t code) const
+    {
+        assert((code >> 6) < _packedKmers.size());
+        return ((_packedKmers[code >> 6] >> (code & 0x3f)) & 1);
+    }
+
+    const unsigned _kmerSize;
+
+    /// one bit per possible ACGT k-mer, set if the k-mer is found in the contig
+    std::vector<uint64_t> _packedKmers;
+
+    /// contig k-mers containing any non-ACGT symbol
+    std::unordered_set<std::string> _unpackedKmers;
+};
@@ -114,9 +114,22 @@ private:
 
     // add the matrices here to reduce allocations over many alignment calls:
     typedef std::vector<ScoreVal> ScoreVec;
-    mutable ScoreVec _score1;
-    mutable ScoreVec _score2;
-    mutable basic_matrix<PtrVal> _ptrMat;
+
+    /// The matrices are kept per-thread, so that a single aligner can be shared between threads:
+    struct Workspace
+    {
+        ScoreVec score1;
+        ScoreVec score2;
+        basic_matrix<PtrVal> ptrMat;
+    };
+
+    static
+    Workspace&
+    getWorkspace()
+    {
+        static thread_local Workspace workspace;
+        return workspace;
+    }
 };
 
 
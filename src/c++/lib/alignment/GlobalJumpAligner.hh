@@ -127,12 +127,24 @@ private:
 
     // add the matrices here to reduce allocations over many alignment calls:
     typedef std::vector<ScoreVal> ScoreVec;
-    mutable ScoreVec _score1;
-    mutable ScoreVec _score2;
-
     typedef basic_matrix<PtrVal> PtrMat;
-    mutable PtrMat _ptrMat1;
-    mutable PtrMat _ptrMat2;
+
+    /// The matrices are kept per-thread, so that a single aligner can be shared between threads:
+    struct Workspace
+    {
+        ScoreVec score1;
+        ScoreVec score2;
+        PtrMat ptrMat1;
+        PtrMat ptrMat2;
+    };
+
+    static
+    Workspace&
+    getWorkspace()
+    {
+        static thread_local Workspace workspace;
+        return workspace;
+    }
 };
 
 
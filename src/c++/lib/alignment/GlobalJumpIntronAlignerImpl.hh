@@ -90,13 +90,14 @@ align(
     assert(0 != ref1Size);
     assert(0 != ref2Size);
 
-    _score1.resize(querySize+1);
-    _score2.resize(querySize+1);
-    _ptrMat1.resize(querySize+1, ref1Size+1);
-    _ptrMat2.resize(querySize+1, ref2Size+1);
+    Workspace& ws(getWorkspace());
+    ws.score1.resize(querySize+1);
+    ws.score2.resize(querySize+1);
+    ws.ptrMat1.resize(querySize+1, ref1Size+1);
+    ws.ptrMat2.resize(querySize+1, ref2Size+1);
 
-    ScoreVec* thisSV(&_score1);
-    ScoreVec* prevSV(&_score2);
+    ScoreVec* thisSV(&ws.score1);
+    ScoreVec* prevSV(&ws.score2);
 
     static const ScoreType badVal(-10000);
 
@@ -109,8 +110,8 @@ align(
     //
     for (unsigned queryIndex(0); queryIndex<=querySize; queryIndex++)
     {
-        PtrVal& headPtr1(_ptrMat1.val(queryIndex,0));
-        PtrVal& headPtr2(_ptrMat2.val(queryIndex,0));
+        PtrVal& headPtr1(ws.ptrMat1.val(queryIndex,0));
+        PtrVal& headPtr2(ws.ptrMat2.val(queryIndex,0));
         ScoreVal& val((*thisSV)[queryIndex]);
         headPtr1.match = AlignState::MATCH;
         headPtr2.match = AlignState::MATCH;
@@ -146,7 +147,7 @@ align(
 
             {
                 // only start from match state
-                PtrVal& headPtr(_ptrMat1.val(0,ref1Index+1));
+                PtrVal& headPtr(ws.ptrMat1.val(0,ref1Index+1));
                 ScoreVal& val((*thisSV)[0]);
                 headPtr.match = AlignState::MATCH;
                 val.match = 0;
@@ -165,7 +166,7 @@ align(
             {
                 // update match
                 ScoreVal& headScore((*thisSV)[queryIndex+1]);
-                PtrVal& headPtr(_ptrMat1.val(queryIndex+1,ref1Index+1));
+                PtrVal& headPtr(ws.ptrMat1.val(queryIndex+1,ref1Index+1));
                 {
                     const ScoreVal& sval((*prevSV)[queryIndex]);
                     headPtr.match = this->max3(
@@ -301,7 +302,7 @@ align(
 
             {
                 // disallow start from the insert or delete state:
-                PtrVal& headPtr(_ptrMat2.val(0,ref2Index+1));
+                PtrVal& headPtr(ws.ptrMat2.val(0,ref2Index+1));
                 ScoreVal& val((*thisSV)[0]);
                 headPtr.match = AlignState::MATCH;
                 val.match = 0;
@@ -320,7 +321,7 @@ align(
             {
                 // update match
                 ScoreVal& headScore((*thisSV)[queryIndex+1]);
-                PtrVal& headPtr(_ptrMat2.val(queryIndex+1,ref2Index+1));
+                PtrVal& headPtr(ws.ptrMat2.val(queryIndex+1,ref2Index+1));
                 {
                     const ScoreVal& sval((*prevSV)[queryIndex]);
                     headPtr.match = this->max4(
@@ -435,7 +436,7 @@ align(
                      ref1Begin, ref1End,
                      ref2Begin, ref2End,
                      querySize,
-                     _ptrMat1, _ptrMat2,
+                     ws.ptrMat1, ws.ptrMat2,
                      dumpStates,storeScores);
 #endif
 
@@ -444,7 +445,7 @@ align(
         ref1Begin, ref1End,
         ref2Begin, ref2End,
         querySize, ref1Size, ref2Size,
-        _ptrMat1, _ptrMat2,
+        ws.ptrMat1, ws.ptrMat2,
         btrace, result);
 }
 
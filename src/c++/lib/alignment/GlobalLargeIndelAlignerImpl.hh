@@ -49,12 +49,13 @@ align(
     assert(0 != querySize);
     assert(0 != refSize);
 
-    _score1.resize(querySize+1);
-    _score2.resize(querySize+1);
-    _ptrMat.resize(querySize+1, refSize+1);
+    Workspace& ws(getWorkspace());
+    ws.score1.resize(querySize+1);
+    ws.score2.resize(querySize+1);
+    ws.ptrMat.resize(querySize+1, refSize+1);
 
-    ScoreVec* thisSV(&_score1);
-    ScoreVec* prevSV(&_score2);
+    ScoreVec* thisSV(&ws.score1);
+    ScoreVec* prevSV(&ws.score2);
 
     static const ScoreType badVal(-10000);
 
@@ -67,7 +68,7 @@ align(
     //
     for (unsigned queryIndex(0); queryIndex<=querySize; queryIndex++)
     {
-        PtrVal& headPtr(_ptrMat.val(queryIndex,0));
+        PtrVal& headPtr(ws.ptrMat.val(queryIndex,0));
         ScoreVal& val((*thisSV)[queryIndex]);
         headPtr.match = AlignState::MATCH;
         val.match = queryIndex * scores.offEdge;
@@ -107,7 +108,7 @@ align(
 
             {
                 // disallow start from the insert or delete states:
-                PtrVal& headPtr(_ptrMat.val(0,refIndex+1));
+                PtrVal& headPtr(ws.ptrMat.val(0,refIndex+1));
                 ScoreVal& val((*thisSV)[0]);
                 headPtr.match = AlignState::MATCH;
                 val.match = 0;
@@ -126,7 +127,7 @@ align(
             {
                 // update match
                 ScoreVal& headScore((*thisSV)[queryIndex+1]);
-                PtrVal& headPtr(_ptrMat.val(queryIndex+1,refIndex+1));
+                PtrVal& headPtr(ws.ptrMat.val(queryIndex+1,refIndex+1));
                 {
                     const ScoreVal& sval((*prevSV)[queryIndex]);
                     headPtr.match = this->max5(
@@ -253,7 +254,7 @@ align(
     std::vector<AlignState::index_t> dumpStates {AlignState::MATCH, AlignState::DELETE, AlignState::INSERT, AlignState::JUMP, AlignState::JUMPINS};
     this->dumpTables(queryBegin, queryEnd,
                      refBegin, refEnd,
-                     querySize, _ptrMat,
+                     querySize, ws.ptrMat,
                      dumpStates, storeScores);
 #endif
 
@@ -261,6 +262,6 @@ align(
         queryBegin, queryEnd,
         refBegin, refEnd,
         querySize, refSize,
-        _ptrMat,
+        ws.ptrMat,
         btrace, result);
 }
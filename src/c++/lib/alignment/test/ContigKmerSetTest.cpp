@@ -0,0 +1,96 @@
+//
+// Manta - Structural Variant and Indel Caller
+// Copyright (c) 2013-2017 Illumina, Inc.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+//
+
+#include "boost/test/unit_test.hpp"
+
+#include "ContigKmerSet.hh"
+
+#include <random>
+#include <string>
+#include <unordered_set>
+
+
+
+BOOST_AUTO_TEST_SUITE( test_ContigKmerSet )
+
+
+
+BOOST_AUTO_TEST_CASE( test_ContigKmerSetSimple )
+{
+    const std::string contig("ACGTACGGTTNACG");
+    const ContigKmerSet contigKmers(contig,4);
+
+    const std::string ref("GGTTNACGTAAAACGG");
+    BOOST_REQUIRE(contigKmers.isKmerInContig(ref.begin()));
+    BOOST_REQUIRE(contigKmers.isKmerInContig(ref.begin()+1));
+    BOOST_REQUIRE(contigKmers.isKmerInContig(ref.begin()+2));
+    BOOST_REQUIRE(contigKmers.isKmerInContig(ref.begin()+4));
+    BOOST_REQUIRE(! contigKmers.isKmerInContig(ref.begin()+7));
+    BOOST_REQUIRE(! contigKmers.isKmerInContig(ref.begin()+11));
+    BOOST_REQUIRE(contigKmers.isKmerInContig(ref.begin()+12));
+}
+
+
+
+BOOST_AUTO_TEST_CASE( test_ContigKmerSetShortContig )
+{
+    const ContigKmerSet contigKmers("ACG",4);
+
+    const std::string ref("ACGA");
+    BOOST_REQUIRE(! contigKmers.isKmerInContig(ref.begin()));
+}
+
+
+
+/// k-mer lookup results must exactly match a lookup in the set of contig k-mer strings
+BOOST_AUTO_TEST_CASE( test_ContigKmerSetMatchesStringSet )
+{
+    static const unsigned kmerSize(3);
+    static const char symbols[] = "ACGTN";
+
+    std::mt19937 rng(1);
+    auto randomSeq = [&](const unsigned size)
+    {
+        std::string seq;
+        for (unsigned i(0); i<size; ++i) seq.push_back(symbols[rng() % 5]);
+        return seq;
+    };
+
+    for (unsigned testIndex(0); testIndex<20; ++testIndex)
+    {
+        const std::string contig(randomSeq(30));
+        const std::string ref(randomSeq(200));
+
+        std::unordered_set<std::string> contigHash;
+        for (unsigned contigIndex(0); (contigIndex+kmerSize)<=contig.size(); ++contigIndex)
+        {
+            contigHash.insert(contig.substr(contigIndex,kmerSize));
+        }
+
+        const ContigKmerSet contigKmers(contig,kmerSize);
+        for (unsigned refIndex(0); (refIndex+kmerSize)<=ref.size(); ++refIndex)
+        {
+            const bool expected(contigHash.count(ref.substr(refIndex,kmerSize)) != 0);
+            BOOST_REQUIRE_EQUAL(contigKmers.isKmerInContig(ref.begin()+refIndex), expected);
+        }
+    }
+}
+
+
+BOOST_AUTO_TEST_SUITE_END()
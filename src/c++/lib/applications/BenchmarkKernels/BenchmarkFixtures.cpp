@@ -0,0 +1,157 @@
+//
+// Manta - Structural Variant and Indel Caller
+// Copyright (c) 2013-2017 Illumina, Inc.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+//
+
+/// \file
+/// \author Chris Saunders
+///
+
+#include "BenchmarkFixtures.hh"
+
+#include "htsapi/bam_seq.hh"
+
+#include <cassert>
+
+#include <random>
+
+
+// Note that std::mt19937 output is fully specified by the standard, but the std distribution
+// classes are not, so random values are derived from the generator output directly to keep
+// fixtures identical across compilers.
+
+static const char baseSymbols[] = "ACGT";
+
+
+static
+char
+randomBase(std::mt19937& rng)
+{
+    return baseSymbols[rng() % 4];
+}
+
+
+/// sample a read from seq with a low substitution error rate
+static
+std::string
+sampleRead(
+    const std::string& seq,
+    const unsigned beginPos,
+    const unsigned readSize,
+    std::mt19937& rng)
+{
+    static const unsigned errorRateInverse(200);
+
+    std::string read(seq.substr(beginPos,readSize));
+    for (char& base : read)
+    {
+        if ((rng() % errorRateInverse) != 0) continue;
+        char newBase(base);
+        while (newBase == base) newBase = randomBase(rng);
+        base = newBase;
+    }
+    return read;
+}
+
+
+
+void
+makeSyntheticDeletionFixture(
+    const unsigned seed,
+    const unsigned refSize,
+    const unsigned deletionSize,
+    SyntheticDeletionFixture& fixture)
+{
+    static const unsigned readSize(150);
+    static const unsigned readStep(3);
+    static const unsigned contigFlankSize(250);
+
+    assert(refSize > (deletionSize + 2*contigFlankSize));
+
+    std::mt19937 rng(seed);
+
+    fixture.ref.clear();
+    for (unsigned i(0); i<refSize; ++i)
+    {
+        fixture.ref.push_back(randomBase(rng));
+    }
+
+    const pos_t deletionBeginPos((refSize-deletionSize)/2);
+    fixture.deletion.set_range(deletionBeginPos,deletionBeginPos+deletionSize);
+    fixture.haplotype = fixture.ref.substr(0,deletionBeginPos) + fixture.ref.substr(deletionBeginPos+deletionSize);
+
+    // breakend position in haplotype coordinates:
+    const unsigned bpPos(deletionBeginPos);
+
+    // tile reads across the breakend:
+    fixture.reads.clear();
+    const unsigned readBeginPos(bpPos-contigFlankSize);
+    const unsigned readEndPos(bpPos+contigFlankSize-readSize);
+    for (unsigned pos(readBeginPos); pos<=readEndPos; pos += readStep)
+    {
+        fixture.reads.push_back(sampleRead(fixture.haplotype,pos,readSize,rng));
+    }
+
+    fixture.splitRead = sampleRead(fixture.haplotype,(bpPos-readSize/2),readSize,rng);
+    fixture.splitReadQual.assign(readSize,30);
+
+    fixture.packedSplitRead.assign((readSize+1)/2,0);
+    for (unsigned i(0); i<readSize; ++i)
+    {
+        fixture.packedSplitRead[i/2] |= (get_bam_seq_code(fixture.splitRead[i]) << 4*(1-(i%2)));
+    }
+
+    fixture.contig = fixture.haplotype.substr(bpPos-contigFlankSize,2*contigFlankSize);
+    fixture.contigBreakend.set_range(contigFlankSize-1,contigFlankSize);
+}
+
+
+
+void
+makeSyntheticLoci(
+    const unsigned seed,
+    const unsigned locusCount,
+    std::vector<SVLocus>& loci)
+{
+    static const int32_t chromCount(4);
+    static const pos_t chromSize(10000000);
+    static const pos_t nodeSize(300);
+    static const pos_t maxLocalSVSize(50000);
+
+    std::mt19937 rng(seed);
+
+    loci.clear();
+    loci.resize(locusCount);
+    for (SVLocus& locus : loci)
+    {
+        const int32_t tid1(rng() % chromCount);
+        const pos_t pos1(rng() % chromSize);
+
+        // half of the loci link to a nearby region, and half to a random region on any chromosome:
+        int32_t tid2(tid1);
+        pos_t pos2(pos1 + nodeSize + (rng() % maxLocalSVSize));
+        if (rng() % 2)
+        {
+            tid2 = (rng() % chromCount);
+            pos2 = (rng() % chromSize);
+        }
+
+        const NodeIndexType nodeIndex1(locus.addNode(GenomeInterval(tid1,pos1,pos1+nodeSize)));
+        const NodeIndexType nodeIndex2(locus.addNode(GenomeInterval(tid2,pos2,pos2+nodeSize)));
+        locus.linkNodes(nodeIndex1,nodeIndex2);
+    }
+}
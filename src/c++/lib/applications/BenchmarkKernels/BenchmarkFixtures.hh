@@ -0,0 +1,93 @@
+//
+// Manta - Structural Variant and Indel Caller
+// Copyright (c) 2013-2017 Illumina, Inc.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+//
+
+/// \file
+/// \author Chris Saunders
+///
+
+#pragma once
+
+#include "assembly/AssemblyReadInfo.hh"
+#include "blt_util/blt_types.hh"
+#include "blt_util/known_pos_range2.hh"
+#include "svgraph/SVLocus.hh"
+
+#include <string>
+#include <vector>
+
+
+/// \brief Synthetic reference window with a planted deletion
+///
+/// All fixture content is a deterministic function of the random seed, so that benchmark
+/// results are comparable between builds.
+///
+struct SyntheticDeletionFixture
+{
+    /// random reference sequence
+    std::string ref;
+
+    /// deleted range in reference coordinates
+    known_pos_range2 deletion;
+
+    /// reference sequence with the deletion applied
+    std::string haplotype;
+
+    /// reads sampled from the haplotype across the deletion breakend, with a low rate of
+    /// substitution errors
+    AssemblyReadInput reads;
+
+    /// a single read spanning the deletion breakend
+    std::string splitRead;
+
+    /// base qualities for splitRead
+    std::vector<uint8_t> splitReadQual;
+
+    /// splitRead in the 4-bit packed BAM sequence format
+    std::vector<uint8_t> packedSplitRead;
+
+    /// haplotype segment centered on the breakend, used as a split read alignment target
+    std::string contig;
+
+    /// breakend range in contig coordinates
+    known_pos_range2 contigBreakend;
+};
+
+
+/// \brief Generate a synthetic reference window with a planted deletion
+///
+/// \param[in] seed random seed for the fixture
+/// \param[in] refSize size of the reference window
+/// \param[in] deletionSize size of the planted deletion, which is centered in the reference window
+void
+makeSyntheticDeletionFixture(
+    const unsigned seed,
+    const unsigned refSize,
+    const unsigned deletionSize,
+    SyntheticDeletionFixture& fixture);
+
+
+/// \brief Generate random two-node SV loci to benchmark SV locus graph merging
+///
+/// Loci are distributed over a small number of chromosomes, so that a realistic fraction of
+/// loci overlap and are merged together.
+void
+makeSyntheticLoci(
+    const unsigned seed,
+    const unsigned locusCount,
+    std::vector<SVLocus>& loci);
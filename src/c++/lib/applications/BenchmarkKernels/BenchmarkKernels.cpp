@@ -0,0 +1,341 @@
+//
+// Manta - Structural Variant and Indel Caller
+// Copyright (c) 2013-2017 Illumina, Inc.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+//
+
+/// \file
+/// \author Chris Saunders
+///
+
+#include "BenchmarkKernels.hh"
+#include "BenchmarkFixtures.hh"
+#include "BenchmarkKernelsOptions.hh"
+#include "KernelTimer.hh"
+
+#include "alignment/GlobalJumpAligner.hh"
+#include "applications/GenerateSVCandidates/SplitReadAlignment.hh"
+#include "assembly/IterativeAssembler.hh"
+#include "blt_util/depth_diff_buffer.hh"
+#include "blt_util/log.hh"
+#include "blt_util/qscore_snp.hh"
+#include "common/OutStream.hh"
+#include "htsapi/align_path_bam_util.hh"
+#include "htsapi/bam_seq.hh"
+#include "htsapi/bam_streamer.hh"
+#include "options/SVRefinerOptions.hh"
+#include "svgraph/SVLocusSet.hh"
+
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <sstream>
+
+
+
+/// Kernel results are written here so that the compiler can't optimize the kernel away
+static volatile unsigned long resultSink(0);
+
+template <typename T>
+static
+void
+keepResult(const T& val)
+{
+    resultSink = static_cast<unsigned long>(val);
+}
+
+
+
+static
+bool
+isSelectedKernel(
+    const BenchmarkKernelsOptions& opt,
+    const std::string& name)
+{
+    if (opt.kernelNames.empty()) return true;
+    return (std::find(opt.kernelNames.begin(),opt.kernelNames.end(),name) != opt.kernelNames.end());
+}
+
+
+
+static
+void
+runSyntheticKernels(
+    const BenchmarkKernelsOptions& opt,
+    std::vector<KernelResult>& results)
+{
+    static const unsigned refSize(4000);
+    static const unsigned deletionSize(1000);
+    static const unsigned locusCount(5000);
+
+    SyntheticDeletionFixture fixture;
+    makeSyntheticDeletionFixture(opt.seed, refSize, deletionSize, fixture);
+
+    const SVRefinerOptions refineOpt;
+
+    // align a breakend-spanning contig to the reference regions flanking the planted deletion:
+    static const std::string jumpAlignerName("GlobalJumpAligner");
+    if (isSelectedKernel(opt,jumpAlignerName))
+    {
+        static const pos_t flankSize(400);
+        const std::string ref1(fixture.ref.substr(fixture.deletion.begin_pos()-flankSize,2*flankSize));
+        const std::string ref2(fixture.ref.substr(fixture.deletion.end_pos()-flankSize,2*flankSize));
+
+        const GlobalJumpAligner<int> aligner(refineOpt.spanningAlignScores,refineOpt.jumpScore);
+        JumpAlignmentResult<int> result;
+        results.push_back(timeKernel(opt.timerOpt, jumpAlignerName, [&]()
+        {
+            aligner.align(
+                fixture.contig.cbegin(),fixture.contig.cend(),
+                ref1.begin(),ref1.end(),
+                ref2.begin(),ref2.end(),
+                result);
+            keepResult(result.score);
+        }));
+    }
+
+    // assemble reads tiled across the planted deletion breakend:
+    static const std::string assemblerName("IterativeAssembler");
+    if (isSelectedKernel(opt,assemblerName))
+    {
+        results.push_back(timeKernel(opt.timerOpt, assemblerName, [&]()
+        {
+            AssemblyReadInput reads(fixture.reads);
+            AssemblyReadOutput readInfo;
+            Assembly contigs;
+            runIterativeAssembler(refineOpt.spanningAssembleOpt, reads, readInfo, contigs);
+            keepResult(contigs.size());
+        }));
+    }
+
+    // align a split read to the breakend contig:
+    static const std::string splitReadAlignerName("splitReadAligner");
+    if (isSelectedKernel(opt,splitReadAlignerName))
+    {
+        static const unsigned flankScoreSize(50);
+        const qscore_snp qualConvert(0);
+        SRAlignmentInfo alignment;
+        results.push_back(timeKernel(opt.timerOpt, splitReadAlignerName, [&]()
+        {
+            splitReadAligner(flankScoreSize, fixture.splitRead, qualConvert, fixture.splitReadQual.data(),
+                             fixture.contig, fixture.contigBreakend, alignment);
+            keepResult(alignment.alignPos);
+        }));
+    }
+
+    // decode a read from the packed BAM sequence format:
+    static const std::string bamSeqDecodeName("bam_seq::get_string");
+    if (isSelectedKernel(opt,bamSeqDecodeName))
+    {
+        const bam_seq packedRead(fixture.packedSplitRead.data(),fixture.splitRead.size());
+        results.push_back(timeKernel(opt.timerOpt, bamSeqDecodeName, [&]()
+        {
+            const std::string read(packedRead.get_string());
+            keepResult(read[0]);
+        }));
+    }
+
+    // merge random loci into an SV locus graph:
+    static const std::string mergeName("SVLocusSet::merge");
+    if (isSelectedKernel(opt,mergeName))
+    {
+        std::vector<SVLocus> loci;
+        makeSyntheticLoci(opt.seed, locusCount, loci);
+        results.push_back(timeKernel(opt.timerOpt, mergeName, [&]()
+        {
+            SVLocusSet set;
+            for (const SVLocus& locus : loci)
+            {
+                set.merge(locus);
+            }
+            keepResult(set.size());
+        }));
+    }
+}
+
+
+
+/// Read every alignment in the input file, with the cigar parsing and depth tracking steps
+/// common to all read scanning operations in the workflow.
+static
+void
+runAlignmentFileKernels(
+    const BenchmarkKernelsOptions& opt,
+    std::vector<KernelResult>& results)
+{
+    if (opt.alignmentFilename.empty()) return;
+
+    static const std::string scanName("alignmentFileScan");
+    if (! isSelectedKernel(opt,scanName)) return;
+
+    const char* referenceFilename(opt.referenceFilename.empty() ? nullptr : opt.referenceFilename.c_str());
+    ALIGNPATH::path_t apath;
+    depth_diff_buffer depth;
+    results.push_back(timeKernel(opt.timerOpt, scanName, [&]()
+    {
+        bam_streamer readStream(opt.alignmentFilename.c_str(), referenceFilename);
+        int32_t tid(-1);
+        while (readStream.next())
+        {
+            const bam_record& bamRead(*(readStream.get_record_ptr()));
+            if (bamRead.is_unmapped()) continue;
+
+            const pos_t refPos(bamRead.pos()-1);
+            if (bamRead.target_id() != tid)
+            {
+                tid = bamRead.target_id();
+                depth.reset(refPos);
+            }
+            bam_cigar_to_apath(bamRead.raw_cigar(),bamRead.n_cigar(),apath);
+            depth.inc(refPos,refPos+ALIGNPATH::apath_ref_length(apath));
+            depth.clear_to_pos(refPos-1);
+        }
+        keepResult(depth.val(0));
+    }));
+}
+
+
+
+static
+void
+writeReport(
+    const std::vector<KernelResult>& results,
+    std::ostream& os)
+{
+    os << "#kernel\titerations\tnsPerOp\tallocsPerOp\tcacheMissesPerOp\n";
+    os << std::fixed << std::setprecision(2);
+    for (const KernelResult& result : results)
+    {
+        os << result.name
+           << '\t' << result.iterations
+           << '\t' << result.nsPerOp
+           << '\t' << result.allocsPerOp
+           << '\t';
+        if (result.cacheMissesPerOp < 0)
+        {
+            os << "NA";
+        }
+        else
+        {
+            os << result.cacheMissesPerOp;
+        }
+        os << '\n';
+    }
+}
+
+
+
+/// Read time per operation for each kernel from a previous benchmark report
+static
+void
+readBaseline(
+    const std::string& filename,
+    std::map<std::string,double>& baselineNsPerOp)
+{
+    std::ifstream ifs(filename.c_str());
+    std::string line;
+    while (std::getline(ifs,line))
+    {
+        if (line.empty() || (line[0] == '#')) continue;
+        std::istringstream iss(line);
+        std::string name;
+        unsigned long iterations;
+        double nsPerOp;
+        if (! (std::getline(iss,name,'\t') && (iss >> iterations >> nsPerOp)))
+        {
+            log_os << "ERROR: Can't parse benchmark baseline line: '" << line << "'\n";
+            exit(EXIT_FAILURE);
+        }
+        baselineNsPerOp[name] = nsPerOp;
+    }
+}
+
+
+
+/// \return true if any kernel has regressed relative to the baseline
+static
+bool
+compareToBaseline(
+    const BenchmarkKernelsOptions& opt,
+    const std::vector<KernelResult>& results)
+{
+    std::map<std::string,double> baselineNsPerOp;
+    readBaseline(opt.baselineFilename, baselineNsPerOp);
+
+    bool isRegression(false);
+    for (const KernelResult& result : results)
+    {
+        const auto iter(baselineNsPerOp.find(result.name));
+        if (iter == baselineNsPerOp.end())
+        {
+            log_os << "INFO: Kernel '" << result.name << "' is not in the baseline.\n";
+            continue;
+        }
+
+        const double change((result.nsPerOp/iter->second)-1.);
+        const bool isKernelRegression(change > opt.maxRegression);
+        log_os << (isKernelRegression ? "ERROR" : "INFO") << ": Kernel '" << result.name << "'"
+               << " nsPerOp: " << result.nsPerOp << " baseline: " << iter->second
+               << " change: " << (change*100) << "%"
+               << (isKernelRegression ? " exceeds max regression" : "") << "\n";
+        if (isKernelRegression) isRegression = true;
+    }
+    return isRegression;
+}
+
+
+
+static
+void
+runBenchmarkKernels(const BenchmarkKernelsOptions& opt)
+{
+    // check that we have write permission on the output file early:
+    {
+        OutStream outs(opt.outputFilename);
+    }
+
+    std::vector<KernelResult> results;
+    runSyntheticKernels(opt, results);
+    runAlignmentFileKernels(opt, results);
+
+    {
+        OutStream outs(opt.outputFilename);
+        writeReport(results, outs.getStream());
+    }
+
+    if (! opt.baselineFilename.empty())
+    {
+        if (compareToBaseline(opt, results))
+        {
+            log_os << "ERROR: Benchmark regression detected relative to baseline: '" << opt.baselineFilename << "'\n";
+            exit(EXIT_FAILURE);
+        }
+    }
+}
+
+
+
+void
+BenchmarkKernels::
+runInternal(int argc, char* argv[]) const
+{
+    BenchmarkKernelsOptions opt;
+
+    parseBenchmarkKernelsOptions(*this,argc,argv,opt);
+    runBenchmarkKernels(opt);
+}
@@ -0,0 +1,150 @@
+//
+// Manta - Structural Variant and Indel Caller
+// Copyright (c) 2013-2017 Illumina, Inc.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+//
+
+/// \file
+/// \author Chris Saunders
+///
+
+#include "BenchmarkKernelsOptions.hh"
+
+#include "blt_util/log.hh"
+#include "common/ProgramUtil.hh"
+#include "options/optionsUtil.hh"
+
+#include "boost/program_options.hpp"
+
+#include <iostream>
+
+
+
+static
+void
+usage(
+    std::ostream& os,
+    const illumina::Program& prog,
+    const boost::program_options::options_description& visible,
+    const char* msg = nullptr)
+{
+    usage(os, prog, visible, "benchmark manta alignment, assembly and graph kernels", "", msg);
+}
+
+
+
+/// \brief Parse BenchmarkKernelsOptions
+///
+/// \param[out] errorMsg If an error occurs this is set to an end-user targeted error message. Any string content on
+///                 input is cleared
+///
+/// \return True if an error occurs while parsing options
+static
+bool
+parseOptions(
+    BenchmarkKernelsOptions& opt,
+    std::string& errorMsg)
+{
+    errorMsg.clear();
+    if (! opt.alignmentFilename.empty())
+    {
+        if (checkStandardizeInputFile(opt.alignmentFilename, "alignment file", errorMsg)) return true;
+    }
+    if (! opt.referenceFilename.empty())
+    {
+        if (checkStandardizeInputFile(opt.referenceFilename, "reference fasta", errorMsg)) return true;
+    }
+    if (! opt.baselineFilename.empty())
+    {
+        if (checkStandardizeInputFile(opt.baselineFilename, "benchmark baseline", errorMsg)) return true;
+    }
+    if (opt.maxRegression < 0)
+    {
+        errorMsg = "max-regression must be non-negative";
+        return true;
+    }
+    if (opt.timerOpt.sampleCount == 0)
+    {
+        errorMsg = "sample-count must be positive";
+        return true;
+    }
+    return false;
+}
+
+
+
+void
+parseBenchmarkKernelsOptions(
+    const illumina::Program& prog,
+    int argc, char* argv[],
+    BenchmarkKernelsOptions& opt)
+{
+    namespace po = boost::program_options;
+    po::options_description req("configuration");
+    req.add_options()
+    ("output-file", po::value(&opt.outputFilename),
+     "write benchmark report to filename (default: stdout)")
+    ("align-file", po::value(&opt.alignmentFilename),
+     "alignment file (BAM or CRAM) used as input to the alignment file scan kernel (optional)")
+    ("ref", po::value(&opt.referenceFilename),
+     "fasta reference sequence, required for CRAM alignment file input")
+    ("baseline-file", po::value(&opt.baselineFilename),
+     "compare results to this previous benchmark report, and fail if any kernel has regressed")
+    ("max-regression", po::value(&opt.maxRegression)->default_value(opt.maxRegression),
+     "max allowed fractional increase in time per operation relative to the baseline")
+    ("kernel", po::value(&opt.kernelNames),
+     "only run the named kernel (may be specified multiple times)")
+    ("seed", po::value(&opt.seed)->default_value(opt.seed),
+     "random seed for synthetic fixtures")
+    ("min-sample-time", po::value(&opt.timerOpt.minSampleSeconds)->default_value(opt.timerOpt.minSampleSeconds),
+     "minimum time in seconds for each timing sample")
+    ("sample-count", po::value(&opt.timerOpt.sampleCount)->default_value(opt.timerOpt.sampleCount),
+     "number of timing samples for each kernel, the fastest sample is reported")
+    ;
+
+    po::options_description help("help");
+    help.add_options()
+    ("help,h","print this message");
+
+    po::options_description visible("options");
+    visible.add(req).add(help);
+
+    bool po_parse_fail(false);
+    po::variables_map vm;
+    try
+    {
+        po::store(po::parse_command_line(argc, argv, visible,
+                                         po::command_line_style::unix_style ^ po::command_line_style::allow_short), vm);
+        po::notify(vm);
+    }
+    catch (const boost::program_options::error& e)
+    {
+        log_os << "\nERROR: Exception thrown by option parser: " << e.what() << "\n";
+        po_parse_fail=true;
+    }
+
+    // all options are optional for this program, so no arguments is not an error:
+    if (vm.count("help") || po_parse_fail)
+    {
+        usage(log_os,prog,visible);
+    }
+
+    std::string errorMsg;
+    if (parseOptions(opt, errorMsg))
+    {
+        usage(log_os, prog, visible, errorMsg.c_str());
+    }
+}
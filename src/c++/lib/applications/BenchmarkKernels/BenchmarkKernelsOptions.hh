@@ -0,0 +1,63 @@
+//
+// Manta - Structural Variant and Indel Caller
+// Copyright (c) 2013-2017 Illumina, Inc.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+//
+
+/// \file
+/// \author Chris Saunders
+///
+
+#pragma once
+
+#include "KernelTimer.hh"
+#include "common/Program.hh"
+
+#include <string>
+#include <vector>
+
+
+struct BenchmarkKernelsOptions
+{
+    KernelTimerOptions timerOpt;
+
+    /// optional alignment file used as input to the alignment file scanning kernel
+    std::string alignmentFilename;
+
+    /// optional reference, only required for CRAM alignment file input
+    std::string referenceFilename;
+
+    std::string outputFilename;
+
+    /// if not empty, compare results to this previous benchmark report
+    std::string baselineFilename;
+
+    /// fail if any kernel is slower than its baseline by more than this fraction
+    double maxRegression = 0.2;
+
+    /// if not empty, only run kernels in this list
+    std::vector<std::string> kernelNames;
+
+    /// random seed for all synthetic fixtures
+    unsigned seed = 1;
+};
+
+
+void
+parseBenchmarkKernelsOptions(
+    const illumina::Program& prog,
+    int argc, char* argv[],
+    BenchmarkKernelsOptions& opt);
@@ -0,0 +1,215 @@
+//
+// Manta - Structural Variant and Indel Caller
+// Copyright (c) 2013-2017 Illumina, Inc.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+//
+
+/// \file
+/// \author Chris Saunders
+///
+
+#include "KernelTimer.hh"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+
+
+/// total heap allocations made by this process
+static std::atomic<unsigned long> allocationCount(0);
+
+
+// Replace the global allocation functions so that each kernel's allocation count can be
+// reported. These replacements are only linked into the benchmark program.
+//
+void*
+operator new(std::size_t size)
+{
+    allocationCount++;
+    void* ptr(std::malloc(size ? size : 1));
+    if (nullptr == ptr) throw std::bad_alloc();
+    return ptr;
+}
+
+void*
+operator new[](std::size_t size)
+{
+    return ::operator new(size);
+}
+
+void*
+operator new(std::size_t size, const std::nothrow_t&) noexcept
+{
+    allocationCount++;
+    return std::malloc(size ? size : 1);
+}
+
+void*
+operator new[](std::size_t size, const std::nothrow_t& tag) noexcept
+{
+    return ::operator new(size, tag);
+}
+
+void
+operator delete(void* ptr) noexcept
+{
+    std::free(ptr);
+}
+
+void
+operator delete[](void* ptr) noexcept
+{
+    std::free(ptr);
+}
+
+void
+operator delete(void* ptr, const std::nothrow_t&) noexcept
+{
+    std::free(ptr);
+}
+
+void
+operator delete[](void* ptr, const std::nothrow_t&) noexcept
+{
+    std::free(ptr);
+}
+
+
+
+/// \brief Count hardware cache misses for this process, where supported
+///
+struct CacheMissCounter
+{
+    CacheMissCounter()
+    {
+#ifdef __linux__
+        perf_event_attr attr;
+        std::memset(&attr, 0, sizeof(attr));
+        attr.type = PERF_TYPE_HARDWARE;
+        attr.size = sizeof(attr);
+        attr.config = PERF_COUNT_HW_CACHE_MISSES;
+        attr.disabled = 1;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        _fd = syscall(__NR_perf_event_open, &attr, 0, -1, -1, 0);
+#endif
+    }
+
+    ~CacheMissCounter()
+    {
+#ifdef __linux__
+        if (isAvailable()) close(_fd);
+#endif
+    }
+
+    bool
+    isAvailable() const
+    {
+        return (_fd >= 0);
+    }
+
+    void
+    start()
+    {
+#ifdef __linux__
+        if (! isAvailable()) return;
+        ioctl(_fd, PERF_EVENT_IOC_RESET, 0);
+        ioctl(_fd, PERF_EVENT_IOC_ENABLE, 0);
+#endif
+    }
+
+    /// \return cache misses since start, or zero if the counter is not available
+    unsigned long long
+    stop()
+    {
+        unsigned long long count(0);
+#ifdef __linux__
+        if (! isAvailable()) return count;
+        ioctl(_fd, PERF_EVENT_IOC_DISABLE, 0);
+        if (read(_fd, &count, sizeof(count)) != static_cast<ssize_t>(sizeof(count))) count = 0;
+#endif
+        return count;
+    }
+
+private:
+    long _fd = -1;
+};
+
+
+
+KernelResult
+timeKernel(
+    const KernelTimerOptions& opt,
+    const std::string& name,
+    const std::function<void()>& kernelOp)
+{
+    typedef std::chrono::steady_clock timer_clock;
+
+    KernelResult result;
+    result.name = name;
+
+    // warm up and calibrate the number of iterations per sample:
+    double warmupSeconds(0);
+    {
+        const timer_clock::time_point startTime(timer_clock::now());
+        kernelOp();
+        warmupSeconds = std::chrono::duration<double>(timer_clock::now()-startTime).count();
+    }
+    unsigned long iterations(1);
+    if (warmupSeconds < opt.minSampleSeconds)
+    {
+        iterations = 1+static_cast<unsigned long>(opt.minSampleSeconds/std::max(warmupSeconds,1e-9));
+    }
+    result.iterations = iterations;
+
+    CacheMissCounter cacheMisses;
+    for (unsigned sampleIndex(0); sampleIndex<opt.sampleCount; ++sampleIndex)
+    {
+        const unsigned long startAllocations(allocationCount);
+        cacheMisses.start();
+        const timer_clock::time_point startTime(timer_clock::now());
+        for (unsigned long i(0); i<iterations; ++i)
+        {
+            kernelOp();
+        }
+        const double sampleNs(std::chrono::duration<double,std::nano>(timer_clock::now()-startTime).count());
+        const unsigned long long sampleCacheMisses(cacheMisses.stop());
+        const unsigned long sampleAllocations(allocationCount-startAllocations);
+
+        const double nsPerOp(sampleNs/iterations);
+        if ((sampleIndex == 0) || (nsPerOp < result.nsPerOp))
+        {
+            result.nsPerOp = nsPerOp;
+            result.allocsPerOp = static_cast<double>(sampleAllocations)/iterations;
+            if (cacheMisses.isAvailable())
+            {
+                result.cacheMissesPerOp = static_cast<double>(sampleCacheMisses)/iterations;
+            }
+        }
+    }
+    return result;
+}
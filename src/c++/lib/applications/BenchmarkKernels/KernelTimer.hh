@@ -0,0 +1,66 @@
+//
+// Manta - Structural Variant and Indel Caller
+// Copyright (c) 2013-2017 Illumina, Inc.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+//
+
+/// \file
+/// \author Chris Saunders
+///
+
+#pragma once
+
+#include <functional>
+#include <string>
+
+
+/// \brief Per-operation cost of a benchmark kernel
+///
+struct KernelResult
+{
+    std::string name;
+    unsigned long iterations = 0;
+    double nsPerOp = 0;
+    double allocsPerOp = 0;
+
+    /// negative if hardware cache miss counts are not available on this system
+    double cacheMissesPerOp = -1;
+};
+
+
+/// \brief Options controlling the kernel measurement loop
+///
+struct KernelTimerOptions
+{
+    /// each sample is extended to run at least this long
+    double minSampleSeconds = 0.2;
+
+    /// the fastest of this many samples is reported
+    unsigned sampleCount = 5;
+};
+
+
+/// \brief Measure the time, heap allocation count and cache misses of a single kernel operation
+///
+/// The kernel is first run once to warm up any caches and calibrate the iteration count
+/// required for each sample to exceed the minimum sample time. The reported result is the
+/// fastest sample, which is the most reproducible statistic on a shared machine.
+///
+KernelResult
+timeKernel(
+    const KernelTimerOptions& opt,
+    const std::string& name,
+    const std::function<void()>& kernelOp);
@@ -53,6 +53,8 @@ parseCSLOptions(const illumina::Program& prog,
     req.add_options()
     ("graph-file", po::value(&opt.graphFilename),
      "sv locus graph file")
+    ("threads", po::value(&opt.threadCount)->default_value(opt.threadCount),
+     "number of threads used to clean and check the graph")
     ;
 
     po::options_description help("help");
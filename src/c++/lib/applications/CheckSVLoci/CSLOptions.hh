@@ -36,6 +36,9 @@ struct CSLOptions
     {}
 
     std::string graphFilename;
+
+    /// number of threads used to clean and check the graph
+    unsigned threadCount = 1;
 };
 
 
@@ -35,8 +35,8 @@ runCSL(const CSLOptions& opt)
 {
     SVLocusSet set;
     set.load(opt.graphFilename.c_str());
-    set.finalize();
-    set.checkState(true,true);
+    set.finalize(opt.threadCount);
+    set.checkState(true,true,opt.threadCount);
 }
 
 
@@ -82,10 +82,16 @@ parseESLOptions(
      "write SV Locus graph to file (required)")
     ("ref", po::value(&opt.referenceFilename),
      "fasta reference sequence (required)")
+    ("packed-ref", po::value(&opt.packedReferenceFilename),
+     "optional 2-bit packed image of the fasta reference from BuildPackedReference, used for all reference sequence access")
     ("align-stats", po::value(&opt.statsFilename),
      "pre-computed alignment statistics for the input alignment files (required)")
     ("chrom-depth", po::value(&opt.chromDepthFilename),
      "average depth estimate for each chromosome")
+    ("evidence-index-output", po::value(&opt.evidenceIndexFilename),
+     "optionally write an index of SV evidence read positions to this file")
+    ("depth-map-output", po::value(&opt.depthMapFilename),
+     "optionally write a binned map of read depth and MAPQ0 read counts to this file")
     ("region", po::value<regions_t>(),
      "samtools formatted region, eg. 'chr1:20-30'. May be supplied more than once but regions must not overlap. At least one entry required.")
     ("rna", po::value(&opt.isRNA)->zero_tokens(),
@@ -159,6 +165,10 @@ parseESLOptions(
 
     checkStandardizeUsageFile(log_os,prog,visible,opt.statsFilename,"alignment statistics");
     checkStandardizeUsageFile(log_os,prog,visible,opt.referenceFilename,"reference fasta");
+    if (! opt.packedReferenceFilename.empty())
+    {
+        checkStandardizeUsageFile(log_os,prog,visible,opt.packedReferenceFilename,"packed reference image");
+    }
 
     if (! opt.chromDepthFilename.empty())
     {
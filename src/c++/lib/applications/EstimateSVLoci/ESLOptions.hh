@@ -43,11 +43,19 @@ struct ESLOptions
     SVLocusSetOptions graphOpt;
 
     std::string referenceFilename;
+    /// Optional 2-bit packed reference image, used in place of the FASTA file for all reference sequence access
+    std::string packedReferenceFilename;
     std::string outputFilename;
     std::vector<std::string> regions;
     std::string statsFilename;
     std::string chromDepthFilename;
 
+    /// if not empty, write an index of all SV evidence read positions to this file
+    std::string evidenceIndexFilename;
+
+    /// if not empty, write a depth and MAPQ0 map of all reads starting in the scanned regions to this file
+    std::string depthMapFilename;
+
     /// TODO remove the need for this bool by having a single overlap pair handler
     bool isRNA = false;
 };
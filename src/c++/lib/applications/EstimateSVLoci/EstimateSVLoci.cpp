@@ -27,6 +27,7 @@
 
 #include "blt_util/input_stream_handler.hh"
 #include "blt_util/log.hh"
+#include "blt_util/packed_reference.hh"
 #include "common/OutStream.hh"
 #include "htsapi/bam_header_util.hh"
 #include "manta/SVReferenceUtil.hh"
@@ -38,12 +39,12 @@
 
 
 
-static
 void
-runESLRegion(
+estimateSVLociRegion(
     const ESLOptions& opt,
     const std::string& region,
-    SVLocusSet& mergedSet)
+    const std::function<void(SVLocusSetFinder&)>& regionFunc,
+    std::shared_ptr<const SVLocusScanner> readScannerPtr)
 {
     TimeTracker timer;
     timer.resume();
@@ -98,13 +99,14 @@ runESLRegion(
     log_os << log_tag << " scanRegion= " << scanRegion << "\n";
 #endif
 
-    // grab the reference for segment we're estimating plus a buffer around the segment edges:
+    // grab the reference for segment we're estimating plus a buffer around the segment edges,
+    // the segment is a view of the shared packed reference image when one has been registered:
     static const unsigned refEdgeBufferSize(500);
 
     reference_contig_segment refSegment;
-    getIntervalReferenceSegment(opt.referenceFilename, bamHeader, refEdgeBufferSize, scanRegion, refSegment);
+    getIntervalReferenceSegment(opt.referenceFilename, bamHeader, refEdgeBufferSize, scanRegion, refSegment, true);
 
-    SVLocusSetFinder locusFinder(opt, scanRegion, bamHeader, refSegment);
+    SVLocusSetFinder locusFinder(opt, scanRegion, bamHeader, refSegment, readScannerPtr);
 
     input_stream_data sdata;
     for (unsigned bamIndex(0); bamIndex<bamCount; ++bamIndex)
@@ -142,24 +144,7 @@ runESLRegion(
 #endif
     locusFinder.setBuildTime(totalTimes);
 
-    const bool isMultiRegion(opt.regions.size()>1);
-
-    if (! isMultiRegion)
-    {
-        // Save the locus set directly in single-region mode to avoid the object copy
-        locusFinder.getLocusSet().save(opt.outputFilename.c_str());
-    }
-    else
-    {
-        if (mergedSet.empty())
-        {
-            mergedSet = locusFinder.getLocusSet();
-        }
-        else
-        {
-            mergedSet.merge(locusFinder.getLocusSet());
-        }
-    }
+    regionFunc(locusFinder);
 }
 
 
@@ -172,18 +157,82 @@ runESL(const ESLOptions& opt)
         // early test that we have permission to write to output file
         OutStream outs(opt.outputFilename);
     }
+    if (! opt.evidenceIndexFilename.empty())
+    {
+        OutStream outs(opt.evidenceIndexFilename);
+    }
+    if (! opt.depthMapFilename.empty())
+    {
+        OutStream outs(opt.depthMapFilename);
+    }
 
     SVLocusSet mergedSet;
+    SVEvidenceReadIndex mergedIndex;
+    depth_pyramid_builder mergedDepthMap;
+
+    const bool isMultiRegion(opt.regions.size()>1);
+    const bool isEvidenceIndex(! opt.evidenceIndexFilename.empty());
+    const bool isDepthMap(! opt.depthMapFilename.empty());
+
+    auto regionFunc = [&](SVLocusSetFinder& locusFinder)
+    {
+        if (! isMultiRegion)
+        {
+            // Save the locus set directly in single-region mode to avoid the object copy
+            locusFinder.getLocusSet().save(opt.outputFilename.c_str());
+
+            if (isEvidenceIndex)
+            {
+                locusFinder.getEvidenceIndex().save(opt.evidenceIndexFilename.c_str());
+            }
+
+            if (isDepthMap)
+            {
+                locusFinder.getDepthMap().write(opt.depthMapFilename);
+            }
+        }
+        else
+        {
+            if (mergedSet.empty())
+            {
+                mergedSet = locusFinder.getLocusSet();
+            }
+            else
+            {
+                mergedSet.merge(locusFinder.getLocusSet());
+            }
+
+            if (isEvidenceIndex)
+            {
+                mergedIndex.merge(locusFinder.getEvidenceIndex());
+            }
+
+            if (isDepthMap)
+            {
+                mergedDepthMap.merge(locusFinder.getDepthMap());
+            }
+        }
+    };
 
     for (const auto& region : opt.regions)
     {
-        runESLRegion(opt, region, mergedSet);
+        estimateSVLociRegion(opt, region, regionFunc);
     }
 
-    const bool isMultiRegion(opt.regions.size()>1);
     if (isMultiRegion)
     {
         mergedSet.save(opt.outputFilename.c_str());
+
+        if (isEvidenceIndex)
+        {
+            mergedIndex.finalize();
+            mergedIndex.save(opt.evidenceIndexFilename.c_str());
+        }
+
+        if (isDepthMap)
+        {
+            mergedDepthMap.write(opt.depthMapFilename);
+        }
     }
 }
 
@@ -196,5 +245,9 @@ runInternal(int argc, char* argv[]) const
     ESLOptions opt;
 
     parseESLOptions(*this,argc,argv,opt);
+    if (! opt.packedReferenceFilename.empty())
+    {
+        register_packed_reference(opt.referenceFilename, opt.packedReferenceFilename);
+    }
     runESL(opt);
 }
@@ -23,8 +23,15 @@
 
 #pragma once
 
+#include "ESLOptions.hh"
+#include "SVLocusSetFinder.hh"
+
 #include "common/Program.hh"
 
+#include <functional>
+#include <memory>
+#include <string>
+
 
 /// estimate per-library information from alignment file(s)
 ///
@@ -39,3 +46,18 @@ struct EstimateSVLoci : public illumina::Program
     void
     runInternal(int argc, char* argv[]) const;
 };
+
+
+/// \brief Build the SV locus graph for a single alignment region
+///
+/// \param[in] region samtools formatted region to scan
+/// \param[in] regionFunc called with the locus finder after all reads in the region have been scanned, so that
+///                       the caller can save or merge the region's SV locus graph and evidence index
+/// \param[in] readScannerPtr optional read scanner shared between regions, if null a read scanner is created
+///                           from opt
+void
+estimateSVLociRegion(
+    const ESLOptions& opt,
+    const std::string& region,
+    const std::function<void(SVLocusSetFinder&)>& regionFunc,
+    std::shared_ptr<const SVLocusScanner> readScannerPtr = nullptr);
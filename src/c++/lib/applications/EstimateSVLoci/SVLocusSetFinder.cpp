@@ -27,6 +27,8 @@
 #include "htsapi/align_path_bam_util.hh"
 #include "manta/ChromDepthFilterUtil.hh"
 
+#include <algorithm>
+#include <cassert>
 #include <iostream>
 
 
@@ -36,24 +38,23 @@ namespace STAGE
 enum index_t
 {
     HEAD,
-    DENOISE,
-    CLEAR_DEPTH
+    COALESCE,
+    DENOISE
 };
 
 
 static
 stage_data
 getStageData(
+    const unsigned coalesceBorderSize,
     const unsigned denoiseBorderSize)
 {
-    // the number of positions below the HEAD position where the
-    // depth buffer can be safely erased
-    static const unsigned clearDepthBorderSize(10);
+    assert(coalesceBorderSize < denoiseBorderSize);
 
     stage_data sd;
     sd.add_stage(HEAD);
+    sd.add_stage(COALESCE, HEAD, coalesceBorderSize);
     sd.add_stage(DENOISE, HEAD, denoiseBorderSize);
-    sd.add_stage(CLEAR_DEPTH, HEAD, clearDepthBorderSize);
 
     return sd;
 }
@@ -112,6 +113,10 @@ computeDenoiseRegion(
 /// The compression level used by this object's private depth-per-position buffer.
 static const unsigned depthBufferCompression = 16;
 
+/// The number of positions below the most recent depth buffer input read where the
+/// depth buffer can be safely erased
+static const pos_t clearDepthBorderSize = 10;
+
 
 
 SVLocusSetFinder::
@@ -119,12 +124,13 @@ SVLocusSetFinder(
     const ESLOptions& opt,
     const GenomeInterval& scanRegion,
     const bam_header_info& bamHeader,
-    const reference_contig_segment& refSeq) :
+    const reference_contig_segment& refSeq,
+    std::shared_ptr<const SVLocusScanner> readScannerPtr) :
     _isAlignmentTumor(opt.alignFileOpt.isAlignmentTumor),
     _scanRegion(scanRegion),
     _denoiseRegion(computeDenoiseRegion(scanRegion, bamHeader, REGION_DENOISE_BORDER)),
     _stageManager(
-        STAGE::getStageData(REGION_DENOISE_BORDER),
+        STAGE::getStageData(COALESCE_BORDER, REGION_DENOISE_BORDER),
         pos_range(
             scanRegion.range.begin_pos(),
             scanRegion.range.end_pos()),
@@ -133,9 +139,15 @@ SVLocusSetFinder(
     _positionReadDepthEstimate(depthBufferCompression),
     _isInDenoiseRegion(false),
     _denoiseStartPos(0),
-    _readScanner(opt.scanOpt,opt.statsFilename,opt.alignFileOpt.alignmentFilename, opt.isRNA),
+    _readScannerPtr(readScannerPtr ? readScannerPtr :
+                    std::make_shared<const SVLocusScanner>(opt.scanOpt,opt.statsFilename,
+                                                           opt.alignFileOpt.alignmentFilename, opt.isRNA)),
+    _readScanner(*_readScannerPtr),
     _isMaxDepthFilter(false),
     _maxDepth(0),
+    _isEvidenceIndex(! opt.evidenceIndexFilename.empty()),
+    _isDepthMap(! opt.depthMapFilename.empty()),
+    _isTumorOnly(std::find(_isAlignmentTumor.begin(), _isAlignmentTumor.end(), false) == _isAlignmentTumor.end()),
     _bamHeader(bamHeader),
     _refSeq(refSeq)
 {
@@ -161,6 +173,19 @@ SVLocusSetFinder(
     }
 
     _svLoci.header = bamHeader;
+
+    if (_isEvidenceIndex)
+    {
+        _evidenceIndex.setSampleCount(sampleCount);
+    }
+
+    if (_isDepthMap)
+    {
+        for (const bam_header_info::chrom_info& chromInfo : bamHeader.chrom_data)
+        {
+            _depthMap.add_contig(chromInfo.label, chromInfo.length);
+        }
+    }
 }
 
 
@@ -178,6 +203,11 @@ process_pos(const int stage_no,
     {
         // pass
     }
+    else if (stage_no == STAGE::COALESCE)
+    {
+        // merge staged loci into the graph before the denoising stage reaches them:
+        _coalescingBuffer.flush(pos, _svLoci);
+    }
     else if (stage_no == STAGE::DENOISE)
     {
         // denoise the SV locus graph in regions of at least this size
@@ -224,10 +254,6 @@ process_pos(const int stage_no,
             }
         }
     }
-    else if (stage_no == STAGE::CLEAR_DEPTH)
-    {
-        _positionReadDepthEstimate.clear_pos(pos);
-    }
     else
     {
         assert(false && "Unexpected stage id");
@@ -254,10 +280,55 @@ addToDepthBuffer(
 
     const pos_t refPos(bamRead.pos()-1);
 
+    // Input reads are position sorted, so depth far enough below the current read won't be queried again:
+    _positionReadDepthEstimate.clear_to_pos(refPos-clearDepthBorderSize);
+
     // Estimated read depth uses a very simple approximation that each input read aligns without any indels.
     // This is done to reduce the depth estimation runtime overhead.
     const pos_t readSize(bamRead.read_size());
-    _positionReadDepthEstimate.inc(refPos,readSize);
+    _positionReadDepthEstimate.inc(refPos,refPos+readSize);
+}
+
+
+
+void
+SVLocusSetFinder::
+addToEvidenceIndex(
+    const unsigned defaultReadGroupIndex,
+    const bam_record& bamRead,
+    const bool isPreFilteredNonEvidence)
+{
+    if (isPreFilteredNonEvidence) return;
+
+    // Each read is indexed by the process which scans its start position:
+    const pos_t refPos(bamRead.pos()-1);
+    if (! _scanRegion.range.is_pos_intersect(refPos)) return;
+
+    if (bamRead.map_qual() < _readScanner.getMinTier2MapQ()) return;
+
+    if (! _readScanner.isSVEvidence(bamRead,defaultReadGroupIndex,_refSeq)) return;
+
+    bam_cigar_to_apath(bamRead.raw_cigar(),bamRead.n_cigar(),_evidencePath);
+    const pos_t refLength(std::max(1u,ALIGNPATH::apath_ref_length(_evidencePath)));
+    _evidenceIndex.add(defaultReadGroupIndex, bamRead.target_id(), refPos, (refPos+refLength));
+}
+
+
+
+void
+SVLocusSetFinder::
+addToDepthMap(
+    const unsigned defaultReadGroupIndex,
+    const bam_record& bamRead)
+{
+    if (_isAlignmentTumor[defaultReadGroupIndex] && (! _isTumorOnly)) return;
+
+    // Each read is mapped by the process which scans its start position:
+    const pos_t refPos(bamRead.pos()-1);
+    if (! _scanRegion.range.is_pos_intersect(refPos)) return;
+
+    // As for the depth buffer, each read is approximated as a perfect match of its read size:
+    _depthMap.add_read(bamRead.target_id(), refPos, (refPos+bamRead.read_size()), (0 == bamRead.map_qual()));
 }
 
 
@@ -279,12 +350,31 @@ update(
         }
     }
 
+    // The depth map uses the same simple filtration criteria as the depth buffer
+    if (_isDepthMap && (! bamRead.is_unmapped()))
+    {
+        addToDepthMap(defaultReadGroupIndex, bamRead);
+    }
+
     // This is the primary read filtration step for the purpose of graph building
     //
     // Although unmapped reads themselves are filtered out, reads with unmapped mates are still
     // accepted, because these contribute signal for assembly (indel) regions.
     if (SVLocusScanner::isMappedReadFilteredCore(bamRead)) return;
 
+    // Most reads are rejected as non-evidence by a cheap pre-filter, which avoids the full SV evidence
+    // test below. The pre-filter only rejects reads which the full test would also reject. It is
+    // computed here only if the evidence index needs it, otherwise after the depth and MAPQ filters.
+    bool isPreFilteredNonEvidence(false);
+
+    // The evidence index must include reads filtered from the graph for high depth or graph-specific
+    // mapping quality thresholds, because candidate generation uses different criteria.
+    if (_isEvidenceIndex)
+    {
+        isPreFilteredNonEvidence = _readScanner.isPreFilteredNonEvidence(bamRead,defaultReadGroupIndex,_refSeq);
+        addToEvidenceIndex(defaultReadGroupIndex, bamRead, isPreFilteredNonEvidence);
+    }
+
     // Filter out reads from high-depth chromosome regions
     if (_isMaxDepthFilter)
     {
@@ -303,6 +393,20 @@ update(
         return;
     }
 
+    if (! _isEvidenceIndex)
+    {
+        isPreFilteredNonEvidence = _readScanner.isPreFilteredNonEvidence(bamRead,defaultReadGroupIndex,_refSeq);
+    }
+
+    if (isPreFilteredNonEvidence)
+    {
+        // record the same evidence counts as the full test for a non-evidence read:
+        SVLocusEvidenceCount& evidenceCount(incounts.evidenceCount);
+        evidenceCount.total++;
+        evidenceCount.ignored++;
+        return;
+    }
+
     // Filter out reads which are not found to be indicative of an SV
     //
     // For certain types of SV evidence, these tests are designed to be a faster approximation of the
@@ -340,10 +444,10 @@ update(
     _readScanner.getSVLoci(bamRead, defaultReadGroupIndex, _bamHeader,
                            _refSeq, loci, eCounts);
 
-    // merge each non-empty SV locus into this genome segment graph:
+    // stage each non-empty SV locus for merge into this genome segment graph:
     for (const SVLocus& locus : loci)
     {
         if (locus.empty()) continue;
-        _svLoci.merge(locus);
+        _coalescingBuffer.add(bamRead.pos()-1, locus);
     }
 }
@@ -25,14 +25,18 @@
 
 #include "ESLOptions.hh"
 
-#include "blt_util/depth_buffer.hh"
+#include "blt_util/depth_diff_buffer.hh"
+#include "blt_util/depth_pyramid.hh"
 #include "blt_util/pos_processor_base.hh"
 #include "blt_util/stage_manager.hh"
 #include "htsapi/bam_record.hh"
+#include "manta/SVEvidenceReadIndex.hh"
 #include "manta/SVLocusScanner.hh"
+#include "svgraph/SVLocusCoalescingBuffer.hh"
 #include "svgraph/SVLocusSet.hh"
 
 #include <iosfwd>
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -50,15 +54,15 @@
 ///
 /// This inherits from pos_processor_base to facilitate a "rolling" execution of
 /// functions at a defined positional offset less than the position of the most recent
-/// read alignment input. These offset functions will (1) trigger the inline graph denoising
-/// process (2) clean up buffered read depth data after it is no longer needed.
+/// read alignment input. These offset functions trigger the inline graph denoising process.
 ///
 /// Depth Tracking and High-Depth Filtration:
 ///
 /// This object tracks the estimated depth per position summed over all non-tumor samples in
 /// the input. This depth estimate is compared to a precomputed expected depth for the chromosome/contig
 /// currently being analyzed. At positions where the local read depth is substantially higher than the
-/// expected chromosome depth, SV evidence reads are not merged into the SV graph.
+/// expected chromosome depth, SV evidence reads are not merged into the SV graph. Depth is tracked with
+/// a difference buffer so that the cost of the depth estimate is independent of read length.
 ///
 /// The motivation for skipping high depth regions is that (in an unbiased/non-targeted sequencing assay)
 /// high-depth regions indicated reference compressions and other artifacts which typically produce many
@@ -67,18 +71,53 @@
 /// mutation process, so at least on non-tumor sample is required to infer the location of reference
 /// compressions or similarly unreliable regions.
 ///
+/// Pre-merge Coalescing:
+///
+/// SV loci from each read are not merged into the SV graph immediately, but are first held in a short
+/// position-ordered staging buffer, where loci of the same shape from nearby reads are summed together. This
+/// reduces the number of graph merge operations at SV hotspots, where many reads support the same event. The
+/// staging buffer is released into the graph at a fixed offset below the HEAD position, ahead of graph denoising.
+///
+/// Evidence Read Index:
+///
+/// Optionally, this object also records the position of every read which could be used as SV evidence in
+/// the candidate generation step, prior to high-depth filtration, so that candidate generation can skip
+/// regions of the input alignments which have no evidence reads. See SVEvidenceReadIndex.
+///
+/// Depth Map:
+///
+/// Optionally, this object also records binned read depth and MAPQ0 read counts of all reads starting in the
+/// scan region, so that candidate generation and scoring can look up depth without scanning the input
+/// alignments. See depth_pyramid.
+///
 struct SVLocusSetFinder : public pos_processor_base
 {
+    enum hack_t
+    {
+        /// Length in bases on the beginning and the end of scan range which is excluded from in-line graph de-noising
+        ///
+        /// TODO compute this number from read insert ranges
+        REGION_DENOISE_BORDER = 5000,
+
+        /// Length in bases below the HEAD position at which staged SV loci are merged into the graph
+        ///
+        /// Loci from reads within this distance of each other can be coalesced before the graph merge.
+        COALESCE_BORDER = 200
+    };
+
     /// This constructs to an immediately usable state following an RAII-like pattern.
     ///
     /// \param scanRegion The genomic region which this SVLocusSetFinder object will translate into an SVLocusGraph
     /// \param bamHeader Bam header containing chromosome details. This is used directly in this object and copied
     ///                  into the SV locus graph.
+    /// \param[in] readScannerPtr optional read scanner shared with other locus finders, if null a read scanner
+    ///                           is created from opt
     SVLocusSetFinder(
         const ESLOptions& opt,
         const GenomeInterval& scanRegion,
         const bam_header_info& bamHeader,
-        const reference_contig_segment& refSeq);
+        const reference_contig_segment& refSeq,
+        std::shared_ptr<const SVLocusScanner> readScannerPtr = nullptr);
 
     ~SVLocusSetFinder() override
     {
@@ -96,12 +135,34 @@ struct SVLocusSetFinder : public pos_processor_base
         const unsigned defaultReadGroupIndex);
 
     /// \brief Provide const access to the SV locus graph that this object is building.
+    ///
+    /// Any SV loci still held in the pre-merge staging buffer are merged into the graph first.
     const SVLocusSet&
     getLocusSet()
     {
+        _coalescingBuffer.flush(_svLoci);
         return _svLoci;
     }
 
+    /// \brief Provide const access to the SV evidence read index that this object is building.
+    ///
+    /// The index is only populated if an evidence index output file was given in the options.
+    const SVEvidenceReadIndex&
+    getEvidenceIndex()
+    {
+        _evidenceIndex.finalize();
+        return _evidenceIndex;
+    }
+
+    /// \brief Provide const access to the depth map that this object is building.
+    ///
+    /// The map is only populated if a depth map output file was given in the options.
+    const depth_pyramid_builder&
+    getDepthMap() const
+    {
+        return _depthMap;
+    }
+
     /// \brief Flush any cached values built up during the update process.
     ///
     /// Calling this method should ensure that the SV locus graph reflects all read evidence input so far, and the
@@ -110,6 +171,7 @@ struct SVLocusSetFinder : public pos_processor_base
     flush()
     {
         _stageManager.reset();
+        _coalescingBuffer.flush(_svLoci);
     }
 
     /// \brief Record the time elapsed in the graph building process.
@@ -148,13 +210,27 @@ private:
         const unsigned defaultReadGroupIndex,
         const bam_record& bamRead);
 
-    enum hack_t
-    {
-        /// Length in bases on the beginning and the end of scan range which is excluded from in-line graph de-noising
-        ///
-        /// TODO compute this number from read insert ranges
-        REGION_DENOISE_BORDER = 5000
-    };
+    /// \brief Add the input read to the evidence read index if it could be used as SV evidence
+    ///        during candidate generation.
+    ///
+    /// This applies the same read filters used to gather evidence in candidate generation, which
+    /// are less stringent than those used to build the SV locus graph.
+    ///
+    /// \param[in] isPreFilteredNonEvidence True if the read has already been rejected as SV evidence by the
+    ///                                     read scanner pre-filter
+    void
+    addToEvidenceIndex(
+        const unsigned defaultReadGroupIndex,
+        const bam_record& bamRead,
+        const bool isPreFilteredNonEvidence);
+
+    /// \brief Add the input read to the depth map
+    ///
+    /// Depth is mapped from the same samples used to estimate breakend depth during scoring.
+    void
+    addToDepthMap(
+        const unsigned defaultReadGroupIndex,
+        const bam_record& bamRead);
 
     /////////////////////////////////////////////////
     // data:
@@ -176,8 +252,11 @@ private:
     /// The SV locus graph being built by this object
     SVLocusSet _svLoci;
 
+    /// Staging buffer used to coalesce similar SV loci before they are merged into _svLoci
+    SVLocusCoalescingBuffer _coalescingBuffer;
+
     /// Track estimated depth per position for the purpose of filtering high-depth regions
-    depth_buffer_compressible _positionReadDepthEstimate;
+    depth_diff_buffer _positionReadDepthEstimate;
 
     /// True when the denoising position pointer is within _denoiseRegion
     bool _isInDenoiseRegion;
@@ -186,7 +265,8 @@ private:
     /// from this position up to a chosen window size
     pos_t _denoiseStartPos;
 
-    SVLocusScanner _readScanner;
+    std::shared_ptr<const SVLocusScanner> _readScannerPtr;
+    const SVLocusScanner& _readScanner;
 
     /// If true, then track estimated depth/pos and filter out input from very high depth regions
     /// This would typically be true for WGS and false for targeted sequencing.
@@ -197,6 +277,24 @@ private:
     /// This depth is supplied from an external estimate
     float _maxDepth;
 
+    /// If true, record all evidence reads in _evidenceIndex
+    const bool _isEvidenceIndex;
+
+    /// Positions of reads which could be used as SV evidence during candidate generation
+    SVEvidenceReadIndex _evidenceIndex;
+
+    /// this is only here as syscall cache:
+    ALIGNPATH::path_t _evidencePath;
+
+    /// If true, record all reads in _depthMap
+    const bool _isDepthMap;
+
+    /// True if all input samples are tumor samples, in which case tumor samples are used to map depth
+    bool _isTumorOnly;
+
+    /// Binned depth and MAPQ0 read counts of all reads starting in _scanRegion
+    depth_pyramid_builder _depthMap;
+
     const bam_header_info& _bamHeader;
     const reference_contig_segment& _refSeq;
 };
@@ -23,6 +23,8 @@
 
 #pragma once
 
+#include <cstdint>
+
 
 /// options for SVLocusGraph edge iteration and noise edge filtration
 struct LocusEdgeOptions
@@ -35,14 +37,36 @@ struct LocusEdgeOptions
 };
 
 
+/// per-edge processing limits, beyond which the remaining candidates of the edge are not assembled
+///
+/// each limit is disabled when set to zero
+struct EdgeBudgetOptions
+{
+    bool
+    isEnabled() const
+    {
+        return ((maxWallSeconds > 0.) || (maxReadsRetained > 0) ||
+                (maxAssemblyWordLengths > 0) || (maxDPCells > 0));
+    }
+
+    double maxWallSeconds = 0.; ///< max edge wall time
+    uint64_t maxReadsRetained = 0; ///< max reads retained as evidence or assembly input
+    uint64_t maxAssemblyWordLengths = 0; ///< max assembly word lengths attempted
+    uint64_t maxDPCells = 0; ///< max cells in all contig alignment DP matrices
+};
+
+
 /// options for SVLocusGraph edge iteration and noise edge filtration
 struct EdgeOptions
 {
     unsigned binCount = 1; ///< divide all edges in the graph into binCount bins of approx equal complexity
     unsigned binIndex = 0; ///< out of binCount bins, iterate through the edges in this bin only
+    bool isLocalityOrder = false; ///< if true, iterate through the edges of the bin in genomic locality order instead of graph storage order
 
     bool isLocusIndex = false; ///< if true, generate candidates for a specific SVgraph locus only, and ignore binCount/binIndex
     LocusEdgeOptions locusOpt;
 
     unsigned graphNodeMaxEdgeCount = 10; ///< if both nodes of an edge have an edge count higher than this, then skip evaluation of this edge, set to 0 to turn this filtration off
+
+    EdgeBudgetOptions budgetOpt;
 };
@@ -46,11 +46,23 @@ getOptionsDescription(
      "Specify how many bins the SV candidate problem should be divided into, where bin-index can be used to specify which bin to solve")
     ("bin-index", po::value(&opt.binIndex)->default_value(opt.binIndex),
      "specify which bin to solve when the SV candidate problem is subdivided into bins. Value must bin in [0,bin-count)")
+    ("locality-edge-order", po::value(&opt.isLocalityOrder)->zero_tokens(),
+     "Process the edges of the bin in an order which follows the genomic position of the edge nodes, instead of graph storage order."
+     " This does not change which edges are in the bin.")
     (locusIndexKey, po::value<std::string>(),
      "Instead of solving for all SV candidates in a bin, solve for candidates of a particular locus or edge."
      " If this argument is specified then bin-index is ignored."
      " Argument can be one of { locusIndex , locusIndex:nodeIndex , locusIndex:nodeIndex:nodeIndex },"
      " which will run an entire locus, all edges connected to one node in a locus or a single edge, respectively.")
+    ("edge-budget-seconds", po::value(&opt.budgetOpt.maxWallSeconds)->default_value(opt.budgetOpt.maxWallSeconds),
+     "Max wall time in seconds for each edge. When an edge exceeds any budget limit, assembly is skipped for its remaining"
+     " candidates, which are scored as imprecise low-resolution variants. Set to 0 to disable this limit.")
+    ("edge-budget-reads-retained", po::value(&opt.budgetOpt.maxReadsRetained)->default_value(opt.budgetOpt.maxReadsRetained),
+     "Max reads retained as evidence or assembly input for each edge. Set to 0 to disable this limit.")
+    ("edge-budget-assembly-word-lengths", po::value(&opt.budgetOpt.maxAssemblyWordLengths)->default_value(opt.budgetOpt.maxAssemblyWordLengths),
+     "Max assembly word lengths attempted for each edge. Set to 0 to disable this limit.")
+    ("edge-budget-dp-cells", po::value(&opt.budgetOpt.maxDPCells)->default_value(opt.budgetOpt.maxDPCells),
+     "Max cells in all contig alignment DP matrices for each edge. Set to 0 to disable this limit.")
     ;
     return optdesc;
 }
@@ -107,6 +119,10 @@ parseOptions(
         {
             errorMsg="bin-index must be in range [0,bin-count)";
         }
+        else if (opt.budgetOpt.maxWallSeconds < 0.)
+        {
+            errorMsg="edge-budget-seconds must be non-negative";
+        }
     }
 
     return (! errorMsg.empty());
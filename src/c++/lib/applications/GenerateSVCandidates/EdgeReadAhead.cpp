@@ -0,0 +1,227 @@
+//
+// Manta - Structural Variant and Indel Caller
+// Copyright (c) 2013-2017 Illumina, Inc.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+//
+
+
+/// \file
+/// \author Chris Saunders
+///
+
+#include "EdgeReadAhead.hh"
+#include "SVFinder.hh"
+
+#include "manta/SVReferenceUtil.hh"
+#include "svgraph/EdgeInfoUtil.hh"
+
+#include <algorithm>
+#include <fstream>
+
+
+
+/// the final compressed block of each index chunk starts at the chunk end offset, and may be up to this size
+static const uint64_t maxBgzfBlockSize(0x10000);
+
+
+
+/// sort and merge overlapping ranges, and extend each range to cover the full final compressed block
+static
+void
+mergeFileRanges(
+    std::vector<std::pair<uint64_t,uint64_t>>& ranges)
+{
+    if (ranges.empty()) return;
+
+    for (auto& range : ranges)
+    {
+        range.second += maxBgzfBlockSize;
+    }
+    std::sort(ranges.begin(),ranges.end());
+
+    unsigned headIndex(0);
+    for (unsigned rangeIndex(1); rangeIndex<ranges.size(); ++rangeIndex)
+    {
+        auto& headRange(ranges[headIndex]);
+        const auto& range(ranges[rangeIndex]);
+        if (range.first <= headRange.second)
+        {
+            headRange.second = std::max(headRange.second, range.second);
+        }
+        else
+        {
+            ranges[++headIndex] = range;
+        }
+    }
+    ranges.resize(headIndex+1);
+}
+
+
+
+EdgeReadAhead::
+EdgeReadAhead(
+    const SVLocusSet& cset,
+    const std::string& referenceFilename,
+    const std::vector<std::string>& alignmentFilenames,
+    bam_streamer_pool& bamStreams)
+    : _cset(cset),
+      _referenceFilename(referenceFilename),
+      _alignmentFilenames(alignmentFilenames),
+      _bamStreams(bamStreams),
+      _addedEdgeCount(0),
+      _startedEdgeCount(0),
+      _isShutdown(false),
+      _ioThread(&EdgeReadAhead::ioThreadLoop, this)
+{}
+
+
+
+EdgeReadAhead::
+~EdgeReadAhead()
+{
+    {
+        std::lock_guard<std::mutex> lock(_taskMutex);
+        _isShutdown = true;
+    }
+    _taskCondition.notify_one();
+    _ioThread.join();
+}
+
+
+
+void
+EdgeReadAhead::
+addEdge(const EdgeInfo& edge)
+{
+    ReadAheadTask task;
+    task.edgeIndex = _addedEdgeCount++;
+
+    // edges which fail this test are skipped by SVFinder without reading any input:
+    if (! isBidirectionalEdge(_cset, edge)) return;
+
+    const SVLocus& locus(_cset.getLocus(edge.locusIndex));
+    const unsigned fileCount(_bamStreams.size());
+    task.fileRanges.resize(fileCount);
+
+    std::vector<NodeIndexType> nodeIndices = { edge.nodeIndex1 };
+    if (edge.nodeIndex2 != edge.nodeIndex1) nodeIndices.push_back(edge.nodeIndex2);
+
+    file_ranges_t nodeRanges;
+    for (const NodeIndexType nodeIndex : nodeIndices)
+    {
+        // the node search interval is found in the same way as in SVFinder:
+        const SVLocusNode& node(locus.getNode(nodeIndex));
+        GenomeInterval searchInterval(node.getInterval());
+        searchInterval.range.merge_range(node.getEvidenceRange());
+
+        task.referenceIntervals.push_back(searchInterval);
+
+        for (unsigned fileIndex(0); fileIndex<fileCount; ++fileIndex)
+        {
+            // only query files already open in the pool, so that read-ahead never changes which files the pool
+            // holds open:
+            const bam_streamer_pool::stream_ptr bamStreamPtr(_bamStreams.getOpenStream(fileIndex));
+            if (! bamStreamPtr) continue;
+            if (! bamStreamPtr->getRegionFileRanges(searchInterval.tid, searchInterval.range.begin_pos(),
+                                                    searchInterval.range.end_pos(), nodeRanges)) continue;
+            file_ranges_t& fileRanges(task.fileRanges[fileIndex]);
+            fileRanges.insert(fileRanges.end(),nodeRanges.begin(),nodeRanges.end());
+        }
+    }
+
+    for (auto& fileRanges : task.fileRanges)
+    {
+        mergeFileRanges(fileRanges);
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(_taskMutex);
+        _tasks.push_back(std::move(task));
+    }
+    _taskCondition.notify_one();
+}
+
+
+
+void
+EdgeReadAhead::
+ioThreadLoop()
+{
+    while (true)
+    {
+        ReadAheadTask task;
+        {
+            std::unique_lock<std::mutex> lock(_taskMutex);
+            _taskCondition.wait(lock, [this] { return (_isShutdown || (! _tasks.empty())); });
+            if (_isShutdown) return;
+            task = std::move(_tasks.front());
+            _tasks.pop_front();
+        }
+
+        if (isTaskExpired(task)) continue;
+
+        // read-ahead is only a hint to the filesystem cache, so any error here is left to be found and reported
+        // when the edge is processed:
+        try
+        {
+            readTask(task);
+        }
+        catch (...)
+        {
+        }
+    }
+}
+
+
+
+void
+EdgeReadAhead::
+readTask(const ReadAheadTask& task)
+{
+    const bam_header_info& bamHeader(_cset.header);
+    for (const GenomeInterval& interval : task.referenceIntervals)
+    {
+        if (isTaskExpired(task)) return;
+        reference_contig_segment refSeq;
+        getIntervalReferenceSegment(_referenceFilename, bamHeader, SVFinder::refEdgeBufferSize, interval, refSeq);
+    }
+
+    static const uint64_t maxReadSize(0x100000);
+    std::vector<char> buffer;
+    const unsigned fileCount(task.fileRanges.size());
+    for (unsigned fileIndex(0); fileIndex<fileCount; ++fileIndex)
+    {
+        const file_ranges_t& fileRanges(task.fileRanges[fileIndex]);
+        if (fileRanges.empty()) continue;
+
+        std::ifstream ifs(_alignmentFilenames[fileIndex].c_str(), std::ios::binary);
+        if (! ifs) continue;
+        for (const auto& fileRange : fileRanges)
+        {
+            ifs.clear();
+            ifs.seekg(fileRange.first);
+            uint64_t readPos(fileRange.first);
+            while (ifs && (readPos < fileRange.second))
+            {
+                if (isTaskExpired(task)) return;
+                const uint64_t readSize(std::min(maxReadSize, (fileRange.second - readPos)));
+                buffer.resize(readSize);
+                ifs.read(buffer.data(), readSize);
+                readPos += readSize;
+            }
+        }
+    }
+}
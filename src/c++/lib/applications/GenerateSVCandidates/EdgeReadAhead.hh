@@ -0,0 +1,124 @@
+//
+// Manta - Structural Variant and Indel Caller
+// Copyright (c) 2013-2017 Illumina, Inc.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+//
+
+
+/// \file
+/// \author Chris Saunders
+///
+
+#pragma once
+
+#include "htsapi/bam_streamer_pool.hh"
+#include "svgraph/EdgeInfo.hh"
+#include "svgraph/GenomeInterval.hh"
+#include "svgraph/SVLocusSet.hh"
+
+#include "boost/utility.hpp"
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+
+/// \brief Read the input data for upcoming SV locus graph edges on a background I/O thread
+///
+/// For each edge added, the reference and alignment file regions which will be scanned for each edge node are
+/// resolved on the calling thread. The I/O thread then reads these reference segments, and the compressed
+/// alignment file blocks listed by each alignment file index for the node search intervals, so that these are
+/// already in the filesystem cache when the edge is processed. Nothing read by the I/O thread is retained, so
+/// read-ahead only changes when data is read, never the data used to process an edge.
+///
+/// Alignment file block ranges are not available for CRAM, so only the reference is read ahead for CRAM input.
+/// Block ranges are only found for alignment files already held open by the stream pool, so that read-ahead
+/// does not cause the pool to close streams in use by the edge processing thread.
+///
+/// Example use:
+/// EdgeReadAhead readAhead(cset, referenceFilename, alignmentFilenames, bamStreams);
+/// readAhead.addEdge(edge1);
+/// readAhead.addEdge(edge2);
+/// readAhead.startEdge(); // starting to process edge1
+/// ...
+///
+struct EdgeReadAhead : private boost::noncopyable
+{
+    EdgeReadAhead(
+        const SVLocusSet& cset,
+        const std::string& referenceFilename,
+        const std::vector<std::string>& alignmentFilenames,
+        bam_streamer_pool& bamStreams);
+
+    ~EdgeReadAhead();
+
+    /// \brief Resolve the input regions of an edge and queue them to be read on the I/O thread
+    void
+    addEdge(const EdgeInfo& edge);
+
+    /// \brief Indicate that processing has started on the next edge in addEdge order
+    ///
+    /// Any read-ahead still queued for this edge or earlier edges is skipped.
+    void
+    startEdge()
+    {
+        _startedEdgeCount++;
+    }
+
+private:
+    typedef std::vector<std::pair<uint64_t,uint64_t>> file_ranges_t;
+
+    struct ReadAheadTask
+    {
+        unsigned edgeIndex = 0;
+        std::vector<GenomeInterval> referenceIntervals;
+
+        /// compressed byte ranges to read from each alignment file
+        std::vector<file_ranges_t> fileRanges;
+    };
+
+    void
+    ioThreadLoop();
+
+    void
+    readTask(const ReadAheadTask& task);
+
+    bool
+    isTaskExpired(const ReadAheadTask& task) const
+    {
+        return (task.edgeIndex < _startedEdgeCount);
+    }
+
+    const SVLocusSet& _cset;
+    const std::string _referenceFilename;
+    const std::vector<std::string> _alignmentFilenames;
+    bam_streamer_pool& _bamStreams;
+
+    unsigned _addedEdgeCount;
+    std::atomic<unsigned> _startedEdgeCount;
+
+    std::mutex _taskMutex;
+    std::condition_variable _taskCondition;
+    std::deque<ReadAheadTask> _tasks;
+    bool _isShutdown;
+
+    std::thread _ioThread;
+};
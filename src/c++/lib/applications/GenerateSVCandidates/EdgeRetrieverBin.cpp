@@ -23,7 +23,9 @@
 
 #include "EdgeRetrieverBin.hh"
 
+#include <algorithm>
 #include <cassert>
+#include <utility>
 
 
 //#define DEBUG_EDGER
@@ -35,6 +37,37 @@
 
 
 
+/// \brief Get the position of a point on a Hilbert curve filling the 2^32 x 2^32 grid
+///
+static
+uint64_t
+getHilbertIndex(
+    uint32_t x,
+    uint32_t y)
+{
+    uint64_t index(0);
+    for (uint64_t s(1ul << 31); s>0; s >>= 1)
+    {
+        const bool rx(x & s);
+        const bool ry(y & s);
+        index += s * s * ((3 * rx) ^ ry);
+
+        // rotate the quadrant so that the curve is continuous:
+        if (! ry)
+        {
+            if (rx)
+            {
+                x = ~x;
+                y = ~y;
+            }
+            std::swap(x,y);
+        }
+    }
+    return index;
+}
+
+
+
 /// \brief When \p totalCount is subdivided into \p binCount approximately even bins, return the 0-indexed count
 ///        which starts the zero-indexed \p binIndex bin.
 ///
@@ -55,9 +88,12 @@ EdgeRetrieverBin(
     const SVLocusSet& set,
     const unsigned graphNodeMaxEdgeCount,
     const unsigned binCount,
-    const unsigned binIndex) :
+    const unsigned binIndex,
+    const bool isLocalityOrder) :
     EdgeRetriever(set,graphNodeMaxEdgeCount),
-    _headCount(0)
+    _headCount(0),
+    _isLocalityOrder(isLocalityOrder),
+    _localityOrderEdgeIndex(0)
 {
     assert(binCount > 0);
     assert(binIndex < binCount);
@@ -73,6 +109,8 @@ EdgeRetrieverBin(
            << _beginCount << " "
            << _endCount << "\n";
 #endif
+
+    if (_isLocalityOrder) sortEdgesByLocality();
 }
 
 
@@ -250,9 +288,80 @@ advanceEdge()
 
 
 
+void
+EdgeRetrieverBin::
+sortEdgesByLocality()
+{
+    typedef std::pair<int32_t,pos_t> node_pos_t;
+
+    auto getNodePos = [&](const EdgeInfo& edge, const NodeIndexType nodeIndex)
+    {
+        const GenomeInterval& interval(_set.getLocus(edge.locusIndex).getNode(nodeIndex).getInterval());
+        return node_pos_t(interval.tid, interval.range.begin_pos());
+    };
+
+    std::vector<EdgeInfo> edges;
+    while (nextStorageOrder())
+    {
+        edges.push_back(_edge);
+    }
+
+    // the curve is filled with the genome order rank of each node position, so that the order does not depend on
+    // contig sizes:
+    std::vector<node_pos_t> nodePositions;
+    for (const EdgeInfo& edge : edges)
+    {
+        nodePositions.push_back(getNodePos(edge, edge.nodeIndex1));
+        nodePositions.push_back(getNodePos(edge, edge.nodeIndex2));
+    }
+    std::sort(nodePositions.begin(), nodePositions.end());
+    nodePositions.erase(std::unique(nodePositions.begin(), nodePositions.end()), nodePositions.end());
+
+    auto getNodeRank = [&](const EdgeInfo& edge, const NodeIndexType nodeIndex)
+    {
+        return static_cast<uint32_t>(std::lower_bound(nodePositions.begin(), nodePositions.end(),
+                                                      getNodePos(edge, nodeIndex)) - nodePositions.begin());
+    };
+
+    std::vector<std::pair<uint64_t,unsigned long>> edgeKeys;
+    const unsigned long edgeCount(edges.size());
+    for (unsigned long edgeIndex(0); edgeIndex<edgeCount; ++edgeIndex)
+    {
+        const EdgeInfo& edge(edges[edgeIndex]);
+        const uint32_t rank1(getNodeRank(edge, edge.nodeIndex1));
+        const uint32_t rank2(getNodeRank(edge, edge.nodeIndex2));
+        edgeKeys.emplace_back(getHilbertIndex(std::min(rank1,rank2), std::max(rank1,rank2)), edgeIndex);
+    }
+
+    // ties are kept in storage order by the edge index in each key:
+    std::sort(edgeKeys.begin(), edgeKeys.end());
+
+    _localityOrderEdges.clear();
+    for (const auto& edgeKey : edgeKeys)
+    {
+        _localityOrderEdges.push_back(edges[edgeKey.second]);
+    }
+    _localityOrderEdgeIndex = 0;
+}
+
+
+
 bool
 EdgeRetrieverBin::
 next()
+{
+    if (! _isLocalityOrder) return nextStorageOrder();
+
+    if (_localityOrderEdgeIndex >= _localityOrderEdges.size()) return false;
+    _edge = _localityOrderEdges[_localityOrderEdgeIndex++];
+    return true;
+}
+
+
+
+bool
+EdgeRetrieverBin::
+nextStorageOrder()
 {
 #ifdef DEBUG_EDGER
     log_os << "EDGER: start next hc: " << _headCount << "\n";
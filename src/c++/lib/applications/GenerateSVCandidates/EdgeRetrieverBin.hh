@@ -25,6 +25,8 @@
 
 #include "EdgeRetriever.hh"
 
+#include <vector>
+
 
 /// Provide an iterator over edges in a set of SV locus graphs
 ///
@@ -37,16 +39,28 @@ struct EdgeRetrieverBin final : public EdgeRetriever
     ///            from highly connected nodes (set to zero to disable)
     /// \param[in] binCount Total number of parallel bins, must be 1 or greater
     /// \param[in] binIndex Parallel bin id, must be less than binCount
+    /// \param[in] isLocalityOrder If true, the edges of the bin are retrieved in an order which follows the genomic
+    ///            position of their nodes, instead of graph storage order. The set of edges in the bin is unchanged.
     EdgeRetrieverBin(
         const SVLocusSet& set,
         const unsigned graphNodeMaxEdgeCount,
         const unsigned binCount,
-        const unsigned binIndex);
+        const unsigned binIndex,
+        const bool isLocalityOrder = false);
 
     bool
     next() override;
 
 private:
+    /// Retrieve the next edge of the bin in graph storage order
+    bool
+    nextStorageOrder();
+
+    /// Sort all edges of the bin along a space-filling curve over the genomic positions of the two edge nodes,
+    /// so that consecutive edges tend to read nearby alignment and reference data
+    void
+    sortEdgesByLocality();
+
     /// Advance the EdgeRetriever::_edge pointer to the first unfiltered edge such that the sum of evidence from
     /// the pointer edge and all previous edges is greater than _beginCount. _headCount will be updated to reflect
     /// the above sum
@@ -66,4 +80,10 @@ private:
 
     /// Tracking index of cumulative observation count as we step through the graph
     unsigned long _headCount;
+
+    bool _isLocalityOrder;
+
+    /// All edges of the bin in locality order, only used if _isLocalityOrder is true
+    std::vector<EdgeInfo> _localityOrderEdges;
+    unsigned long _localityOrderEdgeIndex;
 };
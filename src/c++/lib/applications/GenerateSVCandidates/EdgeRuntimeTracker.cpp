@@ -39,7 +39,8 @@ EdgeRuntimeTracker(
     _cand(0),
     _compCand(0),
     _assmCand(0),
-    _assmCompCand(0)
+    _assmCompCand(0),
+    _isBudgetFallback(false)
 {
     if (outputFile.empty()) return;
     _osPtr = new std::ofstream(outputFile.c_str());
@@ -82,11 +83,33 @@ stop(const EdgeInfo& edge)
                     << '\t' << _compCand
                     << '\t' << _assmCand
                     << '\t' << _assmCompCand
-                    << '\t' << candTime.getWallSeconds()
-                    << '\t' << assmTime.getWallSeconds()
-                    << '\t' << remoteTime.getWallSeconds()
-                    << '\t' << scoreTime.getWallSeconds()
+                    << '\t' << stages.getTimes(EDGE_STAGE::CANDIDATE).wall
+                    << '\t' << stages.getTimes(EDGE_STAGE::ASSEMBLY).wall
+                    << '\t' << stages.getTimes(EDGE_STAGE::REMOTE).wall
+                    << '\t' << stages.getTimes(EDGE_STAGE::SCORE).wall;
+            stages.getWork().writeLine(*_osPtr);
+            *_osPtr << '\t' << _isBudgetFallback
                     << '\n';
         }
     }
 }
+
+
+
+bool
+EdgeRuntimeTracker::
+isBudgetExceeded(const EdgeBudgetOptions& budget) const
+{
+    const EdgeWorkStats& work(stages.getWork());
+    auto isOver = [&](const EDGE_WORK::index_t workIndex, const uint64_t maxCount)
+    {
+        return ((maxCount > 0) && (work.getTotal(workIndex) > maxCount));
+    };
+
+    if (isOver(EDGE_WORK::READS_RETAINED, budget.maxReadsRetained)) return true;
+    if (isOver(EDGE_WORK::ASSEMBLY_ITERATIONS, budget.maxAssemblyWordLengths)) return true;
+    if (isOver(EDGE_WORK::DP_CELLS, budget.maxDPCells)) return true;
+
+    // the edge timer is still running, so this is the elapsed time for the edge so far:
+    return ((budget.maxWallSeconds > 0.) && (edgeTime.getTimes().wall > budget.maxWallSeconds));
+}
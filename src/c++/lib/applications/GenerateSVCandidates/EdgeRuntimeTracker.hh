@@ -23,6 +23,8 @@
 
 #pragma once
 
+#include "EdgeOptions.hh"
+#include "appstats/EdgeStageTracker.hh"
 #include "blt_util/time_util.hh"
 #include "svgraph/EdgeInfo.hh"
 
@@ -34,6 +36,12 @@
 
 
 /// simple edge time tracker and reporter
+///
+/// Edges exceeding a minimum runtime are written to the output log, one tab-separated line per edge:
+/// the edge, its total wall time, the candidate/complex candidate/assembly/complex assembly counts, the
+/// wall time of the candidate, assembly, remote read and score stages, all work counts from
+/// EdgeWorkStats::writeLine, and finally a 0/1 indicator for the edge budget fallback.
+///
 struct EdgeRuntimeTracker : private boost::noncopyable
 {
     explicit
@@ -45,16 +53,14 @@ struct EdgeRuntimeTracker : private boost::noncopyable
     start()
     {
         edgeTime.clear();
-        candTime.clear();
-        assmTime.clear();
-        scoreTime.clear();
-        remoteTime.clear();
+        stages.clear();
 
         edgeTime.resume();
         _cand = 0;
         _compCand = 0;
         _assmCand = 0;
         _assmCompCand = 0;
+        _isBudgetFallback = false;
     }
 
     void
@@ -80,10 +86,25 @@ struct EdgeRuntimeTracker : private boost::noncopyable
         else           _assmCand++;
     }
 
-    TimeTracker candTime;
-    TimeTracker assmTime;
-    TimeTracker scoreTime;
-    TimeTracker remoteTime;
+    /// \return true if the current edge has exceeded any limit in budget
+    bool
+    isBudgetExceeded(const EdgeBudgetOptions& budget) const;
+
+    /// record that the budget fallback has been applied to the current edge
+    void
+    setBudgetFallback()
+    {
+        _isBudgetFallback = true;
+    }
+
+    bool
+    isBudgetFallback() const
+    {
+        return _isBudgetFallback;
+    }
+
+    /// per-stage time and work counts for the current edge
+    EdgeStageTracker stages;
 private:
     std::ostream* _osPtr;
     TimeTracker edgeTime;
@@ -92,4 +113,5 @@ private:
     unsigned _compCand;
     unsigned _assmCand;
     unsigned _assmCompCand;
+    bool _isBudgetFallback;
 };
@@ -109,6 +109,16 @@ struct GSCEdgeStatsManager : private boost::noncopyable
         }
     }
 
+    void
+    updateAssemblyBudgetSkip(
+        const EdgeInfo& edge)
+    {
+        if (_osPtr == nullptr) return;
+
+        GSCEdgeGroupStats& gStats(getStatsGroup(edge));
+        gStats.totalJunctionAssemblyBudgetSkips++;
+    }
+
     void
     updateScoredEdgeTime(
         const EdgeInfo& edge,
@@ -118,9 +128,12 @@ struct GSCEdgeStatsManager : private boost::noncopyable
 
         GSCEdgeGroupStats& gStats(getStatsGroup(edge));
         gStats.totalTime.merge(edgeTracker.getLastEdgeTime());
-        gStats.candTime.merge(edgeTracker.candTime.getTimes());
-        gStats.assemblyTime.merge(edgeTracker.assmTime.getTimes());
-        gStats.scoringTime.merge(edgeTracker.scoreTime.getTimes());
+        gStats.candTime.merge(edgeTracker.stages.getTimes(EDGE_STAGE::CANDIDATE));
+        gStats.assemblyTime.merge(edgeTracker.stages.getTimes(EDGE_STAGE::ASSEMBLY));
+        gStats.scoringTime.merge(edgeTracker.stages.getTimes(EDGE_STAGE::SCORE));
+        gStats.remoteTime.merge(edgeTracker.stages.getTimes(EDGE_STAGE::REMOTE));
+        gStats.workStats.merge(edgeTracker.stages.getWork());
+        if (edgeTracker.isBudgetFallback()) gStats.totalBudgetFallbackEdgeCount++;
     }
 
 private:
@@ -79,8 +79,14 @@ parseGSCOptions(
      "pre-computed alignment statistics for the input alignment files (required)")
     ("chrom-depth", po::value(&opt.chromDepthFilename),
      "average depth estimate for each chromosome")
+    ("evidence-index", po::value(&opt.evidenceIndexFilename),
+     "optional sv evidence read index from the sv locus graph construction step, used to skip input alignment regions without evidence")
+    ("depth-map", po::value(&opt.depthMapFilename),
+     "optional depth map from the sv locus graph construction step, used to find high depth regions and breakend depth without scanning the input alignments")
     ("ref", po::value(&opt.referenceFilename),
      "fasta reference sequence (required)")
+    ("packed-ref", po::value(&opt.packedReferenceFilename),
+     "optional 2-bit packed image of the fasta reference from BuildPackedReference, used for all reference sequence access")
     ("edge-runtime-log", po::value(&opt.edgeRuntimeFilename),
      "optionally log time for long-running edges to this file")
     ("edge-stats-log", po::value(&opt.edgeStatsFilename),
@@ -115,6 +121,12 @@ parseGSCOptions(
      "Directory and prefix of bams storing the supporting reads of SVs")
     ("output-contigs", po::value(&opt.isOutputContig)->zero_tokens(),
      "Output assembled contig sequences in VCF files")
+    ("max-open-align-files", po::value(&opt.maxOpenAlignmentFileCount)->default_value(opt.maxOpenAlignmentFileCount),
+     "maximum number of alignment files held open at once, zero for no limit")
+    ("cohort-scan-threads", po::value(&opt.cohortScanThreadCount)->default_value(opt.cohortScanThreadCount),
+     "number of threads used to read each SV evidence region from all alignment files concurrently, values less than 2 disable concurrent reads")
+    ("read-ahead-edges", po::value(&opt.readAheadEdgeCount)->default_value(opt.readAheadEdgeCount),
+     "number of upcoming edges for which input is read ahead on a background I/O thread, zero disables read-ahead")
     ;
 
     po::options_description alignDesc(getOptionsDescription(opt.alignFileOpt));
@@ -170,12 +182,24 @@ parseGSCOptions(
 
     checkStandardizeUsageFile(log_os,prog,visible,opt.graphFilename,"SV locus graph");
     checkStandardizeUsageFile(log_os,prog,visible,opt.referenceFilename,"reference fasta");
+    if (! opt.packedReferenceFilename.empty())
+    {
+        checkStandardizeUsageFile(log_os,prog,visible,opt.packedReferenceFilename,"packed reference image");
+    }
     checkStandardizeUsageFile(log_os,prog,visible,opt.statsFilename,"alignment statistics");
 
     if (! opt.chromDepthFilename.empty())
     {
         checkStandardizeUsageFile(log_os,prog,visible,opt.chromDepthFilename,"chromosome depth");
     }
+    if (! opt.evidenceIndexFilename.empty())
+    {
+        checkStandardizeUsageFile(log_os,prog,visible,opt.evidenceIndexFilename,"SV evidence read index");
+    }
+    if (! opt.depthMapFilename.empty())
+    {
+        checkStandardizeUsageFile(log_os,prog,visible,opt.depthMapFilename,"depth map");
+    }
     if (opt.candidateOutputFilename.empty())
     {
         usage(log_os,prog,visible,"Must specify candidate output file");
@@ -50,8 +50,13 @@ struct GSCOptions
 
     std::string graphFilename;
     std::string referenceFilename;
+    /// Optional 2-bit packed reference image, used in place of the FASTA file for all reference sequence access
+    std::string packedReferenceFilename;
     std::string statsFilename;
     std::string chromDepthFilename;
+    std::string evidenceIndexFilename;
+    /// Optional depth map from the SV locus graph construction step, used in place of alignment scans for depth
+    std::string depthMapFilename;
     std::string edgeRuntimeFilename;
     std::string edgeStatsFilename;
 
@@ -79,6 +84,16 @@ struct GSCOptions
     unsigned minScoredVariantSize = 51; ///< min size for scoring and scored output following candidate generation
 
     bool isOutputContig = false; ///< if true, an assembled contig is written in VCF
+
+    unsigned maxOpenAlignmentFileCount = 0; ///< max alignment files held open by the shared stream pool, zero for no limit
+
+    /// Number of threads used to read the same region from all alignment files concurrently in cohort scan mode,
+    /// cohort scan mode is disabled for values less than 2
+    unsigned cohortScanThreadCount = 0;
+
+    /// Number of edges ahead of the current edge for which reference and alignment file input is read on a
+    /// background I/O thread, read-ahead is disabled for a value of zero
+    unsigned readAheadEdgeCount = 0;
 };
 
 
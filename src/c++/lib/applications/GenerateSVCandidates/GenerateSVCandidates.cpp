@@ -22,18 +22,20 @@
 ///
 
 #include "GenerateSVCandidates.hh"
+#include "EdgeReadAhead.hh"
 #include "EdgeRetrieverBin.hh"
 #include "EdgeRetrieverLocus.hh"
-#include "GSCOptions.hh"
 #include "SVCandidateProcessor.hh"
 #include "SVFinder.hh"
 #include "SVSupports.hh"
 
 #include "blt_util/log.hh"
+#include "blt_util/packed_reference.hh"
 #include "common/Exceptions.hh"
 #include "manta/MultiJunctionUtil.hh"
 #include "manta/SVCandidateUtil.hh"
 
+#include <deque>
 #include <iostream>
 #include <string>
 
@@ -73,7 +75,7 @@ edgeRFactory(
     }
     else
     {
-        return (new EdgeRetrieverBin(set, opt.graphNodeMaxEdgeCount, opt.binCount, opt.binIndex));
+        return (new EdgeRetrieverBin(set, opt.graphNodeMaxEdgeCount, opt.binCount, opt.binIndex, opt.isLocalityOrder));
     }
 }
 
@@ -158,12 +160,13 @@ struct ReducedGraphInfo
 
 
 
-static
 void
 runGSC(
     const GSCOptions& opt,
     const char* progName,
-    const char* progVersion)
+    const char* progVersion,
+    std::shared_ptr<const SVLocusSet> setPtr,
+    std::shared_ptr<const SVLocusScanner> readScannerPtr)
 {
 #if 0
     {
@@ -174,13 +177,23 @@ runGSC(
     EdgeRuntimeTracker edgeTracker(opt.edgeRuntimeFilename);
     GSCEdgeStatsManager edgeStatMan(opt.edgeStatsFilename);
 
-    const SVLocusScanner readScanner(opt.scanOpt, opt.statsFilename, opt.alignFileOpt.alignmentFilename, opt.isRNA, !opt.isUnstrandedRNA);
+    if (! readScannerPtr)
+    {
+        readScannerPtr = std::make_shared<const SVLocusScanner>(opt.scanOpt, opt.statsFilename,
+                                                                opt.alignFileOpt.alignmentFilename, opt.isRNA,
+                                                                !opt.isUnstrandedRNA);
+    }
+    const SVLocusScanner& readScanner(*readScannerPtr);
+
+    // all read scanning components share a single stream for each alignment file:
+    bam_streamer_pool bamStreams(opt.alignFileOpt.alignmentFilename, opt.referenceFilename, opt.maxOpenAlignmentFileCount,
+                                 opt.cohortScanThreadCount);
 
-    SVFinder svFind(opt, readScanner, edgeTracker,edgeStatMan);
+    SVFinder svFind(opt, readScanner, bamStreams, edgeTracker, edgeStatMan, setPtr);
     MultiJunctionFilter svMJFilter(opt,edgeStatMan);
     const SVLocusSet& cset(svFind.getSet());
 
-    SVCandidateProcessor svProcessor(opt, readScanner, progName, progVersion, cset, edgeTracker, edgeStatMan);
+    SVCandidateProcessor svProcessor(opt, readScanner, progName, progVersion, cset, bamStreams, edgeTracker, edgeStatMan);
 
     std::unique_ptr<EdgeRetriever> edgerPtr(edgeRFactory(cset, opt.edgeOpt));
     EdgeRetriever& edger(*edgerPtr);
@@ -190,7 +203,6 @@ runGSC(
     std::vector<SVMultiJunctionCandidate> mjSVs;
 
     const unsigned sampleSize(opt.alignFileOpt.alignmentFilename.size());
-    std::vector<bam_streamer_ptr> origBamStreamPtrs;
     std::vector<bam_dumper_ptr> supportBamDumperPtrs;
 
     const bool isGenerateSupportBam(opt.supportBamStub.size() > 0);
@@ -198,14 +210,10 @@ runGSC(
     {
         for (unsigned idx(0); idx<sampleSize; ++idx)
         {
-            std::string alignmentFile(opt.alignFileOpt.alignmentFilename[idx]);
-            bam_streamer_ptr bamStreamPtr(new bam_streamer(alignmentFile.c_str(), opt.referenceFilename.c_str()));
-            origBamStreamPtrs.push_back(bamStreamPtr);
-
             std::string supportBamName(opt.supportBamStub
                                        + ".bam_" + std::to_string(idx)
                                        + ".bam");
-            const bam_hdr_t& header(bamStreamPtr->get_header());
+            const bam_hdr_t& header(bamStreams.getHeader(idx));
             bam_dumper_ptr bamDumperPtr(new bam_dumper(supportBamName.c_str(), header));
             supportBamDumperPtrs.push_back(bamDumperPtr);
         }
@@ -216,9 +224,33 @@ runGSC(
         log_os << __FUNCTION__ << ": " << cset.header << "\n";
     }
 
-    while (edger.next())
+    // edges are retrieved ahead of processing, so that their input can be read ahead on a separate thread:
+    std::unique_ptr<EdgeReadAhead> readAheadPtr;
+    if (opt.readAheadEdgeCount > 0)
+    {
+        readAheadPtr.reset(new EdgeReadAhead(cset, opt.referenceFilename, opt.alignFileOpt.alignmentFilename, bamStreams));
+    }
+
+    std::deque<EdgeInfo> edgeQueue;
+    bool isEdgeRetrievalComplete(false);
+
+    while (true)
     {
-        const EdgeInfo& edge(edger.getEdge());
+        while ((! isEdgeRetrievalComplete) && (edgeQueue.size() <= opt.readAheadEdgeCount))
+        {
+            if (! edger.next())
+            {
+                isEdgeRetrievalComplete = true;
+                break;
+            }
+            edgeQueue.push_back(edger.getEdge());
+            if (readAheadPtr) readAheadPtr->addEdge(edgeQueue.back());
+        }
+        if (edgeQueue.empty()) break;
+
+        const EdgeInfo edge(edgeQueue.front());
+        edgeQueue.pop_front();
+        if (readAheadPtr) readAheadPtr->startEdge();
 
         try
         {
@@ -249,7 +281,7 @@ runGSC(
             {
                 for (unsigned idx(0); idx<sampleSize; ++idx)
                 {
-                    writeSupportBam(origBamStreamPtrs[idx],
+                    writeSupportBam(bamStreams.getStream(idx),
                                     svSupports.supportSamples[idx],
                                     supportBamDumperPtrs[idx]);
                 }
@@ -290,6 +322,10 @@ runInternal(int argc, char* argv[]) const
     GSCOptions opt;
 
     parseGSCOptions(*this,argc,argv,opt);
+    if (! opt.packedReferenceFilename.empty())
+    {
+        register_packed_reference(opt.referenceFilename, opt.packedReferenceFilename);
+    }
 #ifdef DEBUG_GSV
     opt.isVerbose=true;
 #endif
@@ -23,7 +23,13 @@
 
 #pragma once
 
+#include "GSCOptions.hh"
+
 #include "common/Program.hh"
+#include "manta/SVLocusScanner.hh"
+#include "svgraph/SVLocusSet.hh"
+
+#include <memory>
 
 
 /// generates candidate calls from graph edges
@@ -39,3 +45,17 @@ struct GenerateSVCandidates : public illumina::Program
     void
     runInternal(int argc, char* argv[]) const;
 };
+
+
+/// \brief Generate, score and write SV candidates for the graph edges selected by opt.edgeOpt
+///
+/// \param[in] setPtr if non-null, use this SV locus graph instead of loading the graph file given in opt
+/// \param[in] readScannerPtr if non-null, use this read scanner instead of creating one from opt, so that one
+///                           scanner and its read group stats can be shared by concurrent runGSC calls
+void
+runGSC(
+    const GSCOptions& opt,
+    const char* progName,
+    const char* progVersion,
+    std::shared_ptr<const SVLocusSet> setPtr = nullptr,
+    std::shared_ptr<const SVLocusScanner> readScannerPtr = nullptr);
@@ -25,6 +25,7 @@
 #include "SVCandidateAssemblyRefiner.hh"
 
 #include "alignment/AlignmentUtil.hh"
+#include "alignment/ContigKmerSet.hh"
 #include "blt_util/log.hh"
 #include "blt_util/seq_util.hh"
 #include "blt_util/align_path.hh"
@@ -34,7 +35,6 @@
 #include "manta/SVReferenceUtil.hh"
 
 #include <iostream>
-#include <unordered_set>
 
 //#define DEBUG_REFINER
 //#define DEBUG_CONTIG
@@ -876,6 +876,18 @@ getInsertTrim(
 
 
 
+/// \return the number of DP matrix cells used to align a query of size querySize to a reference of size refSize
+static
+uint64_t
+getAlignmentCellCount(
+    const size_t querySize,
+    const size_t refSize)
+{
+    return static_cast<uint64_t>(querySize)*refSize;
+}
+
+
+
 // search for combinations of left and right-side insertion candidates to find a good insertion pair
 static
 void
@@ -887,7 +899,8 @@ processLargeInsertion(
     const std::vector<unsigned>& largeInsertionCandidateIndex,
     const std::set<pos_t>& excludedPos,
     SVCandidateAssemblyData& assemblyData,
-    const GSCOptions& opt)
+    const GSCOptions& opt,
+    EdgeStageTracker& edgeStages)
 {
     if (largeInsertionCandidateIndex.empty()) return;
 
@@ -981,6 +994,8 @@ processLargeInsertion(
             constFakeContig.seq.begin(), constFakeContig.seq.end(),
             align1RefStr.begin() + leadingCut, align1RefStr.end() - trailingCut,
             fakeAlignment);
+        edgeStages.add(EDGE_WORK::DP_CELLS,
+                       getAlignmentCellCount(constFakeContig.seq.size(), (align1RefStr.size() - leadingCut - trailingCut)));
 
         fakeAlignment.align.beginPos += leadingCut;
 
@@ -1057,17 +1072,19 @@ processLargeInsertion(
 SVCandidateAssemblyRefiner::
 SVCandidateAssemblyRefiner(
     const GSCOptions& opt,
+    const SVLocusScanner& readScanner,
     const bam_header_info& header,
     const AllCounts& counts,
+    bam_streamer_pool& bamStreams,
     EdgeRuntimeTracker& edgeTracker) :
     _opt(opt),
     _header(header),
-    _smallSVAssembler(opt.scanOpt, opt.refineOpt.smallSVAssembleOpt, opt.alignFileOpt, opt.referenceFilename,
-                      opt.statsFilename, opt.chromDepthFilename, header, counts, opt.isRNA, edgeTracker.remoteTime),
+    _smallSVAssembler(opt.scanOpt, opt.refineOpt.smallSVAssembleOpt, opt.alignFileOpt, readScanner, bamStreams,
+                      opt.chromDepthFilename, header, counts, edgeTracker.stages),
     _spanningAssembler(opt.scanOpt,
                        (opt.isRNA ? opt.refineOpt.RNAspanningAssembleOpt : opt.refineOpt.spanningAssembleOpt),
-                       opt.alignFileOpt, opt.referenceFilename,
-                       opt.statsFilename, opt.chromDepthFilename, header, counts, opt.isRNA, edgeTracker.remoteTime),
+                       opt.alignFileOpt, readScanner, bamStreams,
+                       opt.chromDepthFilename, header, counts, edgeTracker.stages),
     _smallSVAligner(opt.refineOpt.smallSVAlignScores),
     _largeSVAligner(opt.refineOpt.largeSVAlignScores,opt.refineOpt.largeGapOpenScore),
     _largeInsertEdgeAligner(opt.refineOpt.largeInsertEdgeAlignScores),
@@ -1077,7 +1094,8 @@ SVCandidateAssemblyRefiner(
         opt.refineOpt.RNAspanningAlignScores,
         opt.refineOpt.RNAJumpScore,
         opt.refineOpt.RNAIntronOpenScore,
-        opt.refineOpt.RNAIntronOffEdgeScore)
+        opt.refineOpt.RNAIntronOffEdgeScore),
+    _edgeStages(edgeTracker.stages)
 {}
 
 
@@ -1211,13 +1229,9 @@ std::string kmerMaskReference(
     const int nSpacer,
     std::vector<exclusion_block>& exclBlocks)
 {
-    // Hash all kmers in the contig
+    // Index all kmers in the contig
     static const int merSize(10);
-    std::unordered_set<std::string> contigHash;
-    for (unsigned contigMerIndex(0); contigMerIndex<(contig.size() - (merSize - 1)); ++contigMerIndex)
-    {
-        contigHash.insert(contig.substr(contigMerIndex,merSize));
-    }
+    const ContigKmerSet contigKmers(contig,merSize);
     // Mask the reference (and keep track of excluded regions for coordinate translation later)
     static const int minExclusion(1000);
     static const int padding(50); // Amount of sequence included around each kmer hit.
@@ -1227,7 +1241,7 @@ std::string kmerMaskReference(
     SymIter inclStart = refSeqStart;
     for (SymIter refIt = refSeqStart; refIt != maxRef; refIt++)
     {
-        if (contigHash.count(std::string(refIt, refIt + merSize)) != 0)
+        if (contigKmers.isKmerInContig(refIt))
         {
             if ((refIt - potExclStart) > (minExclusion + padding))
             {
@@ -1610,6 +1624,7 @@ getJumpAssembly(
         _opt.referenceFilename, _header, extraRefSize, sv,
         assemblyData.bp1ref, assemblyData.bp2ref,
         bp1LeadingTrim, bp1TrailingTrim, bp2LeadingTrim, bp2TrailingTrim);
+    _edgeStages.add(EDGE_WORK::REFERENCE_FETCHES, 2);
 
     // the 'cut' values below represent sequence which will be removed
     // from the edges of the reference region for each breakend.
@@ -1727,6 +1742,8 @@ getJumpAssembly(
                                       cutRef1.begin(), cutRef1.end(), cutRef2.begin(), cutRef2.end(),
                                       bp1Fw, bp2Fw, bporient.isTranscriptStrandKnown,
                                       alignment);
+            _edgeStages.add(EDGE_WORK::DP_CELLS,
+                            getAlignmentCellCount(contig.seq.size(), (cutRef1.size() + cutRef2.size())));
 
 #ifdef DEBUG_REFINER
             log_os << __FUNCTION__ << " Masked 1: " << alignment.align1 << '\n';
@@ -1758,6 +1775,9 @@ getJumpAssembly(
                                    align1RefStrPtr->begin() + align1LeadingCut, align1RefStrPtr->end() - align1TrailingCut,
                                    align2RefStrPtr->begin() + align2LeadingCut, align2RefStrPtr->end() - align2TrailingCut,
                                    alignment);
+            const size_t alignRefSize((align1RefStrPtr->size() - align1LeadingCut - align1TrailingCut) +
+                                      (align2RefStrPtr->size() - align2LeadingCut - align2TrailingCut));
+            _edgeStages.add(EDGE_WORK::DP_CELLS, getAlignmentCellCount(contig.seq.size(), alignRefSize));
         }
 
         alignment.align1.beginPos += align1LeadingCut;
@@ -1870,6 +1890,7 @@ getSmallSVAssembly(
     unsigned leadingTrim;
     unsigned trailingTrim;
     getIntervalReferenceSegment(_opt.referenceFilename, _header, extraRefSize, sv.bp1.interval, assemblyData.bp1ref, leadingTrim, trailingTrim);
+    _edgeStages.add(EDGE_WORK::REFERENCE_FETCHES);
 
     // in most cases, these values should equal extraRefSplitSize,
     // sometimes they're forced to be shorter b/c we didn't retrieve as much reference sequence as targeted:
@@ -1952,12 +1973,7 @@ getSmallSVAssembly(
             //
             // pick low k because this is just a simple runtime optimization
             static const int merSize(10);
-            std::unordered_set<std::string> contigHash;
-            const unsigned contigSize(contig.seq.size());
-            for (unsigned contigMerIndex(0); contigMerIndex<(contigSize-(merSize-1)); ++contigMerIndex)
-            {
-                contigHash.insert(contig.seq.substr(contigMerIndex,merSize));
-            }
+            const ContigKmerSet contigKmers(contig.seq,merSize);
 
             const pos_t refSize(align1RefStr.size());
             const pos_t minRefIndex(leadingCut);
@@ -1967,14 +1983,14 @@ getSmallSVAssembly(
             pos_t refIndex=minRefIndex;
             for (refIndex=minRefIndex; refIndex<=maxFwdRefIndex; refIndex++)
             {
-                if (contigHash.count(align1RefStr.substr(refIndex,merSize)) != 0) break;
+                if (contigKmers.isKmerInContig(align1RefStr.begin()+refIndex)) break;
             }
             adjustedLeadingCut=refIndex;
 
             const pos_t minRevRefIndex(std::max(minRefIndex,refSize-maxTrailingCut));
             for (refIndex=(maxRefIndex); refIndex>=minRevRefIndex; refIndex--)
             {
-                if (contigHash.count(align1RefStr.substr(refIndex,merSize)) != 0) break;
+                if (contigKmers.isKmerInContig(align1RefStr.begin()+refIndex)) break;
             }
             adjustedTrailingCut=(refSize-(refIndex+merSize));
         }
@@ -1991,6 +2007,8 @@ getSmallSVAssembly(
                 contig.seq.begin(), contig.seq.end(),
                 align1RefStr.begin() + adjustedLeadingCut, align1RefStr.end() - adjustedTrailingCut,
                 alignment);
+            _edgeStages.add(EDGE_WORK::DP_CELLS,
+                            getAlignmentCellCount(contig.seq.size(), (align1RefStr.size() - adjustedLeadingCut - adjustedTrailingCut)));
 
             alignment.align.beginPos += adjustedLeadingCut;
             getExtendedContig(alignment, contig.seq, align1RefStr, extendedContig);
@@ -2042,6 +2060,8 @@ getSmallSVAssembly(
                 contig.seq.begin(), contig.seq.end(),
                 align1RefStr.begin() + adjustedLeadingCut, align1RefStr.end() - adjustedTrailingCut,
                 alignment);
+            _edgeStages.add(EDGE_WORK::DP_CELLS,
+                            getAlignmentCellCount(contig.seq.size(), (align1RefStr.size() - adjustedLeadingCut - adjustedTrailingCut)));
 
             alignment.align.beginPos += adjustedLeadingCut;
             getExtendedContig(alignment, contig.seq, align1RefStr, extendedContig);
@@ -2278,7 +2298,7 @@ getSmallSVAssembly(
         // contig processing loop
         if (isFindLargeInsertions)
         {
-            processLargeInsertion(sv, leadingCut, trailingCut, _largeInsertCompleteAligner, largeInsertionCandidateIndex, insPos, assemblyData, _opt);
+            processLargeInsertion(sv, leadingCut, trailingCut, _largeInsertCompleteAligner, largeInsertionCandidateIndex, insPos, assemblyData, _opt, _edgeStages);
         }
     }
 }
@@ -44,8 +44,10 @@ struct SVCandidateAssemblyRefiner
 {
     SVCandidateAssemblyRefiner(
         const GSCOptions& opt,
+        const SVLocusScanner& readScanner,
         const bam_header_info& header,
         const AllCounts& counts,
+        bam_streamer_pool& bamStreams,
         EdgeRuntimeTracker& edgeTracker);
 
     /// \brief add assembly and assembly post-processing data to SV candidate
@@ -98,4 +100,5 @@ private:
     const GlobalJumpAligner<int> _spanningAligner;
     const GlobalJumpIntronAligner<int> _RNASpanningAligner;
     mutable GenomeIntervalTracker _spanToComplexAssmRegions;
+    EdgeStageTracker& _edgeStages;
 };
@@ -40,11 +40,13 @@ SVWriter(
     const SVLocusScanner& readScanner,
     const SVLocusSet& cset,
     const char* progName,
-    const char* progVersion) :
+    const char* progVersion,
+    bam_streamer_pool& bamStreams,
+    EdgeStageTracker& edgeStages) :
     opt(initOpt),
     isSomatic(! opt.somaticOutputFilename.empty()),
     isTumorOnly(! opt.tumorOutputFilename.empty()),
-    svScore(opt, readScanner, cset.header),
+    svScore(opt, readScanner, cset.header, bamStreams, edgeStages),
     candfs(opt.candidateOutputFilename),
     dipfs(opt.diploidOutputFilename),
     somfs(opt.somaticOutputFilename),
@@ -488,14 +490,15 @@ SVCandidateProcessor(
     const char* progName,
     const char* progVersion,
     const SVLocusSet& cset,
+    bam_streamer_pool& bamStreams,
     EdgeRuntimeTracker& edgeTracker,
     GSCEdgeStatsManager& edgeStatMan) :
     _opt(opt),
     _cset(cset),
     _edgeTracker(edgeTracker),
     _edgeStatMan(edgeStatMan),
-    _svRefine(opt, cset.header, cset.getCounts(), _edgeTracker),
-    _svWriter(opt, readScanner, cset, progName, progVersion)
+    _svRefine(opt, readScanner, cset.header, cset.getCounts(), bamStreams, _edgeTracker),
+    _svWriter(opt, readScanner, cset, progName, progVersion, bamStreams, _edgeTracker.stages)
 {}
 
 
@@ -571,11 +574,26 @@ evaluateCandidate(
 
     if (! _opt.isSkipAssembly)
     {
-        const TimeScoper assmTime(_edgeTracker.assmTime);
+        const EdgeStageScoper assmStage(_edgeTracker.stages, EDGE_STAGE::ASSEMBLY);
         for (unsigned junctionIndex(0); junctionIndex<junctionCount; ++junctionIndex)
         {
             const SVCandidate& candidateSV(mjCandidateSV.junction[junctionIndex]);
             SVCandidateAssemblyData& assemblyData(mjAssemblyData[junctionIndex]);
+
+            // once the edge exceeds its budget, fall back to low-resolution output for all remaining junctions:
+            if (_edgeTracker.isBudgetFallback() || _edgeTracker.isBudgetExceeded(_opt.edgeOpt.budgetOpt))
+            {
+                if (_opt.isVerbose && (! _edgeTracker.isBudgetFallback()))
+                {
+                    log_os << __FUNCTION__ << ": Edge budget exceeded, skipping assembly for all remaining junctions in edge: " << edge << "\n";
+                }
+                _edgeTracker.setBudgetFallback();
+                assemblyData.isCandidateSpanning = isSpanningSV(candidateSV);
+                assemblyData.isEdgeBudgetSkip = true;
+                _edgeStatMan.updateAssemblyBudgetSkip(edge);
+                continue;
+            }
+
             _svRefine.getCandidateAssemblyData(candidateSV, svData, _opt.isRNA, isFindLargeInsertions, assemblyData);
 
             if (_opt.isVerbose)
@@ -656,7 +674,7 @@ evaluateCandidate(
         // if any junctions go into the small assembler (for instance b/c the breakends are too close), then
         // treat all junctions as independent:
         //
-        const TimeScoper scoreTime(_edgeTracker.scoreTime);
+        const EdgeStageScoper scoreStage(_edgeTracker.stages, EDGE_STAGE::SCORE);
         if ((junctionCount>1) && isAnySmallAssembler)
         {
             // call each junction independently by providing a filter vector in each iteration
@@ -53,7 +53,9 @@ struct SVWriter
         const SVLocusScanner& readScanner,
         const SVLocusSet& cset,
         const char* progName,
-        const char* progVersion);
+        const char* progVersion,
+        bam_streamer_pool& bamStreams,
+        EdgeStageTracker& edgeStages);
 
     void
     writeSV(
@@ -98,6 +100,7 @@ struct SVCandidateProcessor
         const char* progName,
         const char* progVersion,
         const SVLocusSet& cset,
+        bam_streamer_pool& bamStreams,
         EdgeRuntimeTracker& edgeTracker,
         GSCEdgeStatsManager& _edgeStatMan);
 
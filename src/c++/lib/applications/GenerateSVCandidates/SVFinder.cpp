@@ -29,9 +29,11 @@
 #include "htsapi/bam_streamer.hh"
 #include "manta/ReadGroupStatsSet.hh"
 #include "manta/SVCandidateUtil.hh"
+#include "manta/SVDepthMapUtil.hh"
 #include "manta/SVReferenceUtil.hh"
 #include "svgraph/EdgeInfoUtil.hh"
 
+#include <algorithm>
 #include <iostream>
 
 
@@ -77,8 +79,10 @@ SVFinder::
 SVFinder(
     const GSCOptions& opt,
     const SVLocusScanner& readScanner,
+    bam_streamer_pool& bamStreams,
     EdgeRuntimeTracker& edgeTracker,
-    GSCEdgeStatsManager& edgeStatMan) :
+    GSCEdgeStatsManager& edgeStatMan,
+    std::shared_ptr<const SVLocusSet> setPtr) :
     _scanOpt(opt.scanOpt),
     _isAlignmentTumor(opt.alignFileOpt.isAlignmentTumor),
     _readScanner(readScanner),
@@ -86,24 +90,51 @@ SVFinder(
     _isRNA(opt.isRNA),
     _isVerbose(opt.isVerbose),
     _isSomatic(false),
+    _bamStreams(bamStreams),
+    _isEvidenceIndex(! opt.evidenceIndexFilename.empty()),
+    _isDepthMapFilter(false),
     _edgeTracker(edgeTracker),
     _edgeStatMan(edgeStatMan)
 {
-    // load in set:
-    _set.load(opt.graphFilename.c_str(),true);
+    if (setPtr)
+    {
+        _setPtr = setPtr;
+    }
+    else
+    {
+        // load in set:
+        std::shared_ptr<SVLocusSet> loadedSetPtr(new SVLocusSet);
+        loadedSetPtr->load(opt.graphFilename.c_str(),true);
+        _setPtr = loadedSetPtr;
+    }
 
-    _dFilterPtr.reset(new ChromDepthFilterUtil(opt.chromDepthFilename,_scanOpt.maxDepthFactor,_set.header));
+    _dFilterPtr.reset(new ChromDepthFilterUtil(opt.chromDepthFilename,_scanOpt.maxDepthFactor,getSet().header));
 
-    // setup regionless bam_streams:
-    // setup all data for main analysis loop:
-    for (const std::string& afile : opt.alignFileOpt.alignmentFilename)
+    // The depth map is built from the tumor samples when no normal sample is given, but in this case
+    // the high depth read filter is not applied:
+    const bool isAnyNormal(std::find(_isAlignmentTumor.begin(), _isAlignmentTumor.end(), false) != _isAlignmentTumor.end());
+    if ((! opt.depthMapFilename.empty()) && isAnyNormal)
     {
-        // avoid creating shared_ptr temporaries:
-        streamPtr tmp(new bam_streamer(afile.c_str(), opt.referenceFilename.c_str()));
-        _bamStreams.push_back(tmp);
+        _depthMapPtr = loadDepthMap(opt.depthMapFilename, getSet().header);
+        _isDepthMapFilter = true;
     }
 
     const unsigned bamCount(_bamStreams.size());
+
+    if (_isEvidenceIndex)
+    {
+        _evidenceIndex.load(opt.evidenceIndexFilename.c_str());
+        if (_evidenceIndex.getSampleCount() != bamCount)
+        {
+            using namespace illumina::common;
+
+            std::ostringstream oss;
+            oss << "SV evidence read index sample count (" << _evidenceIndex.getSampleCount()
+                << ") does not match input alignment file count (" << bamCount << ")";
+            BOOST_THROW_EXCEPTION(LogicException(oss.str()));
+        }
+    }
+
     {
         // assert expected bam order of all normal samples followed by all tumor samples,
         // also, determine if this is a somatic run:
@@ -146,8 +177,10 @@ SVFinder::
 
 
 /// test if read supports an SV on this edge, if so, add to SVData
+///
+/// \return true if the read is added to SVData
 static
-void
+bool
 addSVNodeRead(
     const bam_header_info& bamHeader,
     const SVLocusScanner& scanner,
@@ -164,16 +197,16 @@ addSVNodeRead(
 {
     using namespace illumina::common;
 
-    if (scanner.isMappedReadFilteredCore(bamRead)) return;
+    if (scanner.isMappedReadFilteredCore(bamRead)) return false;
 
-    if (bamRead.map_qual() < scanner.getMinTier2MapQ()) return;
+    if (bamRead.map_qual() < scanner.getMinTier2MapQ()) return false;
 
     const bool isSubMapped(bamRead.map_qual() < scanner.getMinMapQ());
-    if ((!isGatherSubmapped) && isSubMapped) return;
+    if ((!isGatherSubmapped) && isSubMapped) return false;
 
     svDataGroup.increment(isNode1,isSubMapped);
 
-    if (! scanner.isSVEvidence(bamRead, bamIndex, refSeq)) return;
+    if (! scanner.isSVEvidence(bamRead, bamIndex, refSeq)) return false;
 
     // finally, check to see if the svDataGroup is full... for now, we allow a very large
     // number of reads to be stored in the hope that we never reach this limit, but just in
@@ -230,8 +263,9 @@ addSVNodeRead(
 
         // once any loci has achieved the local/remote overlap criteria, there's no reason to keep scanning loci
         // of the same bam record:
-        break;
+        return true;
     }
+    return false;
 }
 
 
@@ -251,9 +285,9 @@ getNodeRefSeq(
     searchInterval = (localNode.getInterval());
     searchInterval.range.merge_range(localNode.getEvidenceRange());
 
-    // grab the reference for segment we're estimating plus a buffer around the segment edges:
-    static const unsigned refEdgeBufferSize(100);
-    getIntervalReferenceSegment(referenceFilename, bamHeader, refEdgeBufferSize, searchInterval, refSeq);
+    // grab the reference for segment we're estimating plus a buffer around the segment edges,
+    // node windows are only accessed by base and substring so they can view the packed reference:
+    getIntervalReferenceSegment(referenceFilename, bamHeader, SVFinder::refEdgeBufferSize, searchInterval, refSeq, true);
 }
 
 
@@ -264,22 +298,10 @@ static
 void
 addReadToDepthEst(
     const bam_record& bamRead,
-    const pos_t beginPos,
-    std::vector<unsigned>& depth)
+    depth_diff_buffer& depth)
 {
-    const pos_t endPos(beginPos+depth.size());
     const pos_t refStart(bamRead.pos()-1);
-
-    const pos_t readSize(bamRead.read_size());
-    for (pos_t readIndex(std::max(0,(beginPos-refStart))); readIndex<readSize; ++readIndex)
-    {
-        const pos_t refPos(refStart+readIndex);
-        if (refPos>=endPos) return;
-        const pos_t depthIndex(refPos-beginPos);
-        assert(depthIndex>=0);
-
-        depth[depthIndex]++;
-    }
+    depth.inc(refStart, refStart+bamRead.read_size());
 }
 
 
@@ -294,6 +316,7 @@ addSVNodeData(
     const GenomeInterval& searchInterval,
     const reference_contig_segment& refSeq,
     const bool isNode1,
+    const bool isLastNodeScan,
     SVCandidateSetData& svData)
 {
     // get full search interval:
@@ -327,21 +350,87 @@ addSVNodeData(
     }
     const pos_t searchBeginPos(searchInterval.range.begin_pos());
     const pos_t searchEndPos(searchInterval.range.end_pos());
-    std::vector<unsigned> normalDepthBuffer(searchInterval.range.size(),0);
+    _normalDepthBuffer.reset(searchBeginPos,searchEndPos);
+
+    // With a depth map, the search interval is not scanned if all of it is over the maximum depth:
+    const bool isDepthMapFilter(isMaxDepth && _isDepthMapFilter);
+    if (isDepthMapFilter)
+    {
+        const depth_bin searchDepth(_depthMapPtr->get_range_summary(searchInterval.tid,searchBeginPos,searchEndPos));
+        if (searchDepth.min_depth > maxDepth) return;
+    }
+
+    // find the start of the last evidence read overlapping the search interval in each sample:
+    pos_t maxLastEvidencePos(-1);
+    if (_isEvidenceIndex)
+    {
+        const unsigned bamCount(_bamStreams.size());
+        _lastEvidencePos.resize(bamCount);
+        for (unsigned bamIndex(0); bamIndex<bamCount; ++bamIndex)
+        {
+            _lastEvidencePos[bamIndex] = _evidenceIndex.getLastEvidencePos(bamIndex,searchInterval);
+            maxLastEvidencePos = std::max(maxLastEvidencePos,_lastEvidencePos[bamIndex]);
+        }
+    }
+
+    // find the range of reads scanned in each sample:
+    const unsigned bamCount(_bamStreams.size());
+    _isSampleScanned.assign(bamCount,true);
+
+    // reads at or after this position are not scanned:
+    _scanEndPos.assign(bamCount,searchEndPos);
+
+    // the alignment file region queried for each sample, which ends at the sample's scan end position:
+    _scanRegions.assign(bamCount,bam_streamer::region_t(searchInterval.tid,searchBeginPos,searchEndPos));
+    if (_isEvidenceIndex)
+    {
+        for (unsigned bamIndex(0); bamIndex<bamCount; ++bamIndex)
+        {
+            // Normal sample reads contribute to the depth estimate used to filter the evidence of all
+            // subsequent samples, so these must be scanned up to the last evidence read of any sample:
+            const bool isDepthSample(isMaxDepth && (! isDepthMapFilter) && (! _isAlignmentTumor[bamIndex]));
+            const pos_t lastEvidencePos(isDepthSample ? maxLastEvidencePos : _lastEvidencePos[bamIndex]);
+            if (lastEvidencePos < 0)
+            {
+                _isSampleScanned[bamIndex] = false;
+                continue;
+            }
+
+            // Every eligible read increments the sample read index, which continues from the first node scan
+            // into the second. Gaps between these indices estimate the background read count in the breakpoint
+            // signal significance test, so cutting the first node scan short would shift the indices of all
+            // second node reads. The scan can only be cut short on the last node of the edge:
+            if (isLastNodeScan)
+            {
+                _scanEndPos[bamIndex] = std::min(searchEndPos, (lastEvidencePos+1));
+
+                // The query region must be non-empty to find reads which start before the search interval. All
+                // reads from the full search interval query which start before the scan end are also found by
+                // this query:
+                _scanRegions[bamIndex].endPos = std::max(_scanEndPos[bamIndex], (searchBeginPos+1));
+            }
+        }
+    }
+
+    // in cohort scan mode, read the scanned region from all samples concurrently before the scan below:
+    _bamStreams.bufferFileRegions(_scanRegions, _isSampleScanned);
 
     // iterate through reads, test reads for association and add to svData:
-    unsigned bamIndex(0);
-    for (streamPtr& bamPtr : _bamStreams)
+    for (unsigned bamIndex(0); bamIndex<bamCount; ++bamIndex)
     {
+        if (! _isSampleScanned[bamIndex]) continue;
+
         const bool isTumor(_isAlignmentTumor[bamIndex]);
 
         const bool isGatherSubmapped(_isSomatic && (! isTumor));
 
         SVCandidateSetSequenceFragmentSampleGroup& svDataGroup(svData.getDataGroup(bamIndex));
-        bam_streamer& readStream(*bamPtr);
+        const bam_streamer_pool::stream_ptr readStreamPtr(_bamStreams.getStream(bamIndex));
+        bam_streamer& readStream(*readStreamPtr);
 
         // set bam stream to new search interval:
-        readStream.resetRegion(searchInterval.tid,searchInterval.range.begin_pos(),searchInterval.range.end_pos());
+        const bam_streamer::region_t& scanRegion(_scanRegions[bamIndex]);
+        readStream.resetRegion(scanRegion.referenceContigId,scanRegion.beginPos,scanRegion.endPos);
 
 #ifdef DEBUG_SVDATA
         log_os << __FUNCTION__ << ": scanning bamIndex: " << bamIndex << "\n";
@@ -351,9 +440,19 @@ addSVNodeData(
             const bam_record& bamRead(*(readStream.get_record_ptr()));
 
             const pos_t refPos(bamRead.pos()-1);
-            if (refPos >= searchEndPos) break;
+            if (refPos >= _scanEndPos[bamIndex]) break;
+
+            _edgeTracker.stages.add(EDGE_WORK::READS_EXAMINED);
+            _edgeTracker.stages.add(EDGE_WORK::BAM_BYTES, bamRead.data_size());
 
-            if (isMaxDepth)
+            if (isDepthMapFilter)
+            {
+                // reads starting before the search interval are filtered on the depth of the first interval bin,
+                // so that the scan above can be skipped in exactly the cases where every read is filtered:
+                const pos_t depthPos(std::max(refPos,searchBeginPos));
+                if (_depthMapPtr->get_bin(searchInterval.tid,depthPos).max_depth > maxDepth) continue;
+            }
+            else if (isMaxDepth)
             {
                 if (! isTumor)
                 {
@@ -361,22 +460,23 @@ addSVNodeData(
                     // depth estimates:
                     if (! bamRead.is_unmapped())
                     {
-                        addReadToDepthEst(bamRead, searchBeginPos, normalDepthBuffer);
+                        addReadToDepthEst(bamRead, _normalDepthBuffer);
                     }
                 }
 
                 assert(refPos<searchEndPos);
-                const pos_t depthOffset(refPos - searchBeginPos);
-                if ((depthOffset>=0) && (normalDepthBuffer[depthOffset] > maxDepth)) continue;
+                if ((refPos>=searchBeginPos) && (_normalDepthBuffer.val(refPos) > maxDepth)) continue;
             }
 
             // test if read supports an SV on this edge, if so, add to SVData
-            addSVNodeRead(
-                bamHeader,_readScanner, localNode, remoteNode,
-                bamRead, bamIndex, isExpectRepeat, refSeq, isNode1,
-                isGatherSubmapped, svDataGroup, _eCounts);
+            const bool isRetained(addSVNodeRead(
+                                      bamHeader,_readScanner, localNode, remoteNode,
+                                      bamRead, bamIndex, isExpectRepeat, refSeq, isNode1,
+                                      isGatherSubmapped, svDataGroup, _eCounts));
+            if (isRetained) _edgeTracker.stages.add(EDGE_WORK::READS_RETAINED);
         }
-        ++bamIndex;
+
+        readStream.clearBufferedRegions();
     }
 }
 
@@ -720,6 +820,14 @@ assignFragmentObservationsToSVCandidates(
             {
 #ifdef DEBUG_SVDATA
                 log_os << __FUNCTION__ << ": Filtered short RNA Candidate (< " << minLength << ")\n";
+#endif
+                continue;
+            }
+
+            if (_readScanner.isKnownSplice(readCand))
+            {
+#ifdef DEBUG_SVDATA
+                log_os << __FUNCTION__ << ": Filtered RNA Candidate explained by annotated splice junction\n";
 #endif
                 continue;
             }
@@ -1318,16 +1426,19 @@ findCandidateSVImpl(
     {
         GenomeInterval searchInterval;
         getNodeRefSeq(bamHeader, locus, edge.nodeIndex1, _referenceFilename, searchInterval, refSeq1);
+        _edgeTracker.stages.add(EDGE_WORK::REFERENCE_FETCHES);
+        const bool isLastNodeScan(edge.nodeIndex1 == edge.nodeIndex2);
         addSVNodeData(bamHeader, locus, edge.nodeIndex1, edge.nodeIndex2,
-                      searchInterval, refSeq1, true, svData);
+                      searchInterval, refSeq1, true, isLastNodeScan, svData);
     }
 
     if (edge.nodeIndex1 != edge.nodeIndex2)
     {
         GenomeInterval searchInterval;
         getNodeRefSeq(bamHeader, locus, edge.nodeIndex2, _referenceFilename, searchInterval, refSeq2);
+        _edgeTracker.stages.add(EDGE_WORK::REFERENCE_FETCHES);
         addSVNodeData(bamHeader, locus, edge.nodeIndex2, edge.nodeIndex1,
-                      searchInterval, refSeq2, false, svData);
+                      searchInterval, refSeq2, false, true, svData);
     }
 
     const SVLocusNode& node1(locus.getNode(edge.nodeIndex1));
@@ -1348,7 +1459,7 @@ findCandidateSV(
     std::vector<SVCandidate>& svs)
 {
     // time/stats tracking setup:
-    const TimeScoper candTime(_edgeTracker.candTime);
+    const EdgeStageScoper candStage(_edgeTracker.stages, EDGE_STAGE::CANDIDATE);
     SVFinderStats stats;
 
     findCandidateSVImpl(edge,svData,svs,stats);
@@ -28,30 +28,40 @@
 #include "GSCOptions.hh"
 #include "GSCEdgeStatsManager.hh"
 #include "appstats/SVFinderStats.hh"
-#include "htsapi/bam_streamer.hh"
+#include "blt_util/depth_diff_buffer.hh"
+#include "blt_util/depth_pyramid.hh"
+#include "htsapi/bam_streamer_pool.hh"
 #include "manta/ChromDepthFilterUtil.hh"
 #include "manta/SVCandidateSetData.hh"
+#include "manta/SVEvidenceReadIndex.hh"
 #include "manta/SVLocusScanner.hh"
 #include "svgraph/EdgeInfo.hh"
 #include "svgraph/SVLocusSet.hh"
 
+#include <memory>
 #include <vector>
 
 
 struct SVFinder
 {
+    /// extra reference sequence retrieved around each node search interval
+    static const pos_t refEdgeBufferSize = 100;
+
+    /// \param[in] setPtr if non-null, use this SV locus graph instead of loading the graph file given in opt
     SVFinder(
         const GSCOptions& opt,
         const SVLocusScanner& readScanner,
+        bam_streamer_pool& bamStreams,
         EdgeRuntimeTracker& edgeTracker,
-        GSCEdgeStatsManager& edgeStatMan);
+        GSCEdgeStatsManager& edgeStatMan,
+        std::shared_ptr<const SVLocusSet> setPtr = nullptr);
 
     ~SVFinder();
 
     const SVLocusSet&
     getSet() const
     {
-        return _set;
+        return *_setPtr;
     }
 
     void
@@ -76,6 +86,7 @@ private:
         const GenomeInterval& searchInterval,
         const reference_contig_segment& refSeq,
         const bool isNode1,
+        const bool isLastNodeScan,
         SVCandidateSetData& svData);
 
     void
@@ -129,7 +140,8 @@ private:
 
     const ReadScannerOptions _scanOpt;
     const std::vector<bool> _isAlignmentTumor;
-    SVLocusSet _set;
+    /// SV locus graph, either loaded from the graph file or shared with the caller
+    std::shared_ptr<const SVLocusSet> _setPtr;
     std::unique_ptr<ChromDepthFilterUtil> _dFilterPtr;
     const SVLocusScanner& _readScanner;
 
@@ -139,12 +151,34 @@ private:
     const bool _isVerbose;
     bool _isSomatic;
 
-    typedef std::shared_ptr<bam_streamer> streamPtr;
-    std::vector<streamPtr> _bamStreams;
+    bam_streamer_pool& _bamStreams;
+
+    /// if true, use _evidenceIndex to skip alignment regions without SV evidence reads
+    const bool _isEvidenceIndex;
+    SVEvidenceReadIndex _evidenceIndex;
+
+    /// if true, look up the high depth read filter from _depthMapPtr instead of the normal sample depth buffer
+    bool _isDepthMapFilter;
+    std::unique_ptr<const depth_pyramid> _depthMapPtr;
+
+    /// this is only here as syscall cache:
+    std::vector<pos_t> _lastEvidencePos;
+
+    /// this is only here as syscall cache:
+    std::vector<bool> _isSampleScanned;
+
+    /// this is only here as syscall cache:
+    std::vector<pos_t> _scanEndPos;
+
+    /// this is only here as syscall cache:
+    std::vector<bam_streamer::region_t> _scanRegions;
 
     /// this is only here as syscall cache:
     std::vector<SVObservation> _readCandidates;
 
+    /// this is only here as syscall cache:
+    depth_diff_buffer _normalDepthBuffer;
+
     /// throwaway stats tracker...
     SampleEvidenceCounts _eCounts;
 
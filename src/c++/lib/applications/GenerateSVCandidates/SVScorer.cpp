@@ -24,6 +24,7 @@
 #include "SVScorer.hh"
 #include "SVScorePairAltProcessor.hh"
 
+#include "blt_util/depth_buffer_util.hh"
 #include "blt_util/LinearScaler.hh"
 #include "blt_util/log.hh"
 #include "blt_util/math_util.hh"
@@ -32,11 +33,13 @@
 #include "common/Exceptions.hh"
 #include "htsapi/align_path_bam_util.hh"
 #include "htsapi/bam_header_util.hh"
-#include "htsapi/bam_streamer.hh"
+#include "htsapi/bam_streamer_pool.hh"
 #include "manta/ReadGroupStatsSet.hh"
 #include "manta/SVCandidateUtil.hh"
+#include "manta/SVDepthMapUtil.hh"
 
 #include <algorithm>
+#include <cmath>
 #include <iostream>
 #include <string>
 
@@ -54,7 +57,9 @@ SVScorer::
 SVScorer(
     const GSCOptions& opt,
     const SVLocusScanner& readScanner,
-    const bam_header_info& header) :
+    const bam_header_info& header,
+    bam_streamer_pool& bamStreams,
+    EdgeStageTracker& edgeStages) :
     _isAlignmentTumor(opt.alignFileOpt.isAlignmentTumor),
     _isRNA(opt.isRNA),
     _callOpt(opt.callOpt),
@@ -69,17 +74,10 @@ SVScorer(
     _dFilterDiploid(opt.chromDepthFilename, _diploidOpt.maxDepthFactor, header),
     _dFilterSomatic(opt.chromDepthFilename, _somaticOpt.maxDepthFactor, header),
     _dFilterTumor(opt.chromDepthFilename, _tumorOpt.maxDepthFactor, header),
-    _readScanner(readScanner)
+    _readScanner(readScanner),
+    _edgeStages(edgeStages),
+    _bamStreams(bamStreams)
 {
-    // setup regionless bam_streams:
-    // setup all data for main analysis loop:
-    for (const std::string& afile : opt.alignFileOpt.alignmentFilename)
-    {
-        // avoid creating shared_ptr temporaries:
-        streamPtr tmp(new bam_streamer(afile.c_str(), opt.referenceFilename.c_str()));
-        _bamStreams.push_back(tmp);
-    }
-
     _sampleCount=0;
     _diploidSampleCount=0;
     for (const bool isTumor : opt.alignFileOpt.isAlignmentTumor)
@@ -92,7 +90,7 @@ SVScorer(
     const unsigned bamCount(_bamStreams.size());
     for (unsigned bamIndex(0); bamIndex<bamCount; ++bamIndex)
     {
-        const bam_hdr_t& indexHeader(_bamStreams[bamIndex]->get_header());
+        const bam_hdr_t& indexHeader(_bamStreams.getHeader(bamIndex));
         std::ostringstream defaultName;
         defaultName << "SAMPLE" << (bamIndex+1);
         std::string sampleName(get_bam_header_sample_name(indexHeader, defaultName.str().c_str()));
@@ -100,47 +98,27 @@ SVScorer(
         std::replace(sampleName.begin(), sampleName.end(), ' ', '_');
         _sampleNames.push_back(sampleName);
     }
+
+    if (! opt.depthMapFilename.empty())
+    {
+        _depthMapPtr = loadDepthMap(opt.depthMapFilename, header);
+    }
 }
 
 
 
-/// add bam alignment to simple short-range vector depth estimate
-///
-/// \param[in] beginPos this is the begin position of the range covered by the depth array
-///
+/// add bam alignment to simple short-range depth estimate
 static
 void
 addReadToDepthEst(
     const bam_record& bamRead,
-    const pos_t beginPos,
-    std::vector<unsigned>& depth)
+    depth_diff_buffer& depth)
 {
-    using namespace ALIGNPATH;
-
-    const pos_t endPos(beginPos+depth.size());
-
     // get cigar:
-    path_t apath;
+    ALIGNPATH::path_t apath;
     bam_cigar_to_apath(bamRead.raw_cigar(), bamRead.n_cigar(), apath);
 
-    pos_t refPos(bamRead.pos()-1);
-    for (const path_segment& ps : apath)
-    {
-        if (refPos>=endPos) return;
-
-        if (is_segment_align_match(ps.type))
-        {
-            for (pos_t pos(refPos); pos < (refPos+static_cast<pos_t>(ps.length)); ++pos)
-            {
-                if (pos>=beginPos)
-                {
-                    if (pos>=endPos) return;
-                    depth[pos-beginPos]++;
-                }
-            }
-        }
-        if (is_segment_type_ref_length(ps.type)) refPos += ps.length;
-    }
+    add_alignment_to_depth_buffer(bamRead.pos()-1, apath, depth);
 }
 
 
@@ -170,7 +148,20 @@ getBreakendMaxMappedDepthAndMQ0(
 
     if (searchRange.size() == 0) return;
 
-    std::vector<unsigned> depth(searchRange.size(),0);
+    // the depth map is built from the same samples as the alignment scan below:
+    if (_depthMapPtr)
+    {
+        const depth_bin regionDepth(_depthMapPtr->get_range_summary(bp.interval.tid, searchRange.begin_pos(), searchRange.end_pos()));
+        maxDepth = static_cast<unsigned>(std::lround(regionDepth.max_depth));
+        if (regionDepth.read_count>=10)
+        {
+            MQ0Frac = static_cast<float>(regionDepth.mq0_read_count)/static_cast<float>(regionDepth.read_count);
+        }
+        return;
+    }
+
+    depth_diff_buffer& depth(_depthBuffer);
+    depth.reset(searchRange.begin_pos(), searchRange.end_pos());
 
     bool isCutoff(false);
     bool isBamFound(false);
@@ -181,7 +172,8 @@ getBreakendMaxMappedDepthAndMQ0(
         if ((!isTumorOnly) && (_isAlignmentTumor[bamIndex])) continue;
         isBamFound=true;
 
-        bam_streamer& bamStream(*_bamStreams[bamIndex]);
+        const bam_streamer_pool::stream_ptr bamStreamPtr(_bamStreams.getStream(bamIndex));
+        bam_streamer& bamStream(*bamStreamPtr);
 
         // set bam stream to new search interval:
         bamStream.resetRegion(bp.interval.tid, searchRange.begin_pos(), searchRange.end_pos());
@@ -190,23 +182,25 @@ getBreakendMaxMappedDepthAndMQ0(
         {
             const bam_record& bamRead(*(bamStream.get_record_ptr()));
 
+            _edgeStages.add(EDGE_WORK::READS_EXAMINED);
+            _edgeStages.add(EDGE_WORK::BAM_BYTES, bamRead.data_size());
+
             // turn filtration down to mapped only to match depth estimate method:
             if (bamRead.is_unmapped()) continue;
 
             const pos_t refPos(bamRead.pos()-1);
             if (refPos >= searchRange.end_pos()) break;
 
-            addReadToDepthEst(bamRead,searchRange.begin_pos(),depth);
+            addReadToDepthEst(bamRead,depth);
 
             totalReads++;
             if (0 == bamRead.map_qual()) totalMQ0Reads++;
 
             if (isMaxDepth)
             {
-                const pos_t depthOffset(refPos-searchRange.begin_pos());
-                if (depthOffset>=0)
+                if (refPos>=searchRange.begin_pos())
                 {
-                    if (depth[depthOffset] > cutoffDepth)
+                    if (depth.val(refPos) > cutoffDepth)
                     {
                         isCutoff=true;
                         break;
@@ -220,7 +214,7 @@ getBreakendMaxMappedDepthAndMQ0(
 
     assert(isBamFound);
 
-    maxDepth = *(std::max_element(depth.begin(),depth.end()));
+    maxDepth = depth.max_val(searchRange.end_pos());
     if (totalReads>=10)
     {
         MQ0Frac = static_cast<float>(totalMQ0Reads)/static_cast<float>(totalReads);
@@ -29,9 +29,12 @@
 #include "SVEvidence.hh"
 #include "SVScorePairProcessor.hh"
 
+#include "appstats/EdgeStageTracker.hh"
 #include "assembly/AssembledContig.hh"
+#include "blt_util/depth_diff_buffer.hh"
+#include "blt_util/depth_pyramid.hh"
 #include "blt_util/qscore_snp.hh"
-#include "htsapi/bam_streamer.hh"
+#include "htsapi/bam_streamer_pool.hh"
 #include "htsapi/bam_header_info.hh"
 #include "manta/ChromDepthFilterUtil.hh"
 #include "manta/SVCandidateAssemblyData.hh"
@@ -41,6 +44,7 @@
 #include "manta/SVMultiJunctionCandidate.hh"
 #include "manta/SVScoreInfoSomatic.hh"
 
+#include <memory>
 #include <vector>
 #include <string>
 
@@ -150,7 +154,9 @@ struct SVScorer
     SVScorer(
         const GSCOptions& opt,
         const SVLocusScanner& readScanner,
-        const bam_header_info& header);
+        const bam_header_info& header,
+        bam_streamer_pool& bamStreams,
+        EdgeStageTracker& edgeStages);
 
     /// gather supporting evidence and generate:
     /// 1) diploid quality score and genotype for SV candidate
@@ -174,7 +180,6 @@ struct SVScorer
         SupportSamples& svSupports);
 
     typedef std::shared_ptr<SVScorePairProcessor> pairProcPtr;
-    typedef std::shared_ptr<bam_streamer> streamPtr;
 
     unsigned
     sampleCount() const
@@ -244,6 +249,8 @@ private:
         SupportSamples& svSupports);
 
     /// determine maximum depth and MQ0 frac in region around breakend of normal sample
+    ///
+    /// if a depth map is available, these are found from the depth map bins intersecting the region
     void
     getBreakendMaxMappedDepthAndMQ0(
         const bool isTumorOnly,
@@ -295,10 +302,17 @@ private:
     const ChromDepthFilterUtil _dFilterSomatic;
     const ChromDepthFilterUtil _dFilterTumor;
     const SVLocusScanner& _readScanner;
+    EdgeStageTracker& _edgeStages;
 
-    std::vector<streamPtr> _bamStreams;
+    bam_streamer_pool& _bamStreams;
 
     unsigned _sampleCount;
     unsigned _diploidSampleCount;
     std::vector<std::string> _sampleNames;
+
+    /// optional depth map, used in place of alignment scans to find breakend depth
+    std::unique_ptr<const depth_pyramid> _depthMapPtr;
+
+    /// this is only here as syscall cache:
+    depth_diff_buffer _depthBuffer;
 };
@@ -27,7 +27,7 @@
 
 #include "common/Exceptions.hh"
 #include "htsapi/align_path_bam_util.hh"
-#include "htsapi/bam_streamer.hh"
+#include "htsapi/bam_streamer_pool.hh"
 #include "htsapi/bam_record_util.hh"
 #include "manta/SVCandidateUtil.hh"
 #include "svgraph/GenomeIntervalUtil.hh"
@@ -53,12 +53,13 @@
 static
 void
 processBamProcList(
-    const std::vector<SVScorer::streamPtr>& bamList,
+    bam_streamer_pool& bamStreams,
     const SVId& svId,
     std::vector<SVScorer::pairProcPtr>& pairProcList,
-    SupportSamples& svSupports)
+    SupportSamples& svSupports,
+    EdgeStageTracker& edgeStages)
 {
-    const unsigned bamCount(bamList.size());
+    const unsigned bamCount(bamStreams.size());
     const unsigned bamProcCount(pairProcList.size());
 
     for (unsigned bamIndex(0); bamIndex < bamCount; ++bamIndex)
@@ -78,7 +79,8 @@ processBamProcList(
             intervalMap = intervalCompressor(scanIntervals);
         }
 
-        bam_streamer& bamStream(*bamList[bamIndex]);
+        const bam_streamer_pool::stream_ptr bamStreamPtr(bamStreams.getStream(bamIndex));
+        bam_streamer& bamStream(*bamStreamPtr);
         SupportFragments& svSupportFrags(svSupports.getSupportFragments(bamIndex));
 
         const unsigned intervalCount(scanIntervals.size());
@@ -104,16 +106,22 @@ processBamProcList(
             {
                 const bam_record& bamRead(*(bamStream.get_record_ptr()));
 
+                edgeStages.add(EDGE_WORK::READS_EXAMINED);
+                edgeStages.add(EDGE_WORK::BAM_BYTES, bamRead.data_size());
+
                 /// this filter is common to all targetProcs:
                 if (SVScorer::pairProcPtr::element_type::isSkipRecordCore(bamRead)) continue;
 
+                bool isRetained(false);
                 for (const unsigned procIndex : targetProcs)
                 {
                     SVScorer::pairProcPtr& bpp(pairProcList[procIndex]);
 
                     if (bpp->isSkipRecord(bamRead)) continue;
                     bpp->processClearedRecord(svId, bamRead, svSupportFrags);
+                    isRetained = true;
                 }
+                if (isRetained) edgeStages.add(EDGE_WORK::READS_RETAINED);
             }
         }
     }
@@ -666,5 +674,5 @@ getSVPairSupport(
 
     // execute bam scanning for all pairs:
     //
-    processBamProcList(_bamStreams, svId, pairProcList, svSupports);
+    processBamProcList(_bamStreams, svId, pairProcList, svSupports, _edgeStages);
 }
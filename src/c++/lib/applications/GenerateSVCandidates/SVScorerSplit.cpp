@@ -211,6 +211,19 @@ getReadSplitScore(
 
 
 
+/// \return The alignment file region searched for split reads supporting breakend bp
+static
+bam_streamer::region_t
+getSplitReadSearchRegion(const SVBreakend& bp)
+{
+    static const int extendedSearchRange(200); // Window to look for alignments that may (if unclipped) overlap the breakpoint
+    return bam_streamer::region_t(bp.interval.tid,
+                                  std::max(0, bp.interval.range.begin_pos() - extendedSearchRange),
+                                  bp.interval.range.end_pos() + extendedSearchRange);
+}
+
+
+
 static
 void
 scoreSplitReads(
@@ -229,19 +242,21 @@ scoreSplitReads(
     SVEvidence::evidenceTrack_t& sampleEvidence,
     bam_streamer& readStream,
     SVSampleInfo& sample,
-    SupportFragments& svSupportFrags)
+    SupportFragments& svSupportFrags,
+    EdgeStageTracker& edgeStages)
 {
-    static const int extendedSearchRange(200); // Window to look for alignments that may (if unclipped) overlap the breakpoint
     // extract reads overlapping the break point
     // We are not looking for remote reads, (semialigned-) reads mapping near this breakpoint, but not across it
     // or any other kind of additional reads used for assembly.
-    readStream.resetRegion(bp.interval.tid,
-                           std::max(0, bp.interval.range.begin_pos() - extendedSearchRange),
-                           bp.interval.range.end_pos() + extendedSearchRange);
+    const bam_streamer::region_t searchRegion(getSplitReadSearchRegion(bp));
+    readStream.resetRegion(searchRegion.referenceContigId, searchRegion.beginPos, searchRegion.endPos);
     while (readStream.next())
     {
         const bam_record& bamRead(*(readStream.get_record_ptr()));
 
+        edgeStages.add(EDGE_WORK::READS_EXAMINED);
+        edgeStages.add(EDGE_WORK::BAM_BYTES, bamRead.data_size());
+
         if (SVLocusScanner::isReadFilteredCore(bamRead)) continue;
         if (bamRead.is_unmapped()) continue;
 
@@ -256,6 +271,8 @@ scoreSplitReads(
         static const bool isShadow(false);
         static const bool isReversedShadow(false);
 
+        edgeStages.add(EDGE_WORK::READS_RETAINED);
+
         try
         {
             getReadSplitScore(bamRead, dopt, svId, bp, bpRef, isBP1,
@@ -307,9 +324,14 @@ scoreSplitReads(
         {
             const bam_record& bamRead(*(readStream.get_record_ptr()));
 
+            edgeStages.add(EDGE_WORK::READS_EXAMINED);
+            edgeStages.add(EDGE_WORK::BAM_BYTES, bamRead.data_size());
+
             if (SVLocusScanner::isReadFilteredCore(bamRead)) continue;
             if (! shadow.check(bamRead)) continue;
 
+            edgeStages.add(EDGE_WORK::READS_RETAINED);
+
             static const bool isShadow(true);
             const bool isReversedShadow(bamRead.is_mate_fwd_strand());
 
@@ -395,11 +417,15 @@ getSVSplitReadSupport(
     const unsigned minMapQ(_readScanner.getMinMapQ());
     const unsigned minTier2MapQ(_readScanner.getMinTier2MapQ());
 
+    // in cohort scan mode, read both breakend regions from all samples concurrently before the scan below:
+    _bamStreams.bufferRegions({getSplitReadSearchRegion(sv.bp1), getSplitReadSearchRegion(sv.bp2)});
+
     const unsigned bamCount(_bamStreams.size());
     for (unsigned bamIndex(0); bamIndex < bamCount; ++bamIndex)
     {
         SVSampleInfo& sample(baseInfo.samples[bamIndex]);
-        bam_streamer& bamStream(*_bamStreams[bamIndex]);
+        const bam_streamer_pool::stream_ptr bamStreamPtr(_bamStreams.getStream(bamIndex));
+        bam_streamer& bamStream(*bamStreamPtr);
 
         SVEvidence::evidenceTrack_t& sampleEvidence(evidence.getSampleEvidence(bamIndex));
         SupportFragments& svSupportFrags(svSupports.getSupportFragments(bamIndex));
@@ -413,7 +439,7 @@ getSVSplitReadSupport(
         scoreSplitReads(_callDopt, flankScoreSize, svId, sv.bp1,
                         SVAlignInfo, assemblyData.bp1ref, true, minMapQ, minTier2MapQ,
                         bamShadowSearchDistance, _scanOpt.minSingletonMapqCandidates, _isRNA,
-                        sampleEvidence, bamStream, sample, svSupportFrags);
+                        sampleEvidence, bamStream, sample, svSupportFrags, _edgeStages);
         // scoring split reads overlapping bp2
 #ifdef DEBUG_SVS
         log_os << __FUNCTION__ << " scoring BP2\n";
@@ -421,9 +447,11 @@ getSVSplitReadSupport(
         scoreSplitReads(_callDopt, flankScoreSize, svId, sv.bp2,
                         SVAlignInfo, assemblyData.bp2ref, false, minMapQ, minTier2MapQ,
                         bamShadowSearchDistance, _scanOpt.minSingletonMapqCandidates, _isRNA,
-                        sampleEvidence, bamStream, sample, svSupportFrags);
+                        sampleEvidence, bamStream, sample, svSupportFrags, _edgeStages);
 
         finishSampleSRData(sample);
+
+        bamStream.clearBufferedRegions();
     }
 
 #ifdef DEBUG_SVS
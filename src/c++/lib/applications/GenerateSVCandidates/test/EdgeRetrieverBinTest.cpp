@@ -24,6 +24,7 @@
 
 #include "svgraph/test/SVLocusTestUtil.hh"
 
+#include <algorithm>
 #include <iostream>
 
 
@@ -341,4 +342,54 @@ BOOST_AUTO_TEST_CASE( test_EdgeRetrieverFilteredFinalEdge )
 }
 
 
+
+BOOST_AUTO_TEST_CASE( test_EdgeRetrieverLocalityOrder )
+{
+    // merge loci out of genomic order:
+    SVLocus locus1;
+    locusAddPair(locus1,5,10,20,6,30,40);
+    SVLocus locus2;
+    locusAddPair(locus2,1,10,20,2,30,40);
+    SVLocus locus3;
+    locusAddPair(locus3,7,10,20,8,30,40);
+    SVLocus locus4;
+    locusAddPair(locus4,3,10,20,4,30,40);
+
+    SVLocusSetOptions sopt;
+    sopt.minMergeEdgeObservations = 1;
+    SVLocusSet set1(sopt);
+    set1.merge(locus1);
+    set1.merge(locus2);
+    set1.merge(locus3);
+    set1.merge(locus4);
+    set1.checkState(true,true);
+
+    auto getLocusOrder = [&](const unsigned binCount, const unsigned binIndex, const bool isLocalityOrder)
+    {
+        EdgeRetrieverBin edger(set1, 0, binCount, binIndex, isLocalityOrder);
+        std::vector<unsigned> locusOrder;
+        while (edger.next())
+        {
+            locusOrder.push_back(edger.getEdge().locusIndex);
+        }
+        return locusOrder;
+    };
+
+    // edges follow the genomic order of their nodes:
+    const std::vector<unsigned> expectedOrder = {1, 3, 0, 2};
+    BOOST_REQUIRE(getLocusOrder(1, 0, true) == expectedOrder);
+
+    // the edges in each bin are unchanged:
+    static const unsigned binCount(3);
+    for (unsigned binIndex(0); binIndex<binCount; ++binIndex)
+    {
+        std::vector<unsigned> storageOrder(getLocusOrder(binCount, binIndex, false));
+        std::vector<unsigned> localityOrder(getLocusOrder(binCount, binIndex, true));
+        std::sort(storageOrder.begin(), storageOrder.end());
+        std::sort(localityOrder.begin(), localityOrder.end());
+        BOOST_REQUIRE(storageOrder == localityOrder);
+    }
+}
+
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,132 @@
+//
+// Manta - Structural Variant and Indel Caller
+// Copyright (c) 2013-2017 Illumina, Inc.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+//
+
+#include "boost/test/unit_test.hpp"
+
+#include "applications/GenerateSVCandidates/EdgeRuntimeTracker.hh"
+
+#include <chrono>
+#include <thread>
+
+
+BOOST_AUTO_TEST_SUITE( test_EdgeRuntimeTracker )
+
+
+/// add count to work type, and test the budget on each side of a limit of 2
+static
+void
+testWorkBudget(
+    const EDGE_WORK::index_t workIndex,
+    const EdgeBudgetOptions& budget)
+{
+    BOOST_REQUIRE(budget.isEnabled());
+
+    EdgeRuntimeTracker edgeTracker("");
+    edgeTracker.start();
+    BOOST_REQUIRE(! edgeTracker.isBudgetExceeded(budget));
+
+    edgeTracker.stages.add(workIndex, 2);
+    BOOST_REQUIRE(! edgeTracker.isBudgetExceeded(budget));
+
+    edgeTracker.stages.add(workIndex);
+    BOOST_REQUIRE(edgeTracker.isBudgetExceeded(budget));
+
+    // work counts are reset for each edge:
+    edgeTracker.start();
+    BOOST_REQUIRE(! edgeTracker.isBudgetExceeded(budget));
+}
+
+
+BOOST_AUTO_TEST_CASE( test_EdgeBudgetReadsRetained )
+{
+    EdgeBudgetOptions budget;
+    budget.maxReadsRetained = 2;
+    testWorkBudget(EDGE_WORK::READS_RETAINED, budget);
+}
+
+
+BOOST_AUTO_TEST_CASE( test_EdgeBudgetAssemblyWordLengths )
+{
+    EdgeBudgetOptions budget;
+    budget.maxAssemblyWordLengths = 2;
+    testWorkBudget(EDGE_WORK::ASSEMBLY_ITERATIONS, budget);
+}
+
+
+BOOST_AUTO_TEST_CASE( test_EdgeBudgetDPCells )
+{
+    EdgeBudgetOptions budget;
+    budget.maxDPCells = 2;
+    testWorkBudget(EDGE_WORK::DP_CELLS, budget);
+}
+
+
+BOOST_AUTO_TEST_CASE( test_EdgeBudgetOtherWork )
+{
+    // work types without a limit don't count against the budget:
+    EdgeBudgetOptions budget;
+    budget.maxReadsRetained = 2;
+
+    EdgeRuntimeTracker edgeTracker("");
+    edgeTracker.start();
+    edgeTracker.stages.add(EDGE_WORK::DP_CELLS, 100);
+    edgeTracker.stages.add(EDGE_WORK::ASSEMBLY_ITERATIONS, 100);
+    BOOST_REQUIRE(! edgeTracker.isBudgetExceeded(budget));
+
+    // with all limits disabled, the budget is never exceeded:
+    const EdgeBudgetOptions noBudget;
+    BOOST_REQUIRE(! noBudget.isEnabled());
+    edgeTracker.stages.add(EDGE_WORK::READS_RETAINED, 100);
+    BOOST_REQUIRE(! edgeTracker.isBudgetExceeded(noBudget));
+}
+
+
+BOOST_AUTO_TEST_CASE( test_EdgeBudgetSeconds )
+{
+    EdgeBudgetOptions shortBudget;
+    shortBudget.maxWallSeconds = 0.001;
+    EdgeBudgetOptions longBudget;
+    longBudget.maxWallSeconds = 1000.;
+
+    EdgeRuntimeTracker edgeTracker("");
+    edgeTracker.start();
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+
+    // the budget is tested against the running edge time:
+    BOOST_REQUIRE(edgeTracker.isBudgetExceeded(shortBudget));
+    BOOST_REQUIRE(! edgeTracker.isBudgetExceeded(longBudget));
+}
+
+
+BOOST_AUTO_TEST_CASE( test_EdgeBudgetFallback )
+{
+    EdgeRuntimeTracker edgeTracker("");
+    edgeTracker.start();
+    BOOST_REQUIRE(! edgeTracker.isBudgetFallback());
+
+    edgeTracker.setBudgetFallback();
+    BOOST_REQUIRE(edgeTracker.isBudgetFallback());
+
+    // the fallback applies to one edge only:
+    edgeTracker.start();
+    BOOST_REQUIRE(! edgeTracker.isBudgetFallback());
+}
+
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -77,6 +77,9 @@ parseAlignmentStatsOptions(
      "write stats to filename (default: stdout)")
     ("ref", po::value(&opt.referenceFilename),
      "fasta reference sequence (required)")
+    ("cache-dir", po::value(&opt.cacheDirname),
+     "reuse statistics cached in this directory from earlier runs on the same alignment files, and add new "
+     "results to the cache (optional)")
     ;
 
     po::options_description help("help");
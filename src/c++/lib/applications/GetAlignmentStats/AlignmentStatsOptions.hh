@@ -30,6 +30,9 @@ struct AlignmentStatsOptions
 
     std::string referenceFilename;
     std::string outputFilename;
+
+    /// if non-empty, use the persistent run cache in this directory
+    std::string cacheDirname;
 };
 
 
@@ -23,7 +23,7 @@
 
 #include "blt_util/log.hh"
 #include "common/OutStream.hh"
-#include "manta/ReadGroupStatsUtil.hh"
+#include "manta/AlignmentRunCache.hh"
 
 #include <cstdlib>
 
@@ -44,10 +44,12 @@ runAlignmentStats(const AlignmentStatsOptions& opt)
         exit(EXIT_FAILURE);
     }
 
+    const AlignmentRunCache runCache(opt.cacheDirname);
+
     ReadGroupStatsSet rstats;
     for (const std::string& alignmentFilename : opt.alignFileOpt.alignmentFilename)
     {
-        extractReadGroupStatsFromAlignmentFile(opt.referenceFilename, alignmentFilename, rstats);
+        runCache.getReadGroupStats(opt.referenceFilename, alignmentFilename, rstats);
     }
 
     rstats.save(opt.outputFilename.c_str());
@@ -101,6 +101,9 @@ parseChromDepthOptions(
      "write stats to filename (default: stdout)")
     ("ref", po::value(&opt.referenceFilename),
      "fasta reference sequence (required)")
+    ("cache-dir", po::value(&opt.cacheDirname),
+     "reuse chromosome depth cached in this directory from earlier runs on the same alignment file, and add new "
+     "results to the cache (optional)")
     ;
 
     po::options_description help("help");
@@ -33,6 +33,9 @@ struct ChromDepthOptions
 
     std::string referenceFilename;
     std::string outputFilename;
+
+    /// if non-empty, use the persistent run cache in this directory
+    std::string cacheDirname;
 };
 
 
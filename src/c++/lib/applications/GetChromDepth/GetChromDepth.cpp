@@ -23,6 +23,7 @@
 
 #include "blt_util/log.hh"
 #include "common/OutStream.hh"
+#include "manta/AlignmentRunCache.hh"
 
 #include <cstdlib>
 
@@ -40,10 +41,15 @@ getChromDepth(const ChromDepthOptions& opt)
         OutStream outs(opt.outputFilename);
     }
 
+    const AlignmentRunCache runCache(opt.cacheDirname);
+
     std::vector<double> chromDepth;
     for (const std::string& chromName : opt.chromNames)
     {
-        chromDepth.push_back(readChromDepthFromAlignment(opt.referenceFilename, opt.alignmentFilename, chromName));
+        chromDepth.push_back(runCache.getChromDepth(opt.referenceFilename, opt.alignmentFilename, chromName, [&]()
+        {
+            return readChromDepthFromAlignment(opt.referenceFilename, opt.alignmentFilename, chromName);
+        }));
     }
 
     OutStream outs(opt.outputFilename);
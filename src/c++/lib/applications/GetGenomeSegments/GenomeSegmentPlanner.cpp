@@ -0,0 +1,157 @@
+//
+// Manta - Structural Variant and Indel Caller
+// Copyright (c) 2013-2017 Illumina, Inc.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+//
+
+/// \file
+/// \author Chris Saunders
+///
+
+#include "GenomeSegmentPlanner.hh"
+
+#include <cassert>
+#include <cmath>
+
+#include <algorithm>
+#include <numeric>
+
+
+
+static
+double
+getRegionWork(const GenomeSegmentPlanRegion& region)
+{
+    return std::accumulate(region.windowWork.begin(),region.windowWork.end(),0.);
+}
+
+
+
+/// \brief Move a segment boundary to the center of the nearest sufficiently large N-gap, if one is close enough
+static
+pos_t
+moveBoundaryToGap(
+    const GenomeSegmentPlanOptions& opt,
+    const std::vector<known_pos_range2>& gaps,
+    const pos_t boundaryPos)
+{
+    pos_t bestPos(boundaryPos);
+    pos_t bestDistance(opt.maxBoundaryGapDistance+1);
+    for (const known_pos_range2& gap : gaps)
+    {
+        if (static_cast<pos_t>(gap.size()) < opt.minBoundaryGapSize) continue;
+        const pos_t gapCenterPos(gap.center_pos());
+        const pos_t distance(std::abs(gapCenterPos-boundaryPos));
+        if (distance < bestDistance)
+        {
+            bestPos = gapCenterPos;
+            bestDistance = distance;
+        }
+    }
+    return bestPos;
+}
+
+
+
+/// \brief Divide a single region into segmentCount segments of approximately equal work
+static
+void
+planRegionSegments(
+    const GenomeSegmentPlanOptions& opt,
+    const GenomeSegmentPlanRegion& region,
+    const unsigned segmentCount,
+    std::vector<known_pos_range2>& segments)
+{
+    const known_pos_range2& range(region.interval.range);
+    const double regionWork(getRegionWork(region));
+
+    segments.clear();
+    pos_t segmentBeginPos(range.begin_pos());
+
+    unsigned windowIndex(0);
+    double cumulativeWork(0);
+    for (unsigned segmentIndex(1); segmentIndex<segmentCount; ++segmentIndex)
+    {
+        const double targetWork(regionWork*segmentIndex/segmentCount);
+
+        // find the window where cumulative work crosses the target, and interpolate the boundary within it:
+        while ((windowIndex < region.windowWork.size()) &&
+               ((cumulativeWork+region.windowWork[windowIndex]) < targetWork))
+        {
+            cumulativeWork += region.windowWork[windowIndex];
+            windowIndex++;
+        }
+        if (windowIndex >= region.windowWork.size()) break;
+
+        const double windowWork(region.windowWork[windowIndex]);
+        const double windowFraction((windowWork > 0) ? ((targetWork-cumulativeWork)/windowWork) : 0.);
+        pos_t boundaryPos(range.begin_pos() + static_cast<pos_t>(windowIndex)*opt.windowSize +
+                          static_cast<pos_t>(std::round(windowFraction*opt.windowSize)));
+        boundaryPos = moveBoundaryToGap(opt, region.gaps, boundaryPos);
+
+        // skip any boundary which would create a segment below the minimum size:
+        if ((boundaryPos-segmentBeginPos) < opt.minSegmentSize) continue;
+        if ((range.end_pos()-boundaryPos) < opt.minSegmentSize) break;
+
+        segments.emplace_back(segmentBeginPos,boundaryPos);
+        segmentBeginPos = boundaryPos;
+    }
+    segments.emplace_back(segmentBeginPos,range.end_pos());
+}
+
+
+
+void
+planGenomeSegments(
+    const GenomeSegmentPlanOptions& opt,
+    const std::vector<GenomeSegmentPlanRegion>& regions,
+    std::vector<std::vector<known_pos_range2>>& segments)
+{
+    assert(opt.windowSize > 0);
+    assert(opt.targetSegmentSize > 0);
+
+    // the total segment count matches that of fixed-size segmentation:
+    unsigned totalSegmentCount(0);
+    double totalWork(0);
+    for (const GenomeSegmentPlanRegion& region : regions)
+    {
+        const pos_t regionSize(region.interval.range.size());
+        totalSegmentCount += std::max(1,static_cast<int>(1+((regionSize-1)/opt.targetSegmentSize)));
+        totalWork += getRegionWork(region);
+    }
+
+    segments.clear();
+    segments.resize(regions.size());
+
+    const double workPerSegment((totalSegmentCount > 0) ? (totalWork/totalSegmentCount) : 0.);
+
+    const unsigned regionCount(regions.size());
+    for (unsigned regionIndex(0); regionIndex<regionCount; ++regionIndex)
+    {
+        const GenomeSegmentPlanRegion& region(regions[regionIndex]);
+        const pos_t regionSize(region.interval.range.size());
+
+        unsigned segmentCount(1);
+        if (workPerSegment > 0)
+        {
+            segmentCount = std::max(1l,std::lround(getRegionWork(region)/workPerSegment));
+        }
+        const unsigned maxSegmentCount(std::max(1,static_cast<int>(regionSize/opt.minSegmentSize)));
+        segmentCount = std::min(segmentCount,maxSegmentCount);
+
+        planRegionSegments(opt, region, segmentCount, segments[regionIndex]);
+    }
+}
@@ -0,0 +1,78 @@
+//
+// Manta - Structural Variant and Indel Caller
+// Copyright (c) 2013-2017 Illumina, Inc.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+//
+
+/// \file
+/// \author Chris Saunders
+///
+
+#pragma once
+
+#include "blt_util/known_pos_range2.hh"
+#include "svgraph/GenomeInterval.hh"
+
+#include <vector>
+
+
+/// \brief A genome region to be divided into segments, with an estimate of the work required to scan each
+///        fixed-size window of the region
+struct GenomeSegmentPlanRegion
+{
+    /// Zero-indexed, half-open region
+    GenomeInterval interval;
+
+    /// Estimated work for each window of the region, where window i begins at
+    /// (interval.range.begin_pos() + i*windowSize). The last window may be shorter than windowSize.
+    std::vector<double> windowWork;
+
+    /// Zero-indexed, half-open reference N-gaps within the region, in position order
+    std::vector<known_pos_range2> gaps;
+};
+
+
+struct GenomeSegmentPlanOptions
+{
+    /// Size of the windows used to estimate work
+    pos_t windowSize = 131072;
+
+    /// The total segment count is the number of segments of this size required to cover all regions
+    pos_t targetSegmentSize = 12000000;
+
+    /// Segments are not cut shorter than this, except where the region itself is shorter
+    pos_t minSegmentSize = 100000;
+
+    /// N-gaps at least this long are preferred as segment boundaries
+    pos_t minBoundaryGapSize = 10000;
+
+    /// A segment boundary can be moved up to this distance to place it in the center of an N-gap
+    pos_t maxBoundaryGapDistance = 1048576;
+};
+
+
+/// \brief Divide genome regions into segments of approximately equal estimated work
+///
+/// The number of segments is the same as if the regions were cut into segments of the target size, but segments
+/// are distributed among the regions and their boundaries are placed according to the estimated work of each
+/// window. Boundaries are moved into nearby N-gaps where possible.
+///
+/// \param[out] segments For each input region, the zero-indexed half-open segments covering the region
+void
+planGenomeSegments(
+    const GenomeSegmentPlanOptions& opt,
+    const std::vector<GenomeSegmentPlanRegion>& regions,
+    std::vector<std::vector<known_pos_range2>>& segments);
@@ -0,0 +1,154 @@
+//
+// Manta - Structural Variant and Indel Caller
+// Copyright (c) 2013-2017 Illumina, Inc.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+//
+
+/// \file
+/// \author Chris Saunders
+///
+
+#include "GenomeSegmentsOptions.hh"
+
+#include "blt_util/log.hh"
+#include "common/ProgramUtil.hh"
+#include "options/AlignmentFileOptionsParser.hh"
+#include "options/optionsUtil.hh"
+
+#include "boost/program_options.hpp"
+
+#include <iostream>
+
+typedef std::vector<std::string> regions_t;
+
+
+static
+void
+usage(
+    std::ostream& os,
+    const illumina::Program& prog,
+    const boost::program_options::options_description& visible,
+    const char* msg = nullptr)
+{
+    usage(os, prog, visible, "divide genome regions into segments with balanced alignment data", "", msg);
+}
+
+
+
+/// \brief Parse GenomeSegmentsOptions
+///
+/// \param[out] errorMsg If an error occurs this is set to an end-user targeted error message. Any string content on
+///                 input is cleared
+///
+/// \return True if an error occurs while parsing options
+static
+bool
+parseOptions(
+    const boost::program_options::variables_map& vm,
+    GenomeSegmentsOptions& opt,
+    std::string& errorMsg)
+{
+    if (parseOptions(vm, opt.alignFileOpt, errorMsg)) return true;
+    if (checkStandardizeInputFile(opt.referenceFilename, "reference fasta", errorMsg)) return true;
+    if (! opt.chromDepthFilename.empty())
+    {
+        if (checkStandardizeInputFile(opt.chromDepthFilename, "chromosome depth", errorMsg)) return true;
+    }
+
+    if (vm.count("region"))
+    {
+        opt.regions=(boost::any_cast<regions_t>(vm["region"].value()));
+    }
+
+    if (opt.regions.empty())
+    {
+        errorMsg = "Need at least one samtools formatted region";
+        return true;
+    }
+
+    for (const std::string& region : opt.regions)
+    {
+        if (! region.empty()) continue;
+        errorMsg = "At least one region is empty";
+        return true;
+    }
+
+    if (opt.planOpt.targetSegmentSize <= 0)
+    {
+        errorMsg = "target-segment-size must be positive";
+        return true;
+    }
+
+    return false;
+}
+
+
+
+void
+parseGenomeSegmentsOptions(
+    const illumina::Program& prog,
+    int argc, char* argv[],
+    GenomeSegmentsOptions& opt)
+{
+    namespace po = boost::program_options;
+    po::options_description req("configuration");
+    req.add_options()
+    ("region", po::value<regions_t>(),
+     "samtools formatted region, eg. 'chr1:20-30'. May be supplied more than once but regions must not overlap. At least one entry required.")
+    ("target-segment-size", po::value(&opt.planOpt.targetSegmentSize)->default_value(opt.planOpt.targetSegmentSize),
+     "the total segment count is the number of segments of this size required to cover all regions")
+    ("chrom-depth", po::value(&opt.chromDepthFilename),
+     "expected depth for each chromosome, used to estimate work for alignment files which can't be estimated from the file index (eg. CRAM)")
+    ("output-file", po::value(&opt.outputFilename),
+     "write segments to filename (default: stdout)")
+    ("ref", po::value(&opt.referenceFilename),
+     "fasta reference sequence (required)")
+    ;
+
+    po::options_description help("help");
+    help.add_options()
+    ("help,h","print this message");
+
+    po::options_description aligndesc(getOptionsDescription(opt.alignFileOpt));
+
+    po::options_description visible("options");
+    visible.add(aligndesc).add(req).add(help);
+
+    bool po_parse_fail(false);
+    po::variables_map vm;
+    try
+    {
+        po::store(po::parse_command_line(argc, argv, visible,
+                                         po::command_line_style::unix_style ^ po::command_line_style::allow_short), vm);
+        po::notify(vm);
+    }
+    catch (const boost::program_options::error& e)
+    {
+        log_os << "\nERROR: Exception thrown by option parser: " << e.what() << "\n";
+        po_parse_fail=true;
+    }
+
+    if ((argc<=1) || (vm.count("help")) || po_parse_fail)
+    {
+        usage(log_os,prog,visible);
+    }
+
+    std::string errorMsg;
+    if (parseOptions(vm, opt, errorMsg))
+    {
+        usage(log_os, prog, visible, errorMsg.c_str());
+    }
+}
@@ -0,0 +1,57 @@
+//
+// Manta - Structural Variant and Indel Caller
+// Copyright (c) 2013-2017 Illumina, Inc.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+//
+
+/// \file
+/// \author Chris Saunders
+///
+
+#pragma once
+
+#include "GenomeSegmentPlanner.hh"
+
+#include "common/Program.hh"
+#include "options/AlignmentFileOptions.hh"
+
+#include <string>
+#include <vector>
+
+
+struct GenomeSegmentsOptions
+{
+    AlignmentFileOptions alignFileOpt;
+    GenomeSegmentPlanOptions planOpt;
+
+    /// Regions to be divided into segments, in samtools format
+    std::vector<std::string> regions;
+
+    std::string referenceFilename;
+
+    /// Optional expected depth for each chromosome, used to estimate work from alignment files where
+    /// the file index can't be used for this purpose
+    std::string chromDepthFilename;
+
+    std::string outputFilename;
+};
+
+
+void
+parseGenomeSegmentsOptions(
+    const illumina::Program& prog,
+    int argc, char* argv[],
+    GenomeSegmentsOptions& opt);
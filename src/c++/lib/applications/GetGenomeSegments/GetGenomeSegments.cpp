@@ -0,0 +1,312 @@
+//
+// Manta - Structural Variant and Indel Caller
+// Copyright (c) 2013-2017 Illumina, Inc.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+//
+
+/// \file
+/// \author Chris Saunders
+///
+
+#include "GetGenomeSegments.hh"
+#include "GenomeSegmentsOptions.hh"
+
+#include "applications/EstimateSVLoci/SVLocusSetFinder.hh"
+#include "blt_util/chrom_depth_map.hh"
+#include "blt_util/log.hh"
+#include "common/OutStream.hh"
+#include "htsapi/bam_header_util.hh"
+#include "htsapi/bam_streamer.hh"
+#include "htsapi/samtools_fasta_util.hh"
+
+#include <cassert>
+
+#include <algorithm>
+#include <iostream>
+
+
+
+/// \brief Number of windows required to cover a region
+static
+unsigned
+getWindowCount(
+    const GenomeSegmentPlanOptions& opt,
+    const GenomeInterval& interval)
+{
+    const pos_t regionSize(interval.range.size());
+    return (regionSize + opt.windowSize - 1) / opt.windowSize;
+}
+
+
+
+static
+known_pos_range2
+getWindowRange(
+    const GenomeSegmentPlanOptions& opt,
+    const GenomeInterval& interval,
+    const unsigned windowIndex)
+{
+    const pos_t beginPos(interval.range.begin_pos() + static_cast<pos_t>(windowIndex)*opt.windowSize);
+    return known_pos_range2(beginPos, std::min(beginPos+opt.windowSize, interval.range.end_pos()));
+}
+
+
+
+/// \brief Find all runs of N in the reference sequence of a region
+///
+/// The reference is read one window at a time to bound memory use on large chromosomes.
+static
+void
+getReferenceGaps(
+    const GenomeSegmentsOptions& opt,
+    const std::string& chromName,
+    const GenomeInterval& interval,
+    std::vector<known_pos_range2>& gaps)
+{
+    gaps.clear();
+
+    std::string refSeq;
+    const unsigned windowCount(getWindowCount(opt.planOpt, interval));
+    for (unsigned windowIndex(0); windowIndex<windowCount; ++windowIndex)
+    {
+        const known_pos_range2 windowRange(getWindowRange(opt.planOpt, interval, windowIndex));
+        get_standardized_region_seq(opt.referenceFilename, chromName, windowRange.begin_pos(), windowRange.end_pos()-1, refSeq);
+
+        const pos_t windowSize(std::min(refSeq.size(), static_cast<size_t>(windowRange.size())));
+        for (pos_t offset(0); offset<windowSize; ++offset)
+        {
+            if (refSeq[offset] != 'N') continue;
+            const pos_t pos(windowRange.begin_pos()+offset);
+            if ((! gaps.empty()) && (gaps.back().end_pos() == pos))
+            {
+                gaps.back().set_end_pos(pos+1);
+            }
+            else
+            {
+                gaps.emplace_back(pos,pos+1);
+            }
+        }
+    }
+}
+
+
+
+/// \brief Number of bases in range which are not part of a reference N-gap
+static
+pos_t
+getNonGapSize(
+    const known_pos_range2& range,
+    const std::vector<known_pos_range2>& gaps)
+{
+    pos_t size(range.size());
+    for (const known_pos_range2& gap : gaps)
+    {
+        if (gap.begin_pos() >= range.end_pos()) break;
+        if (! gap.is_range_intersect(range)) continue;
+        size -= (std::min(gap.end_pos(),range.end_pos()) - std::max(gap.begin_pos(),range.begin_pos()));
+    }
+    return size;
+}
+
+
+
+/// \brief Estimate the fraction of the data in one alignment file found in each window of each region
+///
+/// The estimate is taken from the alignment file index where possible. Otherwise it is taken from the
+/// expected depth of each chromosome and the number of non-gap bases in each window.
+static
+void
+addAlignmentFileWork(
+    const GenomeSegmentsOptions& opt,
+    const std::string& alignmentFilename,
+    const std::vector<std::string>& chromNames,
+    const cdmap_t& chromDepth,
+    std::vector<GenomeSegmentPlanRegion>& planRegions)
+{
+    bam_streamer readStream(alignmentFilename.c_str(), opt.referenceFilename.c_str());
+
+    std::vector<std::vector<double>> fileWork(planRegions.size());
+    double totalFileWork(0);
+
+    const unsigned regionCount(planRegions.size());
+    for (unsigned regionIndex(0); regionIndex<regionCount; ++regionIndex)
+    {
+        const GenomeSegmentPlanRegion& planRegion(planRegions[regionIndex]);
+        const int32_t tid(readStream.target_name_to_id(chromNames[regionIndex].c_str()));
+
+        double depth(1);
+        const auto depthIter(chromDepth.find(chromNames[regionIndex]));
+        if (depthIter != chromDepth.end()) depth = depthIter->second;
+
+        const unsigned windowCount(getWindowCount(opt.planOpt, planRegion.interval));
+        for (unsigned windowIndex(0); windowIndex<windowCount; ++windowIndex)
+        {
+            const known_pos_range2 windowRange(getWindowRange(opt.planOpt, planRegion.interval, windowIndex));
+
+            double work(0);
+            uint64_t dataSize(0);
+            if ((tid >= 0) && readStream.estimateRegionDataSize(tid, windowRange.begin_pos(), windowRange.end_pos(), dataSize))
+            {
+                work = dataSize;
+            }
+            else
+            {
+                work = depth*getNonGapSize(windowRange, planRegion.gaps);
+            }
+            fileWork[regionIndex].push_back(work);
+            totalFileWork += work;
+        }
+    }
+
+    if (totalFileWork <= 0) return;
+
+    for (unsigned regionIndex(0); regionIndex<regionCount; ++regionIndex)
+    {
+        std::vector<double>& windowWork(planRegions[regionIndex].windowWork);
+        const unsigned windowCount(windowWork.size());
+        for (unsigned windowIndex(0); windowIndex<windowCount; ++windowIndex)
+        {
+            windowWork[windowIndex] += (fileWork[regionIndex][windowIndex] / totalFileWork);
+        }
+    }
+}
+
+
+
+/// \brief Add a fixed-cost work component proportional to the number of non-gap bases in each window
+///
+/// This approximates the cost of reference processing and other per-base work in regions with little
+/// alignment data, and is used alone if no alignment data is found.
+static
+void
+addReferenceWork(
+    const GenomeSegmentsOptions& opt,
+    const unsigned alignmentFileCount,
+    std::vector<GenomeSegmentPlanRegion>& planRegions)
+{
+    // fraction of the total work attributed to the reference, where each alignment file contributes a total of 1:
+    static const double referenceWorkFraction(0.1);
+
+    std::vector<std::vector<pos_t>> nonGapSize(planRegions.size());
+    double totalNonGapSize(0);
+
+    const unsigned regionCount(planRegions.size());
+    for (unsigned regionIndex(0); regionIndex<regionCount; ++regionIndex)
+    {
+        const GenomeSegmentPlanRegion& planRegion(planRegions[regionIndex]);
+        const unsigned windowCount(planRegion.windowWork.size());
+        for (unsigned windowIndex(0); windowIndex<windowCount; ++windowIndex)
+        {
+            const known_pos_range2 windowRange(getWindowRange(opt.planOpt, planRegion.interval, windowIndex));
+            nonGapSize[regionIndex].push_back(getNonGapSize(windowRange, planRegion.gaps));
+            totalNonGapSize += nonGapSize[regionIndex].back();
+        }
+    }
+
+    if (totalNonGapSize <= 0) return;
+
+    const double referenceWork(referenceWorkFraction*std::max(1u,alignmentFileCount));
+    for (unsigned regionIndex(0); regionIndex<regionCount; ++regionIndex)
+    {
+        std::vector<double>& windowWork(planRegions[regionIndex].windowWork);
+        const unsigned windowCount(windowWork.size());
+        for (unsigned windowIndex(0); windowIndex<windowCount; ++windowIndex)
+        {
+            windowWork[windowIndex] += (referenceWork*nonGapSize[regionIndex][windowIndex]/totalNonGapSize);
+        }
+    }
+}
+
+
+
+static
+void
+getGenomeSegments(GenomeSegmentsOptions opt)
+{
+    // check that we have write permission on the output file early:
+    {
+        OutStream outs(opt.outputFilename);
+    }
+
+    // Segment boundaries should allow for the protected border around each boundary where SV locus graph
+    // denoising is skipped, so segments are kept long relative to this border, and N-gaps are only used as
+    // boundaries if the protected border on both sides of the boundary would fall within the gap:
+    static const pos_t denoiseBorderSize(SVLocusSetFinder::REGION_DENOISE_BORDER);
+    opt.planOpt.minSegmentSize = 20*denoiseBorderSize;
+    opt.planOpt.minBoundaryGapSize = 2*denoiseBorderSize;
+
+    const std::vector<std::string>& alignmentFilenames(opt.alignFileOpt.alignmentFilename);
+    assert(! alignmentFilenames.empty());
+
+    // parse regions using the header of the first alignment file:
+    std::vector<std::string> chromNames;
+    std::vector<GenomeSegmentPlanRegion> planRegions;
+    {
+        const bam_streamer readStream(alignmentFilenames.front().c_str(), opt.referenceFilename.c_str());
+        const bam_hdr_t& header(readStream.get_header());
+        for (const std::string& region : opt.regions)
+        {
+            int32_t tid, beginPos, endPos;
+            parse_bam_region_from_hdr(&header, region.c_str(), tid, beginPos, endPos);
+            endPos = std::min(endPos, static_cast<int32_t>(header.target_len[tid]));
+
+            chromNames.push_back(header.target_name[tid]);
+            planRegions.emplace_back();
+            GenomeSegmentPlanRegion& planRegion(planRegions.back());
+            planRegion.interval = GenomeInterval(tid, beginPos, endPos);
+            planRegion.windowWork.resize(getWindowCount(opt.planOpt, planRegion.interval), 0.);
+            getReferenceGaps(opt, chromNames.back(), planRegion.interval, planRegion.gaps);
+        }
+    }
+
+    cdmap_t chromDepth;
+    parse_chrom_depth(opt.chromDepthFilename, chromDepth);
+
+    for (const std::string& alignmentFilename : alignmentFilenames)
+    {
+        addAlignmentFileWork(opt, alignmentFilename, chromNames, chromDepth, planRegions);
+    }
+    addReferenceWork(opt, alignmentFilenames.size(), planRegions);
+
+    std::vector<std::vector<known_pos_range2>> segments;
+    planGenomeSegments(opt.planOpt, planRegions, segments);
+
+    OutStream outs(opt.outputFilename);
+    std::ostream& os(outs.getStream());
+
+    os << "#regionIndex\tchrom\tbeginPos\tendPos\n";
+    const unsigned regionCount(planRegions.size());
+    for (unsigned regionIndex(0); regionIndex<regionCount; ++regionIndex)
+    {
+        for (const known_pos_range2& segment : segments[regionIndex])
+        {
+            os << regionIndex << '\t' << chromNames[regionIndex]
+               << '\t' << (segment.begin_pos()+1) << '\t' << segment.end_pos() << '\n';
+        }
+    }
+}
+
+
+
+void
+GetGenomeSegments::
+runInternal(int argc, char* argv[]) const
+{
+    GenomeSegmentsOptions opt;
+
+    parseGenomeSegmentsOptions(*this,argc,argv,opt);
+    getGenomeSegments(opt);
+}
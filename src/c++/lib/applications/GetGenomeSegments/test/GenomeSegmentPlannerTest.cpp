@@ -0,0 +1,142 @@
+//
+// Manta - Structural Variant and Indel Caller
+// Copyright (c) 2013-2017 Illumina, Inc.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+//
+//
+
+#include "boost/test/unit_test.hpp"
+
+#include "applications/GetGenomeSegments/GenomeSegmentPlanner.hh"
+
+
+BOOST_AUTO_TEST_SUITE( test_GenomeSegmentPlanner )
+
+
+static
+GenomeSegmentPlanOptions
+getTestOptions()
+{
+    GenomeSegmentPlanOptions opt;
+    opt.windowSize = 100;
+    opt.targetSegmentSize = 1000;
+    opt.minSegmentSize = 100;
+    opt.minBoundaryGapSize = 20;
+    opt.maxBoundaryGapDistance = 50;
+    return opt;
+}
+
+
+static
+GenomeSegmentPlanRegion
+getUniformRegion(
+    const GenomeSegmentPlanOptions& opt,
+    const pos_t regionSize)
+{
+    GenomeSegmentPlanRegion region;
+    region.interval = GenomeInterval(0,0,regionSize);
+    region.windowWork.resize((regionSize+opt.windowSize-1)/opt.windowSize,1.);
+    return region;
+}
+
+
+// Test that uniform work produces the same segments as fixed-size segmentation
+BOOST_AUTO_TEST_CASE( test_UniformWork )
+{
+    const GenomeSegmentPlanOptions opt(getTestOptions());
+    std::vector<GenomeSegmentPlanRegion> regions(1,getUniformRegion(opt,3000));
+
+    std::vector<std::vector<known_pos_range2>> segments;
+    planGenomeSegments(opt,regions,segments);
+
+    BOOST_REQUIRE_EQUAL(segments.size(),1u);
+    BOOST_REQUIRE_EQUAL(segments[0].size(),3u);
+    BOOST_REQUIRE_EQUAL(segments[0][0],known_pos_range2(0,1000));
+    BOOST_REQUIRE_EQUAL(segments[0][1],known_pos_range2(1000,2000));
+    BOOST_REQUIRE_EQUAL(segments[0][2],known_pos_range2(2000,3000));
+}
+
+
+// Test that segments are shorter where work is concentrated
+BOOST_AUTO_TEST_CASE( test_ConcentratedWork )
+{
+    const GenomeSegmentPlanOptions opt(getTestOptions());
+    std::vector<GenomeSegmentPlanRegion> regions(1,getUniformRegion(opt,3000));
+
+    // 2/3 of all work is in the first 200 bases:
+    regions[0].windowWork[0] = 28;
+    regions[0].windowWork[1] = 28;
+
+    std::vector<std::vector<known_pos_range2>> segments;
+    planGenomeSegments(opt,regions,segments);
+
+    BOOST_REQUIRE_EQUAL(segments[0].size(),3u);
+    BOOST_REQUIRE_EQUAL(segments[0][0],known_pos_range2(0,100));
+    BOOST_REQUIRE_EQUAL(segments[0][1],known_pos_range2(100,200));
+    BOOST_REQUIRE_EQUAL(segments[0][2],known_pos_range2(200,3000));
+}
+
+
+// Test that segments are distributed among regions by work rather than size
+BOOST_AUTO_TEST_CASE( test_MultiRegion )
+{
+    const GenomeSegmentPlanOptions opt(getTestOptions());
+    std::vector<GenomeSegmentPlanRegion> regions;
+    regions.push_back(getUniformRegion(opt,2000));
+    regions.push_back(getUniformRegion(opt,2000));
+    for (double& work : regions[1].windowWork) work = 3;
+
+    std::vector<std::vector<known_pos_range2>> segments;
+    planGenomeSegments(opt,regions,segments);
+
+    BOOST_REQUIRE_EQUAL(segments.size(),2u);
+    BOOST_REQUIRE_EQUAL(segments[0].size(),1u);
+    BOOST_REQUIRE_EQUAL(segments[1].size(),3u);
+}
+
+
+// Test that segment boundaries move into nearby large N-gaps, and that the minimum segment size is enforced
+BOOST_AUTO_TEST_CASE( test_GapBoundary )
+{
+    const GenomeSegmentPlanOptions opt(getTestOptions());
+    std::vector<GenomeSegmentPlanRegion> regions(1,getUniformRegion(opt,3000));
+
+    // too small to be used:
+    regions[0].gaps.emplace_back(995,1005);
+    // within snap distance:
+    regions[0].gaps.emplace_back(1020,1060);
+    // too far away:
+    regions[0].gaps.emplace_back(1900,1920);
+    regions[0].gaps.emplace_back(2100,2200);
+
+    std::vector<std::vector<known_pos_range2>> segments;
+    planGenomeSegments(opt,regions,segments);
+
+    BOOST_REQUIRE_EQUAL(segments[0].size(),3u);
+    BOOST_REQUIRE_EQUAL(segments[0][0],known_pos_range2(0,1039));
+    BOOST_REQUIRE_EQUAL(segments[0][1],known_pos_range2(1039,2000));
+
+    // a short region is never split:
+    regions.clear();
+    regions.push_back(getUniformRegion(opt,150));
+    regions[0].windowWork[0] = 100;
+    regions.push_back(getUniformRegion(opt,10000));
+    planGenomeSegments(opt,regions,segments);
+    BOOST_REQUIRE_EQUAL(segments[0].size(),1u);
+    BOOST_REQUIRE_EQUAL(segments[0][0],known_pos_range2(0,150));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
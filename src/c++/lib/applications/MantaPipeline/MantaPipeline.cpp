@@ -0,0 +1,577 @@
+//
+// Manta - Structural Variant and Indel Caller
+// Copyright (c) 2013-2017 Illumina, Inc.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+//
+
+/// \file
+/// \author Chris Saunders
+///
+
+#include "MantaPipeline.hh"
+#include "MantaPipelineOptions.hh"
+#include "MantaPipelineUtil.hh"
+
+#include "applications/EstimateSVLoci/EstimateSVLoci.hh"
+#include "applications/GenerateSVCandidates/GenerateSVCandidates.hh"
+#include "applications/GetChromDepth/ReadChromDepthUtil.hh"
+#include "applications/PostProcessSVCalls/PostProcessSVCalls.hh"
+#include "blt_util/depth_pyramid.hh"
+#include "blt_util/log.hh"
+#include "blt_util/packed_reference.hh"
+#include "blt_util/parse_util.hh"
+#include "common/OutStream.hh"
+#include "htsapi/bam_header_util.hh"
+#include "htsapi/bam_streamer.hh"
+#include "manta/AlignmentRunCache.hh"
+
+#include "boost/filesystem.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <mutex>
+#include <sstream>
+#include <thread>
+
+
+
+/// Run func(taskIndex) for each task on up to threadCount threads
+///
+/// Tasks are handed out to threads on demand in task index order. If func throws, the exception from the lowest task
+/// index is rethrown after all threads complete.
+template <typename Func>
+static
+void
+runParallelTasks(
+    const unsigned taskCount,
+    const unsigned threadCount,
+    Func func)
+{
+    std::vector<std::exception_ptr> taskExceptions(taskCount);
+    std::atomic<unsigned> nextTaskIndex(0);
+
+    auto runTasks = [&]()
+    {
+        while (true)
+        {
+            const unsigned taskIndex(nextTaskIndex++);
+            if (taskIndex >= taskCount) return;
+            try
+            {
+                func(taskIndex);
+            }
+            catch (...)
+            {
+                taskExceptions[taskIndex] = std::current_exception();
+            }
+        }
+    };
+
+    std::vector<std::thread> threads;
+    const unsigned activeThreadCount(std::min(threadCount, taskCount));
+    for (unsigned threadIndex(0); threadIndex<activeThreadCount; ++threadIndex)
+    {
+        threads.emplace_back(runTasks);
+    }
+    for (std::thread& thread : threads)
+    {
+        thread.join();
+    }
+
+    for (const std::exception_ptr& taskException : taskExceptions)
+    {
+        if (taskException) std::rethrow_exception(taskException);
+    }
+}
+
+
+
+static
+std::string
+getPath(
+    const std::string& directory,
+    const std::string& filename)
+{
+    return (boost::filesystem::path(directory) / filename).string();
+}
+
+
+
+/// \brief A contiguous region of the genome which is called by the pipeline
+struct ScanRegion
+{
+    std::string chromName;
+    pos_t beginPos = 0;
+    pos_t endPos = 0;
+};
+
+
+
+/// \brief Get all regions called by the pipeline, in the order used for output
+static
+void
+getScanRegions(
+    const MantaPipelineOptions& opt,
+    const bam_header_info& bamHeader,
+    std::vector<ScanRegion>& scanRegions)
+{
+    scanRegions.clear();
+    if (opt.isTargeted())
+    {
+        std::vector<GenomeInterval> targets;
+        if (! opt.targetVcfFilename.empty())
+        {
+            std::ifstream ifs(opt.targetVcfFilename.c_str());
+            readVcfTargets(ifs, bamHeader, targets);
+        }
+        if (! opt.targetBedFilename.empty())
+        {
+            std::ifstream ifs(opt.targetBedFilename.c_str());
+            readBedTargets(ifs, bamHeader, targets);
+        }
+        mergeTargets(bamHeader, opt.targetFlankSize, targets);
+
+        for (const GenomeInterval& target : targets)
+        {
+            scanRegions.emplace_back();
+            scanRegions.back().chromName = bamHeader.chrom_data[target.tid].label;
+            scanRegions.back().beginPos = target.range.begin_pos();
+            scanRegions.back().endPos = target.range.end_pos();
+        }
+        return;
+    }
+
+    if (opt.regions.empty())
+    {
+        for (const auto& chrom : bamHeader.chrom_data)
+        {
+            scanRegions.emplace_back();
+            scanRegions.back().chromName = chrom.label;
+            scanRegions.back().endPos = chrom.length;
+        }
+        return;
+    }
+
+    for (const std::string& region : opt.regions)
+    {
+        int32_t tid(0), beginPos(0), endPos(0);
+        parse_bam_region(bamHeader, region.c_str(), tid, beginPos, endPos);
+
+        const bam_header_info::chrom_info& chrom(bamHeader.chrom_data[tid]);
+        scanRegions.emplace_back();
+        scanRegions.back().chromName = chrom.label;
+        scanRegions.back().beginPos = beginPos;
+        scanRegions.back().endPos = std::min(endPos, static_cast<int32_t>(chrom.length));
+    }
+}
+
+
+
+/// \brief Compute read group statistics for all alignment files and write the merged result to statsFilename
+static
+void
+writeAlignmentStats(
+    const MantaPipelineOptions& opt,
+    const AlignmentRunCache& runCache,
+    const std::string& statsFilename)
+{
+    const std::vector<std::string>& alignmentFilenames(opt.alignFileOpt.alignmentFilename);
+    const unsigned fileCount(alignmentFilenames.size());
+
+    std::vector<ReadGroupStatsSet> fileStats(fileCount);
+    runParallelTasks(fileCount, opt.threadCount, [&](const unsigned fileIndex)
+    {
+        runCache.getReadGroupStats(opt.referenceFilename, alignmentFilenames[fileIndex], fileStats[fileIndex]);
+    });
+
+    ReadGroupStatsSet mergedStats;
+    for (const ReadGroupStatsSet& rstats : fileStats)
+    {
+        mergedStats.merge(rstats);
+    }
+    mergedStats.save(statsFilename.c_str());
+}
+
+
+
+/// \brief Round chromosome depth to the precision of the GetChromDepth output
+///
+/// This is used so that depth summed over multiple alignment files matches the workflow's merged depth file.
+static
+double
+roundChromDepth(const double depth)
+{
+    std::ostringstream oss;
+    oss << std::fixed << std::setprecision(2) << depth;
+    return illumina::blt_util::parse_double_str(oss.str());
+}
+
+
+
+/// \brief Estimate depth for each chromosome in the scan regions and write the result to chromDepthFilename
+///
+/// As in the workflow, depth is taken from the non-tumor alignment files, or from the tumor alignment files if there
+/// is no non-tumor input.
+static
+void
+writeChromDepth(
+    const MantaPipelineOptions& opt,
+    const AlignmentRunCache& runCache,
+    const std::vector<ScanRegion>& scanRegions,
+    const std::string& chromDepthFilename)
+{
+    std::vector<std::string> depthFilenames;
+    const unsigned alignmentFileCount(opt.alignFileOpt.alignmentFilename.size());
+    for (unsigned fileIndex(0); fileIndex<alignmentFileCount; ++fileIndex)
+    {
+        if (opt.alignFileOpt.isAlignmentTumor[fileIndex]) continue;
+        depthFilenames.push_back(opt.alignFileOpt.alignmentFilename[fileIndex]);
+    }
+    if (depthFilenames.empty())
+    {
+        depthFilenames = opt.alignFileOpt.alignmentFilename;
+    }
+
+    std::vector<std::string> chromNames;
+    for (const ScanRegion& scanRegion : scanRegions)
+    {
+        if (std::find(chromNames.begin(), chromNames.end(), scanRegion.chromName) != chromNames.end()) continue;
+        chromNames.push_back(scanRegion.chromName);
+    }
+
+    const unsigned fileCount(depthFilenames.size());
+    const unsigned chromCount(chromNames.size());
+    std::vector<double> depth(fileCount*chromCount);
+    runParallelTasks(depth.size(), opt.threadCount, [&](const unsigned taskIndex)
+    {
+        const unsigned fileIndex(taskIndex/chromCount);
+        const unsigned chromIndex(taskIndex%chromCount);
+        depth[taskIndex] = runCache.getChromDepth(opt.referenceFilename, depthFilenames[fileIndex], chromNames[chromIndex], [&]()
+        {
+            return readChromDepthFromAlignment(opt.referenceFilename, depthFilenames[fileIndex], chromNames[chromIndex]);
+        });
+    });
+
+    OutStream outs(chromDepthFilename);
+    std::ostream& os(outs.getStream());
+    for (unsigned chromIndex(0); chromIndex<chromCount; ++chromIndex)
+    {
+        os << chromNames[chromIndex] << "\t" << std::fixed;
+        if (fileCount == 1)
+        {
+            os << std::setprecision(2) << depth[chromIndex];
+        }
+        else
+        {
+            double totalDepth(0);
+            for (unsigned fileIndex(0); fileIndex<fileCount; ++fileIndex)
+            {
+                totalDepth += roundChromDepth(depth[fileIndex*chromCount+chromIndex]);
+            }
+            os << std::setprecision(3) << totalDepth;
+        }
+        os << "\n";
+    }
+}
+
+
+
+/// \brief Build the SV locus graph for all genome segments and merge them into a single finalized graph
+static
+void
+buildLocusGraph(
+    const MantaPipelineOptions& opt,
+    const std::vector<ScanRegion>& scanRegions,
+    const std::string& statsFilename,
+    const std::string& chromDepthFilename,
+    const std::string& depthMapFilename,
+    SVLocusSet& mergedSet)
+{
+    ESLOptions eslOpt;
+    eslOpt.alignFileOpt = opt.alignFileOpt;
+    eslOpt.scanOpt = opt.scanOpt;
+    eslOpt.graphOpt = opt.graphOpt;
+    eslOpt.referenceFilename = opt.referenceFilename;
+    eslOpt.statsFilename = statsFilename;
+    eslOpt.chromDepthFilename = chromDepthFilename;
+    eslOpt.depthMapFilename = depthMapFilename;
+    const bool isDepthMap(! depthMapFilename.empty());
+
+    static const pos_t megabase(1000000);
+    std::vector<std::string> segments;
+    for (const ScanRegion& scanRegion : scanRegions)
+    {
+        std::vector<std::string> regionSegments;
+        getRegionSegments(scanRegion.chromName, scanRegion.beginPos, scanRegion.endPos,
+                          opt.scanSizeMb*megabase, regionSegments);
+        segments.insert(segments.end(), regionSegments.begin(), regionSegments.end());
+    }
+    eslOpt.regions = segments;
+
+    // Segment graphs are merged in genome order as they become available, so that the merged graph does not
+    // depend on the thread count, and finished segment graphs are not all held in memory at once:
+    const unsigned segmentCount(segments.size());
+    std::vector<std::unique_ptr<SVLocusSet>> segmentSets(segmentCount);
+    unsigned nextMergeIndex(0);
+    std::mutex mergeMutex;
+
+    // depth map counts are summed, so these are merged in any order:
+    depth_pyramid_builder mergedDepthMap;
+
+    // a single read scanner and copy of the read group stats is shared by all segments:
+    const std::shared_ptr<const SVLocusScanner> readScannerPtr(
+        std::make_shared<const SVLocusScanner>(eslOpt.scanOpt, eslOpt.statsFilename,
+                                               eslOpt.alignFileOpt.alignmentFilename, eslOpt.isRNA));
+
+    runParallelTasks(segmentCount, opt.threadCount, [&](const unsigned segmentIndex)
+    {
+        estimateSVLociRegion(eslOpt, segments[segmentIndex], [&](SVLocusSetFinder& locusFinder)
+        {
+            std::unique_ptr<SVLocusSet> segmentSetPtr(new SVLocusSet);
+            *segmentSetPtr = locusFinder.getLocusSet();
+
+            std::lock_guard<std::mutex> lock(mergeMutex);
+            if (isDepthMap)
+            {
+                mergedDepthMap.merge(locusFinder.getDepthMap());
+            }
+            segmentSets[segmentIndex] = std::move(segmentSetPtr);
+            while ((nextMergeIndex < segmentCount) && segmentSets[nextMergeIndex])
+            {
+                if (mergedSet.empty())
+                {
+                    mergedSet = *segmentSets[nextMergeIndex];
+                }
+                else
+                {
+                    mergedSet.merge(*segmentSets[nextMergeIndex]);
+                }
+                segmentSets[nextMergeIndex].reset();
+                nextMergeIndex++;
+            }
+        }, readScannerPtr);
+    });
+
+    if (isDepthMap)
+    {
+        mergedDepthMap.write(depthMapFilename);
+    }
+
+    mergedSet.finalize(opt.threadCount);
+
+    // compact the locus indices to match a saved graph, so that candidate IDs are the same as the staged workflow:
+    mergedSet.removeEmptyLoci();
+    mergedSet.checkState(true,true,opt.threadCount);
+}
+
+
+
+/// \brief Per-bin and final file names for one type of VCF output
+struct VcfOutput
+{
+    VcfOutput(
+        const std::string& initLabel,
+        const bool initIsResolveDuplicates) :
+        label(initLabel),
+        isResolveDuplicates(initIsResolveDuplicates)
+    {}
+
+    std::string label;
+    bool isResolveDuplicates;
+    std::vector<std::string> binFilenames;
+};
+
+
+
+static
+void
+runMantaPipeline(
+    const MantaPipelineOptions& opt,
+    const char* progName,
+    const char* progVersion)
+{
+    const std::string& outputDir(opt.outputDirectory);
+    const std::string hygenDir(getPath(outputDir, "svHyGen"));
+    boost::filesystem::create_directories(hygenDir);
+
+    bam_header_info bamHeader;
+    {
+        const bam_streamer readStream(opt.alignFileOpt.alignmentFilename.front().c_str(), opt.referenceFilename.c_str());
+        bamHeader = bam_header_info(readStream.get_header());
+    }
+
+    std::vector<ScanRegion> scanRegions;
+    getScanRegions(opt, bamHeader, scanRegions);
+
+    // Stats and depth are consumed by the read scanning and scoring components through their existing file
+    // interfaces, so unless these are given from a previous run, each is computed in memory and written to the
+    // output directory once:
+    const AlignmentRunCache runCache(opt.cacheDirname);
+
+    std::string statsFilename(opt.statsFilename);
+    if (statsFilename.empty())
+    {
+        statsFilename = getPath(outputDir, "alignmentStats.xml");
+        writeAlignmentStats(opt, runCache, statsFilename);
+    }
+
+    std::string chromDepthFilename(opt.chromDepthFilename);
+    if ((! opt.isExome) && chromDepthFilename.empty())
+    {
+        chromDepthFilename = getPath(outputDir, "chromDepth.txt");
+        writeChromDepth(opt, runCache, scanRegions, chromDepthFilename);
+    }
+
+    std::string depthMapFilename;
+    if (opt.isDepthMap)
+    {
+        depthMapFilename = getPath(hygenDir, "depthMap.bin");
+    }
+
+    std::shared_ptr<SVLocusSet> setPtr(new SVLocusSet);
+    buildLocusGraph(opt, scanRegions, statsFilename, chromDepthFilename, depthMapFilename, *setPtr);
+
+    // generate, score and write SV candidates for each graph edge bin:
+    unsigned normalCount(0);
+    unsigned tumorCount(0);
+    for (const bool value : opt.alignFileOpt.isAlignmentTumor)
+    {
+        if (value) tumorCount++;
+        else      normalCount++;
+    }
+    const bool isTumorOnly(normalCount == 0);
+    const bool isSomatic((normalCount > 0) && (tumorCount > 0));
+
+    GSCOptions gscOpt;
+    gscOpt.alignFileOpt = opt.alignFileOpt;
+    gscOpt.scanOpt = opt.scanOpt;
+    gscOpt.diploidOpt = opt.diploidOpt;
+    gscOpt.somaticOpt = opt.somaticOpt;
+    gscOpt.tumorOpt = opt.tumorOpt;
+    gscOpt.referenceFilename = opt.referenceFilename;
+    gscOpt.statsFilename = statsFilename;
+    gscOpt.chromDepthFilename = chromDepthFilename;
+    gscOpt.depthMapFilename = depthMapFilename;
+    gscOpt.minCandidateSpanningCount = opt.minCandidateSpanningCount;
+    gscOpt.minScoredVariantSize = opt.minScoredVariantSize;
+    gscOpt.isSkipRemoteReads = isSomatic;
+
+    // A targeted graph is small enough that the per-bin cost of opening the alignment and reference files dominates
+    // candidate generation, so only one bin is used per thread:
+    const unsigned binCount(opt.isTargeted() ? std::min(opt.candidateBinCount, opt.threadCount) : opt.candidateBinCount);
+    gscOpt.edgeOpt.binCount = binCount;
+
+    VcfOutput candidateOutput("candidateSV", false);
+    VcfOutput diploidOutput("diploidSV", true);
+    VcfOutput somaticOutput("somaticSV", true);
+    VcfOutput tumorOutput("tumorSV", true);
+
+    std::vector<GSCOptions> binOpts(binCount, gscOpt);
+    for (unsigned binIndex(0); binIndex<binCount; ++binIndex)
+    {
+        std::ostringstream binStr;
+        binStr << std::setfill('0') << std::setw(4) << binIndex;
+        auto getBinFilename = [&](VcfOutput& output)
+        {
+            output.binFilenames.push_back(getPath(hygenDir, output.label + "." + binStr.str() + ".vcf"));
+            return output.binFilenames.back();
+        };
+
+        GSCOptions& binOpt(binOpts[binIndex]);
+        binOpt.edgeOpt.binIndex = binIndex;
+        binOpt.candidateOutputFilename = getBinFilename(candidateOutput);
+        if (isTumorOnly)
+        {
+            binOpt.tumorOutputFilename = getBinFilename(tumorOutput);
+        }
+        else
+        {
+            binOpt.diploidOutputFilename = getBinFilename(diploidOutput);
+            if (isSomatic)
+            {
+                binOpt.somaticOutputFilename = getBinFilename(somaticOutput);
+            }
+        }
+    }
+
+    // a single read scanner and copy of the read group stats is shared by all bins:
+    const std::shared_ptr<const SVLocusScanner> readScannerPtr(
+        std::make_shared<const SVLocusScanner>(gscOpt.scanOpt, gscOpt.statsFilename,
+                                               gscOpt.alignFileOpt.alignmentFilename, gscOpt.isRNA,
+                                               !gscOpt.isUnstrandedRNA));
+
+    runParallelTasks(binCount, opt.threadCount, [&](const unsigned binIndex)
+    {
+        runGSC(binOpts[binIndex], progName, progVersion, setPtr, readScannerPtr);
+    });
+
+    // merge and sort the VCF output of all bins, then post-process, compress and index each sorted VCF:
+    for (const VcfOutput* outputPtr : { &candidateOutput, &diploidOutput, &somaticOutput, &tumorOutput })
+    {
+        const VcfOutput& output(*outputPtr);
+        if (output.binFilenames.empty()) continue;
+
+        const std::string sortedFilename(getPath(hygenDir, output.label + ".vcf"));
+        {
+            VcfRecordSorter sorter(output.isResolveDuplicates);
+            for (const std::string& binFilename : output.binFilenames)
+            {
+                std::ifstream ifs(binFilename.c_str());
+                sorter.addVcf(ifs);
+            }
+
+            OutStream outs(sortedFilename);
+            sorter.write(outs.getStream());
+        }
+
+        PostProcessSVCallsOptions postOpt;
+        postOpt.vcfFilename = sortedFilename;
+        postOpt.outputFilename = getPath(outputDir, output.label + ".vcf.gz");
+        postOpt.threadCount = opt.threadCount;
+        if (outputPtr == &diploidOutput)
+        {
+            postOpt.isPloidyFilter = true;
+        }
+        else if ((outputPtr == &candidateOutput) && (opt.minScoredVariantSize > 1))
+        {
+            postOpt.smallIndelOutputFilename = getPath(outputDir, "candidateSmallIndels.vcf.gz");
+            postOpt.maxSmallIndelSize = opt.minScoredVariantSize-1;
+        }
+        runPostProcessSVCalls(postOpt);
+    }
+
+    boost::filesystem::remove_all(hygenDir);
+}
+
+
+
+void
+MantaPipeline::
+runInternal(int argc, char* argv[]) const
+{
+    MantaPipelineOptions opt;
+
+    parseMantaPipelineOptions(*this,argc,argv,opt);
+    if (! opt.packedReferenceFilename.empty())
+    {
+        register_packed_reference(opt.referenceFilename, opt.packedReferenceFilename);
+    }
+    runMantaPipeline(opt, name(), version());
+}
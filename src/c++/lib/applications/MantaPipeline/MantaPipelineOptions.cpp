@@ -0,0 +1,247 @@
+//
+// Manta - Structural Variant and Indel Caller
+// Copyright (c) 2013-2017 Illumina, Inc.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+//
+
+/// \file
+/// \author Chris Saunders
+///
+
+#include "MantaPipelineOptions.hh"
+
+#include "blt_util/log.hh"
+#include "common/ProgramUtil.hh"
+#include "options/AlignmentFileOptionsParser.hh"
+#include "options/ReadScannerOptionsParser.hh"
+#include "options/SVLocusSetOptionsParser.hh"
+#include "options/optionsUtil.hh"
+
+#include "boost/program_options.hpp"
+
+#include <iostream>
+
+
+typedef std::vector<std::string> regions_t;
+
+
+static
+void
+usage(
+    std::ostream& os,
+    const illumina::Program& prog,
+    const boost::program_options::options_description& visible,
+    const char* msg = nullptr)
+{
+    usage(os, prog, visible, "call SVs from alignment files in a single process", "", msg);
+}
+
+
+
+static
+void
+checkStandardizeUsageFile(
+    std::ostream& os,
+    const illumina::Program& prog,
+    const boost::program_options::options_description& visible,
+    std::string& filename,
+    const char* fileLabel)
+{
+    std::string errorMsg;
+    if ( checkStandardizeInputFile(filename, fileLabel, errorMsg))
+    {
+        usage(os,prog,visible,errorMsg.c_str());
+    }
+}
+
+
+
+void
+parseMantaPipelineOptions(
+    const illumina::Program& prog,
+    int argc, char* argv[],
+    MantaPipelineOptions& opt)
+{
+    namespace po = boost::program_options;
+    po::options_description req("configuration");
+    req.add_options()
+    ("ref", po::value(&opt.referenceFilename),
+     "fasta reference sequence (required)")
+    ("packed-ref", po::value(&opt.packedReferenceFilename),
+     "optional 2-bit packed image of the fasta reference from BuildPackedReference, used for all reference sequence access")
+    ("output-dir", po::value(&opt.outputDirectory),
+     "directory for variant output and intermediate files (required)")
+    ("region", po::value<regions_t>(),
+     "samtools formatted region to call, eg. 'chr1:20-30'. May be supplied more than once but regions must not overlap. All chromosomes are called if no region is given.")
+    ("target-vcf", po::value(&opt.targetVcfFilename),
+     "VCF file of known SVs, only the regions around each SV breakend are called")
+    ("target-bed", po::value(&opt.targetBedFilename),
+     "BED file of target regions, only these regions are called")
+    ("target-flank-size", po::value(&opt.targetFlankSize)->default_value(opt.targetFlankSize),
+     "size of the region scanned for SV evidence on each side of a target breakend or region")
+    ("align-stats", po::value(&opt.statsFilename),
+     "pre-computed alignment statistics for the input alignment files from a previous run, these are estimated from the alignment files if not given")
+    ("chrom-depth", po::value(&opt.chromDepthFilename),
+     "pre-computed average depth for each chromosome from a previous run, this is estimated from the alignment files if not given")
+    ("cache-dir", po::value(&opt.cacheDirname),
+     "reuse alignment statistics and chromosome depth cached in this directory from earlier runs on the same alignment files, and add new results to the cache")
+    ("threads", po::value(&opt.threadCount)->default_value(opt.threadCount),
+     "number of threads shared by all pipeline stages")
+    ("scan-size-mb", po::value(&opt.scanSizeMb)->default_value(opt.scanSizeMb),
+     "maximum size in megabases of the genome segments scanned in parallel to build the SV locus graph")
+    ("candidate-bins", po::value(&opt.candidateBinCount)->default_value(opt.candidateBinCount),
+     "number of SV locus graph edge bins processed in parallel to generate SV candidates")
+    ("min-candidate-spanning-count", po::value(&opt.minCandidateSpanningCount)->default_value(opt.minCandidateSpanningCount),
+     "minimum number of supporting spanning observations required to become an SV candidate")
+    ("min-scored-sv-size", po::value(&opt.minScoredVariantSize)->default_value(opt.minScoredVariantSize),
+     "minimum size for variants which are scored and output following initial candidate generation")
+    ("exome", po::value(&opt.isExome)->zero_tokens(),
+     "Turn off the chromosome depth filters for exome or other targeted sequencing input")
+    ("depth-map", po::value(&opt.isDepthMap)->zero_tokens(),
+     "Map read depth while building the SV locus graph, and use this map to find high depth regions and breakend depth during candidate generation and scoring")
+    ;
+
+    po::options_description alignDesc(getOptionsDescription(opt.alignFileOpt));
+    po::options_description scanDesc(getOptionsDescription(opt.scanOpt));
+    po::options_description graphDesc(getOptionsDescription(opt.graphOpt));
+    po::options_description diploidCallDesc(getOptionsDescription(opt.diploidOpt));
+    po::options_description somaticCallDesc(getOptionsDescription(opt.somaticOpt));
+    po::options_description tumorCallDesc(getOptionsDescription(opt.tumorOpt));
+
+    po::options_description help("help");
+    help.add_options()
+    ("help,h","print this message");
+
+    po::options_description visible("options");
+    visible.add(alignDesc).add(scanDesc).add(graphDesc).add(req).add(diploidCallDesc).add(somaticCallDesc).add(tumorCallDesc).add(help);
+
+    bool po_parse_fail(false);
+    po::variables_map vm;
+    try
+    {
+        po::store(po::parse_command_line(argc, argv, visible,
+                                         po::command_line_style::unix_style ^ po::command_line_style::allow_short), vm);
+        po::notify(vm);
+    }
+    catch (const boost::program_options::error& e)     // todo:: find out what is the more specific exception class thrown by program options
+    {
+        log_os << "\nERROR: Exception thrown by option parser: " << e.what() << "\n";
+        po_parse_fail=true;
+    }
+
+    if ((argc<=1) || (vm.count("help")) || po_parse_fail)
+    {
+        usage(log_os,prog,visible);
+    }
+
+    if (vm.count("region"))
+    {
+        opt.regions=(boost::any_cast<regions_t>(vm["region"].value()));
+    }
+
+    std::string errorMsg;
+    if (parseOptions(vm, opt.alignFileOpt, errorMsg))
+    {}
+    else if (parseOptions(vm, opt.scanOpt, errorMsg))
+    {}
+    else if (parseOptions(vm, opt.graphOpt, errorMsg))
+    {}
+    else if (opt.referenceFilename.empty())
+    {
+        errorMsg="Must specify a fasta reference file";
+    }
+    else if (opt.outputDirectory.empty())
+    {
+        errorMsg="Must specify an output directory";
+    }
+    else if (opt.isTargeted() && (! opt.regions.empty()))
+    {
+        errorMsg="Can't combine target files with region arguments";
+    }
+    else if (opt.targetFlankSize < 0)
+    {
+        errorMsg="Target flank size can't be negative";
+    }
+    else if (opt.isExome && (! opt.chromDepthFilename.empty()))
+    {
+        errorMsg="Chromosome depth is not used for exome input";
+    }
+    else if (opt.threadCount == 0)
+    {
+        errorMsg="Thread count must be at least one";
+    }
+    else if (opt.scanSizeMb == 0)
+    {
+        errorMsg="Scan size must be at least one megabase";
+    }
+    else if (opt.candidateBinCount == 0)
+    {
+        errorMsg="Candidate bin count must be at least one";
+    }
+
+    if (errorMsg.empty())
+    {
+        // apply the sample limits of the configManta.py workflow:
+        unsigned normalCount(0);
+        unsigned tumorCount(0);
+        for (const bool value : opt.alignFileOpt.isAlignmentTumor)
+        {
+            if (value) tumorCount++;
+            else      normalCount++;
+        }
+
+        if (tumorCount > 1)
+        {
+            errorMsg="Can't accept more than one tumor alignment file";
+        }
+        else if ((tumorCount > 0) && (normalCount > 1))
+        {
+            errorMsg="Can't accept multiple non-tumor alignment files for tumor subtraction";
+        }
+    }
+
+    if (! errorMsg.empty()) usage(log_os,prog,visible,errorMsg.c_str());
+
+    for (const auto& region : opt.regions)
+    {
+        if (region.empty())
+        {
+            usage(log_os,prog,visible,"Empty region argument");
+        }
+    }
+
+    checkStandardizeUsageFile(log_os,prog,visible,opt.referenceFilename,"reference fasta");
+    if (! opt.packedReferenceFilename.empty())
+    {
+        checkStandardizeUsageFile(log_os,prog,visible,opt.packedReferenceFilename,"packed reference image");
+    }
+    if (! opt.targetVcfFilename.empty())
+    {
+        checkStandardizeUsageFile(log_os,prog,visible,opt.targetVcfFilename,"target VCF");
+    }
+    if (! opt.targetBedFilename.empty())
+    {
+        checkStandardizeUsageFile(log_os,prog,visible,opt.targetBedFilename,"target BED");
+    }
+    if (! opt.statsFilename.empty())
+    {
+        checkStandardizeUsageFile(log_os,prog,visible,opt.statsFilename,"alignment statistics");
+    }
+    if (! opt.chromDepthFilename.empty())
+    {
+        checkStandardizeUsageFile(log_os,prog,visible,opt.chromDepthFilename,"chromosome depth");
+    }
+}
@@ -0,0 +1,113 @@
+//
+// Manta - Structural Variant and Indel Caller
+// Copyright (c) 2013-2017 Illumina, Inc.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+//
+
+/// \file
+/// \author Chris Saunders
+///
+
+#pragma once
+
+#include "blt_util/blt_types.hh"
+#include "common/Program.hh"
+#include "manta/SVLocusScanner.hh"
+#include "options/AlignmentFileOptions.hh"
+#include "options/CallOptionsDiploid.hh"
+#include "options/CallOptionsSomatic.hh"
+#include "options/CallOptionsTumor.hh"
+#include "options/ReadScannerOptions.hh"
+#include "options/SVLocusSetOptions.hh"
+
+#include <string>
+#include <vector>
+
+
+struct MantaPipelineOptions
+{
+    MantaPipelineOptions() :
+        graphOpt(SVObservationWeights::observation)  // initialize noise edge filtration parameters
+    {
+        // use the default settings of the configManta.py workflow where these differ from the individual programs:
+        scanOpt.minCandidateVariantSize = 8;
+        diploidOpt.minPassGTScore = 15;
+    }
+
+    AlignmentFileOptions alignFileOpt;
+    ReadScannerOptions scanOpt;
+    SVLocusSetOptions graphOpt;
+    CallOptionsDiploid diploidOpt;
+    CallOptionsSomatic somaticOpt;
+    CallOptionsTumor tumorOpt;
+
+    std::string referenceFilename;
+
+    /// Optional 2-bit packed reference image, used in place of the FASTA file for all reference sequence access
+    std::string packedReferenceFilename;
+
+    /// Directory for final variant output and intermediate files
+    std::string outputDirectory;
+
+    /// Regions to call in samtools format, all chromosomes are called if empty
+    std::vector<std::string> regions;
+
+    /// VCF file of known SV breakends, if set only the regions around these breakends are called
+    std::string targetVcfFilename;
+
+    /// BED file of regions, if set only these regions are called
+    std::string targetBedFilename;
+
+    pos_t targetFlankSize = 1000; ///< size of the region scanned for SV evidence on each side of a target
+
+    /// Alignment statistics from a previous run, estimated from the alignment files if empty
+    std::string statsFilename;
+
+    /// Chromosome depth from a previous run, estimated from the alignment files if empty
+    std::string chromDepthFilename;
+
+    /// If non-empty, alignment statistics and chromosome depth are reused from and added to the run cache in this
+    /// directory
+    std::string cacheDirname;
+
+    /// \return true if calling is restricted to target breakends or regions
+    bool
+    isTargeted() const
+    {
+        return ((! targetVcfFilename.empty()) || (! targetBedFilename.empty()));
+    }
+
+    unsigned threadCount = 1; ///< number of threads shared by all pipeline stages
+
+    unsigned scanSizeMb = 12; ///< max size of the genome segments scanned in parallel to build the SV locus graph
+
+    unsigned candidateBinCount = 256; ///< number of SV locus graph edge bins processed in parallel to generate candidates
+
+    unsigned minCandidateSpanningCount = 3; ///< how many spanning evidence observations are required to become a candidate?
+
+    unsigned minScoredVariantSize = 51; ///< min size for scoring and scored output following candidate generation
+
+    bool isExome = false; ///< if true, turn off the chromosome depth filters, which are not suitable for targeted sequencing
+
+    bool isDepthMap = false; ///< if true, map depth while building the SV locus graph and use the map for all later depth lookups
+};
+
+
+void
+parseMantaPipelineOptions(
+    const illumina::Program& prog,
+    int argc, char* argv[],
+    MantaPipelineOptions& opt);
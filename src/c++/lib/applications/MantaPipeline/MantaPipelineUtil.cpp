@@ -0,0 +1,418 @@
+//
+// Manta - Structural Variant and Indel Caller
+// Copyright (c) 2013-2017 Illumina, Inc.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+//
+
+/// \file
+/// \author Chris Saunders
+///
+
+#include "MantaPipelineUtil.hh"
+
+#include "blt_util/parse_util.hh"
+#include "blt_util/string_util.hh"
+#include "common/Exceptions.hh"
+
+#include <algorithm>
+#include <iostream>
+#include <sstream>
+#include <tuple>
+
+
+
+void
+getRegionSegments(
+    const std::string& chromName,
+    const pos_t beginPos,
+    const pos_t endPos,
+    const pos_t segmentSize,
+    std::vector<std::string>& segments)
+{
+    segments.clear();
+    if (endPos <= beginPos) return;
+
+    const pos_t regionSize(endPos-beginPos);
+    const pos_t segmentCount(1+((regionSize-1)/segmentSize));
+    const pos_t segmentBaseSize(regionSize/segmentCount);
+    const pos_t largeSegmentCount(regionSize%segmentCount);
+
+    pos_t segmentBeginPos(beginPos);
+    for (pos_t segmentIndex(0); segmentIndex<segmentCount; ++segmentIndex)
+    {
+        const pos_t segmentEndPos(segmentBeginPos + segmentBaseSize + ((segmentIndex<largeSegmentCount) ? 1 : 0));
+        std::ostringstream oss;
+        oss << chromName << ':' << (segmentBeginPos+1) << '-' << segmentEndPos;
+        segments.push_back(oss.str());
+        segmentBeginPos = segmentEndPos;
+    }
+}
+
+
+
+/// \return index of chromName in the alignment header
+static
+int32_t
+getTargetChromIndex(
+    const bam_header_info& header,
+    const std::string& chromName)
+{
+    const auto iter(header.chrom_to_index.find(chromName));
+    if (iter == header.chrom_to_index.end())
+    {
+        std::ostringstream oss;
+        oss << "Target chromosome '" << chromName << "' is not found in the alignment file header";
+        BOOST_THROW_EXCEPTION(illumina::common::LogicException(oss.str()));
+    }
+    return iter->second;
+}
+
+
+
+/// Add a single-base target at the one-indexed position pos
+static
+void
+addBreakendTarget(
+    const bam_header_info& header,
+    const std::string& chromName,
+    const pos_t pos,
+    std::vector<GenomeInterval>& targets)
+{
+    targets.emplace_back(getTargetChromIndex(header,chromName), pos-1, pos);
+}
+
+
+
+void
+readVcfTargets(
+    std::istream& is,
+    const bam_header_info& header,
+    std::vector<GenomeInterval>& targets)
+{
+    using namespace illumina::blt_util;
+
+    enum fields
+    {
+        CHROM,
+        POS,
+        ID,
+        REF,
+        ALT,
+        QUAL,
+        FILTER,
+        INFO,
+        SIZE
+    };
+
+    std::string line;
+    std::vector<std::string> words;
+    std::vector<std::string> infoWords;
+    while (std::getline(is,line))
+    {
+        if (line.empty() || (line[0] == '#')) continue;
+
+        split_string(line,'\t',words);
+        if (words.size() < SIZE)
+        {
+            std::ostringstream oss;
+            oss << "Unexpected format in target VCF record: '" << line << "'";
+            BOOST_THROW_EXCEPTION(illumina::common::LogicException(oss.str()));
+        }
+
+        addBreakendTarget(header, words[CHROM], parse_int_str(words[POS]), targets);
+
+        // the mate breakend of a breakend ALT allele is formatted as, eg. 'G]chr2:1000]':
+        const std::string& alt(words[ALT]);
+        const std::string::size_type mateBegin(alt.find_first_of("[]"));
+        if (mateBegin != std::string::npos)
+        {
+            const std::string::size_type mateEnd(alt.find(alt[mateBegin],mateBegin+1));
+            const std::string::size_type mateSplit(alt.rfind(':',mateEnd));
+            if ((mateEnd == std::string::npos) || (mateSplit == std::string::npos) || (mateSplit <= mateBegin))
+            {
+                std::ostringstream oss;
+                oss << "Unexpected breakend ALT allele format in target VCF record: '" << line << "'";
+                BOOST_THROW_EXCEPTION(illumina::common::LogicException(oss.str()));
+            }
+            addBreakendTarget(header, alt.substr(mateBegin+1,mateSplit-(mateBegin+1)),
+                              parse_int_str(alt.substr(mateSplit+1,mateEnd-(mateSplit+1))), targets);
+            continue;
+        }
+
+        split_string(words[INFO],';',infoWords);
+        for (const std::string& infoWord : infoWords)
+        {
+            if (infoWord.compare(0,4,"END=") != 0) continue;
+            addBreakendTarget(header, words[CHROM], parse_int_str(infoWord.substr(4)), targets);
+        }
+    }
+}
+
+
+
+void
+readBedTargets(
+    std::istream& is,
+    const bam_header_info& header,
+    std::vector<GenomeInterval>& targets)
+{
+    using namespace illumina::blt_util;
+
+    std::string line;
+    std::vector<std::string> words;
+    while (std::getline(is,line))
+    {
+        if (line.empty() || (line[0] == '#')) continue;
+        if ((line.compare(0,5,"track") == 0) || (line.compare(0,7,"browser") == 0)) continue;
+
+        split_string(line,'\t',words);
+        if (words.size() < 3)
+        {
+            std::ostringstream oss;
+            oss << "Unexpected format in target BED record: '" << line << "'";
+            BOOST_THROW_EXCEPTION(illumina::common::LogicException(oss.str()));
+        }
+
+        targets.emplace_back(getTargetChromIndex(header,words[0]), parse_int_str(words[1]), parse_int_str(words[2]));
+    }
+}
+
+
+
+void
+mergeTargets(
+    const bam_header_info& header,
+    const pos_t flankSize,
+    std::vector<GenomeInterval>& targets)
+{
+    for (GenomeInterval& target : targets)
+    {
+        const pos_t chromSize(header.chrom_data[target.tid].length);
+        target.range.set_range(std::max(0, target.range.begin_pos()-flankSize),
+                               std::min(chromSize, target.range.end_pos()+flankSize));
+    }
+
+    std::sort(targets.begin(), targets.end());
+
+    std::vector<GenomeInterval> mergedTargets;
+    for (const GenomeInterval& target : targets)
+    {
+        if ((! mergedTargets.empty()) && (mergedTargets.back().tid == target.tid) &&
+            (mergedTargets.back().range.end_pos() >= target.range.begin_pos()))
+        {
+            GenomeInterval& lastTarget(mergedTargets.back());
+            lastTarget.range.set_end_pos(std::max(lastTarget.range.end_pos(), target.range.end_pos()));
+            continue;
+        }
+        mergedTargets.push_back(target);
+    }
+    targets.swap(mergedTargets);
+}
+
+
+
+static const std::string contigHeaderPrefix("##contig=<ID=");
+
+
+
+void
+VcfRecordSorter::
+addVcf(std::istream& is)
+{
+    using namespace illumina::blt_util;
+
+    enum fields
+    {
+        CHROM,
+        POS,
+        ID,
+        REF,
+        ALT,
+        QUAL,
+        FILTER,
+        INFO,
+        SIZE
+    };
+
+    std::string line;
+    std::vector<std::string> words;
+    std::vector<std::string> infoWords;
+    while (std::getline(is,line))
+    {
+        if (line.empty()) continue;
+        line.push_back('\n');
+
+        if (line[0] == '#')
+        {
+            if (_isHeaderComplete) continue;
+            _header.push_back(line);
+            if (line.compare(0,contigHeaderPrefix.size(),contigHeaderPrefix) == 0)
+            {
+                const std::string::size_type idEnd(line.find_first_of(",>",contigHeaderPrefix.size()));
+                _chromOrder.push_back(line.substr(contigHeaderPrefix.size(),idEnd-contigHeaderPrefix.size()));
+            }
+            continue;
+        }
+
+        split_string(line.substr(0,line.size()-1),'\t',words);
+        if (words.size() < SIZE)
+        {
+            std::ostringstream oss;
+            oss << "Unexpected format in VCF record: '" << line << "'";
+            BOOST_THROW_EXCEPTION(illumina::common::LogicException(oss.str()));
+        }
+
+        _records.emplace_back();
+        VcfRecord& rec(_records.back());
+        rec.line = line;
+        rec.chrom = words[CHROM];
+        rec.pos = parse_int_str(words[POS]);
+        rec.ref = words[REF];
+        rec.alt = words[ALT];
+        rec.qual = words[QUAL];
+        rec.isPass = (words[FILTER] == "PASS");
+
+        rec.endPos = rec.pos + rec.ref.size() - 1;
+        split_string(words[INFO],';',infoWords);
+        for (const std::string& infoWord : infoWords)
+        {
+            if ((infoWord == "INV3") || (infoWord == "INV5"))
+            {
+                rec.invState = infoWord;
+            }
+            else if (infoWord.compare(0,4,"END=") == 0)
+            {
+                rec.endPos = parse_int_str(infoWord.substr(4));
+            }
+        }
+    }
+    _isHeaderComplete = true;
+}
+
+
+
+void
+VcfRecordSorter::
+sortRecords()
+{
+    for (VcfRecord& rec : _records)
+    {
+        rec.chromOrder = std::distance(_chromOrder.begin(), std::find(_chromOrder.begin(), _chromOrder.end(), rec.chrom));
+    }
+
+    std::stable_sort(_records.begin(), _records.end(),
+                     [](const VcfRecord& a, const VcfRecord& b)
+    {
+        return (std::tie(a.chromOrder, a.chrom, a.pos, a.endPos, a.ref, a.alt) <
+                std::tie(b.chromOrder, b.chrom, b.pos, b.endPos, b.ref, b.alt));
+    });
+}
+
+
+
+/// \return true if an assembled insertion allele is long enough to be a duplicate of an imprecise insertion
+static
+bool
+isLongAssembledInsertion(const std::string& alt)
+{
+    static const unsigned minInsertionAltSize(80);
+    if (alt.empty() || (alt[0] == '<')) return false;
+    return (alt.size() >= minInsertionAltSize);
+}
+
+
+
+bool
+VcfRecordSorter::
+isDuplicateRecord(
+    const VcfRecord& rec1,
+    const VcfRecord& rec2)
+{
+    if ((rec1.chrom != rec2.chrom) || (rec1.pos != rec2.pos) || (rec1.ref != rec2.ref) ||
+        (rec1.endPos != rec2.endPos) || (rec1.invState != rec2.invState))
+    {
+        return false;
+    }
+    if (rec1.alt == rec2.alt) return true;
+
+    // an imprecise insertion duplicates an assembled insertion at the same position:
+    static const std::string impreciseInsertionAlt("<INS>");
+    if (rec1.alt == impreciseInsertionAlt) return isLongAssembledInsertion(rec2.alt);
+    if (rec2.alt == impreciseInsertionAlt) return isLongAssembledInsertion(rec1.alt);
+    return false;
+}
+
+
+
+void
+VcfRecordSorter::
+write(std::ostream& os)
+{
+    sortRecords();
+
+    for (const std::string& line : _header)
+    {
+        os << line;
+    }
+
+    if (! _isResolveDuplicates)
+    {
+        for (const VcfRecord& rec : _records)
+        {
+            os << rec.line;
+        }
+        return;
+    }
+
+    using namespace illumina::blt_util;
+
+    const unsigned recordCount(_records.size());
+    unsigned setBeginIndex(0);
+    while (setBeginIndex < recordCount)
+    {
+        // find the end of the set of duplicate records, where each record is compared to its predecessor:
+        unsigned setEndIndex(setBeginIndex+1);
+        for (; setEndIndex<recordCount; ++setEndIndex)
+        {
+            if (! isDuplicateRecord(_records[setEndIndex-1], _records[setEndIndex])) break;
+        }
+
+        unsigned bestIndex(setBeginIndex);
+        double bestQual(0);
+        bool bestIsPass(false);
+        bool bestIsAssembled(false);
+        for (unsigned recordIndex(setBeginIndex); recordIndex<setEndIndex; ++recordIndex)
+        {
+            const VcfRecord& rec(_records[recordIndex]);
+            const double qual((rec.qual == ".") ? 0. : parse_double_str(rec.qual));
+            const bool isAssembled(rec.alt.empty() || (rec.alt[0] != '<'));
+
+            const bool isNewPass((! bestIsPass) && rec.isPass);
+            const bool isHighQual((bestIsPass == rec.isPass) && (qual > bestQual));
+            const bool isNewAssembled((! bestIsAssembled) && isAssembled);
+            if (isNewPass || isHighQual || isNewAssembled)
+            {
+                bestIndex = recordIndex;
+                bestQual = qual;
+                bestIsPass = rec.isPass;
+                bestIsAssembled = isAssembled;
+            }
+        }
+        os << _records[bestIndex].line;
+
+        setBeginIndex = setEndIndex;
+    }
+}
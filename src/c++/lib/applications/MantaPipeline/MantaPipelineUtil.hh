@@ -0,0 +1,135 @@
+//
+// Manta - Structural Variant and Indel Caller
+// Copyright (c) 2013-2017 Illumina, Inc.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+//
+
+/// \file
+/// \author Chris Saunders
+///
+
+#pragma once
+
+#include "blt_util/blt_types.hh"
+#include "htsapi/bam_header_info.hh"
+#include "svgraph/GenomeInterval.hh"
+
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+
+/// \brief Divide a region into samtools formatted segments no larger than segmentSize
+///
+/// Segment sizes are distributed as evenly as possible, matching the genome segments of the configManta.py workflow.
+///
+/// \param[in] beginPos zero-indexed region start
+/// \param[in] endPos zero-indexed, open region end
+void
+getRegionSegments(
+    const std::string& chromName,
+    const pos_t beginPos,
+    const pos_t endPos,
+    const pos_t segmentSize,
+    std::vector<std::string>& segments);
+
+
+/// \brief Add a target for each breakend in a VCF file of known SVs
+///
+/// Each record adds a single-base target at POS, and a second target at END or at the mate breakend position of a
+/// breakend ALT allele. It is an error for a target chromosome to be missing from the alignment header.
+void
+readVcfTargets(
+    std::istream& is,
+    const bam_header_info& header,
+    std::vector<GenomeInterval>& targets);
+
+
+/// \brief Add a target for each region in a BED file
+///
+/// It is an error for a target chromosome to be missing from the alignment header.
+void
+readBedTargets(
+    std::istream& is,
+    const bam_header_info& header,
+    std::vector<GenomeInterval>& targets);
+
+
+/// \brief Extend targets by flankSize on each side, then sort and merge all overlapping targets
+///
+/// Extended targets are clipped to the chromosome bounds given in the alignment header.
+void
+mergeTargets(
+    const bam_header_info& header,
+    const pos_t flankSize,
+    std::vector<GenomeInterval>& targets);
+
+
+/// \brief Merge and sort the VCF records from multiple files
+///
+/// This matches the sorting and duplicate resolution of the workflow's sortVcf.py script. Records are sorted on
+/// chromosome order in the VCF header, position, end position, REF and ALT. If duplicate resolution is enabled, only
+/// the best record from each set of equivalent records is written, preferring records which pass all filters, then
+/// records with higher quality, then assembled records.
+///
+struct VcfRecordSorter
+{
+    explicit
+    VcfRecordSorter(const bool isResolveDuplicates) :
+        _isResolveDuplicates(isResolveDuplicates)
+    {}
+
+    /// \brief Add all records from a VCF stream, the header is taken from the first stream only
+    void
+    addVcf(std::istream& is);
+
+    /// \brief Write the header and all sorted records
+    void
+    write(std::ostream& os);
+
+private:
+    struct VcfRecord
+    {
+        std::string line;
+        std::string chrom;
+        int pos = 0;
+        int endPos = 0;
+        std::string ref;
+        std::string alt;
+        std::string qual;
+        std::string invState;
+        bool isPass = false;
+
+        /// index of chrom in the VCF header contig list, or the header contig count if not found
+        unsigned chromOrder = 0;
+    };
+
+    /// \return true if rec2 should be resolved with rec1 as a duplicate record
+    static
+    bool
+    isDuplicateRecord(
+        const VcfRecord& rec1,
+        const VcfRecord& rec2);
+
+    void
+    sortRecords();
+
+    bool _isResolveDuplicates;
+    bool _isHeaderComplete = false;
+    std::vector<std::string> _header;
+    std::vector<std::string> _chromOrder;
+    std::vector<VcfRecord> _records;
+};
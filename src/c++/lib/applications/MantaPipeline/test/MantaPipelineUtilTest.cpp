@@ -0,0 +1,183 @@
+//
+// Manta - Structural Variant and Indel Caller
+// Copyright (c) 2013-2017 Illumina, Inc.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+//
+
+#include "boost/test/unit_test.hpp"
+
+#include "applications/MantaPipeline/MantaPipelineUtil.hh"
+#include "common/Exceptions.hh"
+
+#include <sstream>
+
+
+BOOST_AUTO_TEST_SUITE( test_MantaPipelineUtil )
+
+
+// Test that segment sizes are distributed evenly, matching the workflow segments
+BOOST_AUTO_TEST_CASE( test_getRegionSegments )
+{
+    std::vector<std::string> segments;
+    getRegionSegments("chr1", 0, 25, 10, segments);
+    BOOST_REQUIRE_EQUAL(segments.size(), 3u);
+    BOOST_REQUIRE_EQUAL(segments[0], "chr1:1-9");
+    BOOST_REQUIRE_EQUAL(segments[1], "chr1:10-17");
+    BOOST_REQUIRE_EQUAL(segments[2], "chr1:18-25");
+
+    getRegionSegments("chr2", 100, 110, 10, segments);
+    BOOST_REQUIRE_EQUAL(segments.size(), 1u);
+    BOOST_REQUIRE_EQUAL(segments[0], "chr2:101-110");
+
+    getRegionSegments("chr2", 100, 100, 10, segments);
+    BOOST_REQUIRE(segments.empty());
+}
+
+
+static const char* testHeader =
+    "##fileformat=VCFv4.1\n"
+    "##contig=<ID=chrB,length=1000>\n"
+    "##contig=<ID=chrA,length=1000>\n"
+    "#CHROM\tPOS\tID\tREF\tALT\tQUAL\tFILTER\tINFO\n";
+
+
+// Test that records from multiple files are sorted in header chromosome order
+BOOST_AUTO_TEST_CASE( test_VcfRecordSorterOrder )
+{
+    std::istringstream vcf1(std::string(testHeader) +
+                            "chrA\t10\tr1\tA\t<DEL>\t20\tPASS\tEND=100;SVTYPE=DEL\n"
+                            "chrB\t50\tr2\tA\t<DEL>\t20\tPASS\tEND=100;SVTYPE=DEL\n");
+    std::istringstream vcf2(std::string(testHeader) +
+                            "chrA\t10\tr3\tA\t<DEL>\t20\tPASS\tEND=90;SVTYPE=DEL\n"
+                            "chrB\t5\tr4\tA\t<DEL>\t20\tPASS\tEND=100;SVTYPE=DEL\n");
+
+    VcfRecordSorter sorter(false);
+    sorter.addVcf(vcf1);
+    sorter.addVcf(vcf2);
+
+    std::ostringstream oss;
+    sorter.write(oss);
+
+    const std::string expect(std::string(testHeader) +
+                             "chrB\t5\tr4\tA\t<DEL>\t20\tPASS\tEND=100;SVTYPE=DEL\n"
+                             "chrB\t50\tr2\tA\t<DEL>\t20\tPASS\tEND=100;SVTYPE=DEL\n"
+                             "chrA\t10\tr3\tA\t<DEL>\t20\tPASS\tEND=90;SVTYPE=DEL\n"
+                             "chrA\t10\tr1\tA\t<DEL>\t20\tPASS\tEND=100;SVTYPE=DEL\n");
+    BOOST_REQUIRE_EQUAL(oss.str(), expect);
+}
+
+
+// Test that the best record is kept from each set of duplicates
+BOOST_AUTO_TEST_CASE( test_VcfRecordSorterDuplicates )
+{
+    const std::string longInsertion(std::string("A") + std::string(100,'G'));
+    std::istringstream vcf1(std::string(testHeader) +
+                            "chrB\t10\tr1\tA\t<DEL>\t40\tMinQUAL\tEND=100;SVTYPE=DEL\n"
+                            "chrB\t10\tr2\tA\t<DEL>\t30\tPASS\tEND=100;SVTYPE=DEL\n"
+                            "chrB\t200\tr3\tA\t<INS>\t50\tPASS\tSVTYPE=INS\n");
+    std::istringstream vcf2(std::string(testHeader) +
+                            "chrB\t10\tr4\tA\t<DEL>\t35\tPASS\tEND=100;SVTYPE=DEL\n"
+                            "chrB\t10\tr5\tA\t<DEL>\t45\tPASS\tEND=100;SVTYPE=DEL;INV3\n"
+                            "chrB\t200\tr6\tA\t" + longInsertion + "\t20\tPASS\tSVTYPE=INS\n");
+
+    // without duplicate resolution all records are retained:
+    {
+        std::istringstream vcf1Copy(vcf1.str());
+        std::istringstream vcf2Copy(vcf2.str());
+        VcfRecordSorter sorter(false);
+        sorter.addVcf(vcf1Copy);
+        sorter.addVcf(vcf2Copy);
+        std::ostringstream oss;
+        sorter.write(oss);
+        BOOST_REQUIRE(oss.str().find("\tr1\t") != std::string::npos);
+        BOOST_REQUIRE(oss.str().find("\tr3\t") != std::string::npos);
+    }
+
+    VcfRecordSorter sorter(true);
+    sorter.addVcf(vcf1);
+    sorter.addVcf(vcf2);
+
+    std::ostringstream oss;
+    sorter.write(oss);
+
+    const std::string expect(std::string(testHeader) +
+                             "chrB\t10\tr4\tA\t<DEL>\t35\tPASS\tEND=100;SVTYPE=DEL\n"
+                             "chrB\t10\tr5\tA\t<DEL>\t45\tPASS\tEND=100;SVTYPE=DEL;INV3\n"
+                             "chrB\t200\tr6\tA\t" + longInsertion + "\t20\tPASS\tSVTYPE=INS\n");
+    BOOST_REQUIRE_EQUAL(oss.str(), expect);
+}
+
+
+static
+bam_header_info
+getTargetTestHeader()
+{
+    bam_header_info header;
+    header.chrom_data.emplace_back("chrA",1000);
+    header.chrom_data.emplace_back("chrB",1000);
+    header.chrom_to_index["chrA"] = 0;
+    header.chrom_to_index["chrB"] = 1;
+    return header;
+}
+
+
+
+// Test that breakend targets are read from POS, END and breakend ALT alleles
+BOOST_AUTO_TEST_CASE( test_readVcfTargets )
+{
+    const bam_header_info header(getTargetTestHeader());
+    std::istringstream vcf(std::string(testHeader) +
+                           "chrA\t10\tr1\tA\t<DEL>\t20\tPASS\tEND=100;SVTYPE=DEL\n"
+                           "chrB\t50\tr2\tA\tA]chrA:200]\t20\tPASS\tSVTYPE=BND\n");
+
+    std::vector<GenomeInterval> targets;
+    readVcfTargets(vcf, header, targets);
+    BOOST_REQUIRE_EQUAL(targets.size(), 4u);
+    BOOST_REQUIRE_EQUAL(targets[0], GenomeInterval(0,9,10));
+    BOOST_REQUIRE_EQUAL(targets[1], GenomeInterval(0,99,100));
+    BOOST_REQUIRE_EQUAL(targets[2], GenomeInterval(1,49,50));
+    BOOST_REQUIRE_EQUAL(targets[3], GenomeInterval(0,199,200));
+
+    std::istringstream badVcf(std::string(testHeader) +
+                              "chrC\t10\tr1\tA\t<DEL>\t20\tPASS\tEND=100;SVTYPE=DEL\n");
+    BOOST_REQUIRE_THROW(readVcfTargets(badVcf, header, targets), illumina::common::ExceptionData);
+}
+
+
+
+// Test that targets are extended, clipped to chromosome bounds and merged
+BOOST_AUTO_TEST_CASE( test_mergeTargets )
+{
+    const bam_header_info header(getTargetTestHeader());
+    std::istringstream bed("track name=test\n"
+                           "chrB\t500\t600\n"
+                           "chrA\t100\t200\n"
+                           "chrA\t950\t990\n"
+                           "chrA\t250\t300\n");
+
+    std::vector<GenomeInterval> targets;
+    readBedTargets(bed, header, targets);
+    BOOST_REQUIRE_EQUAL(targets.size(), 4u);
+
+    mergeTargets(header, 50, targets);
+    BOOST_REQUIRE_EQUAL(targets.size(), 3u);
+    BOOST_REQUIRE_EQUAL(targets[0], GenomeInterval(0,50,350));
+    BOOST_REQUIRE_EQUAL(targets[1], GenomeInterval(0,900,1000));
+    BOOST_REQUIRE_EQUAL(targets[2], GenomeInterval(1,450,650));
+}
+
+
+BOOST_AUTO_TEST_SUITE_END()
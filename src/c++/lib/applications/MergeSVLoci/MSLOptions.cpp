@@ -49,6 +49,40 @@ usage(
 
 
 
+/// read file names from a user-defined file, one per line
+static
+void
+readFileList(
+    const illumina::Program& prog,
+    const boost::program_options::options_description& visible,
+    const std::string& listFilename,
+    const char* listLabel,
+    std::vector<std::string>& filenames)
+{
+    std::ifstream parFile(listFilename.c_str(), std::ios_base::in | std::ios_base::binary);
+    if (! parFile.good())
+    {
+        std::ostringstream osfl;
+        osfl << listLabel << " does not exist: '" << listFilename << "'";
+        usage(log_os, prog, visible, osfl.str().c_str());
+    }
+
+    std::string lineIn;
+    while (getline(parFile, lineIn))
+    {
+        if (lineIn.size() == 0) continue;
+        const unsigned sm1(lineIn.size()-1);
+        if (lineIn[sm1] == '\r')
+        {
+            if (sm1 == 0) continue;
+            lineIn.resize(sm1);
+        }
+        filenames.push_back(lineIn);
+    }
+}
+
+
+
 void
 parseMSLOptions(const illumina::Program& prog,
                 int argc, char* argv[],
@@ -63,6 +97,20 @@ parseMSLOptions(const illumina::Program& prog,
      "file listing all input sv locus graph files, one filename per line (specified only once)")
     ("output-file", po::value(&opt.outputFilename),
      "merged output sv locus graph file")
+    ("evidence-index-file", po::value(&opt.evidenceIndexFilename),
+     "input sv evidence read index file (may be specified multiple times)")
+    ("evidence-index-file-list", po::value(&opt.evidenceIndexFilenameList),
+     "file listing all input sv evidence read index files, one filename per line (specified only once)")
+    ("evidence-index-output-file", po::value(&opt.evidenceIndexOutputFilename),
+     "merged output sv evidence read index file, required if any evidence read index input is given")
+    ("depth-map-file", po::value(&opt.depthMapFilename),
+     "input depth map file (may be specified multiple times)")
+    ("depth-map-file-list", po::value(&opt.depthMapFilenameList),
+     "file listing all input depth map files, one filename per line (specified only once)")
+    ("depth-map-output-file", po::value(&opt.depthMapOutputFilename),
+     "merged output depth map file, required if any depth map input is given")
+    ("threads", po::value(&opt.threadCount)->default_value(opt.threadCount),
+     "number of threads used to clean the merged graph")
     ("verbose", po::value(&opt.isVerbose)->zero_tokens(),
      "provide additional progress logging");
 
@@ -96,26 +144,18 @@ parseMSLOptions(const illumina::Program& prog,
     //read graph file names from a user-defined file
     if (! opt.graphFilenameList.empty())
     {
-        std::ifstream parFile(opt.graphFilenameList.c_str(), std::ios_base::in | std::ios_base::binary);
-        if (! parFile.good())
-        {
-            std::ostringstream osfl;
-            osfl << "SV locus graph file list does not exist: '" << opt.graphFilenameList << "'";
-            usage(log_os, prog, visible, osfl.str().c_str());
-        }
+        readFileList(prog, visible, opt.graphFilenameList, "SV locus graph file list", opt.graphFilename);
+    }
 
-        std::string lineIn;
-        while (getline(parFile, lineIn))
-        {
-            if (lineIn.size() == 0) continue;
-            const unsigned sm1(lineIn.size()-1);
-            if (lineIn[sm1] == '\r')
-            {
-                if (sm1 == 0) continue;
-                lineIn.resize(sm1);
-            }
-            opt.graphFilename.push_back(lineIn);
-        }
+    if (! opt.evidenceIndexFilenameList.empty())
+    {
+        readFileList(prog, visible, opt.evidenceIndexFilenameList, "SV evidence read index file list",
+                     opt.evidenceIndexFilename);
+    }
+
+    if (! opt.depthMapFilenameList.empty())
+    {
+        readFileList(prog, visible, opt.depthMapFilenameList, "depth map file list", opt.depthMapFilename);
     }
 
     // fast check of config state:
@@ -146,5 +186,33 @@ parseMSLOptions(const illumina::Program& prog,
     {
         usage(log_os,prog,visible, "Must specify a graph output file");
     }
+
+    for (const std::string& indexFilename : opt.evidenceIndexFilename)
+    {
+        if (! boost::filesystem::exists(indexFilename))
+        {
+            std::ostringstream oss;
+            oss << "SV evidence read index file does not exist: '" << indexFilename << "'";
+            usage(log_os,prog,visible,oss.str().c_str());
+        }
+    }
+    if (opt.evidenceIndexFilename.empty() != opt.evidenceIndexOutputFilename.empty())
+    {
+        usage(log_os,prog,visible, "Evidence read index input and output files must be specified together");
+    }
+
+    for (const std::string& depthMapFilename : opt.depthMapFilename)
+    {
+        if (! boost::filesystem::exists(depthMapFilename))
+        {
+            std::ostringstream oss;
+            oss << "Depth map file does not exist: '" << depthMapFilename << "'";
+            usage(log_os,prog,visible,oss.str().c_str());
+        }
+    }
+    if (opt.depthMapFilename.empty() != opt.depthMapOutputFilename.empty())
+    {
+        usage(log_os,prog,visible, "Depth map input and output files must be specified together");
+    }
 }
 
@@ -32,12 +32,27 @@
 struct MSLOptions
 {
     MSLOptions() :
+        threadCount(1),
         isVerbose(false)
     {}
 
     std::vector<std::string> graphFilename;
     std::string graphFilenameList;
     std::string outputFilename;
+
+    /// optional SV evidence read indices to merge in parallel with the graphs
+    std::vector<std::string> evidenceIndexFilename;
+    std::string evidenceIndexFilenameList;
+    std::string evidenceIndexOutputFilename;
+
+    /// optional depth maps to merge in parallel with the graphs
+    std::vector<std::string> depthMapFilename;
+    std::string depthMapFilenameList;
+    std::string depthMapOutputFilename;
+
+    /// number of threads used to clean the merged graph
+    unsigned threadCount;
+
     bool isVerbose;
 };
 
@@ -24,8 +24,10 @@
 #include "MergeSVLoci.hh"
 #include "MSLOptions.hh"
 
+#include "blt_util/depth_pyramid.hh"
 #include "blt_util/log.hh"
 #include "common/OutStream.hh"
+#include "manta/SVEvidenceReadIndex.hh"
 #include "svgraph/SVLocusSet.hh"
 
 
@@ -67,7 +69,7 @@ runMSL(const MSLOptions& opt)
         }
     }
 
-    mergedSet.finalize();
+    mergedSet.finalize(opt.threadCount);
     if (opt.isVerbose)
     {
         log_os << "INFO: Finished cleaning merged graph.\n";
@@ -75,6 +77,39 @@ runMSL(const MSLOptions& opt)
     timer.stop();
     mergedSet.setMergeTime(timer.getTimes());
     mergedSet.save(opt.outputFilename.c_str());
+
+    if (! opt.evidenceIndexFilename.empty())
+    {
+        SVEvidenceReadIndex mergedIndex;
+        for (const std::string& indexFile : opt.evidenceIndexFilename)
+        {
+            SVEvidenceReadIndex inputIndex;
+            inputIndex.load(indexFile.c_str());
+            mergedIndex.merge(inputIndex);
+        }
+        mergedIndex.finalize();
+        mergedIndex.save(opt.evidenceIndexOutputFilename.c_str());
+
+        if (opt.isVerbose)
+        {
+            log_os << "INFO: Finished merging evidence read indices.\n";
+        }
+    }
+
+    if (! opt.depthMapFilename.empty())
+    {
+        depth_pyramid_builder mergedDepthMap;
+        for (const std::string& depthMapFile : opt.depthMapFilename)
+        {
+            mergedDepthMap.merge(depth_pyramid(depthMapFile));
+        }
+        mergedDepthMap.write(opt.depthMapOutputFilename);
+
+        if (opt.isVerbose)
+        {
+            log_os << "INFO: Finished merging depth maps.\n";
+        }
+    }
 }
 
 
@@ -0,0 +1,370 @@
+//
+// Manta - Structural Variant and Indel Caller
+// Copyright (c) 2013-2017 Illumina, Inc.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+//
+
+/// \file
+/// \author Chris Saunders
+///
+
+#include "PostProcessSVCalls.hh"
+#include "PostProcessSVCallsUtil.hh"
+
+#include "blt_util/string_util.hh"
+#include "common/Exceptions.hh"
+#include "common/OutStream.hh"
+#include "htsapi/bgzf_dumper.hh"
+#include "htsapi/vcf_streamer.hh"
+#include "htsapi/vcf_util.hh"
+
+#include <iostream>
+#include <map>
+#include <memory>
+#include <sstream>
+
+
+
+/// \brief VCF output which is either plain text, or BGZF compressed and tabix indexed when the output is closed
+struct SVCallWriter
+{
+    SVCallWriter(
+        const std::string& filename,
+        const unsigned threadCount) :
+        _filename(filename)
+    {
+        static const std::string compressedSuffix(".gz");
+        const bool isCompressed((filename.size() > compressedSuffix.size()) &&
+                                (filename.compare(filename.size()-compressedSuffix.size(),
+                                                  compressedSuffix.size(), compressedSuffix) == 0));
+        if (isCompressed)
+        {
+            _bgzfPtr.reset(new bgzf_dumper(filename.c_str(), threadCount));
+        }
+        else
+        {
+            _outStreamPtr.reset(new OutStream(filename));
+        }
+    }
+
+    void
+    writeLine(const std::string& line)
+    {
+        if (_bgzfPtr)
+        {
+            _bgzfPtr->put_text(line);
+            _bgzfPtr->put_text("\n");
+        }
+        else
+        {
+            _outStreamPtr->getStream() << line << '\n';
+        }
+    }
+
+    /// \brief Complete all output, including the index of BGZF output
+    void
+    close()
+    {
+        if (_bgzfPtr)
+        {
+            _bgzfPtr->close();
+            _bgzfPtr.reset();
+            build_vcf_tabix_index(_filename.c_str());
+        }
+        _outStreamPtr.reset();
+    }
+
+private:
+    std::string _filename;
+    std::unique_ptr<bgzf_dumper> _bgzfPtr;
+    std::unique_ptr<OutStream> _outStreamPtr;
+};
+
+
+
+/// \brief Insert newLine into the header before the first line starting with prefix
+///
+/// Nothing is inserted if no line starts with prefix, so a header without the expected section is left unchanged.
+static
+void
+insertHeaderLine(
+    const std::string& prefix,
+    const std::string& newLine,
+    std::vector<std::string>& headerLines)
+{
+    for (auto iter(headerLines.begin()); iter != headerLines.end(); ++iter)
+    {
+        if (iter->compare(0,prefix.size(),prefix) != 0) continue;
+        headerLines.insert(iter, newLine);
+        return;
+    }
+}
+
+
+
+/// \brief De novo scoring state for a trio, matching the workflow's denovo_scoring.py script
+struct DenovoScorer
+{
+    DenovoScorer(
+        const PostProcessSVCallsOptions& opt,
+        const vcf_streamer& vcfs)
+    {
+        const unsigned sampleCount(vcfs.getSampleCount());
+        for (unsigned sampleIndex(0); sampleIndex<sampleCount; ++sampleIndex)
+        {
+            const std::string sampleName(vcfs.getSampleName(sampleIndex));
+            const unsigned wordIndex(VCFID::SAMPLE + sampleIndex);
+            if (sampleName == opt.probandSampleName) _probandIndex = wordIndex;
+            else if (sampleName == opt.fatherSampleName) _fatherIndex = wordIndex;
+            else if (sampleName == opt.motherSampleName) _motherIndex = wordIndex;
+        }
+
+        for (const unsigned index : { _probandIndex, _fatherIndex, _motherIndex })
+        {
+            if (index != 0) continue;
+            std::ostringstream oss;
+            oss << "Can't find all trio sample names in VCF file: '" << opt.vcfFilename << "'";
+            BOOST_THROW_EXCEPTION(illumina::common::LogicException(oss.str()));
+        }
+    }
+
+    /// \brief Add the de novo quality of the proband genotype to a tab-split VCF record
+    void
+    scoreRecord(std::vector<std::string>& words)
+    {
+        unsigned gtIndex(0);
+        if (! get_format_key_index(words[VCFID::FORMAT].c_str(),"GT",gtIndex))
+        {
+            std::ostringstream oss;
+            oss << "No GT field in SV VCF record at: '" << words[VCFID::CHROM] << ":" << words[VCFID::POS] << "'";
+            BOOST_THROW_EXCEPTION(illumina::common::LogicException(oss.str()));
+        }
+
+        std::vector<std::string> sampleWords;
+        auto getGT = [&](const unsigned index)
+        {
+            split_string(words.at(index),':',sampleWords);
+            return sampleWords.at(gtIndex);
+        };
+        const std::string probandGT(getGT(_probandIndex));
+        const std::string fatherGT(getGT(_fatherIndex));
+        const std::string motherGT(getGT(_motherIndex));
+
+        const bool isConsistent(isMendelianConsistentGenotype(probandGT, fatherGT, motherGT));
+        if (! isConsistent)
+        {
+            std::string filter(words[VCFID::FILT]);
+            for (char& c : filter) c = toupper(c);
+            if (filter == "PASS") _passedCount++;
+            else                 _filteredCount++;
+            _genotypeCounts[probandGT + "-" + fatherGT + "-" + motherGT]++;
+        }
+
+        words[VCFID::FORMAT] += ":DQ";
+        const unsigned wordCount(words.size());
+        for (unsigned wordIndex(VCFID::SAMPLE); wordIndex<wordCount; ++wordIndex)
+        {
+            if (wordIndex == _probandIndex)
+            {
+                words[wordIndex] += (isConsistent ? ":0" : ":60");
+            }
+            else
+            {
+                words[wordIndex] += ":.";
+            }
+        }
+    }
+
+    void
+    writeStats(std::ostream& os) const
+    {
+        os << "# of passed SVs: " << _passedCount << "\n";
+        os << "# of filtered SVs: " << _filteredCount << "\n";
+        os << "probandGT-fatherGT-motherGT\tcounts\n";
+        for (const auto& value : _genotypeCounts)
+        {
+            os << value.first << "\t" << value.second << "\n";
+        }
+    }
+
+private:
+    unsigned _probandIndex = 0;
+    unsigned _fatherIndex = 0;
+    unsigned _motherIndex = 0;
+
+    unsigned _passedCount = 0;
+    unsigned _filteredCount = 0;
+    std::map<std::string,unsigned> _genotypeCounts;
+};
+
+
+
+static
+std::string
+joinWords(const std::vector<std::string>& words)
+{
+    std::string line;
+    for (const std::string& word : words)
+    {
+        if (! line.empty()) line.push_back('\t');
+        line += word;
+    }
+    return line;
+}
+
+
+
+void
+runPostProcessSVCalls(const PostProcessSVCallsOptions& opt)
+{
+    // the input header is read separately from the records to reproduce it exactly:
+    std::vector<std::string> inputHeaderLines;
+    read_vcf_header_lines(opt.vcfFilename.c_str(), inputHeaderLines);
+
+    vcf_streamer vcfs(opt.vcfFilename.c_str(), nullptr, true, false);
+
+    std::unique_ptr<DenovoScorer> denovoPtr;
+    if (opt.isDenovo())
+    {
+        denovoPtr.reset(new DenovoScorer(opt, vcfs));
+    }
+
+    std::vector<std::string> headerLines(inputHeaderLines);
+    if (opt.isPloidyFilter)
+    {
+        insertHeaderLine("##FILTER", "##FILTER=<ID=Ploidy,Description=\"For DEL & DUP variants, the genotypes of overlapping variants (with similar size) are inconsistent with diploid expectation\">", headerLines);
+    }
+    if (denovoPtr)
+    {
+        insertHeaderLine("##FORMAT", "##FORMAT=<ID=DQ,Number=1,Type=Integer,Description=\"De novo quality score\">", headerLines);
+    }
+
+    SVCallWriter writer(opt.outputFilename, opt.threadCount);
+    for (const std::string& line : headerLines)
+    {
+        writer.writeLine(line);
+    }
+
+    std::unique_ptr<SVCallWriter> smallIndelWriterPtr;
+    if (! opt.smallIndelOutputFilename.empty())
+    {
+        smallIndelWriterPtr.reset(new SVCallWriter(opt.smallIndelOutputFilename, opt.threadCount));
+        for (const std::string& line : inputHeaderLines)
+        {
+            smallIndelWriterPtr->writeLine(line);
+        }
+    }
+
+    // records from the current chromosome are held until the chromosome is complete if the ploidy filter is enabled:
+    std::string chrom;
+    std::vector<std::string> chromLines;
+    std::vector<PloidyFilterRecord> chromPloidyRecords;
+    std::set<std::pair<pos_t,pos_t>> filteredSites;
+
+    std::vector<std::string> words;
+    auto writeRecord = [&](const std::string& line)
+    {
+        if ((! opt.isPloidyFilter) && (! denovoPtr))
+        {
+            writer.writeLine(line);
+            return;
+        }
+
+        split_string(line,'\t',words);
+        if (opt.isPloidyFilter)
+        {
+            bool isPloidyFilterCandidate(false);
+            PloidyFilterRecord ploidyRecord;
+            getPloidyFilterRecord(words, isPloidyFilterCandidate, ploidyRecord);
+            if (isPloidyFilterCandidate && filteredSites.count(std::make_pair(ploidyRecord.pos, ploidyRecord.endPos)))
+            {
+                words[VCFID::FILT] = "Ploidy";
+            }
+        }
+        if (denovoPtr)
+        {
+            denovoPtr->scoreRecord(words);
+        }
+        writer.writeLine(joinWords(words));
+    };
+
+    auto processChrom = [&]()
+    {
+        filteredSites.clear();
+        findPloidyFilteredSites(chromPloidyRecords, filteredSites);
+        for (const std::string& line : chromLines)
+        {
+            writeRecord(line);
+        }
+        chromLines.clear();
+        chromPloidyRecords.clear();
+    };
+
+    while (vcfs.next())
+    {
+        const vcf_record& rec(*vcfs.get_record_ptr());
+        const std::string line(rec.line);
+
+        if (smallIndelWriterPtr && isSmallIndelCandidate(rec, opt.maxSmallIndelSize))
+        {
+            smallIndelWriterPtr->writeLine(line);
+        }
+
+        if (! opt.isPloidyFilter)
+        {
+            writeRecord(line);
+            continue;
+        }
+
+        if (rec.chrom != chrom)
+        {
+            processChrom();
+            chrom = rec.chrom;
+        }
+
+        split_string(line,'\t',words);
+        bool isPloidyFilterCandidate(false);
+        PloidyFilterRecord ploidyRecord;
+        getPloidyFilterRecord(words, isPloidyFilterCandidate, ploidyRecord);
+        if (isPloidyFilterCandidate)
+        {
+            chromPloidyRecords.push_back(ploidyRecord);
+        }
+        chromLines.push_back(line);
+    }
+    processChrom();
+
+    writer.close();
+    if (smallIndelWriterPtr) smallIndelWriterPtr->close();
+
+    if (denovoPtr)
+    {
+        OutStream outs(opt.denovoStatsFilename);
+        denovoPtr->writeStats(outs.getStream());
+    }
+}
+
+
+
+void
+PostProcessSVCalls::
+runInternal(int argc, char* argv[]) const
+{
+    PostProcessSVCallsOptions opt;
+
+    parsePostProcessSVCallsOptions(*this,argc,argv,opt);
+    runPostProcessSVCalls(opt);
+}
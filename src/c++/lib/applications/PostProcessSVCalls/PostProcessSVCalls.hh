@@ -0,0 +1,51 @@
+//
+// Manta - Structural Variant and Indel Caller
+// Copyright (c) 2013-2017 Illumina, Inc.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+//
+
+/// \file
+/// \author Chris Saunders
+///
+
+#pragma once
+
+#include "PostProcessSVCallsOptions.hh"
+
+#include "common/Program.hh"
+
+
+/// filter, annotate and index sorted SV calls
+///
+struct PostProcessSVCalls : public illumina::Program
+{
+    const char*
+    name() const
+    {
+        return "PostProcessSVCalls";
+    }
+
+    void
+    runInternal(int argc, char* argv[]) const;
+};
+
+
+/// \brief Apply all post-processing steps selected in opt to a sorted SV VCF in a single streaming pass
+///
+/// Input records are held in memory one chromosome at a time when the ploidy filter is enabled, and are otherwise
+/// written as soon as they are read.
+void
+runPostProcessSVCalls(const PostProcessSVCallsOptions& opt);
@@ -0,0 +1,142 @@
+//
+// Manta - Structural Variant and Indel Caller
+// Copyright (c) 2013-2017 Illumina, Inc.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+//
+
+/// \file
+/// \author Chris Saunders
+///
+
+#include "PostProcessSVCallsOptions.hh"
+
+#include "blt_util/log.hh"
+#include "common/ProgramUtil.hh"
+#include "options/optionsUtil.hh"
+
+#include "boost/program_options.hpp"
+
+#include <iostream>
+
+
+
+static
+void
+usage(
+    std::ostream& os,
+    const illumina::Program& prog,
+    const boost::program_options::options_description& visible,
+    const char* msg = nullptr)
+{
+    usage(os, prog, visible, "filter, annotate and index sorted SV calls in a single pass", "", msg);
+}
+
+
+
+void
+parsePostProcessSVCallsOptions(
+    const illumina::Program& prog,
+    int argc, char* argv[],
+    PostProcessSVCallsOptions& opt)
+{
+    namespace po = boost::program_options;
+    po::options_description req("configuration");
+    req.add_options()
+    ("vcf-file", po::value(&opt.vcfFilename),
+     "coordinate sorted SV VCF file (required)")
+    ("output-file", po::value(&opt.outputFilename),
+     "write processed SV VCF to file, output is BGZF compressed and tabix indexed if the filename ends in '.gz' (required)")
+    ("ploidy-filter", po::value(&opt.isPloidyFilter)->zero_tokens(),
+     "filter overlapping DEL and DUP records with genotypes which can't be resolved to two haplotypes")
+    ("proband", po::value(&opt.probandSampleName),
+     "proband sample name, set to annotate the de novo quality of each SV in a trio")
+    ("father", po::value(&opt.fatherSampleName),
+     "father sample name for de novo scoring")
+    ("mother", po::value(&opt.motherSampleName),
+     "mother sample name for de novo scoring")
+    ("denovo-stats-file", po::value(&opt.denovoStatsFilename),
+     "write de novo scoring summary to file (required for de novo scoring)")
+    ("small-indel-output-file", po::value(&opt.smallIndelOutputFilename),
+     "write the simple indel candidates in the input to file, output is BGZF compressed and tabix indexed if the filename ends in '.gz'")
+    ("max-small-indel-size", po::value(&opt.maxSmallIndelSize),
+     "maximum indel size written to the small indel output (required for small indel output)")
+    ("threads", po::value(&opt.threadCount)->default_value(opt.threadCount),
+     "number of threads used to compress each BGZF output file")
+    ;
+
+    po::options_description help("help");
+    help.add_options()
+    ("help,h","print this message");
+
+    po::options_description visible("options");
+    visible.add(req).add(help);
+
+    bool po_parse_fail(false);
+    po::variables_map vm;
+    try
+    {
+        po::store(po::parse_command_line(argc, argv, visible,
+                                         po::command_line_style::unix_style ^ po::command_line_style::allow_short), vm);
+        po::notify(vm);
+    }
+    catch (const boost::program_options::error& e)     // todo:: find out what is the more specific exception class thrown by program options
+    {
+        log_os << "\nERROR: Exception thrown by option parser: " << e.what() << "\n";
+        po_parse_fail=true;
+    }
+
+    if ((argc<=1) || (vm.count("help")) || po_parse_fail)
+    {
+        usage(log_os,prog,visible);
+    }
+
+    std::string errorMsg;
+    if (opt.vcfFilename.empty())
+    {
+        errorMsg="Must specify an input VCF file";
+    }
+    else if (opt.outputFilename.empty())
+    {
+        errorMsg="Must specify an output VCF file";
+    }
+    else if (opt.threadCount == 0)
+    {
+        errorMsg="Thread count must be at least one";
+    }
+    else if (opt.isDenovo() && (opt.fatherSampleName.empty() || opt.motherSampleName.empty()))
+    {
+        errorMsg="Must specify father and mother sample names for de novo scoring";
+    }
+    else if ((! opt.isDenovo()) && ((! opt.fatherSampleName.empty()) || (! opt.motherSampleName.empty())))
+    {
+        errorMsg="Must specify proband sample name for de novo scoring";
+    }
+    else if (opt.isDenovo() && opt.denovoStatsFilename.empty())
+    {
+        errorMsg="Must specify de novo stats file for de novo scoring";
+    }
+    else if ((! opt.smallIndelOutputFilename.empty()) && (opt.maxSmallIndelSize == 0))
+    {
+        errorMsg="Must specify a positive max small indel size for small indel output";
+    }
+
+    if (! errorMsg.empty()) usage(log_os,prog,visible,errorMsg.c_str());
+
+    if (checkStandardizeInputFile(opt.vcfFilename, "SV VCF", errorMsg))
+    {
+        usage(log_os,prog,visible,errorMsg.c_str());
+    }
+}
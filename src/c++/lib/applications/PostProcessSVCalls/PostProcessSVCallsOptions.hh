@@ -0,0 +1,72 @@
+//
+// Manta - Structural Variant and Indel Caller
+// Copyright (c) 2013-2017 Illumina, Inc.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+//
+
+/// \file
+/// \author Chris Saunders
+///
+
+#pragma once
+
+#include "common/Program.hh"
+
+#include <string>
+
+
+struct PostProcessSVCallsOptions
+{
+    /// Coordinate sorted SV VCF input, which does not require an index
+    std::string vcfFilename;
+
+    /// Output VCF, which is BGZF compressed and tabix indexed if the filename ends in '.gz'
+    std::string outputFilename;
+
+    /// Filter overlapping DEL and DUP records which can't be resolved to two haplotypes
+    bool isPloidyFilter = false;
+
+    /// \name de novo scoring sample names
+    /// if the proband is set, all records are annotated with the de novo quality of the proband genotype
+    /// @{
+    std::string probandSampleName;
+    std::string fatherSampleName;
+    std::string motherSampleName;
+    /// @}
+
+    /// Summary of de novo scoring results, required for de novo scoring
+    std::string denovoStatsFilename;
+
+    /// Optional VCF output of the simple indel candidates in the input, for use by a small variant caller
+    std::string smallIndelOutputFilename;
+
+    unsigned maxSmallIndelSize = 0; ///< max REF or ALT allele size, less one base of padding, for small indel output
+
+    unsigned threadCount = 1; ///< threads used to compress each BGZF output
+
+    bool
+    isDenovo() const
+    {
+        return (! probandSampleName.empty());
+    }
+};
+
+
+void
+parsePostProcessSVCallsOptions(
+    const illumina::Program& prog,
+    int argc, char* argv[],
+    PostProcessSVCallsOptions& opt);
@@ -0,0 +1,225 @@
+//
+// Manta - Structural Variant and Indel Caller
+// Copyright (c) 2013-2017 Illumina, Inc.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+//
+
+/// \file
+/// \author Chris Saunders
+///
+
+#include "PostProcessSVCallsUtil.hh"
+
+#include "blt_util/parse_util.hh"
+#include "blt_util/string_util.hh"
+#include "common/Exceptions.hh"
+#include "htsapi/vcf_util.hh"
+
+#include <algorithm>
+#include <cstdlib>
+#include <sstream>
+
+
+
+void
+getPloidyFilterRecord(
+    const std::vector<std::string>& words,
+    bool& isPloidyFilterCandidate,
+    PloidyFilterRecord& rec)
+{
+    using namespace illumina::blt_util;
+
+    if (words.size() <= VCFID::FORMAT)
+    {
+        std::ostringstream oss;
+        oss << "Unexpected number of fields in SV VCF record at: '" << words[VCFID::CHROM] << ":" << words[VCFID::POS] << "'";
+        BOOST_THROW_EXCEPTION(illumina::common::LogicException(oss.str()));
+    }
+
+    rec.pos = parse_int_str(words[VCFID::POS]);
+    rec.endPos = rec.pos + words[VCFID::REF].size() - 1;
+    rec.svLen = -1;
+
+    std::string svType;
+    std::vector<std::string> infoWords;
+    split_string(words[VCFID::INFO],';',infoWords);
+    for (const std::string& infoWord : infoWords)
+    {
+        if (infoWord.compare(0,4,"END=") == 0)
+        {
+            rec.endPos = parse_int_str(infoWord.substr(4));
+        }
+        else if (infoWord.compare(0,6,"SVLEN=") == 0)
+        {
+            rec.svLen = std::abs(parse_int_str(infoWord.substr(6)));
+        }
+        else if (infoWord.compare(0,7,"SVTYPE=") == 0)
+        {
+            svType = infoWord.substr(7);
+        }
+    }
+
+    isPloidyFilterCandidate = ((words[VCFID::FILT] == "PASS") && ((svType == "DEL") || (svType == "DUP")));
+
+    rec.gtPloidy.clear();
+    if (! isPloidyFilterCandidate) return;
+
+    unsigned gtIndex(0);
+    if (! get_format_key_index(words[VCFID::FORMAT].c_str(),"GT",gtIndex))
+    {
+        std::ostringstream oss;
+        oss << "No GT field in SV VCF record at: '" << words[VCFID::CHROM] << ":" << words[VCFID::POS] << "'";
+        BOOST_THROW_EXCEPTION(illumina::common::LogicException(oss.str()));
+    }
+
+    std::vector<std::string> sampleWords;
+    std::vector<int> gt;
+    const unsigned wordCount(words.size());
+    for (unsigned sampleIndex(VCFID::SAMPLE); sampleIndex<wordCount; ++sampleIndex)
+    {
+        split_string(words[sampleIndex],':',sampleWords);
+        parse_gt(sampleWords.at(gtIndex).c_str(),gt);
+        int ploidy(0);
+        for (const int allele : gt)
+        {
+            if (allele > 0) ploidy += allele;
+        }
+        rec.gtPloidy.push_back(ploidy);
+    }
+}
+
+
+
+/// \brief Resolve all groups of overlapping records from the start of the block which end at or before nextPos
+static
+void
+processPloidyBlock(
+    const pos_t nextPos,
+    std::vector<const PloidyFilterRecord*>& recordBlock,
+    std::set<std::pair<pos_t,pos_t>>& filteredSites)
+{
+    while (! recordBlock.empty())
+    {
+        const PloidyFilterRecord& target(*recordBlock.front());
+
+        // when the target extends past the next record, more records must be read before the target is resolved:
+        if (target.endPos > nextPos) break;
+
+        std::vector<int> ploidySum(target.gtPloidy);
+        std::vector<unsigned> overlapIndices = { 0 };
+
+        const unsigned blockSize(recordBlock.size());
+        for (unsigned blockIndex(1); blockIndex<blockSize; ++blockIndex)
+        {
+            const PloidyFilterRecord& record(*recordBlock[blockIndex]);
+            if (record.pos >= target.endPos) break;
+
+            // collect overlapping records with similar size:
+            if ((record.svLen < 2*target.svLen) && (record.svLen > 0.5*target.svLen))
+            {
+                const unsigned sampleCount(std::min(ploidySum.size(), record.gtPloidy.size()));
+                for (unsigned sampleIndex(0); sampleIndex<sampleCount; ++sampleIndex)
+                {
+                    ploidySum[sampleIndex] += record.gtPloidy[sampleIndex];
+                }
+                overlapIndices.push_back(blockIndex);
+            }
+        }
+
+        const bool isAnomalousPloidy(std::any_of(ploidySum.begin(), ploidySum.end(), [](const int ploidy)
+        {
+            return (ploidy > 2);
+        }));
+
+        for (auto iter(overlapIndices.rbegin()); iter != overlapIndices.rend(); ++iter)
+        {
+            const PloidyFilterRecord& record(*recordBlock[*iter]);
+            if (isAnomalousPloidy)
+            {
+                filteredSites.emplace(record.pos, record.endPos);
+            }
+            recordBlock.erase(recordBlock.begin() + *iter);
+        }
+    }
+}
+
+
+
+void
+findPloidyFilteredSites(
+    const std::vector<PloidyFilterRecord>& records,
+    std::set<std::pair<pos_t,pos_t>>& filteredSites)
+{
+    std::vector<const PloidyFilterRecord*> recordBlock;
+    pos_t maxEndPos(-1);
+    for (const PloidyFilterRecord& record : records)
+    {
+        // keep adding records to the block until a record starts after the end of the first block record:
+        const pos_t targetEndPos(recordBlock.empty() ? record.endPos : recordBlock.front()->endPos);
+        if (record.pos >= targetEndPos)
+        {
+            processPloidyBlock(record.pos, recordBlock, filteredSites);
+        }
+        recordBlock.push_back(&record);
+        maxEndPos = std::max(maxEndPos, record.endPos);
+    }
+
+    processPloidyBlock(maxEndPos+1, recordBlock, filteredSites);
+}
+
+
+
+bool
+isMendelianConsistentGenotype(
+    const std::string& probandGT,
+    const std::string& fatherGT,
+    const std::string& motherGT)
+{
+    std::vector<std::string> fatherAlleles;
+    std::vector<std::string> motherAlleles;
+    split_string(fatherGT,'/',fatherAlleles);
+    split_string(motherGT,'/',motherAlleles);
+    for (const std::string& fatherAllele : fatherAlleles)
+    {
+        for (const std::string& motherAllele : motherAlleles)
+        {
+            const bool isFatherFirst(fatherAllele < motherAllele);
+            const std::string gt((isFatherFirst ? fatherAllele : motherAllele) + "/" +
+                                 (isFatherFirst ? motherAllele : fatherAllele));
+            if (gt == probandGT) return true;
+        }
+    }
+    return false;
+}
+
+
+
+bool
+isSmallIndelCandidate(
+    const vcf_record& rec,
+    const unsigned maxIndelSize)
+{
+    // candidate records have a single ALT allele:
+    if (rec.alt.size() != 1) return false;
+
+    // remove symbolic alleles and breakends:
+    const std::string& alt(rec.alt.front());
+    if (alt.find_first_of("<[]:") != std::string::npos) return false;
+
+    if (rec.ref.size() > (maxIndelSize+1)) return false;
+    if (alt.size() > (maxIndelSize+1)) return false;
+    return true;
+}
@@ -0,0 +1,87 @@
+//
+// Manta - Structural Variant and Indel Caller
+// Copyright (c) 2013-2017 Illumina, Inc.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+//
+
+/// \file
+/// \author Chris Saunders
+///
+
+#pragma once
+
+#include "blt_util/blt_types.hh"
+#include "htsapi/vcf_record.hh"
+
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+
+
+/// \brief Fields of a diploid SV record used by the ploidy filter
+struct PloidyFilterRecord
+{
+    pos_t pos = 0;
+    pos_t endPos = 0;
+
+    /// absolute SVLEN value, or -1 if SVLEN is not defined
+    int svLen = -1;
+
+    /// sum of the genotype allele indices for each sample
+    std::vector<int> gtPloidy;
+};
+
+
+/// \brief Parse the ploidy filter fields from a tab-split VCF record
+///
+/// \param[out] isPloidyFilterCandidate true if the record passes all filters and is a DEL or DUP, only these records
+///                                     are evaluated by the ploidy filter
+void
+getPloidyFilterRecord(
+    const std::vector<std::string>& words,
+    bool& isPloidyFilterCandidate,
+    PloidyFilterRecord& rec);
+
+
+/// \brief Find overlapping records from one chromosome which can't be resolved to two haplotypes
+///
+/// Each record is grouped with all following records which start before its end and have an SVLEN within a factor of
+/// two. If the total genotype ploidy of any sample in a group is greater than two, all records in the group are
+/// filtered. Records are only compared to other records from the same chromosome.
+///
+/// \param[in] records all passing DEL and DUP records from a single chromosome, in VCF order
+/// \param[out] filteredSites the (pos, endPos) of each filtered record
+void
+findPloidyFilteredSites(
+    const std::vector<PloidyFilterRecord>& records,
+    std::set<std::pair<pos_t,pos_t>>& filteredSites);
+
+
+/// \return true if the proband genotype can be formed from one allele of each parent genotype
+bool
+isMendelianConsistentGenotype(
+    const std::string& probandGT,
+    const std::string& fatherGT,
+    const std::string& motherGT);
+
+
+/// \return true if the record is a simple indel with REF and ALT alleles no longer than maxIndelSize plus one base of
+/// padding, so that it can be used as an indel candidate by a small variant caller
+bool
+isSmallIndelCandidate(
+    const vcf_record& rec,
+    const unsigned maxIndelSize);
@@ -0,0 +1,133 @@
+//
+// Manta - Structural Variant and Indel Caller
+// Copyright (c) 2013-2017 Illumina, Inc.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+//
+
+#include "boost/test/unit_test.hpp"
+
+#include "applications/PostProcessSVCalls/PostProcessSVCallsUtil.hh"
+#include "blt_util/string_util.hh"
+
+
+BOOST_AUTO_TEST_SUITE( test_PostProcessSVCallsUtil )
+
+
+static
+PloidyFilterRecord
+getTestRecord(
+    const std::string& line,
+    bool& isPloidyFilterCandidate)
+{
+    std::vector<std::string> words;
+    split_string(line,'\t',words);
+    PloidyFilterRecord rec;
+    getPloidyFilterRecord(words, isPloidyFilterCandidate, rec);
+    return rec;
+}
+
+
+
+BOOST_AUTO_TEST_CASE( test_getPloidyFilterRecord )
+{
+    bool isCandidate(false);
+    const PloidyFilterRecord rec(getTestRecord("chr1\t100\tr1\tA\t<DEL>\t20\tPASS\tSVTYPE=DEL;SVLEN=-400;END=500;CIEND=-5,5\tGT:GQ\t0/1:20\t1/1:30", isCandidate));
+    BOOST_REQUIRE(isCandidate);
+    BOOST_REQUIRE_EQUAL(rec.pos, 100);
+    BOOST_REQUIRE_EQUAL(rec.endPos, 500);
+    BOOST_REQUIRE_EQUAL(rec.svLen, 400);
+    BOOST_REQUIRE_EQUAL(rec.gtPloidy.size(), 2u);
+    BOOST_REQUIRE_EQUAL(rec.gtPloidy[0], 1);
+    BOOST_REQUIRE_EQUAL(rec.gtPloidy[1], 2);
+
+    // filtered records and other SV types are not evaluated by the ploidy filter:
+    getTestRecord("chr1\t100\tr1\tA\t<DEL>\t20\tMinQUAL\tSVTYPE=DEL;SVLEN=-400;END=500\tGT\t0/1", isCandidate);
+    BOOST_REQUIRE(! isCandidate);
+    getTestRecord("chr1\t100\tr1\tA\t<INV>\t20\tPASS\tSVTYPE=INV;SVLEN=400;END=500\tGT\t0/1", isCandidate);
+    BOOST_REQUIRE(! isCandidate);
+}
+
+
+
+static
+PloidyFilterRecord
+makeRecord(
+    const pos_t pos,
+    const pos_t endPos,
+    const int ploidy)
+{
+    PloidyFilterRecord rec;
+    rec.pos = pos;
+    rec.endPos = endPos;
+    rec.svLen = endPos-pos;
+    rec.gtPloidy.push_back(ploidy);
+    return rec;
+}
+
+
+
+BOOST_AUTO_TEST_CASE( test_findPloidyFilteredSites )
+{
+    std::vector<PloidyFilterRecord> records;
+
+    // two overlapping homozygous deletions of similar size are inconsistent with a diploid genome:
+    records.push_back(makeRecord(100,500,2));
+    records.push_back(makeRecord(200,600,2));
+
+    // an overlapping deletion with very different size is not compared:
+    records.push_back(makeRecord(300,2000,2));
+
+    // two overlapping heterozygous deletions are consistent:
+    records.push_back(makeRecord(3000,3400,1));
+    records.push_back(makeRecord(3100,3500,1));
+
+    std::set<std::pair<pos_t,pos_t>> filteredSites;
+    findPloidyFilteredSites(records, filteredSites);
+    BOOST_REQUIRE_EQUAL(filteredSites.size(), 2u);
+    BOOST_REQUIRE(filteredSites.count(std::make_pair(100,500)));
+    BOOST_REQUIRE(filteredSites.count(std::make_pair(200,600)));
+}
+
+
+
+BOOST_AUTO_TEST_CASE( test_isMendelianConsistentGenotype )
+{
+    BOOST_REQUIRE(isMendelianConsistentGenotype("0/1","0/0","1/1"));
+    BOOST_REQUIRE(isMendelianConsistentGenotype("0/1","0/1","0/0"));
+    BOOST_REQUIRE(! isMendelianConsistentGenotype("0/1","0/0","0/0"));
+    BOOST_REQUIRE(! isMendelianConsistentGenotype("1/1","0/1","0/0"));
+}
+
+
+
+BOOST_AUTO_TEST_CASE( test_isSmallIndelCandidate )
+{
+    auto isSmall = [](const char* line, const unsigned maxSize)
+    {
+        vcf_record rec;
+        rec.set(line);
+        return isSmallIndelCandidate(rec, maxSize);
+    };
+
+    BOOST_REQUIRE(isSmall("chr1\t100\tr1\tACGT\tA\t.\tPASS\t.", 3));
+    BOOST_REQUIRE(! isSmall("chr1\t100\tr1\tACGTA\tA\t.\tPASS\t.", 3));
+    BOOST_REQUIRE(! isSmall("chr1\t100\tr1\tA\tACGTA\t.\tPASS\t.", 3));
+    BOOST_REQUIRE(! isSmall("chr1\t100\tr1\tA\t<DEL>\t.\tPASS\t.", 3));
+    BOOST_REQUIRE(! isSmall("chr1\t100\tr1\tA\tA[chr2:100[\t.\tPASS\t.", 20));
+}
+
+
+BOOST_AUTO_TEST_SUITE_END()
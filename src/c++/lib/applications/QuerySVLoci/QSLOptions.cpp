@@ -0,0 +1,99 @@
+//
+// Manta - Structural Variant and Indel Caller
+// Copyright (c) 2013-2017 Illumina, Inc.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+//
+
+
+/// \file
+/// \author Chris Saunders
+///
+
+#include "QSLOptions.hh"
+
+#include "blt_util/log.hh"
+#include "common/ProgramUtil.hh"
+
+#include "boost/filesystem.hpp"
+#include "boost/program_options.hpp"
+
+#include <iostream>
+
+
+
+static
+void
+usage(
+    std::ostream& os,
+    const illumina::Program& prog,
+    const boost::program_options::options_description& visible,
+    const char* msg = nullptr)
+{
+    usage(os, prog, visible, "load an sv locus graph once and answer queries read from stdin (enter 'help' for query syntax)",
+          " < queries > responses", msg);
+}
+
+
+
+void
+parseQSLOptions(
+    const illumina::Program& prog,
+    int argc, char* argv[],
+    QSLOptions& opt)
+{
+    namespace po = boost::program_options;
+    po::options_description req("configuration");
+    req.add_options()
+    ("graph-file", po::value(&opt.graphFilename),
+     "sv locus graph file")
+    ;
+
+    po::options_description help("help");
+    help.add_options()
+    ("help,h","print this message");
+
+    po::options_description visible("options");
+    visible.add(req).add(help);
+
+    bool po_parse_fail(false);
+    po::variables_map vm;
+    try
+    {
+        po::store(po::parse_command_line(argc, argv, visible,
+                                         po::command_line_style::unix_style ^ po::command_line_style::allow_short), vm);
+        po::notify(vm);
+    }
+    catch (const boost::program_options::error& e)
+    {
+        log_os << "\nERROR: Exception thrown by option parser: " << e.what() << "\n";
+        po_parse_fail=true;
+    }
+
+    if ((argc<=1) || (vm.count("help")) || po_parse_fail)
+    {
+        usage(log_os,prog,visible);
+    }
+
+    // fast check of config state:
+    if (opt.graphFilename.empty())
+    {
+        usage(log_os,prog,visible,"Must specify sv locus graph file");
+    }
+    if (! boost::filesystem::exists(opt.graphFilename))
+    {
+        usage(log_os,prog,visible,"SV locus graph file does not exist");
+    }
+}
@@ -0,0 +1,287 @@
+//
+// Manta - Structural Variant and Indel Caller
+// Copyright (c) 2013-2017 Illumina, Inc.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+//
+
+
+/// \file
+/// \author Chris Saunders
+///
+
+#include "QuerySVLoci.hh"
+#include "QSLOptions.hh"
+
+#include "blt_util/blt_exception.hh"
+#include "blt_util/log.hh"
+#include "blt_util/parse_util.hh"
+#include "blt_util/string_util.hh"
+#include "htsapi/bam_header_util.hh"
+#include "svgraph/SVLocusSet.hh"
+
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+
+
+/// written at the end of every query response, so that a client can find where each response ends
+static const char responseEndMarker[] = "#END";
+
+
+
+static
+void
+writeQueryHelp(std::ostream& os)
+{
+    os << "Queries (one per line):\n"
+       << "\theader\t\t\t\tlist the chromosome index and label of each reference contig\n"
+       << "\tstats\t\t\t\tsummary stats of the whole graph\n"
+       << "\tregion REGION\t\t\tlist all nodes intersecting the region, eg. 'chr1:20-30'\n"
+       << "\tlocus LOCUS\t\t\tlist all nodes of the locus\n"
+       << "\tlocus-stats LOCUS\t\tsummary stats of the locus\n"
+       << "\tnode LOCUS:NODE\t\t\tlist the node and every node connected to it by an edge\n"
+       << "\tedge-count-distro [MAXCOUNT]\thistogram of edge count per node, with MAXCOUNT bins (default: 10)\n"
+       << "\tquit\t\t\t\tstop reading queries\n";
+}
+
+
+
+/// \brief Parse and check a locus index argument
+static
+LocusIndexType
+parseLocusIndex(
+    const SVLocusSet& set,
+    const std::string& locusString)
+{
+    using namespace illumina::blt_util;
+
+    const LocusIndexType locusIndex(parse_unsigned_str(locusString));
+    if (locusIndex >= set.size())
+    {
+        std::ostringstream oss;
+        oss << "ERROR: Locus index " << locusIndex << " is not less than the locus count " << set.size();
+        throw blt_exception(oss.str().c_str());
+    }
+    return locusIndex;
+}
+
+
+
+/// \brief Write a node and each node connected to it by an edge, with the edge counts in both directions
+static
+void
+writeNodeNeighborhood(
+    const SVLocusSet& set,
+    const std::string& nodeAddressString,
+    std::ostream& os)
+{
+    using namespace illumina::blt_util;
+
+    std::vector<std::string> indices;
+    split_string(nodeAddressString, ':', indices);
+    if (indices.size() != 2)
+    {
+        throw blt_exception("ERROR: Node address must be in the format 'LOCUS:NODE'");
+    }
+
+    const LocusIndexType locusIndex(parseLocusIndex(set, indices[0]));
+    const SVLocus& locus(set.getLocus(locusIndex));
+    const NodeIndexType nodeIndex(parse_unsigned_str(indices[1]));
+    if (nodeIndex >= locus.size())
+    {
+        std::ostringstream oss;
+        oss << "ERROR: Node index " << nodeIndex << " is not less than the node count " << locus.size()
+            << " of locus " << locusIndex;
+        throw blt_exception(oss.str().c_str());
+    }
+
+    const SVLocusNode& node(locus.getNode(nodeIndex));
+    os << "SVNode LocusIndex:NodeIndex : " << locusIndex << ":" << nodeIndex << "\n";
+    os << node;
+
+    const SVLocusEdgeManager edgeMap(node.getEdgeManager());
+    for (const SVLocusEdgesType::value_type& edge : edgeMap.getMap())
+    {
+        const NodeIndexType remoteNodeIndex(edge.first);
+        if (remoteNodeIndex == nodeIndex) continue;
+        os << "EdgeNode LocusIndex:NodeIndex : " << locusIndex << ":" << remoteNodeIndex
+           << " out_count: " << edge.second.getCount()
+           << " in_count: " << locus.getEdge(remoteNodeIndex,nodeIndex).getCount() << "\n";
+        os << locus.getNode(remoteNodeIndex);
+    }
+}
+
+
+
+static
+void
+writeNodeEdgeCountDistro(
+    const SVLocusSet& set,
+    const unsigned maxEdgeCount,
+    std::ostream& os)
+{
+    static const char sep('\t');
+
+    std::vector<unsigned> edgeCount(maxEdgeCount);
+    set.getNodeEdgeCountDistro(edgeCount);
+    os << "NodeEdgeCount:\n";
+    for (unsigned i(0); i<maxEdgeCount; ++i)
+    {
+        os << i;
+        if ((i+1) == maxEdgeCount) os << '+';
+        os << sep << edgeCount[i] << "\n";
+    }
+}
+
+
+
+/// \brief Answer one query
+///
+/// \return False if the query ends the query loop
+static
+bool
+runQuery(
+    const std::string& queryLine,
+    SVLocusSet& set,
+    std::ostream& os)
+{
+    using namespace illumina::blt_util;
+
+    const SVLocusSet& cset(set);
+
+    std::istringstream iss(queryLine);
+    std::string query;
+    iss >> query;
+    std::vector<std::string> args;
+    std::string arg;
+    while (iss >> arg) args.push_back(arg);
+
+    auto requireArgCount = [&](const unsigned minCount, const unsigned maxCount)
+    {
+        if ((args.size() < minCount) || (args.size() > maxCount))
+        {
+            std::ostringstream oss;
+            oss << "ERROR: Unexpected argument count for query '" << query << "'";
+            throw blt_exception(oss.str().c_str());
+        }
+    };
+
+    if (query.empty())
+    {
+        // blank lines are ignored
+    }
+    else if ((query == "quit") || (query == "exit"))
+    {
+        return false;
+    }
+    else if (query == "help")
+    {
+        writeQueryHelp(os);
+    }
+    else if (query == "header")
+    {
+        requireArgCount(0,0);
+        os << cset.header << "\n";
+    }
+    else if (query == "stats")
+    {
+        requireArgCount(0,0);
+        cset.dumpStats(os);
+    }
+    else if (query == "region")
+    {
+        requireArgCount(1,1);
+        int32_t tid,beginPos,endPos;
+        parse_bam_region(cset.header, args[0].c_str(), tid, beginPos, endPos);
+        set.dumpRegion(os,GenomeInterval(tid,beginPos,endPos));
+    }
+    else if (query == "locus")
+    {
+        requireArgCount(1,1);
+        os << cset.getLocus(parseLocusIndex(cset, args[0]));
+    }
+    else if (query == "locus-stats")
+    {
+        requireArgCount(1,1);
+        cset.dumpLocusStats(os, parseLocusIndex(cset, args[0]));
+    }
+    else if (query == "node")
+    {
+        requireArgCount(1,1);
+        writeNodeNeighborhood(cset, args[0], os);
+    }
+    else if (query == "edge-count-distro")
+    {
+        requireArgCount(0,1);
+        unsigned maxEdgeCount(10);
+        if (! args.empty()) maxEdgeCount = parse_unsigned_str(args[0]);
+        if (maxEdgeCount == 0) throw blt_exception("ERROR: Edge count histogram size must be positive");
+        writeNodeEdgeCountDistro(cset, maxEdgeCount, os);
+    }
+    else
+    {
+        std::ostringstream oss;
+        oss << "ERROR: Unknown query '" << query << "', enter 'help' for query syntax";
+        throw blt_exception(oss.str().c_str());
+    }
+    return true;
+}
+
+
+
+static
+void
+runQSL(const QSLOptions& opt)
+{
+    SVLocusSet set;
+    set.load(opt.graphFilename.c_str());
+
+    log_os << "INFO: Loaded SV locus graph with " << set.nonEmptySize() << " loci, ready for queries\n";
+
+    std::ostream& os(std::cout);
+    std::string queryLine;
+    while (std::getline(std::cin, queryLine))
+    {
+        bool isContinue(true);
+
+        // a failed query is reported in the response, and does not end the query loop:
+        try
+        {
+            isContinue = runQuery(queryLine, set, os);
+        }
+        catch (const std::exception& e)
+        {
+            os << e.what() << "\n";
+        }
+
+        if (! isContinue) break;
+        os << responseEndMarker << std::endl;
+    }
+}
+
+
+
+void
+QuerySVLoci::
+runInternal(int argc, char* argv[]) const
+{
+    QSLOptions opt;
+
+    parseQSLOptions(*this,argc,argv,opt);
+    runQSL(opt);
+}
@@ -0,0 +1,105 @@
+//
+// Manta - Structural Variant and Indel Caller
+// Copyright (c) 2013-2017 Illumina, Inc.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+//
+
+/// \file
+/// \author Chris Saunders
+///
+
+#pragma once
+
+#include "EdgeWorkStats.hh"
+#include "blt_util/time_util.hh"
+
+#include "boost/utility.hpp"
+
+
+/// track time and work counts for each stage of processing a single edge
+///
+/// Stages are entered with EdgeStageScoper. Stage scopes may be nested, in which case time accumulates
+/// for all open stages, but work counts are only attributed to the innermost stage. Any work counted
+/// outside of a stage scope is attributed to the candidate stage.
+///
+/// Work counting is a single integer increment, so it is left on in all cases.
+///
+struct EdgeStageTracker : private boost::noncopyable
+{
+    void
+    clear()
+    {
+        for (TimeTracker& stageTime : _stageTime)
+        {
+            stageTime.clear();
+        }
+        _work.clear();
+        _stage = EDGE_STAGE::CANDIDATE;
+    }
+
+    /// add work count to the current stage
+    void
+    add(
+        const EDGE_WORK::index_t work,
+        const uint64_t count = 1)
+    {
+        _work.add(_stage, work, count);
+    }
+
+    CpuTimes
+    getTimes(const EDGE_STAGE::index_t stage) const
+    {
+        return _stageTime[stage].getTimes();
+    }
+
+    const EdgeWorkStats&
+    getWork() const
+    {
+        return _work;
+    }
+
+private:
+    friend struct EdgeStageScoper;
+
+    EDGE_STAGE::index_t _stage = EDGE_STAGE::CANDIDATE;
+    TimeTracker _stageTime[EDGE_STAGE::SIZE];
+    EdgeWorkStats _work;
+};
+
+
+/// enter an edge processing stage for the lifetime of this object
+struct EdgeStageScoper : private boost::noncopyable
+{
+    EdgeStageScoper(
+        EdgeStageTracker& tracker,
+        const EDGE_STAGE::index_t stage)
+        : _tracker(tracker),
+          _parentStage(tracker._stage)
+    {
+        _tracker._stage = stage;
+        _tracker._stageTime[stage].resume();
+    }
+
+    ~EdgeStageScoper()
+    {
+        _tracker._stageTime[_tracker._stage].stop();
+        _tracker._stage = _parentStage;
+    }
+
+private:
+    EdgeStageTracker& _tracker;
+    const EDGE_STAGE::index_t _parentStage;
+};
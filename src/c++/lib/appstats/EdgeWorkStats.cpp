@@ -0,0 +1,65 @@
+//
+// Manta - Structural Variant and Indel Caller
+// Copyright (c) 2013-2017 Illumina, Inc.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+//
+
+/// \file
+/// \author Chris Saunders
+///
+
+#include "EdgeWorkStats.hh"
+
+#include <iostream>
+
+
+
+void
+EdgeWorkStats::
+writeLine(std::ostream& os) const
+{
+    for (unsigned stageIndex(0); stageIndex<EDGE_STAGE::SIZE; ++stageIndex)
+    {
+        for (unsigned workIndex(0); workIndex<EDGE_WORK::SIZE; ++workIndex)
+        {
+            os << '\t' << counts[stageIndex][workIndex];
+        }
+    }
+}
+
+
+
+void
+EdgeWorkStats::
+report(std::ostream& os) const
+{
+    os << "WorkStage";
+    for (unsigned workIndex(0); workIndex<EDGE_WORK::SIZE; ++workIndex)
+    {
+        os << '\t' << EDGE_WORK::label(static_cast<EDGE_WORK::index_t>(workIndex));
+    }
+    os << '\n';
+
+    for (unsigned stageIndex(0); stageIndex<EDGE_STAGE::SIZE; ++stageIndex)
+    {
+        os << EDGE_STAGE::label(static_cast<EDGE_STAGE::index_t>(stageIndex));
+        for (unsigned workIndex(0); workIndex<EDGE_WORK::SIZE; ++workIndex)
+        {
+            os << '\t' << counts[stageIndex][workIndex];
+        }
+        os << '\n';
+    }
+}
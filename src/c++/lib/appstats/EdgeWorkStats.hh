@@ -0,0 +1,196 @@
+//
+// Manta - Structural Variant and Indel Caller
+// Copyright (c) 2013-2017 Illumina, Inc.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+//
+
+/// \file
+/// \author Chris Saunders
+///
+
+#pragma once
+
+#include "boost/serialization/nvp.hpp"
+
+#include <cstdint>
+
+#include <iosfwd>
+
+
+/// stages of processing a single SV locus graph edge
+namespace EDGE_STAGE
+{
+enum index_t
+{
+    CANDIDATE,
+    ASSEMBLY,
+    REMOTE,
+    SCORE,
+    SIZE
+};
+
+inline
+const char*
+label(const index_t idx)
+{
+    switch (idx)
+    {
+    case CANDIDATE:
+        return "candidate";
+    case ASSEMBLY:
+        return "assembly";
+    case REMOTE:
+        return "remoteRead";
+    case SCORE:
+        return "score";
+    default:
+        return "UNKNOWN";
+    }
+}
+}
+
+
+/// types of work counted within each edge processing stage
+namespace EDGE_WORK
+{
+enum index_t
+{
+    BAM_BYTES,
+    READS_EXAMINED,
+    READS_RETAINED,
+    DP_CELLS,
+    ASSEMBLY_ITERATIONS,
+    REFERENCE_FETCHES,
+    SIZE
+};
+
+inline
+const char*
+label(const index_t idx)
+{
+    switch (idx)
+    {
+    case BAM_BYTES:
+        return "BamBytes";
+    case READS_EXAMINED:
+        return "ReadsExamined";
+    case READS_RETAINED:
+        return "ReadsRetained";
+    case DP_CELLS:
+        return "AlignDPCells";
+    case ASSEMBLY_ITERATIONS:
+        return "AssemblyWordLengths";
+    case REFERENCE_FETCHES:
+        return "ReferenceFetches";
+    default:
+        return "UNKNOWN";
+    }
+}
+}
+
+
+/// work counts for each edge processing stage
+///
+/// the counts are intended to show whether the runtime of an edge (or group of edges) is dominated
+/// by alignment file input, assembly, contig alignment, etc., where:
+/// - BAM_BYTES is the size of all alignment records read from the alignment files
+/// - READS_EXAMINED is the number of alignment records read from the alignment files
+/// - READS_RETAINED is the number of these records used as evidence or assembly input
+/// - DP_CELLS is the number of cells in all gapped contig alignment DP matrices
+/// - ASSEMBLY_ITERATIONS is the number of assembly word lengths attempted
+/// - REFERENCE_FETCHES is the number of reference segment requests
+///
+struct EdgeWorkStats
+{
+    EdgeWorkStats()
+    {
+        clear();
+    }
+
+    void
+    clear()
+    {
+        for (unsigned stageIndex(0); stageIndex<EDGE_STAGE::SIZE; ++stageIndex)
+        {
+            for (unsigned workIndex(0); workIndex<EDGE_WORK::SIZE; ++workIndex)
+            {
+                counts[stageIndex][workIndex] = 0;
+            }
+        }
+    }
+
+    void
+    add(
+        const EDGE_STAGE::index_t stage,
+        const EDGE_WORK::index_t work,
+        const uint64_t count)
+    {
+        counts[stage][work] += count;
+    }
+
+    uint64_t
+    get(
+        const EDGE_STAGE::index_t stage,
+        const EDGE_WORK::index_t work) const
+    {
+        return counts[stage][work];
+    }
+
+    /// \return count of work summed over all stages
+    uint64_t
+    getTotal(
+        const EDGE_WORK::index_t work) const
+    {
+        uint64_t total(0);
+        for (unsigned stageIndex(0); stageIndex<EDGE_STAGE::SIZE; ++stageIndex)
+        {
+            total += counts[stageIndex][work];
+        }
+        return total;
+    }
+
+    void
+    merge(
+        const EdgeWorkStats& rhs)
+    {
+        for (unsigned stageIndex(0); stageIndex<EDGE_STAGE::SIZE; ++stageIndex)
+        {
+            for (unsigned workIndex(0); workIndex<EDGE_WORK::SIZE; ++workIndex)
+            {
+                counts[stageIndex][workIndex] += rhs.counts[stageIndex][workIndex];
+            }
+        }
+    }
+
+    /// write all counts on a single line, tab-separated in stage-major order,
+    /// with a leading tab:
+    void
+    writeLine(std::ostream& os) const;
+
+    void
+    report(std::ostream& os) const;
+
+    template<class Archive>
+    void serialize(Archive& ar, const unsigned /* version */)
+    {
+        ar& BOOST_SERIALIZATION_NVP(counts)
+        ;
+    }
+
+    uint64_t counts[EDGE_STAGE::SIZE][EDGE_WORK::SIZE];
+};
+
+BOOST_CLASS_IMPLEMENTATION(EdgeWorkStats, boost::serialization::object_serializable)
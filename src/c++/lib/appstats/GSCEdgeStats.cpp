@@ -104,6 +104,8 @@ report(std::ostream& os) const
     finderStats.report(os);
     os << "SpanningComplexCandidateFiltered\t" << totalSpanningCandidateFilter << "\n";
     os << "JunctionAssemblyOverlapSkipped\t" << totalJunctionAssemblyOverlapSkips << "\n";
+    os << "BudgetFallbackEdgeCount\t" << totalBudgetFallbackEdgeCount << "\n";
+    os << "JunctionAssemblyBudgetSkipped\t" << totalJunctionAssemblyBudgetSkips << "\n";
     os << "JunctionCount\t" << totalJunctionCount << "\n";
     os << "ComplexJunctionCount\t" << totalComplexJunctionCount << "\n";
     os << "BreaksPerJunction:\n";
@@ -116,7 +118,10 @@ report(std::ostream& os) const
     reportTime("candi",candTime,totalInputEdgeCount,totalCandidateCount, os);
     reportTime("assem",assemblyTime,totalInputEdgeCount,totalCandidateCount, os);
     reportTime("score",scoringTime,totalInputEdgeCount,totalCandidateCount, os);
+    reportTime("remot",remoteTime,totalInputEdgeCount,totalCandidateCount, os);
     reportTime("nocat",nocatTime,totalInputEdgeCount,totalCandidateCount, os);
+    os << "WorkCounts:\n";
+    workStats.report(os);
 }
 
 
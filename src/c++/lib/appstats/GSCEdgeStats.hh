@@ -23,6 +23,7 @@
 
 #pragma once
 
+#include "EdgeWorkStats.hh"
 #include "SVFinderStats.hh"
 #include "blt_util/time_util.hh"
 
@@ -99,6 +100,7 @@ struct GSCEdgeGroupStats
         candTime.merge(rhs.candTime);
         assemblyTime.merge(rhs.assemblyTime);
         scoringTime.merge(rhs.scoringTime);
+        remoteTime.merge(rhs.remoteTime);
         totalInputEdgeCount += rhs.totalInputEdgeCount;
         totalCandidateCount += rhs.totalCandidateCount;
         totalComplexCandidate += rhs.totalComplexCandidate;
@@ -108,10 +110,13 @@ struct GSCEdgeGroupStats
         totalComplexJunctionCount += rhs.totalComplexJunctionCount;
         totalAssemblyCandidates += rhs.totalAssemblyCandidates;
         totalSpanningAssemblyCandidates += rhs.totalSpanningAssemblyCandidates;
+        totalBudgetFallbackEdgeCount += rhs.totalBudgetFallbackEdgeCount;
+        totalJunctionAssemblyBudgetSkips += rhs.totalJunctionAssemblyBudgetSkips;
         candidatesPerEdge.merge(rhs.candidatesPerEdge);
         assemblyCandidatesPerJunction.merge(rhs.assemblyCandidatesPerJunction);
         breaksPerJunction.merge(rhs.breaksPerJunction);
         finderStats.merge(rhs.finderStats);
+        workStats.merge(rhs.workStats);
     }
 
     void
@@ -124,6 +129,7 @@ struct GSCEdgeGroupStats
         & BOOST_SERIALIZATION_NVP(candTime)
         & BOOST_SERIALIZATION_NVP(assemblyTime)
         & BOOST_SERIALIZATION_NVP(scoringTime)
+        & BOOST_SERIALIZATION_NVP(remoteTime)
         & BOOST_SERIALIZATION_NVP(totalInputEdgeCount)
         & BOOST_SERIALIZATION_NVP(totalCandidateCount)
         & BOOST_SERIALIZATION_NVP(totalComplexCandidate)
@@ -133,10 +139,13 @@ struct GSCEdgeGroupStats
         & BOOST_SERIALIZATION_NVP(totalComplexJunctionCount)
         & BOOST_SERIALIZATION_NVP(totalAssemblyCandidates)
         & BOOST_SERIALIZATION_NVP(totalSpanningAssemblyCandidates)
+        & BOOST_SERIALIZATION_NVP(totalBudgetFallbackEdgeCount)
+        & BOOST_SERIALIZATION_NVP(totalJunctionAssemblyBudgetSkips)
         & BOOST_SERIALIZATION_NVP(candidatesPerEdge)
         & BOOST_SERIALIZATION_NVP(assemblyCandidatesPerJunction)
         & BOOST_SERIALIZATION_NVP(breaksPerJunction)
         & BOOST_SERIALIZATION_NVP(finderStats)
+        & BOOST_SERIALIZATION_NVP(workStats)
         ;
     }
 
@@ -144,6 +153,9 @@ struct GSCEdgeGroupStats
     CpuTimes candTime;
     CpuTimes assemblyTime;
     CpuTimes scoringTime;
+
+    /// remote read retrieval time, this is a subset of assemblyTime
+    CpuTimes remoteTime;
     uint64_t totalInputEdgeCount = 0;
     uint64_t totalCandidateCount = 0;
     uint64_t totalComplexCandidate = 0;
@@ -154,11 +166,17 @@ struct GSCEdgeGroupStats
     uint64_t totalAssemblyCandidates = 0;
     uint64_t totalSpanningAssemblyCandidates = 0;
 
+    /// edges which exceeded the edge processing budget, and the junctions not assembled as a result
+    uint64_t totalBudgetFallbackEdgeCount = 0;
+    uint64_t totalJunctionAssemblyBudgetSkips = 0;
+
     SimpleHist candidatesPerEdge;
     SimpleHist assemblyCandidatesPerJunction;
     SimpleHist breaksPerJunction;
 
     SVFinderStats finderStats;
+
+    EdgeWorkStats workStats;
 };
 
 BOOST_CLASS_IMPLEMENTATION(GSCEdgeGroupStats, boost::serialization::object_serializable)
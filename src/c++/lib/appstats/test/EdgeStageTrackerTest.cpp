@@ -0,0 +1,74 @@
+//
+// Manta - Structural Variant and Indel Caller
+// Copyright (c) 2013-2017 Illumina, Inc.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+//
+
+#include "boost/test/unit_test.hpp"
+
+#include "appstats/EdgeStageTracker.hh"
+
+
+BOOST_AUTO_TEST_SUITE( test_EdgeStageTracker )
+
+
+BOOST_AUTO_TEST_CASE( test_EdgeStageTrackerNesting )
+{
+    EdgeStageTracker tracker;
+    tracker.clear();
+
+    // work outside of any stage scope goes to the candidate stage:
+    tracker.add(EDGE_WORK::READS_EXAMINED);
+    {
+        const EdgeStageScoper assmStage(tracker, EDGE_STAGE::ASSEMBLY);
+        tracker.add(EDGE_WORK::READS_EXAMINED, 3);
+        {
+            const EdgeStageScoper remoteStage(tracker, EDGE_STAGE::REMOTE);
+            tracker.add(EDGE_WORK::READS_EXAMINED, 5);
+            tracker.add(EDGE_WORK::BAM_BYTES, 100);
+        }
+        // work is attributed to the parent stage once the nested stage is closed:
+        tracker.add(EDGE_WORK::ASSEMBLY_ITERATIONS, 2);
+    }
+
+    const EdgeWorkStats& work(tracker.getWork());
+    BOOST_REQUIRE_EQUAL(work.get(EDGE_STAGE::CANDIDATE, EDGE_WORK::READS_EXAMINED), 1u);
+    BOOST_REQUIRE_EQUAL(work.get(EDGE_STAGE::ASSEMBLY, EDGE_WORK::READS_EXAMINED), 3u);
+    BOOST_REQUIRE_EQUAL(work.get(EDGE_STAGE::REMOTE, EDGE_WORK::READS_EXAMINED), 5u);
+    BOOST_REQUIRE_EQUAL(work.get(EDGE_STAGE::REMOTE, EDGE_WORK::BAM_BYTES), 100u);
+    BOOST_REQUIRE_EQUAL(work.get(EDGE_STAGE::ASSEMBLY, EDGE_WORK::ASSEMBLY_ITERATIONS), 2u);
+    BOOST_REQUIRE_EQUAL(work.get(EDGE_STAGE::SCORE, EDGE_WORK::READS_EXAMINED), 0u);
+
+    tracker.clear();
+    BOOST_REQUIRE_EQUAL(tracker.getWork().get(EDGE_STAGE::REMOTE, EDGE_WORK::READS_EXAMINED), 0u);
+}
+
+
+BOOST_AUTO_TEST_CASE( test_EdgeWorkStatsMerge )
+{
+    EdgeWorkStats work1;
+    work1.add(EDGE_STAGE::SCORE, EDGE_WORK::READS_RETAINED, 4);
+    work1.add(EDGE_STAGE::ASSEMBLY, EDGE_WORK::DP_CELLS, 1000);
+
+    EdgeWorkStats work2;
+    work2.add(EDGE_STAGE::SCORE, EDGE_WORK::READS_RETAINED, 6);
+
+    work1.merge(work2);
+    BOOST_REQUIRE_EQUAL(work1.get(EDGE_STAGE::SCORE, EDGE_WORK::READS_RETAINED), 10u);
+    BOOST_REQUIRE_EQUAL(work1.get(EDGE_STAGE::ASSEMBLY, EDGE_WORK::DP_CELLS), 1000u);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
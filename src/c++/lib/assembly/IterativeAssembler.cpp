@@ -900,7 +900,7 @@ selectContigs(
 }
 
 
-void
+unsigned
 runIterativeAssembler(
     const IterativeAssemblerOptions& opt,
     AssemblyReadInput& reads,
@@ -918,8 +918,10 @@ runIterativeAssembler(
     readInfo.resize(reads.size());
     Assembly iterativeContigs;
 
+    unsigned wordLengthCount(0);
     for (unsigned wordLength(opt.minWordLength); wordLength<=opt.maxWordLength; wordLength+=opt.wordStepSize)
     {
+        wordLengthCount++;
 #ifdef DEBUG_ASBL
         log_os << logtag << "Try " << wordLength << "-mer.\n";
 #endif
@@ -992,4 +994,6 @@ runIterativeAssembler(
         index++;
     }
 #endif
+
+    return wordLengthCount;
 }
@@ -37,7 +37,9 @@
 /// \param[out] assembledReadInfo for each read in 'reads', provide information on if and how it was assembled into a contig
 /// \param[out] contigs zero to many assembled contigs
 ///
-void
+/// \return the number of word lengths attempted
+///
+unsigned
 runIterativeAssembler(
     const IterativeAssemblerOptions& opt,
     AssemblyReadInput& reads,
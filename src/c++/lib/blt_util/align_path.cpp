@@ -85,6 +85,16 @@ operator<<(std::ostream& os, const path_t& apath)
 void
 cigar_to_apath(const char* cigar,
                path_t& apath)
+{
+    cigar_to_apath(cigar, nullptr, apath);
+}
+
+
+
+void
+cigar_to_apath(const char* cigar,
+               const char* cigar_end,
+               path_t& apath)
 {
     using illumina::blt_util::parse_unsigned;
 
@@ -94,7 +104,7 @@ cigar_to_apath(const char* cigar,
 
     path_segment lps;
     const char* cptr(cigar);
-    while (*cptr)
+    while ((cptr != cigar_end) && *cptr)
     {
         path_segment ps;
         // expect sequences of digits and cigar codes:
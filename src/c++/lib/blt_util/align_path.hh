@@ -223,6 +223,15 @@ void
 cigar_to_apath(const char* cigar,
                path_t& apath);
 
+/// \brief Convert the CIGAR string in [cigar,cigar_end) into apath format
+///
+/// this allows a CIGAR string embedded in a larger string (such as a BAM 'SA' tag) to be
+/// parsed without a copy
+void
+cigar_to_apath(const char* cigar,
+               const char* cigar_end,
+               path_t& apath);
+
 /// \return The read length spanned by the path
 unsigned
 apath_read_length(const path_t& apath);
@@ -47,3 +47,26 @@ add_alignment_to_depth_buffer(
     }
 }
 
+
+
+
+void
+add_alignment_to_depth_buffer(
+    const pos_t& pos,
+    const ALIGNPATH::path_t& apath,
+    depth_diff_buffer& db)
+{
+    using namespace ALIGNPATH;
+
+    pos_t ref_head_pos(pos);
+
+    for (const path_segment& ps : apath)
+    {
+        if ( is_segment_align_match(ps.type) )
+        {
+            db.inc(ref_head_pos, ref_head_pos+static_cast<pos_t>(ps.length));
+        }
+
+        if ( is_segment_type_ref_length(ps.type) ) ref_head_pos += ps.length;
+    }
+}
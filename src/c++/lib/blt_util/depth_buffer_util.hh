@@ -25,6 +25,7 @@
 
 #include "blt_util/align_path.hh"
 #include "blt_util/depth_buffer.hh"
+#include "blt_util/depth_diff_buffer.hh"
 
 
 /// parse alignment into depth buffer object:
@@ -34,3 +35,12 @@ add_alignment_to_depth_buffer(
     const pos_t& pos,
     const ALIGNPATH::path_t& apath,
     depth_buffer& db);
+
+
+/// parse alignment into depth difference buffer object:
+///
+void
+add_alignment_to_depth_buffer(
+    const pos_t& pos,
+    const ALIGNPATH::path_t& apath,
+    depth_diff_buffer& db);
@@ -0,0 +1,336 @@
+//
+// Manta - Structural Variant and Indel Caller
+// Copyright (c) 2013-2017 Illumina, Inc.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+//
+
+/// \file
+/// \author Chris Saunders
+///
+
+#include "depth_diff_buffer.hh"
+
+#include <algorithm>
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+
+
+/// sum n difference values
+static
+int
+sumDiff(
+    const int* diff,
+    const unsigned n)
+{
+    int sum(0);
+    for (unsigned i(0); i<n; ++i) sum += diff[i];
+    return sum;
+}
+
+
+
+#ifdef __SSE2__
+/// SSE2 lacks a signed 32 bit max, so emulate it with compare/mask:
+static inline
+__m128i
+max_epi32(
+    const __m128i a,
+    const __m128i b)
+{
+    const __m128i mask(_mm_cmpgt_epi32(a,b));
+    return _mm_or_si128(_mm_and_si128(mask,a),_mm_andnot_si128(mask,b));
+}
+#endif
+
+
+
+/// prefix sum n difference values starting from depth
+///
+/// \param[in,out] depth starting depth on input, depth after the last difference value on output
+/// \param[in,out] maxDepth updated to the max of its input value and all prefix sums
+static
+void
+scanDiffMax(
+    const int* diff,
+    const unsigned n,
+    int& depth,
+    int& maxDepth)
+{
+    unsigned i(0);
+#ifdef __SSE2__
+    if (n >= 4)
+    {
+        __m128i vdepth(_mm_set1_epi32(depth));
+        __m128i vmax(_mm_set1_epi32(maxDepth));
+        for (; (i+4)<=n; i+=4)
+        {
+            // in-register inclusive prefix sum of 4 values:
+            __m128i x(_mm_loadu_si128(reinterpret_cast<const __m128i*>(diff+i)));
+            x = _mm_add_epi32(x,_mm_slli_si128(x,4));
+            x = _mm_add_epi32(x,_mm_slli_si128(x,8));
+            x = _mm_add_epi32(x,vdepth);
+            vmax = max_epi32(vmax,x);
+            vdepth = _mm_shuffle_epi32(x,_MM_SHUFFLE(3,3,3,3));
+        }
+        vmax = max_epi32(vmax,_mm_shuffle_epi32(vmax,_MM_SHUFFLE(1,0,3,2)));
+        vmax = max_epi32(vmax,_mm_shuffle_epi32(vmax,_MM_SHUFFLE(2,3,0,1)));
+        maxDepth = _mm_cvtsi128_si32(vmax);
+        depth = _mm_cvtsi128_si32(vdepth);
+    }
+#endif
+    for (; i<n; ++i)
+    {
+        depth += diff[i];
+        maxDepth = std::max(maxDepth,depth);
+    }
+}
+
+
+
+static
+unsigned
+getPow2Size(
+    const unsigned minSize)
+{
+    unsigned size(1);
+    while (size < minSize) size *= 2;
+    return size;
+}
+
+
+
+depth_diff_buffer::
+depth_diff_buffer(
+    const unsigned compressionFactor,
+    const unsigned minCapacity)
+    : _csize(compressionFactor),
+      _halfcsize(_csize/2),
+      _diff(getPow2Size(std::max(minCapacity,_csize*2)),0),
+      _slotMask(_diff.size()-1),
+      _endPos(std::numeric_limits<pos_t>::max()),
+      _tailPos(0),
+      _tailDepth(0),
+      _headPos(0),
+      _headDepth(0),
+      _maxDiffPos(-1)
+{
+    assert(_csize>=1);
+}
+
+
+
+template <typename F>
+void
+depth_diff_buffer::
+forEachSegment(
+    const pos_t beginPos,
+    const pos_t endPos,
+    F func) const
+{
+    if (endPos <= beginPos) return;
+    assert(static_cast<unsigned>(endPos-beginPos) <= _diff.size());
+
+    const unsigned beginSlot(slotIndex(beginPos));
+    const unsigned size(endPos-beginPos);
+    const unsigned size1(std::min(size,static_cast<unsigned>(_diff.size()-beginSlot)));
+    func(beginSlot,size1);
+    if (size1<size) func(0u,size-size1);
+}
+
+
+
+void
+depth_diff_buffer::
+reset(
+    const pos_t beginPos,
+    const pos_t endPos)
+{
+    // only clear the section of the ring buffer that was used:
+    forEachSegment(_tailPos, _maxDiffPos+1,
+                   [this](const unsigned slot, const unsigned n)
+    {
+        std::fill(_diff.begin()+slot, _diff.begin()+slot+n, 0);
+    });
+
+    _endPos = endPos;
+    _tailPos = beginPos - (beginPos % static_cast<pos_t>(_csize));
+    _tailDepth = 0;
+    _headPos = _tailPos;
+    _headDepth = 0;
+    _maxDiffPos = _tailPos-1;
+}
+
+
+
+void
+depth_diff_buffer::
+growToPos(const pos_t endPos)
+{
+    const unsigned minSize(endPos-_tailPos+1);
+    if (minSize <= _diff.size()) return;
+
+    std::vector<int> diff2(getPow2Size(minSize),0);
+    const unsigned slotMask2(diff2.size()-1);
+    for (pos_t pos(_tailPos); pos<=_maxDiffPos; ++pos)
+    {
+        diff2[static_cast<unsigned>(pos) & slotMask2] = _diff[slotIndex(pos)];
+    }
+    _diff.swap(diff2);
+    _slotMask = slotMask2;
+}
+
+
+
+void
+depth_diff_buffer::
+inc(
+    pos_t beginPos,
+    pos_t endPos)
+{
+    endPos = std::min(endPos,_endPos);
+    if (endPos <= std::max(beginPos,_tailPos)) return;
+
+    growToPos(endPos);
+
+    if (beginPos < _tailPos)
+    {
+        _tailDepth++;
+    }
+    else
+    {
+        _diff[slotIndex(beginPos)]++;
+        _maxDiffPos = std::max(_maxDiffPos,beginPos);
+    }
+    if (beginPos <= _headPos) _headDepth++;
+
+    if (endPos < _endPos)
+    {
+        _diff[slotIndex(endPos)]--;
+        _maxDiffPos = std::max(_maxDiffPos,endPos);
+        if (endPos <= _headPos) _headDepth--;
+    }
+}
+
+
+
+void
+depth_diff_buffer::
+moveHead(const pos_t pos)
+{
+    assert(pos >= _tailPos);
+
+    if (pos < _headPos)
+    {
+        // rewind:
+        _headPos = _tailPos;
+        _headDepth = _tailDepth;
+        if (_maxDiffPos >= _tailPos) _headDepth += _diff[slotIndex(_tailPos)];
+    }
+
+    if (pos == _headPos) return;
+
+    int sum(0);
+    forEachSegment(_headPos+1, std::min(pos,_maxDiffPos)+1,
+                   [&](const unsigned slot, const unsigned n)
+    {
+        sum += sumDiff(_diff.data()+slot,n);
+    });
+    _headDepth += sum;
+    _headPos = pos;
+}
+
+
+
+unsigned
+depth_diff_buffer::
+val(pos_t pos)
+{
+    pos = std::max(pos,_tailPos);
+
+    if (_csize == 1)
+    {
+        moveHead(pos);
+        return std::max(_headDepth,0);
+    }
+
+    const pos_t blockBeginPos(pos - (pos % static_cast<pos_t>(_csize)));
+    moveHead(blockBeginPos);
+
+    // sum depth over the compression block without moving the head:
+    int depth(_headDepth);
+    int blockSum(depth);
+    const pos_t blockEndPos(blockBeginPos+_csize);
+    for (pos_t blockPos(blockBeginPos+1); blockPos<blockEndPos; ++blockPos)
+    {
+        if (blockPos <= _maxDiffPos) depth += _diff[slotIndex(blockPos)];
+        blockSum += depth;
+    }
+    return ((std::max(blockSum,0)+_halfcsize)/_csize);
+}
+
+
+
+unsigned
+depth_diff_buffer::
+max_val(pos_t endPos) const
+{
+    endPos = std::min(endPos,_endPos);
+    if (endPos <= _tailPos) return 0;
+
+    int depth(_tailDepth);
+    int maxDepth(0);
+    forEachSegment(_tailPos, std::min(endPos,_maxDiffPos+1),
+                   [&](const unsigned slot, const unsigned n)
+    {
+        scanDiffMax(_diff.data()+slot,n,depth,maxDepth);
+    });
+
+    // depth is constant after the last difference value:
+    maxDepth = std::max(maxDepth,depth);
+    return maxDepth;
+}
+
+
+
+void
+depth_diff_buffer::
+clear_to_pos(const pos_t pos)
+{
+    pos_t newTailPos(pos+1);
+    newTailPos -= (newTailPos % static_cast<pos_t>(_csize));
+    if (newTailPos <= _tailPos) return;
+
+    // fold all dropped difference values into the tail depth:
+    forEachSegment(_tailPos, std::min(newTailPos,_maxDiffPos+1),
+                   [this](const unsigned slot, const unsigned n)
+    {
+        _tailDepth += sumDiff(_diff.data()+slot,n);
+        std::fill(_diff.begin()+slot, _diff.begin()+slot+n, 0);
+    });
+
+    _tailPos = newTailPos;
+    _maxDiffPos = std::max(_maxDiffPos,_tailPos-1);
+
+    if (_headPos < _tailPos)
+    {
+        _headPos = _tailPos;
+        _headDepth = _tailDepth;
+        if (_maxDiffPos >= _tailPos) _headDepth += _diff[slotIndex(_tailPos)];
+    }
+}
@@ -0,0 +1,136 @@
+//
+// Manta - Structural Variant and Indel Caller
+// Copyright (c) 2013-2017 Illumina, Inc.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+//
+
+/// \file
+/// \author Chris Saunders
+///
+
+#pragma once
+
+#include "blt_util/blt_types.hh"
+
+#include <cassert>
+
+#include <limits>
+#include <vector>
+
+
+/// \brief Approximate read depth tracker for position-sorted read input
+///
+/// Each read range [beginPos,endPos) is stored as a +1 at beginPos and a -1 at endPos in
+/// a difference array, so the cost of adding a read does not depend on its length. Depth
+/// is recovered by prefix summation from a scan head which normally only moves forward
+/// with the read input. Moving the scan head backwards is supported (this is required
+/// when several samples are streamed over the same window in sequence), but each such
+/// rewind restarts the prefix sum from the tail of the buffer.
+///
+/// The difference array is held in a power-of-two ring buffer covering [tail,tail+capacity).
+/// The buffer is only reallocated if a read extends beyond the current capacity, so in
+/// a typical application the buffer reaches a steady size after the first few reads.
+///
+/// Optionally, depth queries can be "compressed" to return the mean depth of the block of
+/// compressionFactor positions containing the query position, which matches the values
+/// returned by depth_buffer_compressible.
+///
+struct depth_diff_buffer
+{
+    explicit
+    depth_diff_buffer(
+        const unsigned compressionFactor = 1,
+        const unsigned minCapacity = 1024);
+
+    /// \brief Clear all depth and restart the buffer at beginPos
+    ///
+    /// \param[in] endPos if specified, depth is not tracked at or after this position
+    void
+    reset(
+        const pos_t beginPos,
+        const pos_t endPos = std::numeric_limits<pos_t>::max());
+
+    /// \brief Increment depth in range [beginPos,endPos) by one
+    void
+    inc(
+        pos_t beginPos,
+        pos_t endPos);
+
+    /// \brief Return depth at pos
+    ///
+    /// The scan head is moved to pos, so queries should follow the read input order for
+    /// this to be efficient.
+    unsigned
+    val(const pos_t pos);
+
+    /// \brief Return the maximum depth in [tail,endPos)
+    unsigned
+    max_val(const pos_t endPos) const;
+
+    /// \brief Drop all depth information for positions up to and including pos
+    ///
+    /// If compressionFactor is gt 1, the buffer is only cleared up to the end of the
+    /// last complete compression block.
+    void
+    clear_to_pos(const pos_t pos);
+
+private:
+
+    unsigned
+    slotIndex(const pos_t pos) const
+    {
+        return (static_cast<unsigned>(pos) & _slotMask);
+    }
+
+    /// Move the scan head to pos
+    void
+    moveHead(const pos_t pos);
+
+    /// Reallocate the ring buffer so that it can hold endPos
+    void
+    growToPos(const pos_t endPos);
+
+    /// Apply func to each contiguous ring buffer segment covering [beginPos,endPos)
+    template <typename F>
+    void
+    forEachSegment(
+        const pos_t beginPos,
+        const pos_t endPos,
+        F func) const;
+
+    const unsigned _csize;
+    const unsigned _halfcsize;
+
+    /// ring buffer of depth differences
+    std::vector<int> _diff;
+    unsigned _slotMask;
+
+    /// depth is not tracked at or after this position
+    pos_t _endPos;
+
+    /// all positions before _tailPos have been dropped from the buffer
+    pos_t _tailPos;
+
+    /// sum of all depth differences dropped from the buffer
+    int _tailDepth;
+
+    /// prefix sum position and the depth at this position
+    pos_t _headPos;
+    int _headDepth;
+
+    /// all difference values stored in the buffer are in [_tailPos,_maxDiffPos]
+    pos_t _maxDiffPos;
+};
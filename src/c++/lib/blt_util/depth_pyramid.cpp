@@ -0,0 +1,555 @@
+//
+// Manta - Structural Variant and Indel Caller
+// Copyright (c) 2013-2017 Illumina, Inc.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+//
+
+/// \file
+/// \author Chris Saunders
+///
+
+#include "blt_util/depth_pyramid.hh"
+#include "blt_util/blt_exception.hh"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+
+
+// File layout:
+//
+// header: magic[8] version(u32) contigCount(u32) indexOffset(u64)
+// data: for each contig and pyramid level, the stored depth_bin records of the level
+// index: for each contig, nameLength(u32) name length(u32) firstBin(u32) binCount(u32) binsOffset(u64)[level_count]
+//
+// For each level, the stored bins cover all bins of that level intersecting the stored base-level bin range.
+//
+static const char mapMagic[8] = {'M','N','T','A','D','P','T','H'};
+static const uint32_t mapVersion(1);
+static const uint64_t headerSize(24);
+
+const pos_t depth_pyramid::base_bin_size;
+const unsigned depth_pyramid::level_factor;
+const unsigned depth_pyramid::level_count;
+
+static const depth_bin emptyBin;
+
+
+
+static
+void
+throwMapError(
+    const std::string& filename,
+    const char* msg)
+{
+    std::ostringstream oss;
+    oss << "ERROR: " << msg << " in depth map '" << filename << "'\n";
+    throw blt_exception(oss.str().c_str());
+}
+
+
+
+/// read a value from the mapped file with bounds checking
+template <typename T>
+static
+T
+readMapValue(
+    const std::string& filename,
+    const uint8_t* data,
+    const size_t size,
+    uint64_t& offset)
+{
+    if ((offset+sizeof(T)) > size) throwMapError(filename, "Unexpected end of data");
+    T val;
+    memcpy(&val, data+offset, sizeof(T));
+    offset += sizeof(T);
+    return val;
+}
+
+
+
+/// \return the number of bins at level covering the base-level bin range [firstBin,firstBin+binCount)
+static
+uint32_t
+getLevelBinCount(
+    const uint32_t firstBin,
+    const uint32_t binCount,
+    const unsigned level)
+{
+    if (binCount == 0) return 0;
+    uint32_t span(1);
+    for (unsigned i(0); i<level; ++i) span *= depth_pyramid::level_factor;
+    return ((firstBin+binCount-1)/span) - (firstBin/span) + 1;
+}
+
+
+
+/// \return the number of base-level bins of a contig
+static
+uint32_t
+getContigBinCount(const pos_t length)
+{
+    return (length + depth_pyramid::base_bin_size - 1) / depth_pyramid::base_bin_size;
+}
+
+
+
+depth_pyramid::
+depth_pyramid(const std::string& filename)
+    : _filename(filename)
+{
+    const int fd(open(filename.c_str(), O_RDONLY));
+    if (fd < 0)
+    {
+        std::ostringstream oss;
+        oss << "ERROR: Can't open depth map '" << filename << "'\n";
+        throw blt_exception(oss.str().c_str());
+    }
+
+    struct stat fileStat;
+    if ((fstat(fd, &fileStat) != 0) || (fileStat.st_size < static_cast<off_t>(headerSize)))
+    {
+        ::close(fd);
+        throwMapError(filename, "Unexpected file size");
+    }
+    _size = fileStat.st_size;
+
+    _data = mmap(nullptr, _size, PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (_data == MAP_FAILED)
+    {
+        _data = nullptr;
+        throwMapError(filename, "Can't memory map file");
+    }
+
+    try
+    {
+        const uint8_t* data(static_cast<const uint8_t*>(_data));
+        if (memcmp(data, mapMagic, sizeof(mapMagic)) != 0)
+        {
+            throwMapError(filename, "Unrecognized file type");
+        }
+
+        uint64_t offset(sizeof(mapMagic));
+        const uint32_t version(readMapValue<uint32_t>(filename, data, _size, offset));
+        if (version != mapVersion) throwMapError(filename, "Unsupported version");
+        const uint32_t contigCount(readMapValue<uint32_t>(filename, data, _size, offset));
+        offset = readMapValue<uint64_t>(filename, data, _size, offset);
+
+        _contigs.resize(contigCount);
+        for (contig_info& contig : _contigs)
+        {
+            const uint32_t nameLength(readMapValue<uint32_t>(filename, data, _size, offset));
+            if ((offset+nameLength) > _size) throwMapError(filename, "Unexpected end of data");
+            contig.name.assign(reinterpret_cast<const char*>(data+offset), nameLength);
+            offset += nameLength;
+
+            contig.length = readMapValue<uint32_t>(filename, data, _size, offset);
+            contig.first_bin = readMapValue<uint32_t>(filename, data, _size, offset);
+            contig.bin_count = readMapValue<uint32_t>(filename, data, _size, offset);
+            if ((contig.first_bin+contig.bin_count) > getContigBinCount(contig.length))
+            {
+                throwMapError(filename, "Invalid contig bin range");
+            }
+
+            for (unsigned level(0); level<level_count; ++level)
+            {
+                const uint64_t binsOffset(readMapValue<uint64_t>(filename, data, _size, offset));
+                const uint64_t binsSize(getLevelBinCount(contig.first_bin, contig.bin_count, level)*sizeof(depth_bin));
+                if (((binsOffset+binsSize) > _size) || ((binsOffset % alignof(depth_bin)) != 0))
+                {
+                    throwMapError(filename, "Invalid contig data offset");
+                }
+                contig.bins[level] = reinterpret_cast<const depth_bin*>(data + binsOffset);
+            }
+        }
+    }
+    catch (...)
+    {
+        munmap(_data, _size);
+        throw;
+    }
+}
+
+
+
+depth_pyramid::
+~depth_pyramid()
+{
+    if (_data != nullptr) munmap(_data, _size);
+}
+
+
+
+const depth_bin&
+depth_pyramid::
+get_level_bin(
+    const unsigned contigIndex,
+    const unsigned level,
+    const uint32_t levelBinIndex) const
+{
+    const contig_info& contig(_contigs[contigIndex]);
+    if (contig.bin_count == 0) return emptyBin;
+
+    uint32_t span(1);
+    for (unsigned i(0); i<level; ++i) span *= level_factor;
+
+    const uint32_t levelFirstBin(contig.first_bin/span);
+    if (levelBinIndex < levelFirstBin) return emptyBin;
+    const uint32_t levelBinOffset(levelBinIndex-levelFirstBin);
+    if (levelBinOffset >= getLevelBinCount(contig.first_bin, contig.bin_count, level)) return emptyBin;
+    return contig.bins[level][levelBinOffset];
+}
+
+
+
+const depth_bin&
+depth_pyramid::
+get_bin(
+    const unsigned contigIndex,
+    const pos_t pos) const
+{
+    if (pos < 0) return emptyBin;
+    return get_level_bin(contigIndex, 0, pos/base_bin_size);
+}
+
+
+
+depth_bin
+depth_pyramid::
+get_range_summary(
+    const unsigned contigIndex,
+    pos_t beginPos,
+    pos_t endPos) const
+{
+    depth_bin summary;
+
+    beginPos = std::max(beginPos, 0);
+    endPos = std::min(endPos, get_contig_length(contigIndex));
+    if (beginPos >= endPos) return summary;
+
+    // cover the range with the coarsest bins aligned to the current position which fit in the range:
+    const uint32_t lastBin((endPos-1)/base_bin_size);
+    bool isFirst(true);
+    for (uint32_t binIndex(beginPos/base_bin_size); binIndex<=lastBin;)
+    {
+        unsigned level(level_count-1);
+        uint32_t span(1);
+        for (unsigned i(0); i<level; ++i) span *= level_factor;
+        while ((level > 0) && (((binIndex % span) != 0) || ((binIndex+span-1) > lastBin)))
+        {
+            level--;
+            span /= level_factor;
+        }
+
+        const depth_bin& bin(get_level_bin(contigIndex, level, binIndex/span));
+        summary.base_count += bin.base_count;
+        summary.read_count += bin.read_count;
+        summary.mq0_read_count += bin.mq0_read_count;
+        if (isFirst)
+        {
+            summary.min_depth = bin.min_depth;
+            summary.max_depth = bin.max_depth;
+            isFirst = false;
+        }
+        else
+        {
+            summary.min_depth = std::min(summary.min_depth, bin.min_depth);
+            summary.max_depth = std::max(summary.max_depth, bin.max_depth);
+        }
+        binIndex += span;
+    }
+    return summary;
+}
+
+
+
+void
+depth_pyramid_builder::
+add_contig(
+    const std::string& name,
+    const pos_t length)
+{
+    _contigs.emplace_back();
+    _contigs.back().name = name;
+    _contigs.back().length = length;
+}
+
+
+
+depth_pyramid_builder::contig_counts&
+depth_pyramid_builder::
+get_contig_bins(const unsigned contigIndex)
+{
+    assert(contigIndex < _contigs.size());
+    contig_counts& contig(_contigs[contigIndex]);
+    if (contig.bins.empty())
+    {
+        contig.bins.resize(getContigBinCount(contig.length));
+    }
+    return contig;
+}
+
+
+
+void
+depth_pyramid_builder::
+merge_bin(
+    contig_counts& contig,
+    const uint32_t binIndex,
+    const bin_counts& counts)
+{
+    assert(binIndex < contig.bins.size());
+    bin_counts& bin(contig.bins[binIndex]);
+    bin.base_count += counts.base_count;
+    bin.read_count += counts.read_count;
+    bin.mq0_read_count += counts.mq0_read_count;
+    contig.begin_bin = std::min(contig.begin_bin, binIndex);
+    contig.end_bin = std::max(contig.end_bin, binIndex+1);
+}
+
+
+
+void
+depth_pyramid_builder::
+add_read(
+    const unsigned contigIndex,
+    pos_t beginPos,
+    pos_t endPos,
+    const bool isMQ0)
+{
+    contig_counts& contig(get_contig_bins(contigIndex));
+    if ((beginPos < 0) || (beginPos >= contig.length)) return;
+    endPos = std::min(endPos, contig.length);
+
+    bin_counts readCounts;
+    readCounts.read_count = 1;
+    readCounts.mq0_read_count = (isMQ0 ? 1 : 0);
+    merge_bin(contig, (beginPos/depth_pyramid::base_bin_size), readCounts);
+
+    while (beginPos < endPos)
+    {
+        const uint32_t binIndex(beginPos/depth_pyramid::base_bin_size);
+        const pos_t binEndPos(std::min(endPos, static_cast<pos_t>((binIndex+1)*depth_pyramid::base_bin_size)));
+        bin_counts baseCounts;
+        baseCounts.base_count = (binEndPos-beginPos);
+        merge_bin(contig, binIndex, baseCounts);
+        beginPos = binEndPos;
+    }
+}
+
+
+
+void
+depth_pyramid_builder::
+merge(const depth_pyramid_builder& rhs)
+{
+    if (_contigs.empty())
+    {
+        *this = rhs;
+        return;
+    }
+
+    if (rhs._contigs.size() != _contigs.size())
+    {
+        throw blt_exception("ERROR: Can't merge depth maps with different contig counts\n");
+    }
+
+    const unsigned contigCount(_contigs.size());
+    for (unsigned contigIndex(0); contigIndex<contigCount; ++contigIndex)
+    {
+        const contig_counts& rhsContig(rhs._contigs[contigIndex]);
+        if ((rhsContig.name != _contigs[contigIndex].name) || (rhsContig.length != _contigs[contigIndex].length))
+        {
+            std::ostringstream oss;
+            oss << "ERROR: Can't merge depth maps with different contigs: '" << rhsContig.name << "' and '"
+                << _contigs[contigIndex].name << "'\n";
+            throw blt_exception(oss.str().c_str());
+        }
+
+        if (rhsContig.begin_bin >= rhsContig.end_bin) continue;
+        contig_counts& contig(get_contig_bins(contigIndex));
+        for (uint32_t binIndex(rhsContig.begin_bin); binIndex<rhsContig.end_bin; ++binIndex)
+        {
+            merge_bin(contig, binIndex, rhsContig.bins[binIndex]);
+        }
+    }
+}
+
+
+
+void
+depth_pyramid_builder::
+merge(const depth_pyramid& rhs)
+{
+    if (_contigs.empty())
+    {
+        for (unsigned contigIndex(0); contigIndex<rhs.contig_count(); ++contigIndex)
+        {
+            add_contig(rhs.get_contig_name(contigIndex), rhs.get_contig_length(contigIndex));
+        }
+    }
+
+    if (rhs.contig_count() != _contigs.size())
+    {
+        throw blt_exception("ERROR: Can't merge depth maps with different contig counts\n");
+    }
+
+    const unsigned contigCount(_contigs.size());
+    for (unsigned contigIndex(0); contigIndex<contigCount; ++contigIndex)
+    {
+        if ((rhs.get_contig_name(contigIndex) != _contigs[contigIndex].name) ||
+            (rhs.get_contig_length(contigIndex) != _contigs[contigIndex].length))
+        {
+            std::ostringstream oss;
+            oss << "ERROR: Can't merge depth maps with different contigs: '" << rhs.get_contig_name(contigIndex)
+                << "' and '" << _contigs[contigIndex].name << "'\n";
+            throw blt_exception(oss.str().c_str());
+        }
+
+        const std::pair<uint32_t,uint32_t> binRange(rhs.get_stored_bin_range(contigIndex));
+        if (binRange.first >= binRange.second) continue;
+        contig_counts& contig(get_contig_bins(contigIndex));
+        for (uint32_t binIndex(binRange.first); binIndex<binRange.second; ++binIndex)
+        {
+            const depth_bin& bin(rhs.get_base_bin(contigIndex, binIndex));
+            bin_counts counts;
+            counts.base_count = bin.base_count;
+            counts.read_count = bin.read_count;
+            counts.mq0_read_count = bin.mq0_read_count;
+            merge_bin(contig, binIndex, counts);
+        }
+    }
+}
+
+
+
+template <typename T>
+static
+void
+writeMapValue(
+    std::ofstream& ofs,
+    const T val)
+{
+    ofs.write(reinterpret_cast<const char*>(&val), sizeof(T));
+}
+
+
+
+void
+depth_pyramid_builder::
+write(const std::string& filename) const
+{
+    std::ofstream ofs(filename.c_str(), std::ios::binary);
+    if (! ofs)
+    {
+        std::ostringstream oss;
+        oss << "ERROR: Can't open depth map for writing: '" << filename << "'\n";
+        throw blt_exception(oss.str().c_str());
+    }
+
+    // write a placeholder header, which is completed after the contig index:
+    const std::string header(headerSize,'\0');
+    ofs.write(header.data(), header.size());
+    uint64_t offset(headerSize);
+
+    std::vector<std::vector<uint64_t>> binsOffsets(_contigs.size());
+    std::vector<depth_bin> levelBins;
+    for (unsigned contigIndex(0); contigIndex<_contigs.size(); ++contigIndex)
+    {
+        const contig_counts& contig(_contigs[contigIndex]);
+        const bool isEmpty(contig.begin_bin >= contig.end_bin);
+        const uint32_t contigBinCount(getContigBinCount(contig.length));
+
+        uint32_t span(1);
+        for (unsigned level(0); level<depth_pyramid::level_count; ++level)
+        {
+            levelBins.clear();
+            if (! isEmpty)
+            {
+                for (uint32_t levelBinIndex(contig.begin_bin/span); levelBinIndex<=((contig.end_bin-1)/span); ++levelBinIndex)
+                {
+                    depth_bin levelBin;
+                    const uint32_t endBin(std::min(contigBinCount, (levelBinIndex+1)*span));
+                    for (uint32_t binIndex(levelBinIndex*span); binIndex<endBin; ++binIndex)
+                    {
+                        const bin_counts& bin(contig.bins[binIndex]);
+                        const pos_t binSize(std::min(depth_pyramid::base_bin_size,
+                                                     contig.length - static_cast<pos_t>(binIndex*depth_pyramid::base_bin_size)));
+                        const float depth(static_cast<float>(bin.base_count)/binSize);
+
+                        if (binIndex == (levelBinIndex*span))
+                        {
+                            levelBin.min_depth = depth;
+                            levelBin.max_depth = depth;
+                        }
+                        else
+                        {
+                            levelBin.min_depth = std::min(levelBin.min_depth, depth);
+                            levelBin.max_depth = std::max(levelBin.max_depth, depth);
+                        }
+                        levelBin.base_count += bin.base_count;
+                        levelBin.read_count += bin.read_count;
+                        levelBin.mq0_read_count += bin.mq0_read_count;
+                    }
+                    levelBins.push_back(levelBin);
+                }
+            }
+
+            binsOffsets[contigIndex].push_back(offset);
+            ofs.write(reinterpret_cast<const char*>(levelBins.data()), levelBins.size()*sizeof(depth_bin));
+            offset += levelBins.size()*sizeof(depth_bin);
+            span *= depth_pyramid::level_factor;
+        }
+    }
+
+    const uint64_t indexOffset(offset);
+    for (unsigned contigIndex(0); contigIndex<_contigs.size(); ++contigIndex)
+    {
+        const contig_counts& contig(_contigs[contigIndex]);
+        const bool isEmpty(contig.begin_bin >= contig.end_bin);
+        writeMapValue<uint32_t>(ofs, contig.name.size());
+        ofs.write(contig.name.data(), contig.name.size());
+        writeMapValue<uint32_t>(ofs, contig.length);
+        writeMapValue<uint32_t>(ofs, (isEmpty ? 0 : contig.begin_bin));
+        writeMapValue<uint32_t>(ofs, (isEmpty ? 0 : (contig.end_bin-contig.begin_bin)));
+        for (const uint64_t binsOffset : binsOffsets[contigIndex])
+        {
+            writeMapValue<uint64_t>(ofs, binsOffset);
+        }
+    }
+
+    ofs.seekp(0);
+    ofs.write(mapMagic, sizeof(mapMagic));
+    writeMapValue<uint32_t>(ofs, mapVersion);
+    writeMapValue<uint32_t>(ofs, _contigs.size());
+    writeMapValue<uint64_t>(ofs, indexOffset);
+    ofs.close();
+
+    if (! ofs)
+    {
+        std::ostringstream oss;
+        oss << "ERROR: Failed to write depth map '" << filename << "'\n";
+        throw blt_exception(oss.str().c_str());
+    }
+}
@@ -0,0 +1,229 @@
+//
+// Manta - Structural Variant and Indel Caller
+// Copyright (c) 2013-2017 Illumina, Inc.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+//
+
+/// \file
+/// \author Chris Saunders
+///
+
+#pragma once
+
+#include "blt_util/blt_types.hh"
+
+#include "boost/noncopyable.hpp"
+
+#include <cstdint>
+
+#include <string>
+#include <utility>
+#include <vector>
+
+
+/// \brief Read depth and MAPQ0 summary of one bin of a depth pyramid
+///
+/// For a single base-level bin min_depth and max_depth are both the mean depth of the bin. For coarser bins
+/// these are the minimum and maximum mean depth over all base-level bins within the bin.
+///
+struct depth_bin
+{
+    /// total aligned bases over the bin
+    uint64_t base_count = 0;
+    /// number of reads starting in the bin
+    uint32_t read_count = 0;
+    /// number of MAPQ0 reads starting in the bin
+    uint32_t mq0_read_count = 0;
+    float min_depth = 0;
+    float max_depth = 0;
+};
+
+
+/// \brief Read-only multi-resolution map of read depth and MAPQ0 read counts over the genome
+///
+/// The map is stored as a pyramid of bins at 1kb, 16kb and 256kb resolution, so that the depth summary
+/// for any genome range is found from a small number of bins, independent of the range size. The map file
+/// is memory mapped read-only, so that all processes on one host using the same map share a single copy.
+///
+/// Contigs are stored in alignment file header order, so the contig index is the alignment target id.
+///
+/// The map is stored in host byte order, it is intended to be built once per run and read on the same host.
+///
+struct depth_pyramid : private boost::noncopyable
+{
+    /// size of the bins in the finest pyramid level
+    static const pos_t base_bin_size = 1024;
+
+    /// number of bins of each level combined into one bin of the next level
+    static const unsigned level_factor = 16;
+
+    static const unsigned level_count = 3;
+
+    /// map the depth pyramid in filename, throws if the file is not a valid depth pyramid
+    explicit
+    depth_pyramid(const std::string& filename);
+
+    ~depth_pyramid();
+
+    unsigned
+    contig_count() const
+    {
+        return _contigs.size();
+    }
+
+    const std::string&
+    get_contig_name(const unsigned contigIndex) const
+    {
+        return _contigs[contigIndex].name;
+    }
+
+    pos_t
+    get_contig_length(const unsigned contigIndex) const
+    {
+        return _contigs[contigIndex].length;
+    }
+
+    /// \return the base-level bin containing pos, or an empty bin if pos is outside of the contig
+    const depth_bin&
+    get_bin(
+        const unsigned contigIndex,
+        const pos_t pos) const;
+
+    /// get the depth summary of all base-level bins intersecting the zero-indexed, closed-open range [beginPos,endPos)
+    ///
+    /// The summary is found from at most 2*(level_factor-1) bins per level, so the lookup cost is independent
+    /// of the range size.
+    ///
+    /// \return summary of the range, base and read counts are summed over all bins intersecting the range,
+    ///         min/max depth are the extremes of base-level bin mean depth over these bins
+    depth_bin
+    get_range_summary(
+        const unsigned contigIndex,
+        const pos_t beginPos,
+        const pos_t endPos) const;
+
+    /// \return the base-level bin index range [begin,end) stored for the contig, all other bins are empty
+    std::pair<uint32_t,uint32_t>
+    get_stored_bin_range(const unsigned contigIndex) const
+    {
+        const contig_info& contig(_contigs[contigIndex]);
+        return std::make_pair(contig.first_bin, contig.first_bin+contig.bin_count);
+    }
+
+    /// \return the base-level bin at binIndex, or an empty bin if binIndex is not stored
+    const depth_bin&
+    get_base_bin(
+        const unsigned contigIndex,
+        const uint32_t binIndex) const
+    {
+        return get_level_bin(contigIndex, 0, binIndex);
+    }
+
+private:
+    const depth_bin&
+    get_level_bin(
+        const unsigned contigIndex,
+        const unsigned level,
+        const uint32_t levelBinIndex) const;
+
+    struct contig_info
+    {
+        std::string name;
+        pos_t length = 0;
+        /// stored range of base-level bins
+        uint32_t first_bin = 0;
+        uint32_t bin_count = 0;
+        const depth_bin* bins[level_count] = {};
+    };
+
+    std::string _filename;
+    void* _data = nullptr;
+    size_t _size = 0;
+    std::vector<contig_info> _contigs;
+};
+
+
+
+/// \brief Accumulate read depth and MAPQ0 counts from alignments and write them as a depth pyramid file
+///
+/// Each read is expected to be added once, by the process which scans its start position. Partial maps
+/// from several processes can be combined with merge.
+///
+struct depth_pyramid_builder
+{
+    /// add a contig, contigs must be added in alignment file header order
+    void
+    add_contig(
+        const std::string& name,
+        const pos_t length);
+
+    unsigned
+    contig_count() const
+    {
+        return _contigs.size();
+    }
+
+    /// add a read starting at beginPos and covering the reference range [beginPos,endPos), the range is
+    /// clipped to the contig boundaries
+    void
+    add_read(
+        const unsigned contigIndex,
+        const pos_t beginPos,
+        const pos_t endPos,
+        const bool isMQ0);
+
+    /// add all counts from another builder with the same contigs
+    void
+    merge(const depth_pyramid_builder& rhs);
+
+    /// add all counts from a depth pyramid file with the same contigs
+    void
+    merge(const depth_pyramid& rhs);
+
+    /// write the depth pyramid file
+    void
+    write(const std::string& filename) const;
+
+private:
+    struct bin_counts
+    {
+        uint64_t base_count = 0;
+        uint32_t read_count = 0;
+        uint32_t mq0_read_count = 0;
+    };
+
+    struct contig_counts
+    {
+        std::string name;
+        pos_t length = 0;
+        /// all bins of the contig, allocated on first use
+        std::vector<bin_counts> bins;
+        /// range [begin_bin,end_bin) of bins with non-zero counts, empty if no reads have been added
+        uint32_t begin_bin = UINT32_MAX;
+        uint32_t end_bin = 0;
+    };
+
+    contig_counts&
+    get_contig_bins(const unsigned contigIndex);
+
+    void
+    merge_bin(
+        contig_counts& contig,
+        const uint32_t binIndex,
+        const bin_counts& counts);
+
+    std::vector<contig_counts> _contigs;
+};
@@ -0,0 +1,445 @@
+//
+// Manta - Structural Variant and Indel Caller
+// Copyright (c) 2013-2017 Illumina, Inc.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+//
+
+/// \file
+/// \author Chris Saunders
+///
+
+#include "blt_util/packed_reference.hh"
+#include "blt_util/blt_exception.hh"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cassert>
+#include <cstring>
+
+#include <map>
+#include <memory>
+#include <mutex>
+#include <sstream>
+
+
+// Image layout:
+//
+// header: magic[8] version(u32) contigCount(u32) indexOffset(u64)
+// data: for each contig, 2-bit packed bases followed by N-run (begin,end) u32 pairs, each block aligned to 8 bytes
+// index: for each contig, nameLength(u32) name length(u32) nrunCount(u32) basesOffset(u64) nrunsOffset(u64)
+//
+static const char imageMagic[8] = {'M','N','T','A','2','B','I','T'};
+static const uint32_t imageVersion(1);
+static const uint64_t headerSize(24);
+static const uint64_t dataAlignment(8);
+
+static const char baseSymbols[] = "ACGT";
+
+
+
+static
+void
+throwImageError(
+    const std::string& filename,
+    const char* msg)
+{
+    std::ostringstream oss;
+    oss << "ERROR: " << msg << " in packed reference image '" << filename << "'\n";
+    throw blt_exception(oss.str().c_str());
+}
+
+
+
+/// read a value from the mapped image with bounds checking
+template <typename T>
+static
+T
+readImageValue(
+    const std::string& filename,
+    const uint8_t* data,
+    const size_t size,
+    uint64_t& offset)
+{
+    if ((offset+sizeof(T)) > size) throwImageError(filename, "Unexpected end of data");
+    T val;
+    memcpy(&val, data+offset, sizeof(T));
+    offset += sizeof(T);
+    return val;
+}
+
+
+
+packed_reference::
+packed_reference(const std::string& filename)
+    : _filename(filename)
+{
+    const int fd(open(filename.c_str(), O_RDONLY));
+    if (fd < 0)
+    {
+        std::ostringstream oss;
+        oss << "ERROR: Can't open packed reference image '" << filename << "'\n";
+        throw blt_exception(oss.str().c_str());
+    }
+
+    struct stat fileStat;
+    if ((fstat(fd, &fileStat) != 0) || (fileStat.st_size < static_cast<off_t>(headerSize)))
+    {
+        ::close(fd);
+        throwImageError(filename, "Unexpected file size");
+    }
+    _size = fileStat.st_size;
+
+    _data = mmap(nullptr, _size, PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (_data == MAP_FAILED)
+    {
+        _data = nullptr;
+        throwImageError(filename, "Can't memory map file");
+    }
+
+    try
+    {
+        const uint8_t* data(static_cast<const uint8_t*>(_data));
+        if (memcmp(data, imageMagic, sizeof(imageMagic)) != 0)
+        {
+            throwImageError(filename, "Unrecognized file type");
+        }
+
+        uint64_t offset(sizeof(imageMagic));
+        const uint32_t version(readImageValue<uint32_t>(filename, data, _size, offset));
+        if (version != imageVersion) throwImageError(filename, "Unsupported version");
+        const uint32_t contigCount(readImageValue<uint32_t>(filename, data, _size, offset));
+        offset = readImageValue<uint64_t>(filename, data, _size, offset);
+
+        _contigs.resize(contigCount);
+        for (unsigned contigIndex(0); contigIndex<contigCount; ++contigIndex)
+        {
+            contig_info& contig(_contigs[contigIndex]);
+            const uint32_t nameLength(readImageValue<uint32_t>(filename, data, _size, offset));
+            if ((offset+nameLength) > _size) throwImageError(filename, "Unexpected end of data");
+            contig.name.assign(reinterpret_cast<const char*>(data+offset), nameLength);
+            offset += nameLength;
+
+            contig.length = readImageValue<uint32_t>(filename, data, _size, offset);
+            contig.nrun_count = readImageValue<uint32_t>(filename, data, _size, offset);
+            const uint64_t basesOffset(readImageValue<uint64_t>(filename, data, _size, offset));
+            const uint64_t nrunsOffset(readImageValue<uint64_t>(filename, data, _size, offset));
+
+            const uint64_t basesSize((static_cast<uint64_t>(contig.length)+3)/4);
+            const uint64_t nrunsSize(static_cast<uint64_t>(contig.nrun_count)*2*sizeof(uint32_t));
+            if (((basesOffset+basesSize) > _size) ||
+                ((nrunsOffset+nrunsSize) > _size) ||
+                ((nrunsOffset % sizeof(uint32_t)) != 0))
+            {
+                throwImageError(filename, "Invalid contig data offset");
+            }
+            contig.bases = data + basesOffset;
+            contig.nruns = reinterpret_cast<const uint32_t*>(data + nrunsOffset);
+
+            _contigIndex[contig.name] = contigIndex;
+        }
+    }
+    catch (...)
+    {
+        munmap(_data, _size);
+        throw;
+    }
+}
+
+
+
+packed_reference::
+~packed_reference()
+{
+    if (_data != nullptr) munmap(_data, _size);
+}
+
+
+
+int
+packed_reference::
+get_contig_index(const std::string& contigName) const
+{
+    const auto iter(_contigIndex.find(contigName));
+    if (iter == _contigIndex.end()) return -1;
+    return iter->second;
+}
+
+
+
+/// \return the index of the first N-run ending after pos
+static
+uint32_t
+findNRun(
+    const uint32_t* nruns,
+    const uint32_t nrunCount,
+    const pos_t pos)
+{
+    uint32_t low(0);
+    uint32_t high(nrunCount);
+    while (low < high)
+    {
+        const uint32_t mid(low + (high-low)/2);
+        if (static_cast<pos_t>(nruns[2*mid+1]) <= pos)
+        {
+            low = mid+1;
+        }
+        else
+        {
+            high = mid;
+        }
+    }
+    return low;
+}
+
+
+
+char
+packed_reference::
+get_base(
+    const unsigned contigIndex,
+    const pos_t pos) const
+{
+    const contig_info& contig(_contigs[contigIndex]);
+    if ((pos < 0) || (pos >= contig.length)) return 'N';
+
+    const uint32_t nrunIndex(findNRun(contig.nruns, contig.nrun_count, pos));
+    if ((nrunIndex < contig.nrun_count) && (static_cast<pos_t>(contig.nruns[2*nrunIndex]) <= pos)) return 'N';
+
+    return baseSymbols[(contig.bases[pos/4] >> (2*(pos%4))) & 0x3];
+}
+
+
+
+void
+packed_reference::
+get_substring(
+    const unsigned contigIndex,
+    pos_t beginPos,
+    pos_t endPos,
+    std::string& seq) const
+{
+    const contig_info& contig(_contigs[contigIndex]);
+    beginPos = std::max(beginPos, 0);
+    endPos = std::min(endPos, contig.length);
+
+    seq.clear();
+    if (beginPos >= endPos) return;
+
+    seq.resize(endPos-beginPos);
+    for (pos_t pos(beginPos); pos<endPos; ++pos)
+    {
+        seq[pos-beginPos] = baseSymbols[(contig.bases[pos/4] >> (2*(pos%4))) & 0x3];
+    }
+
+    // overlay all N-runs intersecting the range:
+    for (uint32_t nrunIndex(findNRun(contig.nruns, contig.nrun_count, beginPos)); nrunIndex<contig.nrun_count; ++nrunIndex)
+    {
+        const pos_t nrunBegin(contig.nruns[2*nrunIndex]);
+        if (nrunBegin >= endPos) break;
+        const pos_t nrunEnd(contig.nruns[2*nrunIndex+1]);
+        for (pos_t pos(std::max(nrunBegin,beginPos)); pos<std::min(nrunEnd,endPos); ++pos)
+        {
+            seq[pos-beginPos] = 'N';
+        }
+    }
+}
+
+
+
+template <typename T>
+static
+void
+writeImageValue(
+    std::ofstream& ofs,
+    const T val)
+{
+    ofs.write(reinterpret_cast<const char*>(&val), sizeof(T));
+}
+
+
+
+packed_reference_writer::
+packed_reference_writer(const std::string& filename)
+    : _filename(filename),
+      _ofs(filename.c_str(), std::ios::binary),
+      _offset(0),
+      _isClosed(false)
+{
+    if (! _ofs)
+    {
+        std::ostringstream oss;
+        oss << "ERROR: Can't open packed reference image for writing: '" << filename << "'\n";
+        throw blt_exception(oss.str().c_str());
+    }
+
+    // write a placeholder header, which is completed on close:
+    const std::string header(headerSize,'\0');
+    _ofs.write(header.data(), header.size());
+    _offset = headerSize;
+}
+
+
+
+void
+packed_reference_writer::
+pad_to_alignment()
+{
+    while ((_offset % dataAlignment) != 0)
+    {
+        _ofs.put('\0');
+        _offset++;
+    }
+}
+
+
+
+void
+packed_reference_writer::
+add_contig(
+    const std::string& name,
+    const std::string& seq)
+{
+    assert(! _isClosed);
+
+    contig_record contig;
+    contig.name = name;
+    contig.length = seq.size();
+
+    std::vector<uint8_t> bases((seq.size()+3)/4, 0);
+    std::vector<uint32_t> nruns;
+    for (uint32_t pos(0); pos<contig.length; ++pos)
+    {
+        uint8_t code(0);
+        switch (seq[pos])
+        {
+        case 'A':
+            code = 0;
+            break;
+        case 'C':
+            code = 1;
+            break;
+        case 'G':
+            code = 2;
+            break;
+        case 'T':
+            code = 3;
+            break;
+        case 'N':
+            if ((! nruns.empty()) && (nruns.back() == pos))
+            {
+                nruns.back() = pos+1;
+            }
+            else
+            {
+                nruns.push_back(pos);
+                nruns.push_back(pos+1);
+            }
+            break;
+        default:
+        {
+            std::ostringstream oss;
+            oss << "ERROR: Unexpected character '" << seq[pos] << "' at position " << (pos+1)
+                << " of contig '" << name << "' while writing packed reference image '" << _filename << "'\n";
+            throw blt_exception(oss.str().c_str());
+        }
+        }
+        bases[pos/4] |= (code << (2*(pos%4)));
+    }
+
+    contig.bases_offset = _offset;
+    _ofs.write(reinterpret_cast<const char*>(bases.data()), bases.size());
+    _offset += bases.size();
+    pad_to_alignment();
+
+    contig.nruns_offset = _offset;
+    contig.nrun_count = nruns.size()/2;
+    _ofs.write(reinterpret_cast<const char*>(nruns.data()), nruns.size()*sizeof(uint32_t));
+    _offset += nruns.size()*sizeof(uint32_t);
+    pad_to_alignment();
+
+    _contigs.push_back(contig);
+}
+
+
+
+void
+packed_reference_writer::
+close()
+{
+    if (_isClosed) return;
+
+    const uint64_t indexOffset(_offset);
+    for (const contig_record& contig : _contigs)
+    {
+        writeImageValue<uint32_t>(_ofs, contig.name.size());
+        _ofs.write(contig.name.data(), contig.name.size());
+        writeImageValue<uint32_t>(_ofs, contig.length);
+        writeImageValue<uint32_t>(_ofs, contig.nrun_count);
+        writeImageValue<uint64_t>(_ofs, contig.bases_offset);
+        writeImageValue<uint64_t>(_ofs, contig.nruns_offset);
+    }
+
+    _ofs.seekp(0);
+    _ofs.write(imageMagic, sizeof(imageMagic));
+    writeImageValue<uint32_t>(_ofs, imageVersion);
+    writeImageValue<uint32_t>(_ofs, _contigs.size());
+    writeImageValue<uint64_t>(_ofs, indexOffset);
+    _ofs.close();
+
+    if (! _ofs)
+    {
+        std::ostringstream oss;
+        oss << "ERROR: Failed to write packed reference image '" << _filename << "'\n";
+        throw blt_exception(oss.str().c_str());
+    }
+    _isClosed = true;
+}
+
+
+
+typedef std::map<std::string,std::unique_ptr<packed_reference>> packed_reference_registry_t;
+
+static std::mutex packedReferenceRegistryMutex;
+static packed_reference_registry_t packedReferenceRegistry;
+
+
+
+void
+register_packed_reference(
+    const std::string& referenceFilename,
+    const std::string& imageFilename)
+{
+    std::unique_ptr<packed_reference> image(new packed_reference(imageFilename));
+    std::lock_guard<std::mutex> lock(packedReferenceRegistryMutex);
+    packedReferenceRegistry[referenceFilename] = std::move(image);
+}
+
+
+
+const packed_reference*
+get_packed_reference(
+    const std::string& referenceFilename)
+{
+    std::lock_guard<std::mutex> lock(packedReferenceRegistryMutex);
+    if (packedReferenceRegistry.empty()) return nullptr;
+    const auto iter(packedReferenceRegistry.find(referenceFilename));
+    if (iter == packedReferenceRegistry.end()) return nullptr;
+    return iter->second.get();
+}
@@ -0,0 +1,179 @@
+//
+// Manta - Structural Variant and Indel Caller
+// Copyright (c) 2013-2017 Illumina, Inc.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+//
+
+/// \file
+/// \author Chris Saunders
+///
+
+#pragma once
+
+#include "blt_util/blt_types.hh"
+
+#include "boost/noncopyable.hpp"
+
+#include <cstdint>
+
+#include <fstream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+
+/// \brief Read-only 2-bit packed image of a standardized reference sequence
+///
+/// The image is memory mapped read-only, so that all processes on one host reading the same image
+/// share a single copy of the reference through the page cache, and no per-process decoding from the
+/// FASTA file is required.
+///
+/// Each contig is stored as 2-bit encoded {A,C,G,T} bases, with runs of N stored separately as a sorted
+/// list of intervals. Other IUPAC codes are standardized to N before packing, so the image reproduces
+/// the standardized reference sequence exactly.
+///
+/// The image is stored in host byte order, it is intended to be built once per run and read on the
+/// same host.
+///
+struct packed_reference : private boost::noncopyable
+{
+    /// map the image in filename, throws if the file is not a valid image
+    explicit
+    packed_reference(const std::string& filename);
+
+    ~packed_reference();
+
+    const std::string&
+    filename() const
+    {
+        return _filename;
+    }
+
+    unsigned
+    contig_count() const
+    {
+        return _contigs.size();
+    }
+
+    /// \return contig index, or -1 if the contig is not in the image
+    int
+    get_contig_index(const std::string& contigName) const;
+
+    const std::string&
+    get_contig_name(const unsigned contigIndex) const
+    {
+        return _contigs[contigIndex].name;
+    }
+
+    pos_t
+    get_contig_length(const unsigned contigIndex) const
+    {
+        return _contigs[contigIndex].length;
+    }
+
+    /// \return the standardized base at pos, or 'N' for positions outside of the contig
+    char
+    get_base(
+        const unsigned contigIndex,
+        const pos_t pos) const;
+
+    /// get the standardized reference sequence for the zero-indexed, closed-open range [beginPos,endPos)
+    ///
+    /// the range is clipped to the contig boundaries, in the same manner as a faidx fetch
+    void
+    get_substring(
+        const unsigned contigIndex,
+        const pos_t beginPos,
+        const pos_t endPos,
+        std::string& seq) const;
+
+private:
+    struct contig_info
+    {
+        std::string name;
+        pos_t length = 0;
+        const uint8_t* bases = nullptr;
+        /// N-runs as consecutive closed-open [begin,end) position pairs
+        const uint32_t* nruns = nullptr;
+        uint32_t nrun_count = 0;
+    };
+
+    std::string _filename;
+    void* _data = nullptr;
+    size_t _size = 0;
+    std::vector<contig_info> _contigs;
+    std::unordered_map<std::string,unsigned> _contigIndex;
+};
+
+
+
+/// \brief Incrementally write a 2-bit packed reference image, one contig at a time
+///
+struct packed_reference_writer : private boost::noncopyable
+{
+    explicit
+    packed_reference_writer(const std::string& filename);
+
+    /// append one contig to the image
+    ///
+    /// \param[in] seq standardized contig sequence, containing only {A,C,G,T,N}
+    void
+    add_contig(
+        const std::string& name,
+        const std::string& seq);
+
+    /// write the contig index and close the image file
+    void
+    close();
+
+private:
+    void
+    pad_to_alignment();
+
+    struct contig_record
+    {
+        std::string name;
+        uint32_t length;
+        uint64_t bases_offset;
+        uint64_t nruns_offset;
+        uint32_t nrun_count;
+    };
+
+    std::string _filename;
+    std::ofstream _ofs;
+    uint64_t _offset;
+    std::vector<contig_record> _contigs;
+    bool _isClosed;
+};
+
+
+
+/// \brief Associate a packed image with a reference FASTA file for the lifetime of the process
+///
+/// Once registered, reference sequence requests for referenceFilename made through
+/// get_standardized_region_seq are served from the mapped image instead of the FASTA file.
+///
+/// This is intended to be called during program setup, before any worker threads are started.
+void
+register_packed_reference(
+    const std::string& referenceFilename,
+    const std::string& imageFilename);
+
+
+/// \return the packed image registered for referenceFilename, or nullptr if none has been registered
+const packed_reference*
+get_packed_reference(
+    const std::string& referenceFilename);
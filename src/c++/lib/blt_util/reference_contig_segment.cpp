@@ -0,0 +1,91 @@
+//
+// Manta - Structural Variant and Indel Caller
+// Copyright (c) 2013-2017 Illumina, Inc.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+//
+
+/// \file
+/// \author Chris Saunders
+///
+
+#include "blt_util/reference_contig_segment.hh"
+#include "blt_util/blt_exception.hh"
+#include "blt_util/packed_reference.hh"
+
+#include <algorithm>
+#include <sstream>
+
+
+
+void
+reference_contig_segment::
+set_packed_view(
+    const packed_reference& packedRef,
+    const unsigned contigIndex,
+    const pos_t beginPos,
+    const pos_t endPos)
+{
+    clear();
+    _offset=beginPos;
+    _packedRef=(&packedRef);
+    _contigIndex=contigIndex;
+    _packedSize=std::max(0,std::min(endPos,packedRef.get_contig_length(contigIndex))-beginPos);
+}
+
+
+
+char
+reference_contig_segment::
+get_packed_base(const pos_t pos) const
+{
+    return _packedRef->get_base(_contigIndex,pos);
+}
+
+
+
+void
+reference_contig_segment::
+get_packed_substring(
+    const pos_t pos,
+    const pos_t length,
+    std::string& substr) const
+{
+    _packedRef->get_substring(_contigIndex,pos,(pos+length),substr);
+}
+
+
+
+void
+reference_contig_segment::
+copy_packed_view()
+{
+    _packedRef->get_substring(_contigIndex,_offset,end(),_seq);
+    _packedRef=nullptr;
+    _packedSize=0;
+}
+
+
+
+void
+reference_contig_segment::
+throw_packed_view_seq() const
+{
+    std::ostringstream oss;
+    oss << "ERROR: Attempting to access the sequence of a packed reference view."
+        << " Contig: '" << _packedRef->get_contig_name(_contigIndex) << "'"
+        << " Range: [" << _offset << "," << end() << ")\n";
+    throw blt_exception(oss.str().c_str());
+}
@@ -28,6 +28,9 @@
 #include <string>
 
 
+struct packed_reference;
+
+
 /// \brief Manages a partial reference sequence segment
 ///
 /// This object holds a subset of the reference sequence within a specific [begin,end] range,
@@ -35,6 +38,11 @@
 /// the reference that is currently required (to save memory), but access the reference using
 /// the regular position coordinates of the full reference sequence.
 ///
+/// The segment can alternately be set up as a view of a range within a shared packed_reference
+/// image, so that the segment's bases are read from the mapped image instead of being copied into
+/// each process. Only the base and substring accessors are available from a view, the non-const
+/// seq() accessor copies the viewed range into the segment.
+///
 /// \TODO Do not expose internal reference storage object type.
 ///
 struct reference_contig_segment
@@ -47,6 +55,7 @@ struct reference_contig_segment
     get_base(const pos_t pos) const
     {
         if (pos<_offset || pos>=end()) return 'N';
+        if (is_packed_view()) return get_packed_base(pos);
         return _seq[pos-_offset];
     }
 
@@ -65,6 +74,10 @@ struct reference_contig_segment
                 substr.push_back(get_base(pos+i));
             }
         }
+        else if (is_packed_view())
+        {
+            get_packed_substring(pos,length,substr);
+        }
         else
         {
             //fast path
@@ -72,15 +85,36 @@ struct reference_contig_segment
         }
     }
 
+    /// access the segment sequence, a packed view is copied into the segment first
     std::string& seq()
     {
+        if (is_packed_view()) copy_packed_view();
         return _seq;
     }
+
+    /// access the segment sequence, throws if the segment is a packed view
     const std::string& seq() const
     {
+        if (is_packed_view()) throw_packed_view_seq();
         return _seq;
     }
 
+    /// set the segment to a view of [beginPos,endPos) on contig contigIndex of packedRef
+    ///
+    /// packedRef must outlive the view
+    void
+    set_packed_view(
+        const packed_reference& packedRef,
+        const unsigned contigIndex,
+        const pos_t beginPos,
+        const pos_t endPos);
+
+    bool
+    is_packed_view() const
+    {
+        return (_packedRef != nullptr);
+    }
+
     pos_t
     get_offset() const
     {
@@ -96,6 +130,7 @@ struct reference_contig_segment
     pos_t
     end() const
     {
+        if (is_packed_view()) return _offset+_packedSize;
         return _offset+_seq.size();
     }
 
@@ -104,10 +139,32 @@ struct reference_contig_segment
     {
         _offset=0;
         _seq.clear();
+        _packedRef=nullptr;
+        _packedSize=0;
     }
 
 private:
 
+    char
+    get_packed_base(const pos_t pos) const;
+
+    void
+    get_packed_substring(
+        const pos_t pos,
+        const pos_t length,
+        std::string& substr) const;
+
+    void
+    copy_packed_view();
+
+    void
+    throw_packed_view_seq() const;
+
     pos_t _offset;
     std::string _seq;
+
+    // packed view state, the view is active when _packedRef is not null:
+    const packed_reference* _packedRef = nullptr;
+    unsigned _contigIndex = 0;
+    pos_t _packedSize = 0;
 };
@@ -0,0 +1,170 @@
+//
+// Manta - Structural Variant and Indel Caller
+// Copyright (c) 2013-2017 Illumina, Inc.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+//
+
+#include "boost/test/unit_test.hpp"
+
+#include "depth_buffer.hh"
+#include "depth_diff_buffer.hh"
+
+#include <algorithm>
+#include <vector>
+
+
+BOOST_AUTO_TEST_SUITE( test_depth_diff_buffer )
+
+
+/// load the same read pattern into a diff buffer and a dense depth vector
+///
+/// reads start at each position in [beginPos,endPos) with lengths cycling through [1,readSize]
+///
+static
+void
+get_test_pattern(
+    const pos_t beginPos,
+    const pos_t endPos,
+    const pos_t readSize,
+    depth_diff_buffer& db,
+    std::vector<unsigned>& depth)
+{
+    depth.clear();
+    depth.resize(endPos+readSize,0);
+    for (pos_t pos(beginPos); pos<endPos; ++pos)
+    {
+        const pos_t readEndPos(pos+1+(pos%readSize));
+        db.inc(pos,readEndPos);
+        for (pos_t i(pos); i<readEndPos; ++i) depth[i]++;
+    }
+}
+
+
+BOOST_AUTO_TEST_CASE( test_depth_diff_buffer_val )
+{
+    depth_diff_buffer db;
+    std::vector<unsigned> depth;
+    get_test_pattern(100,300,50,db,depth);
+
+    for (pos_t pos(100); pos<350; ++pos)
+    {
+        BOOST_REQUIRE_EQUAL(db.val(pos),depth[pos]);
+    }
+
+    // check that rewinding the scan head gives the same result:
+    BOOST_REQUIRE_EQUAL(db.val(150),depth[150]);
+}
+
+
+BOOST_AUTO_TEST_CASE( test_depth_diff_buffer_streaming )
+{
+    // interleave read input and queries, as done for position sorted read input:
+    depth_diff_buffer db(1,16);
+    std::vector<unsigned> depth(1000,0);
+    for (pos_t pos(10); pos<900; pos += 3)
+    {
+        db.clear_to_pos(pos-10);
+        db.inc(pos,pos+40);
+        for (pos_t i(pos); i<(pos+40); ++i) depth[i]++;
+        BOOST_REQUIRE_EQUAL(db.val(pos),depth[pos]);
+    }
+}
+
+
+BOOST_AUTO_TEST_CASE( test_depth_diff_buffer_window )
+{
+    // reads starting before the window and ending after it are clipped to the window:
+    depth_diff_buffer db;
+    db.reset(100,120);
+    db.inc(90,110);
+    db.inc(95,200);
+    db.inc(105,106);
+
+    BOOST_REQUIRE_EQUAL(db.val(100),2u);
+    BOOST_REQUIRE_EQUAL(db.val(105),3u);
+    BOOST_REQUIRE_EQUAL(db.val(110),1u);
+    BOOST_REQUIRE_EQUAL(db.max_val(120),3u);
+
+    db.reset(1000,1010);
+    BOOST_REQUIRE_EQUAL(db.val(1000),0u);
+    BOOST_REQUIRE_EQUAL(db.max_val(1010),0u);
+}
+
+
+BOOST_AUTO_TEST_CASE( test_depth_diff_buffer_max )
+{
+    depth_diff_buffer db;
+    std::vector<unsigned> depth;
+    get_test_pattern(0,500,37,db,depth);
+
+    for (pos_t endPos(1); endPos<500; endPos += 7)
+    {
+        const unsigned expect(*std::max_element(depth.begin(),depth.begin()+endPos));
+        BOOST_REQUIRE_EQUAL(db.max_val(endPos),expect);
+    }
+}
+
+
+BOOST_AUTO_TEST_CASE( test_depth_diff_buffer_grow )
+{
+    // reads longer than the initial capacity should be handled:
+    depth_diff_buffer db(1,16);
+    db.inc(0,100);
+    db.inc(10,20);
+    db.inc(50,1000);
+    BOOST_REQUIRE_EQUAL(db.val(15),2u);
+    BOOST_REQUIRE_EQUAL(db.val(60),2u);
+    BOOST_REQUIRE_EQUAL(db.val(500),1u);
+    BOOST_REQUIRE_EQUAL(db.val(1000),0u);
+}
+
+
+BOOST_AUTO_TEST_CASE( test_depth_diff_buffer_compressed )
+{
+    // compressed values should match depth_buffer_compressible:
+    static const unsigned compressionLevel(8);
+    depth_buffer_compressible dbc(compressionLevel);
+    depth_diff_buffer db(compressionLevel);
+    for (unsigned i(101); i<200; ++i)
+    {
+        dbc.inc(i,200-i);
+        db.inc(i,200);
+    }
+
+    for (pos_t pos(101); pos<200; ++pos)
+    {
+        BOOST_REQUIRE_EQUAL(db.val(pos),dbc.val(pos));
+    }
+}
+
+
+BOOST_AUTO_TEST_CASE( test_depth_diff_buffer_clear )
+{
+    depth_diff_buffer db(8);
+    for (unsigned i(101); i<200; ++i)
+    {
+        db.inc(i,200);
+    }
+    db.clear_to_pos(119);
+
+    // positions in the partially cleared block are retained:
+    BOOST_REQUIRE_EQUAL(db.val(120),24u);
+    BOOST_REQUIRE_EQUAL(db.val(150),48u);
+    BOOST_REQUIRE_EQUAL(db.val(199),96u);
+}
+
+
+BOOST_AUTO_TEST_SUITE_END()
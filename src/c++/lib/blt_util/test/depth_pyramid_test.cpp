@@ -0,0 +1,142 @@
+//
+// Manta - Structural Variant and Indel Caller
+// Copyright (c) 2013-2017 Illumina, Inc.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+//
+
+#include "boost/test/unit_test.hpp"
+
+#include "blt_util/blt_exception.hh"
+#include "blt_util/depth_pyramid.hh"
+
+#include <cstdio>
+
+
+BOOST_AUTO_TEST_SUITE( test_depth_pyramid )
+
+
+static const char testMapFilename[] = "testDepthPyramid.bin";
+static const char testMapFilename2[] = "testDepthPyramid2.bin";
+
+
+BOOST_AUTO_TEST_CASE( test_depth_pyramid_roundtrip )
+{
+    static const pos_t binSize(depth_pyramid::base_bin_size);
+    static const pos_t chr1Length(600*binSize+100);
+
+    {
+        depth_pyramid_builder builder;
+        builder.add_contig("chr1", chr1Length);
+        builder.add_contig("chr2", 1000);
+
+        // 10x depth over bins [20,40) and 1 MAPQ0 read in bin 30:
+        for (pos_t pos(20*binSize); pos<40*binSize; pos += 10)
+        {
+            builder.add_read(0, pos, pos+100, (pos == 30*binSize));
+        }
+
+        // one read overlapping the end of chr1:
+        builder.add_read(0, chr1Length-50, chr1Length+50, false);
+        builder.write(testMapFilename);
+    }
+
+    {
+        const depth_pyramid map(testMapFilename);
+        BOOST_REQUIRE_EQUAL(map.contig_count(), 2u);
+        BOOST_REQUIRE_EQUAL(map.get_contig_name(1), "chr2");
+        BOOST_REQUIRE_EQUAL(map.get_contig_length(0), chr1Length);
+
+        BOOST_REQUIRE_EQUAL(map.get_bin(0, 25*binSize).max_depth, 10.f);
+        BOOST_REQUIRE_EQUAL(map.get_bin(0, 25*binSize).read_count, static_cast<unsigned>(binSize/10+1));
+        BOOST_REQUIRE_EQUAL(map.get_bin(0, 10*binSize).read_count, 0u);
+        BOOST_REQUIRE_EQUAL(map.get_bin(0, -1).read_count, 0u);
+        BOOST_REQUIRE_EQUAL(map.get_bin(1, 10).read_count, 0u);
+
+        // the final partial bin depth is normalized by its size:
+        BOOST_REQUIRE_EQUAL(map.get_bin(0, chr1Length-1).max_depth, 0.5f);
+
+        const depth_bin inner(map.get_range_summary(0, 21*binSize+5, 39*binSize));
+        BOOST_REQUIRE_EQUAL(inner.min_depth, 10.f);
+        BOOST_REQUIRE_EQUAL(inner.max_depth, 10.f);
+        BOOST_REQUIRE_EQUAL(inner.mq0_read_count, 1u);
+
+        const depth_bin outer(map.get_range_summary(0, 0, chr1Length));
+        BOOST_REQUIRE_EQUAL(outer.min_depth, 0.f);
+        BOOST_REQUIRE_EQUAL(outer.max_depth, 10.f);
+        BOOST_REQUIRE_EQUAL(outer.read_count, static_cast<unsigned>(20*binSize/10+1));
+        BOOST_REQUIRE_EQUAL(outer.base_count, static_cast<uint64_t>(20*binSize*10+50));
+
+        // range summaries match a sum over all base-level bins:
+        for (pos_t beginPos(0); beginPos<chr1Length; beginPos += 3*binSize+7)
+        {
+            for (pos_t endPos(beginPos+1); endPos<chr1Length; endPos += 11*binSize+3)
+            {
+                const depth_bin summary(map.get_range_summary(0, beginPos, endPos));
+                uint64_t baseCount(0);
+                float maxDepth(0);
+                for (pos_t binIndex(beginPos/binSize); binIndex<=((endPos-1)/binSize); ++binIndex)
+                {
+                    baseCount += map.get_bin(0, binIndex*binSize).base_count;
+                    maxDepth = std::max(maxDepth, map.get_bin(0, binIndex*binSize).max_depth);
+                }
+                BOOST_REQUIRE_EQUAL(summary.base_count, baseCount);
+                BOOST_REQUIRE_EQUAL(summary.max_depth, maxDepth);
+            }
+        }
+    }
+
+    // merged partial maps match a single map:
+    {
+        depth_pyramid_builder builder2;
+        builder2.add_contig("chr1", chr1Length);
+        builder2.add_contig("chr2", 1000);
+        builder2.add_read(1, 10, 110, true);
+        builder2.write(testMapFilename2);
+
+        depth_pyramid_builder merged;
+        merged.merge(depth_pyramid(testMapFilename));
+        merged.merge(depth_pyramid(testMapFilename2));
+        merged.write(testMapFilename);
+
+        const depth_pyramid map(testMapFilename);
+        BOOST_REQUIRE_EQUAL(map.get_range_summary(0, 0, chr1Length).read_count, static_cast<unsigned>(20*binSize/10+1));
+        BOOST_REQUIRE_EQUAL(map.get_bin(1, 10).mq0_read_count, 1u);
+        BOOST_REQUIRE_EQUAL(map.get_bin(1, 10).max_depth, 0.1f);
+    }
+
+    remove(testMapFilename);
+    remove(testMapFilename2);
+}
+
+
+BOOST_AUTO_TEST_CASE( test_depth_pyramid_invalid )
+{
+    {
+        depth_pyramid_builder builder;
+        builder.add_contig("chr1", 1000);
+        builder.write(testMapFilename);
+    }
+
+    depth_pyramid_builder builder2;
+    builder2.add_contig("chr2", 1000);
+    BOOST_REQUIRE_THROW(builder2.merge(depth_pyramid(testMapFilename)), blt_exception);
+
+    remove(testMapFilename);
+    BOOST_REQUIRE_THROW(depth_pyramid map(testMapFilename), blt_exception);
+}
+
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,152 @@
+//
+// Manta - Structural Variant and Indel Caller
+// Copyright (c) 2013-2017 Illumina, Inc.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+//
+
+#include "boost/test/unit_test.hpp"
+
+#include "blt_util/blt_exception.hh"
+#include "blt_util/packed_reference.hh"
+#include "blt_util/reference_contig_segment.hh"
+
+#include <cstdio>
+
+
+BOOST_AUTO_TEST_SUITE( test_packed_reference )
+
+
+static const char testImageFilename[] = "testPackedReference.2bit";
+
+
+BOOST_AUTO_TEST_CASE( test_packed_reference_roundtrip )
+{
+    static const std::string seq1("NNACGTACGTTGCANNNNGATTACANGGN");
+    static const std::string seq2("TTTTTTTTTTTTTTTTTTTTTTT");
+
+    {
+        packed_reference_writer writer(testImageFilename);
+        writer.add_contig("chr1", seq1);
+        writer.add_contig("chr2", seq2);
+        writer.add_contig("chrEmpty", "");
+        writer.close();
+    }
+
+    {
+        const packed_reference ref(testImageFilename);
+        BOOST_REQUIRE_EQUAL(ref.contig_count(), 3u);
+        BOOST_REQUIRE_EQUAL(ref.get_contig_index("chr2"), 1);
+        BOOST_REQUIRE_EQUAL(ref.get_contig_index("chr3"), -1);
+        BOOST_REQUIRE_EQUAL(ref.get_contig_length(0), static_cast<pos_t>(seq1.size()));
+        BOOST_REQUIRE_EQUAL(ref.get_contig_length(2), 0);
+
+        std::string seq;
+        ref.get_substring(0, 0, seq1.size(), seq);
+        BOOST_REQUIRE_EQUAL(seq, seq1);
+        ref.get_substring(1, 0, seq2.size(), seq);
+        BOOST_REQUIRE_EQUAL(seq, seq2);
+
+        // every sub-range matches:
+        for (pos_t beginPos(0); beginPos<static_cast<pos_t>(seq1.size()); ++beginPos)
+        {
+            for (pos_t endPos(beginPos); endPos<=static_cast<pos_t>(seq1.size()); ++endPos)
+            {
+                ref.get_substring(0, beginPos, endPos, seq);
+                BOOST_REQUIRE_EQUAL(seq, seq1.substr(beginPos, endPos-beginPos));
+            }
+            BOOST_REQUIRE_EQUAL(ref.get_base(0, beginPos), seq1[beginPos]);
+        }
+
+        // ranges are clipped to the contig:
+        ref.get_substring(0, -5, 4, seq);
+        BOOST_REQUIRE_EQUAL(seq, seq1.substr(0,4));
+        ref.get_substring(1, 20, 100, seq);
+        BOOST_REQUIRE_EQUAL(seq, "TTT");
+        BOOST_REQUIRE_EQUAL(ref.get_base(1, 100), 'N');
+    }
+
+    remove(testImageFilename);
+}
+
+
+BOOST_AUTO_TEST_CASE( test_packed_reference_segment_view )
+{
+    static const std::string seq1("NNACGTACGTTGCANNNNGATTACANGGN");
+
+    {
+        packed_reference_writer writer(testImageFilename);
+        writer.add_contig("chr1", seq1);
+        writer.close();
+    }
+
+    {
+        const packed_reference ref(testImageFilename);
+
+        static const pos_t beginPos(3);
+        static const pos_t endPos(20);
+
+        reference_contig_segment copySegment;
+        copySegment.set_offset(beginPos);
+        copySegment.seq() = seq1.substr(beginPos, endPos-beginPos);
+
+        reference_contig_segment viewSegment;
+        viewSegment.set_packed_view(ref, 0, beginPos, endPos);
+        BOOST_REQUIRE(viewSegment.is_packed_view());
+        BOOST_REQUIRE_EQUAL(viewSegment.get_offset(), copySegment.get_offset());
+        BOOST_REQUIRE_EQUAL(viewSegment.end(), copySegment.end());
+
+        // base and substring access match a copied segment, including the N padding outside of the segment:
+        std::string copySubstr;
+        std::string viewSubstr;
+        for (pos_t pos(-2); pos<(static_cast<pos_t>(seq1.size())+2); ++pos)
+        {
+            BOOST_REQUIRE_EQUAL(viewSegment.get_base(pos), copySegment.get_base(pos));
+            for (pos_t length(0); length<8; ++length)
+            {
+                copySegment.get_substring(pos, length, copySubstr);
+                viewSegment.get_substring(pos, length, viewSubstr);
+                BOOST_REQUIRE_EQUAL(viewSubstr, copySubstr);
+            }
+        }
+
+        // the view cannot expose a const sequence:
+        const reference_contig_segment& constViewSegment(viewSegment);
+        BOOST_REQUIRE_THROW(constViewSegment.seq(), blt_exception);
+
+        // ...but the non-const sequence accessor copies the view:
+        BOOST_REQUIRE_EQUAL(viewSegment.seq(), copySegment.seq());
+        BOOST_REQUIRE(! viewSegment.is_packed_view());
+        BOOST_REQUIRE_EQUAL(viewSegment.end(), copySegment.end());
+
+        // views are clipped to the contig:
+        viewSegment.set_packed_view(ref, 0, 20, 100);
+        BOOST_REQUIRE_EQUAL(viewSegment.end(), static_cast<pos_t>(seq1.size()));
+        BOOST_REQUIRE_EQUAL(viewSegment.get_base(100), 'N');
+    }
+
+    remove(testImageFilename);
+}
+
+
+BOOST_AUTO_TEST_CASE( test_packed_reference_invalid )
+{
+    BOOST_REQUIRE_THROW(packed_reference_writer(testImageFilename).add_contig("chr1", "ACGR"), blt_exception);
+    BOOST_REQUIRE_THROW(packed_reference ref(testImageFilename), blt_exception);
+    remove(testImageFilename);
+}
+
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -96,6 +96,7 @@ writeHeaderPrefix(
     _os << "##INFO=<ID=RIGHT_SVINSSEQ,Number=.,Type=String,Description=\"Known right side of insertion for an insertion of unknown length\">\n";
     _os << "##INFO=<ID=INV3,Number=0,Type=Flag,Description=\"Inversion breakends open 3' of reported location\">\n";
     _os << "##INFO=<ID=INV5,Number=0,Type=Flag,Description=\"Inversion breakends open 5' of reported location\">\n";
+    _os << "##INFO=<ID=EDGE_BUDGET_FALLBACK,Number=0,Type=Flag,Description=\"Breakend assembly was skipped because the SV locus graph edge containing this variant exceeded its processing budget\">\n";
 
     // if "--outputContig" is specified, then print out INFO tag for Assembled contig sequence
     if (_isOutputContig)
@@ -401,6 +402,7 @@ writeTransloc(
     if (isImprecise)
     {
         infotags.push_back("IMPRECISE");
+        if (adata.isEdgeBudgetSkip) infotags.push_back("EDGE_BUDGET_FALLBACK");
     }
     else if (_isOutputContig)
     {
@@ -478,6 +480,7 @@ writeInvdel(
     const SVCandidate& sv,
     const SVId& svId,
     const bool isIndel,
+    const SVCandidateAssemblyData& adata,
     const EventInfo& event)
 {
     const bool isImprecise(sv.isImprecise());
@@ -636,6 +639,7 @@ writeInvdel(
     if (isImprecise)
     {
         infoTags.push_back("IMPRECISE");
+        if (adata.isEdgeBudgetSkip) infoTags.push_back("EDGE_BUDGET_FALLBACK");
     }
     else if(_isOutputContig){
         infoTags.push_back("CONTIG=" + sv.contigSeq);
@@ -793,7 +797,7 @@ writeSVCore(
         else
         {
             const bool isIndel(isSVIndel(svType));
-            writeInvdel(sv, svId, isIndel, event);
+            writeInvdel(sv, svId, isIndel, adata, event);
         }
     }
     catch (...)
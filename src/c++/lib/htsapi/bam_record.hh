@@ -285,6 +285,12 @@ public:
         return _bp->core.l_qseq;
     }
 
+    /// size in bytes of the variable-length record data (read name, cigar, sequence, qualities and aux fields)
+    unsigned data_size() const
+    {
+        return _bp->l_data;
+    }
+
     bam_seq get_bam_read() const
     {
         return bam_seq(bam_get_seq(_bp),read_size());
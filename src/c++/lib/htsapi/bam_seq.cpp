@@ -23,8 +23,176 @@
 
 #include "htsapi/bam_seq.hh"
 
+#include <cstring>
+
 #include <iostream>
 
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+
+
+namespace
+{
+
+/// ascii and reverse complement ascii values for each possible byte of the packed bam sequence,
+/// where each byte holds two bases
+struct bam_seq_pair_table
+{
+    bam_seq_pair_table()
+    {
+        for (unsigned i(0); i<256; ++i)
+        {
+            const uint8_t code1(i >> 4);
+            const uint8_t code2(i & 0xf);
+            fwd[i][0] = get_bam_seq_char(code1);
+            fwd[i][1] = get_bam_seq_char(code2);
+            rc[i][0] = get_bam_seq_complement_char(code2);
+            rc[i][1] = get_bam_seq_complement_char(code1);
+        }
+    }
+
+    char fwd[256][2];
+    char rc[256][2];
+};
+
+const bam_seq_pair_table&
+get_pair_table()
+{
+    static const bam_seq_pair_table table;
+    return table;
+}
+
+}
+
+
+
+#ifdef __SSE2__
+/// map each 4-bit bam base code in x to its ascii value, or to the complement ascii value if isComplement is true
+///
+/// SSE2 has no byte shuffle to use as a 16 entry lookup table, but only 5 codes map to a value other than 'N', so
+/// these are selected with compare/mask.
+static inline
+__m128i
+bam_code_to_char(
+    const __m128i x,
+    const bool isComplement)
+{
+    using namespace BAM_BASE;
+
+    static const uint8_t codes[] = { REF, A, C, G, T };
+    __m128i result(_mm_set1_epi8('N'));
+    for (const uint8_t code : codes)
+    {
+        const char c(isComplement ? get_bam_seq_complement_char(code) : get_bam_seq_char(code));
+        const __m128i mask(_mm_cmpeq_epi8(x,_mm_set1_epi8(code)));
+        result = _mm_or_si128(_mm_and_si128(mask,_mm_set1_epi8(c)),_mm_andnot_si128(mask,result));
+    }
+    return result;
+}
+
+
+/// decode 16 bytes of the packed bam sequence (32 bases) into two vectors of ascii bases in sequence order
+static inline
+void
+decode_block(
+    const uint8_t* sptr,
+    const bool isComplement,
+    __m128i& bases1,
+    __m128i& bases2)
+{
+    const __m128i lowMask(_mm_set1_epi8(0xf));
+    const __m128i x(_mm_loadu_si128(reinterpret_cast<const __m128i*>(sptr)));
+    const __m128i hi(bam_code_to_char(_mm_and_si128(_mm_srli_epi16(x,4),lowMask), isComplement));
+    const __m128i lo(bam_code_to_char(_mm_and_si128(x,lowMask), isComplement));
+
+    // the high nibble holds the first base of each byte:
+    bases1 = _mm_unpacklo_epi8(hi,lo);
+    bases2 = _mm_unpackhi_epi8(hi,lo);
+}
+
+
+/// reverse the order of the 16 bytes in x
+static inline
+__m128i
+reverse_bytes(__m128i x)
+{
+    x = _mm_shuffle_epi32(x,_MM_SHUFFLE(0,1,2,3));
+    x = _mm_shufflelo_epi16(x,_MM_SHUFFLE(2,3,0,1));
+    x = _mm_shufflehi_epi16(x,_MM_SHUFFLE(2,3,0,1));
+    return _mm_or_si128(_mm_slli_epi16(x,8),_mm_srli_epi16(x,8));
+}
+#endif
+
+
+
+void
+bam_seq::
+decode(char* out) const
+{
+    const bam_seq_pair_table& table(get_pair_table());
+
+    unsigned i(0);
+    if ((_offset % 2) && (i < _size))
+    {
+        out[i] = get_char(i);
+        i++;
+    }
+
+    // _offset+i is now even, so the remaining bases are aligned to byte boundaries:
+    const uint8_t* sptr(_s + ((_offset+i)/2));
+#ifdef __SSE2__
+    for (; (i+32) <= _size; i += 32, sptr += 16)
+    {
+        __m128i bases1, bases2;
+        decode_block(sptr, false, bases1, bases2);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out+i),bases1);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out+i+16),bases2);
+    }
+#endif
+    for (; (i+1) < _size; i += 2, ++sptr)
+    {
+        std::memcpy(out+i, table.fwd[*sptr], 2);
+    }
+
+    if (i < _size) out[i] = get_char(i);
+}
+
+
+
+void
+bam_seq::
+decode_rc(char* out) const
+{
+    const bam_seq_pair_table& table(get_pair_table());
+
+    // i is the forward sequence index, which is written to out[(_size-1)-i]:
+    unsigned i(0);
+    if ((_offset % 2) && (i < _size))
+    {
+        out[_size-1] = get_complement_char(i);
+        i++;
+    }
+
+    const uint8_t* sptr(_s + ((_offset+i)/2));
+#ifdef __SSE2__
+    for (; (i+32) <= _size; i += 32, sptr += 16)
+    {
+        __m128i bases1, bases2;
+        decode_block(sptr, true, bases1, bases2);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out+(_size-32-i)),reverse_bytes(bases2));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out+(_size-16-i)),reverse_bytes(bases1));
+    }
+#endif
+    for (; (i+1) < _size; i += 2, ++sptr)
+    {
+        std::memcpy(out+(_size-2-i), table.rc[*sptr], 2);
+    }
+
+    if (i < _size) out[(_size-1)-i] = get_complement_char(i);
+}
+
 
 std::ostream&
 operator<<(std::ostream& os,
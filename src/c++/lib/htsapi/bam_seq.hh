@@ -153,6 +153,9 @@ bam_seq_code_to_id(const uint8_t a,
 // sequences from bam files and regular strings using the same
 // object:
 //
+// all implementations are final, so that code using a specific sequence type
+// gets inlined base access instead of a virtual call per base
+//
 struct bam_seq_base : public PolymorphicObject
 {
     virtual uint8_t get_code(pos_t i) const = 0;
@@ -174,7 +177,7 @@ std::ostream& operator<<(std::ostream& os, const bam_seq_base& bs);
 
 //
 //
-struct bam_seq : public bam_seq_base
+struct bam_seq final : public bam_seq_base
 {
     bam_seq(const uint8_t* s,
             const uint16_t init_size,
@@ -215,10 +218,7 @@ struct bam_seq : public bam_seq_base
     get_string() const
     {
         std::string s(_size,'N');
-        for (unsigned i(0); i<_size; ++i)
-        {
-            s[i] = get_char(i);
-        }
+        decode(&s[0]);
         return s;
     }
 
@@ -227,14 +227,19 @@ struct bam_seq : public bam_seq_base
     get_rc_string() const
     {
         std::string s(_size,'N');
-        for (unsigned i(0); i<_size; ++i)
-        {
-            s[i] = get_complement_char(i);
-        }
-        std::reverse(s.begin(),s.end());
+        decode_rc(&s[0]);
         return s;
     }
 
+    /// write the sequence as ascii to out[0,size), decoding two bases per byte, or 32 bases at a time where
+    /// SSE2 is available
+    void
+    decode(char* out) const;
+
+    /// write the reverse complement of the sequence as ascii to out[0,size), decoding two bases per byte
+    void
+    decode_rc(char* out) const;
+
     unsigned size() const override
     {
         return _size;
@@ -249,7 +254,7 @@ private:
 
 //
 //
-struct string_bam_seq : public bam_seq_base
+struct string_bam_seq final : public bam_seq_base
 {
     explicit
     string_bam_seq(const std::string& s)
@@ -285,7 +290,7 @@ private:
 
 /// Coerce a reference_contig_segment to the bam_seq_base interface without copying
 ///
-struct rc_segment_bam_seq : public bam_seq_base
+struct rc_segment_bam_seq final : public bam_seq_base
 {
     explicit
     rc_segment_bam_seq(const reference_contig_segment& r)
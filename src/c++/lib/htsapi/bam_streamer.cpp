@@ -47,7 +47,9 @@ bam_streamer(
       _hitr(nullptr),
       _record_no(0),
       _stream_name(filename),
-      _is_region(false)
+      _is_region(false),
+      _buffered_region_index(-1),
+      _buffered_record_index(0)
 {
     assert(nullptr != filename);
     if ('\0' == *filename)
@@ -205,7 +207,24 @@ resetRegion(
     int beginPos,
     int endPos)
 {
+    _is_record_set = false;
+    _record_no = 0;
+
+    const region_t region(referenceContigId, beginPos, endPos);
+    const unsigned bufferedRegionCount(_buffered_regions.size());
+    for (unsigned bufferedRegionIndex(0); bufferedRegionIndex<bufferedRegionCount; ++bufferedRegionIndex)
+    {
+        if (! (_buffered_regions[bufferedRegionIndex].region == region)) continue;
+        _buffered_region_index = bufferedRegionIndex;
+        _buffered_record_index = 0;
+        _is_region = true;
+        _region.clear();
+        return;
+    }
+    _buffered_region_index = -1;
+
     if (nullptr != _hitr) hts_itr_destroy(_hitr);
+    _hitr = nullptr;
 
     _load_index();
 
@@ -225,9 +244,125 @@ resetRegion(
     }
     _is_region = true;
     _region.clear();
+}
+
+
+
+void
+bam_streamer::buffered_region::
+push_back(const bam1_t& br)
+{
+    if (dataOffset.empty()) dataOffset.push_back(0);
+    core.push_back(br.core);
+    data.insert(data.end(), br.data, br.data+br.l_data);
+    dataOffset.push_back(data.size());
+}
+
+
+
+void
+bam_streamer::buffered_region::
+get_record(
+    const unsigned recordIndex,
+    bam1_t& br) const
+{
+    assert(recordIndex < size());
+
+    // setup a temporary record pointing into the buffer, so that htslib handles the record copy:
+    bam1_t bufferRecord;
+    bufferRecord.core = core[recordIndex];
+    bufferRecord.l_data = (dataOffset[recordIndex+1] - dataOffset[recordIndex]);
+    bufferRecord.m_data = bufferRecord.l_data;
+    bufferRecord.data = const_cast<uint8_t*>(data.data() + dataOffset[recordIndex]);
+    bufferRecord.id = 0;
+    bam_copy1(&br, &bufferRecord);
+}
+
+
+
+void
+bam_streamer::
+bufferRegion(const region_t& region)
+{
+    _buffered_regions.emplace_back();
+    buffered_region& bufferedRegion(_buffered_regions.back());
+
+    // reset to the region before it is registered as buffered, so that records are read from the file:
+    resetRegion(region.referenceContigId, region.beginPos, region.endPos);
+    while (next())
+    {
+        bufferedRegion.push_back(*(_brec._bp));
+    }
+    bufferedRegion.region = region;
 
     _is_record_set = false;
-    _record_no = 0;
+}
+
+
+
+void
+bam_streamer::
+clearBufferedRegions()
+{
+    _buffered_regions.clear();
+    _buffered_region_index = -1;
+    _is_record_set = false;
+}
+
+
+
+bool
+bam_streamer::
+estimateRegionDataSize(
+    int referenceContigId,
+    int beginPos,
+    int endPos,
+    uint64_t& dataSize)
+{
+    dataSize = 0;
+
+    std::vector<std::pair<uint64_t,uint64_t>> fileRanges;
+    if (! getRegionFileRanges(referenceContigId, beginPos, endPos, fileRanges)) return false;
+
+    for (const auto& fileRange : fileRanges)
+    {
+        dataSize += (fileRange.second - fileRange.first);
+    }
+    return true;
+}
+
+
+
+bool
+bam_streamer::
+getRegionFileRanges(
+    int referenceContigId,
+    int beginPos,
+    int endPos,
+    std::vector<std::pair<uint64_t,uint64_t>>& fileRanges)
+{
+    fileRanges.clear();
+
+    // CRAM index queries do not provide file chunk offsets:
+    if (hts_get_format(_hfp)->format != bam) return false;
+
+    _load_index();
+
+    hts_itr_t* itr(sam_itr_queryi(_hidx,referenceContigId,beginPos,endPos));
+    if (itr == nullptr)
+    {
+        std::ostringstream oss;
+        oss << "Failed to fetch region: #" << referenceContigId << ":" << beginPos << "-" << endPos << " specified for BAM/CRAM file: " << name();
+        throw blt_exception(oss.str().c_str());
+    }
+
+    // chunk boundaries are BGZF virtual offsets, where the upper 48 bits give the compressed file offset:
+    for (int chunkIndex(0); chunkIndex<itr->n_off; ++chunkIndex)
+    {
+        fileRanges.emplace_back((itr->off[chunkIndex].u >> 16), (itr->off[chunkIndex].v >> 16));
+    }
+    hts_itr_destroy(itr);
+    return true;
 }
 
 
@@ -238,6 +373,19 @@ next()
 {
     if (nullptr == _hfp) return false;
 
+    if (_buffered_region_index >= 0)
+    {
+        const buffered_region& bufferedRegion(_buffered_regions[_buffered_region_index]);
+        _is_record_set = (_buffered_record_index < bufferedRegion.size());
+        if (_is_record_set)
+        {
+            bufferedRegion.get_record(_buffered_record_index, *(_brec._bp));
+            _buffered_record_index++;
+            _record_no++;
+        }
+        return _is_record_set;
+    }
+
     int ret;
     if (nullptr == _hitr)
     {
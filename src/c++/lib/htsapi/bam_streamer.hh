@@ -29,6 +29,8 @@
 #include "boost/utility.hpp"
 
 #include <string>
+#include <utility>
+#include <vector>
 
 
 /// Stream bam records from CRAM/BAM/SAM files. For CRAM/BAM
@@ -45,6 +47,31 @@
 //
 struct bam_streamer : public boost::noncopyable
 {
+    /// \brief An alignment file region, using the same coordinate convention as resetRegion()
+    struct region_t
+    {
+        region_t(
+            const int initReferenceContigId = -1,
+            const int initBeginPos = 0,
+            const int initEndPos = 0)
+            : referenceContigId(initReferenceContigId),
+              beginPos(initBeginPos),
+              endPos(initEndPos)
+        {}
+
+        bool
+        operator==(const region_t& rhs) const
+        {
+            return ((referenceContigId == rhs.referenceContigId) &&
+                    (beginPos == rhs.beginPos) &&
+                    (endPos == rhs.endPos));
+        }
+
+        int referenceContigId;
+        int beginPos;
+        int endPos;
+    };
+
     /// \param filename CRAM/BAM input file
     /// \param referenceFilename Corresponding reference file. nullptr can be given here to indicate that the
     ///            the reference is not being provided, but many CRAM files cannot be read in this case.
@@ -75,6 +102,65 @@ struct bam_streamer : public boost::noncopyable
         int beginPos,
         int endPos);
 
+    /// \brief Estimate the volume of alignment data in a region from the alignment file index
+    ///
+    /// The estimate is the compressed size of the file chunks the index lists for the region, so it is only
+    /// approximately proportional to the number of reads in the region. This will fail if the alignment file
+    /// is not indexed.
+    ///
+    /// \param referenceContigId htslib zero-indexed contig id
+    /// \param beginPos start position (zero-indexed, closed)
+    /// \param endPos end position (zero-indexed, open)
+    /// \param[out] dataSize estimated compressed data size in bytes
+    ///
+    /// \return False if the index format does not support this estimate (this is currently true for CRAM)
+    bool
+    estimateRegionDataSize(
+        int referenceContigId,
+        int beginPos,
+        int endPos,
+        uint64_t& dataSize);
+
+    /// \brief Get the compressed file byte ranges which the alignment file index lists for a region
+    ///
+    /// Each range starts at the beginning of a compressed block, and ends at the beginning of the compressed block
+    /// containing the end of the region data, so the final block of each range is not included. This will fail if
+    /// the alignment file is not indexed.
+    ///
+    /// \param referenceContigId htslib zero-indexed contig id
+    /// \param beginPos start position (zero-indexed, closed)
+    /// \param endPos end position (zero-indexed, open)
+    /// \param[out] fileRanges compressed file byte offset ranges (closed-open)
+    ///
+    /// \return False if the index format does not support this query (this is currently true for CRAM)
+    bool
+    getRegionFileRanges(
+        int referenceContigId,
+        int beginPos,
+        int endPos,
+        std::vector<std::pair<uint64_t,uint64_t>>& fileRanges);
+
+    /// \brief Read all records in a region into memory
+    ///
+    /// Any later call to resetRegion() for exactly the same region iterates through the buffered records instead
+    /// of the alignment file, until clearBufferedRegions() is called. This only changes the state of this stream
+    /// object, so separate streams can buffer regions from different threads concurrently.
+    ///
+    /// This will fail if the alignment file is not indexed.
+    void
+    bufferRegion(const region_t& region);
+
+    /// \brief Release all records stored by bufferRegion()
+    void
+    clearBufferedRegions();
+
+    /// \return True if the current region is iterated from records stored by bufferRegion()
+    bool
+    isBufferedRegion() const
+    {
+        return (_buffered_region_index >= 0);
+    }
+
     bool next();
 
     const bam_record* get_record_ptr() const
@@ -110,6 +196,32 @@ struct bam_streamer : public boost::noncopyable
 private:
     void _load_index();
 
+    /// \brief All records from one region, stored by bufferRegion()
+    ///
+    /// The fixed-size and variable-length parts of each record are stored in separate contiguous arrays.
+    struct buffered_region
+    {
+        unsigned
+        size() const
+        {
+            return core.size();
+        }
+
+        void
+        push_back(const bam1_t& br);
+
+        /// copy buffered record into br
+        void
+        get_record(
+            const unsigned recordIndex,
+            bam1_t& br) const;
+
+        region_t region;
+        std::vector<bam1_core_t> core;
+        std::vector<unsigned> dataOffset;
+        std::vector<uint8_t> data;
+    };
+
     bool _is_record_set;
     htsFile* _hfp;
     bam_hdr_t* _hdr;
@@ -122,4 +234,10 @@ private:
     std::string _stream_name;
     bool _is_region;
     std::string _region;
+
+    std::vector<buffered_region> _buffered_regions;
+
+    /// index of the buffered region currently being iterated, or -1 if records are read from the file
+    int _buffered_region_index;
+    unsigned _buffered_record_index;
 };
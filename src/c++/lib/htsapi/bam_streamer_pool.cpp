@@ -0,0 +1,227 @@
+//
+// Manta - Structural Variant and Indel Caller
+// Copyright (c) 2013-2017 Illumina, Inc.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+//
+
+/// \file
+/// \author Chris Saunders
+///
+
+#include "htsapi/bam_streamer_pool.hh"
+
+#include <algorithm>
+#include <cassert>
+#include <exception>
+#include <thread>
+
+
+
+bam_streamer_pool::
+bam_streamer_pool(
+    const std::vector<std::string>& alignmentFilenames,
+    const std::string& referenceFilename,
+    const unsigned maxOpenFileCount,
+    const unsigned bufferThreadCount)
+    : _referenceFilename(referenceFilename),
+      _maxOpenFileCount(maxOpenFileCount),
+      _bufferThreadCount(bufferThreadCount),
+      _files(alignmentFilenames.size()),
+      _totalFileOpenCount(0)
+{
+    const unsigned fileCount(alignmentFilenames.size());
+    for (unsigned fileIndex(0); fileIndex<fileCount; ++fileIndex)
+    {
+        _files[fileIndex].filename = alignmentFilenames[fileIndex];
+    }
+}
+
+
+
+bam_streamer_pool::
+~bam_streamer_pool()
+{
+    for (FileInfo& file : _files)
+    {
+        if (nullptr != file.header) bam_hdr_destroy(file.header);
+    }
+}
+
+
+
+void
+bam_streamer_pool::
+touchFile(const unsigned fileIndex)
+{
+    assert(fileIndex < _files.size());
+    FileInfo& file(_files[fileIndex]);
+
+    if (file.stream)
+    {
+        _lruFileIndices.splice(_lruFileIndices.begin(), _lruFileIndices, file.lruIter);
+        return;
+    }
+
+    if ((_maxOpenFileCount > 0) && (_lruFileIndices.size() >= _maxOpenFileCount))
+    {
+        // close the least recently used file:
+        FileInfo& lruFile(_files[_lruFileIndices.back()]);
+        lruFile.stream.reset();
+        _lruFileIndices.pop_back();
+    }
+
+    const char* referenceFilename(_referenceFilename.empty() ? nullptr : _referenceFilename.c_str());
+    file.stream.reset(new bam_streamer(file.filename.c_str(), referenceFilename));
+    _totalFileOpenCount++;
+
+    if (nullptr == file.header)
+    {
+        file.header = bam_hdr_dup(&(file.stream->get_header()));
+    }
+
+    _lruFileIndices.push_front(fileIndex);
+    file.lruIter = _lruFileIndices.begin();
+}
+
+
+
+bam_streamer_pool::stream_ptr
+bam_streamer_pool::
+getStream(const unsigned fileIndex)
+{
+    touchFile(fileIndex);
+    return _files[fileIndex].stream;
+}
+
+
+
+const bam_hdr_t&
+bam_streamer_pool::
+getHeader(const unsigned fileIndex)
+{
+    assert(fileIndex < _files.size());
+    if (nullptr == _files[fileIndex].header)
+    {
+        touchFile(fileIndex);
+    }
+    return *(_files[fileIndex].header);
+}
+
+
+
+void
+bam_streamer_pool::
+bufferRegions(
+    const std::vector<bam_streamer::region_t>& regions,
+    const std::vector<bool>& isFileSelected)
+{
+    bufferFiles([&](const unsigned, bam_streamer& stream)
+    {
+        for (const bam_streamer::region_t& region : regions)
+        {
+            stream.bufferRegion(region);
+        }
+    }, isFileSelected);
+}
+
+
+
+void
+bam_streamer_pool::
+bufferFileRegions(
+    const std::vector<bam_streamer::region_t>& fileRegions,
+    const std::vector<bool>& isFileSelected)
+{
+    assert(fileRegions.size() == size());
+    bufferFiles([&](const unsigned fileIndex, bam_streamer& stream)
+    {
+        stream.bufferRegion(fileRegions[fileIndex]);
+    }, isFileSelected);
+}
+
+
+
+void
+bam_streamer_pool::
+bufferFiles(
+    const std::function<void(const unsigned fileIndex, bam_streamer& stream)>& bufferFile,
+    const std::vector<bool>& isFileSelected)
+{
+    if (_bufferThreadCount < 2) return;
+
+    // a buffered file closed by the pool before the client's scan loses its buffer, so only buffer as many files
+    // as the pool can hold open:
+    const unsigned maxBufferedFileCount((_maxOpenFileCount > 0) ? _maxOpenFileCount : size());
+
+    std::vector<unsigned> fileIndices;
+    const unsigned fileCount(size());
+    for (unsigned fileIndex(0); fileIndex<fileCount; ++fileIndex)
+    {
+        const bool isSelected(isFileSelected.empty() || isFileSelected[fileIndex]);
+        if ((! isSelected) || (fileIndices.size() >= maxBufferedFileCount))
+        {
+            // release buffers from any previous call:
+            if (_files[fileIndex].stream) _files[fileIndex].stream->clearBufferedRegions();
+            continue;
+        }
+        fileIndices.push_back(fileIndex);
+    }
+    if (fileIndices.size() < 2) return;
+
+    const unsigned selectedFileCount(fileIndices.size());
+    for (unsigned batchBegin(0); batchBegin<selectedFileCount; batchBegin += _bufferThreadCount)
+    {
+        const unsigned batchEnd(std::min(batchBegin+_bufferThreadCount, selectedFileCount));
+
+        // streams are retrieved on this thread because the pool itself is not thread-safe:
+        std::vector<stream_ptr> streams;
+        for (unsigned batchIndex(batchBegin); batchIndex<batchEnd; ++batchIndex)
+        {
+            streams.push_back(getStream(fileIndices[batchIndex]));
+        }
+
+        const unsigned streamCount(streams.size());
+        std::vector<std::exception_ptr> streamErrors(streamCount);
+        std::vector<std::thread> threads;
+        for (unsigned streamIndex(0); streamIndex<streamCount; ++streamIndex)
+        {
+            const unsigned fileIndex(fileIndices[batchBegin+streamIndex]);
+            threads.emplace_back([&,streamIndex,fileIndex]()
+            {
+                try
+                {
+                    bam_streamer& stream(*streams[streamIndex]);
+                    stream.clearBufferedRegions();
+                    bufferFile(fileIndex, stream);
+                }
+                catch (...)
+                {
+                    streamErrors[streamIndex] = std::current_exception();
+                }
+            });
+        }
+
+        for (std::thread& thread : threads)
+        {
+            thread.join();
+        }
+
+        for (const std::exception_ptr& streamError : streamErrors)
+        {
+            if (streamError) std::rethrow_exception(streamError);
+        }
+    }
+}
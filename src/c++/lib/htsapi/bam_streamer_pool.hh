@@ -0,0 +1,171 @@
+//
+// Manta - Structural Variant and Indel Caller
+// Copyright (c) 2013-2017 Illumina, Inc.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+//
+
+/// \file
+/// \author Chris Saunders
+///
+
+#pragma once
+
+#include "htsapi/bam_streamer.hh"
+
+#include "boost/utility.hpp"
+
+#include <cassert>
+#include <functional>
+#include <list>
+#include <memory>
+#include <string>
+#include <vector>
+
+
+/// \brief Shared set of alignment file streams for all read scanning components of a process
+///
+/// Each alignment file is opened at most once by the pool, so all clients share one file handle, header and
+/// index per file. Files are opened on first use. If a maximum open file count is set, the least recently
+/// used streams are closed as required to stay under this limit, and are reopened on the next request.
+///
+/// Streams are shared, so clients must reset the stream region before each use, and should only hold the
+/// returned stream pointer for the duration of one region query. A stream which is closed by the pool while
+/// a client still holds it stays valid until the client releases it.
+///
+/// Example use:
+/// bam_streamer_pool pool(alignmentFilenames, referenceFilename);
+/// const bam_streamer_pool::stream_ptr streamPtr(pool.getStream(fileIndex));
+/// streamPtr->resetRegion("chr1:1000000-2000000");
+/// while (streamPtr->next()) { ... }
+///
+struct bam_streamer_pool : private boost::noncopyable
+{
+    typedef std::shared_ptr<bam_streamer> stream_ptr;
+
+    /// \param maxOpenFileCount Maximum number of files held open by the pool, zero indicates no limit
+    /// \param bufferThreadCount Number of threads used to buffer regions from different files concurrently,
+    ///                          buffering is disabled for values less than 2
+    bam_streamer_pool(
+        const std::vector<std::string>& alignmentFilenames,
+        const std::string& referenceFilename,
+        const unsigned maxOpenFileCount = 0,
+        const unsigned bufferThreadCount = 0);
+
+    ~bam_streamer_pool();
+
+    /// \return Total number of alignment files in the pool
+    unsigned
+    size() const
+    {
+        return _files.size();
+    }
+
+    /// \brief Get the stream for an alignment file, opening the file if required
+    stream_ptr
+    getStream(const unsigned fileIndex);
+
+    /// \brief Get the stream for an alignment file only if the file is already open
+    ///
+    /// This does not open the file or change the order in which open files are closed by the pool.
+    ///
+    /// \return The open file stream, or a null pointer if the file is not open
+    stream_ptr
+    getOpenStream(const unsigned fileIndex) const
+    {
+        assert(fileIndex < _files.size());
+        return _files[fileIndex].stream;
+    }
+
+    /// \brief Get the header of an alignment file
+    ///
+    /// The header persists for the lifetime of the pool, even if the file is closed.
+    const bam_hdr_t&
+    getHeader(const unsigned fileIndex);
+
+    /// \brief Read the same set of regions from multiple files concurrently, and buffer the records in memory
+    ///
+    /// This is intended to be called before a client scans the same regions in every file in turn, in file index
+    /// order, so that file reading and decompression for all files runs in parallel, and the client's scan of each
+    /// file only iterates through buffered records (see bam_streamer::bufferRegion()). The client should release
+    /// the buffered records of each stream (see bam_streamer::clearBufferedRegions()) once its scan of that file
+    /// is complete. Any regions buffered by a previous call are also released. This has no effect unless the pool
+    /// is configured with at least 2 buffer threads.
+    ///
+    /// Buffered records are lost if their file is closed by the pool, so if the pool has a maximum open file
+    /// count, only this many files are buffered. These are the first selected files in file index order, so that
+    /// all buffered files remain open until they are scanned. Files which are not buffered are read as usual.
+    ///
+    /// \param isFileSelected If not empty, only buffer files where this is true
+    void
+    bufferRegions(
+        const std::vector<bam_streamer::region_t>& regions,
+        const std::vector<bool>& isFileSelected = std::vector<bool>());
+
+    /// \brief Read a separate region from each of multiple files concurrently, and buffer the records in memory
+    ///
+    /// This is the same as bufferRegions(), except that only fileRegions[fileIndex] is buffered for each file.
+    ///
+    /// \param isFileSelected If not empty, only buffer files where this is true
+    void
+    bufferFileRegions(
+        const std::vector<bam_streamer::region_t>& fileRegions,
+        const std::vector<bool>& isFileSelected = std::vector<bool>());
+
+    /// \return Number of files currently held open by the pool
+    unsigned
+    openFileCount() const
+    {
+        return _lruFileIndices.size();
+    }
+
+    /// \return Total number of file open operations made by the pool
+    unsigned
+    totalFileOpenCount() const
+    {
+        return _totalFileOpenCount;
+    }
+
+private:
+    struct FileInfo
+    {
+        std::string filename;
+        stream_ptr stream;
+        bam_hdr_t* header = nullptr;
+        std::list<unsigned>::iterator lruIter;
+    };
+
+    /// \brief Open file if required, and mark it as the most recently used file
+    void
+    touchFile(const unsigned fileIndex);
+
+    /// \brief Shared implementation of bufferRegions() and bufferFileRegions()
+    ///
+    /// \param bufferFile Function used to buffer the required regions of one file from its stream
+    void
+    bufferFiles(
+        const std::function<void(const unsigned fileIndex, bam_streamer& stream)>& bufferFile,
+        const std::vector<bool>& isFileSelected);
+
+    std::string _referenceFilename;
+    unsigned _maxOpenFileCount;
+    unsigned _bufferThreadCount;
+    std::vector<FileInfo> _files;
+
+    /// indices of all open files, from most to least recently used
+    std::list<unsigned> _lruFileIndices;
+
+    unsigned _totalFileOpenCount;
+};
@@ -32,11 +32,11 @@ bool
 bed_streamer::
 next()
 {
-    if (_is_stream_end || (nullptr==_hfp) || (nullptr==_titr)) return false;
+    if (_is_stream_end || (nullptr==_hfp)) return false;
 
     while (true)
     {
-        if (tbx_itr_next(_hfp, _tidx, _titr, &_kstr) < 0)
+        if (_read_line() < 0)
         {
             _is_stream_end=true;
         }
@@ -0,0 +1,128 @@
+//
+// Manta - Structural Variant and Indel Caller
+// Copyright (c) 2013-2017 Illumina, Inc.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+//
+
+/// \file
+/// \author Chris Saunders
+///
+
+#include "htsapi/bgzf_dumper.hh"
+#include "htsapi/tabix_util.hh"
+
+#include "blt_util/blt_exception.hh"
+#include "blt_util/log.hh"
+
+extern "C" {
+#include "htslib/bgzf.h"
+}
+
+#include <cassert>
+#include <cstdlib>
+
+#include <iostream>
+#include <sstream>
+
+
+
+bgzf_dumper::
+bgzf_dumper(
+    const char* filename,
+    const unsigned threadCount)
+    : _bgzfp(nullptr),
+      _stream_name(filename)
+{
+    assert(nullptr != filename);
+
+    _bgzfp = bgzf_open(filename, "w");
+    if (nullptr == _bgzfp)
+    {
+        std::ostringstream oss;
+        oss << "Failed to open BGZF file for writing: '" << filename << "'";
+        throw blt_exception(oss.str().c_str());
+    }
+
+    if (threadCount > 1)
+    {
+        static const int subBlockCount(256);
+        bgzf_mt(_bgzfp, threadCount, subBlockCount);
+    }
+}
+
+
+
+bgzf_dumper::
+~bgzf_dumper()
+{
+    if (nullptr != _bgzfp)
+    {
+        if (bgzf_close(_bgzfp) != 0)
+        {
+            log_os << "Failed to close BGZF file: '" << name() << "'\n";
+            std::exit(EXIT_FAILURE);
+        }
+    }
+}
+
+
+
+void
+bgzf_dumper::
+put_text(const std::string& text)
+{
+    assert(nullptr != _bgzfp);
+
+    if (bgzf_write(_bgzfp, text.data(), text.size()) < 0)
+    {
+        std::ostringstream oss;
+        oss << "Failed to write to BGZF file: '" << name() << "'";
+        throw blt_exception(oss.str().c_str());
+    }
+}
+
+
+
+void
+bgzf_dumper::
+close()
+{
+    if (nullptr == _bgzfp) return;
+
+    const int retval(bgzf_close(_bgzfp));
+    _bgzfp = nullptr;
+    if (retval != 0)
+    {
+        std::ostringstream oss;
+        oss << "Failed to close BGZF file: '" << name() << "'";
+        throw blt_exception(oss.str().c_str());
+    }
+}
+
+
+
+void
+build_vcf_tabix_index(const char* filename)
+{
+    assert(nullptr != filename);
+
+    if (tbx_index_build(filename, 0, &tbx_conf_vcf) != 0)
+    {
+        std::ostringstream oss;
+        oss << "Failed to build tabix index for VCF file: '" << filename << "'";
+        throw blt_exception(oss.str().c_str());
+    }
+}
@@ -0,0 +1,65 @@
+//
+// Manta - Structural Variant and Indel Caller
+// Copyright (c) 2013-2017 Illumina, Inc.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+//
+
+/// \file
+/// \author Chris Saunders
+///
+
+#pragma once
+
+#include "boost/utility.hpp"
+
+#include <string>
+
+struct BGZF;
+
+
+/// \brief Write text to a BGZF compressed file
+///
+struct bgzf_dumper : private boost::noncopyable
+{
+    /// \param[in] threadCount number of threads used for block compression
+    explicit
+    bgzf_dumper(
+        const char* filename,
+        const unsigned threadCount = 1);
+
+    ~bgzf_dumper();
+
+    void
+    put_text(const std::string& text);
+
+    /// \brief Flush and close the file, after which no further text can be written
+    void
+    close();
+
+    const char* name() const
+    {
+        return _stream_name.c_str();
+    }
+
+private:
+    BGZF* _bgzfp;
+    std::string _stream_name;
+};
+
+
+/// \brief Build a tabix index for a closed, BGZF compressed and coordinate sorted VCF file
+void
+build_vcf_tabix_index(const char* filename);
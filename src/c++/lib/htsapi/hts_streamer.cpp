@@ -26,6 +26,10 @@
 #include "blt_util/blt_exception.hh"
 #include "blt_util/log.hh"
 
+extern "C" {
+#include "htslib/kseq.h"
+}
+
 #include <cstdlib>
 
 #include <iostream>
@@ -66,8 +70,6 @@ hts_streamer(
         exit(EXIT_FAILURE);
     }
 
-    _load_index();
-
     // read only a region of HTS file:
     if (nullptr != region)
     {
@@ -93,6 +95,8 @@ hts_streamer::
 resetRegion(
     const char* region)
 {
+    _load_index();
+
     if (nullptr != _titr) tbx_itr_destroy(_titr);
 
     _titr = tbx_itr_querys(_tidx, region);
@@ -114,3 +118,16 @@ _load_index()
         exit(EXIT_FAILURE);
     }
 }
+
+
+
+int
+hts_streamer::
+_read_line()
+{
+    if (nullptr == _titr)
+    {
+        return hts_getline(_hfp, KS_SEP_LINE, &_kstr);
+    }
+    return tbx_itr_next(_hfp, _tidx, _titr, &_kstr);
+}
@@ -36,8 +36,8 @@ struct hts_streamer : private boost::noncopyable
     /// \param[in] filename (required)
     /// \param[in] region (may be nullptr)
     ///
-    /// note that region must be set before iteration will produce any output
-    /// (ie. there is no "whole genome iteration" enabled if no region is provided)
+    /// if no region is provided, the whole file is streamed in file order without an index, until a region is set
+    /// with resetRegion()
     hts_streamer(
         const char* filename,
         const char* region);
@@ -68,6 +68,12 @@ protected:
     void
     _load_index();
 
+    /// read the next line from the current region, or from the whole file if no region has been set
+    ///
+    /// \return negative value at the end of the stream
+    int
+    _read_line();
+
     bool _is_record_set;
     bool _is_stream_end;
     unsigned _record_no;
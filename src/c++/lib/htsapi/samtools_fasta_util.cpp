@@ -24,6 +24,7 @@
 #include "samtools_fasta_util.hh"
 
 #include "blt_util/blt_exception.hh"
+#include "blt_util/packed_reference.hh"
 #include "blt_util/parse_util.hh"
 #include "blt_util/seq_util.hh"
 #include "blt_util/string_util.hh"
@@ -164,6 +165,54 @@ get_standardized_region_seq(
     const int end_pos,
     std::string& ref_seq)
 {
+    // serve the request from a packed reference image when one has been registered for this reference:
+    const packed_reference* packedRef(get_packed_reference(ref_file));
+    if (nullptr != packedRef)
+    {
+        const int contigIndex(packedRef->get_contig_index(chrom));
+        if (contigIndex >= 0)
+        {
+            packedRef->get_substring(contigIndex, begin_pos, (end_pos+1), ref_seq);
+            return;
+        }
+    }
+
     get_region_seq(ref_file,chrom,begin_pos,end_pos,ref_seq);
     standardize_ref_seq(ref_file.c_str(), chrom.c_str(), ref_seq, begin_pos);
 }
+
+
+
+void
+build_packed_reference(
+    const std::string& ref_file,
+    const std::string& image_file)
+{
+    faidx_t* fai(fai_load(ref_file.c_str()));
+    if (nullptr == fai)
+    {
+        std::ostringstream oss;
+        oss << "ERROR: Can't load index for reference file: '" << ref_file << "'\n";
+        throw blt_exception(oss.str().c_str());
+    }
+
+    packed_reference_writer writer(image_file);
+    std::string seq;
+    const int contigCount(faidx_nseq(fai));
+    for (int contigIndex(0); contigIndex<contigCount; ++contigIndex)
+    {
+        const std::string chrom(faidx_iseq(fai, contigIndex));
+        const int chromSize(faidx_seq_len(fai, chrom.c_str()));
+        if (chromSize > 0)
+        {
+            get_standardized_region_seq(ref_file, chrom, 0, (chromSize-1), seq);
+        }
+        else
+        {
+            seq.clear();
+        }
+        writer.add_contig(chrom, seq);
+    }
+    writer.close();
+    fai_destroy(fai);
+}
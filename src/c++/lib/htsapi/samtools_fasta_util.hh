@@ -71,3 +71,13 @@ get_standardized_region_seq(
     const int begin_pos,
     const int end_pos,
     std::string& ref_seq);
+
+
+/// write a 2-bit packed image of the standardized sequence of every contig in the reference
+///
+/// \param ref_file fasta reference sequence, which must be indexed
+/// \param image_file output packed reference image, which can be read by packed_reference
+void
+build_packed_reference(
+    const std::string& ref_file,
+    const std::string& image_file);
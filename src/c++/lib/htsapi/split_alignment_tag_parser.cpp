@@ -0,0 +1,169 @@
+//
+// Manta - Structural Variant and Indel Caller
+// Copyright (c) 2013-2017 Illumina, Inc.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+//
+
+/// \file
+/// \author Chris Saunders
+///
+
+#include "htsapi/split_alignment_tag_parser.hh"
+
+#include "blt_util/parse_util.hh"
+#include "common/Exceptions.hh"
+
+#include <cstring>
+
+#include <sstream>
+
+
+
+/// \brief Enumerate the fields for each split alignment segment as described in the BAM spec "SA" tag entry
+namespace SA_FIELDS
+{
+enum index_t
+{
+    CHROM,
+    POS,
+    STRAND,
+    CIGAR,
+    MAPQ,
+    NM,
+    SIZE
+};
+}
+
+
+
+static
+void
+segment_format_error(
+    const char* segment_begin,
+    const char* segment_end,
+    const char* msg)
+{
+    using namespace illumina::common;
+
+    std::ostringstream oss;
+    oss << "ERROR: " << msg << " in the split alignment segment: '"
+        << std::string(segment_begin,segment_end) << "'\n";
+    BOOST_THROW_EXCEPTION(LogicException(oss.str()));
+}
+
+
+
+void
+split_alignment_tag_parser::
+parse(
+    const char* sa_tag,
+    const std::map<std::string, int32_t>& chrom_to_index)
+{
+    _segment_count = 0;
+
+    const char* segment_begin(sa_tag);
+    while (*segment_begin != '\0')
+    {
+        const char* segment_end(std::strchr(segment_begin,';'));
+        if (nullptr == segment_end) segment_end = (segment_begin + std::strlen(segment_begin));
+
+        parse_segment(segment_begin, segment_end, chrom_to_index);
+
+        segment_begin = segment_end;
+        if (*segment_begin == ';') segment_begin++;
+    }
+}
+
+
+
+void
+split_alignment_tag_parser::
+parse_segment(
+    const char* segment_begin,
+    const char* segment_end,
+    const std::map<std::string, int32_t>& chrom_to_index)
+{
+    using namespace illumina::blt_util;
+
+    // find the [begin,end) range of each field:
+    const char* field_begin[SA_FIELDS::SIZE];
+    const char* field_end[SA_FIELDS::SIZE];
+    {
+        unsigned field_index(0);
+        field_begin[0] = segment_begin;
+        for (const char* cptr(segment_begin); cptr != segment_end; ++cptr)
+        {
+            if (*cptr != ',') continue;
+            field_end[field_index] = cptr;
+            field_index++;
+            if (field_index >= SA_FIELDS::SIZE) break;
+            field_begin[field_index] = (cptr+1);
+        }
+
+        if (field_index != (SA_FIELDS::SIZE-1))
+        {
+            segment_format_error(segment_begin, segment_end, "Unexpected format");
+        }
+        field_end[field_index] = segment_end;
+    }
+
+    if (_segment_count >= _segments.size()) _segments.emplace_back();
+    split_alignment_segment& segment(_segments[_segment_count]);
+    SimpleAlignment& align(segment.align);
+
+    _chrom.assign(field_begin[SA_FIELDS::CHROM], field_end[SA_FIELDS::CHROM]);
+    const auto chrom_iter(chrom_to_index.find(_chrom));
+    if (chrom_iter == chrom_to_index.end())
+    {
+        using namespace illumina::common;
+
+        std::ostringstream oss;
+        oss << "ERROR: Split alignment segment maps to an unknown chromosome: '" << _chrom << "'\n";
+        BOOST_THROW_EXCEPTION(LogicException(oss.str()));
+    }
+    align.tid = chrom_iter->second;
+
+    {
+        const char* cptr(field_begin[SA_FIELDS::POS]);
+        align.pos = (parse_int(cptr)-1);
+        if (cptr != field_end[SA_FIELDS::POS])
+        {
+            segment_format_error(segment_begin, segment_end, "Unexpected position entry");
+        }
+    }
+
+    {
+        const char strand(*field_begin[SA_FIELDS::STRAND]);
+        if (! ((strand=='-') || (strand=='+')))
+        {
+            segment_format_error(segment_begin, segment_end, "Unexpected strand entry");
+        }
+        align.is_fwd_strand = (strand == '+');
+    }
+
+    cigar_to_apath(field_begin[SA_FIELDS::CIGAR], field_end[SA_FIELDS::CIGAR], align.path);
+
+    {
+        const char* cptr(field_begin[SA_FIELDS::MAPQ]);
+        segment.mapq = parse_unsigned(cptr);
+        if (cptr != field_end[SA_FIELDS::MAPQ])
+        {
+            segment_format_error(segment_begin, segment_end, "Unexpected mapping quality entry");
+        }
+    }
+
+    _segment_count++;
+}
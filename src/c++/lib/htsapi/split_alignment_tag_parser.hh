@@ -0,0 +1,94 @@
+//
+// Manta - Structural Variant and Indel Caller
+// Copyright (c) 2013-2017 Illumina, Inc.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+//
+
+/// \file
+/// \author Chris Saunders
+///
+
+#pragma once
+
+#include "blt_util/SimpleAlignment.hh"
+
+#include <map>
+#include <string>
+#include <vector>
+
+
+/// \brief One segment of a split read alignment from the BAM 'SA' tag
+struct split_alignment_segment
+{
+    SimpleAlignment align;
+    unsigned mapq = 0;
+};
+
+
+/// \brief Parse all segments of a BAM 'SA' tag
+///
+/// Segment fields are parsed in place from the tag string, and segment storage is reused from
+/// one read to the next, so that no allocation is required to parse a typical read once the
+/// parser has seen a few split reads.
+///
+/// Segments are reported in the order they appear in the tag.
+///
+struct split_alignment_tag_parser
+{
+    /// \brief Parse \p sa_tag, replacing any segments from the previous parse
+    ///
+    /// Throws if the tag is malformed or refers to a chromosome name which is not found in \p chrom_to_index
+    ///
+    /// \param[in] sa_tag the 'SA' tag value in SAM format: "chrom,pos,strand,cigar,mapq,nm;..."
+    /// \param[in] chrom_to_index chromosome name to BAM index lookup, as found in bam_header_info
+    void
+    parse(
+        const char* sa_tag,
+        const std::map<std::string, int32_t>& chrom_to_index);
+
+    unsigned
+    size() const
+    {
+        return _segment_count;
+    }
+
+    bool
+    empty() const
+    {
+        return (0 == _segment_count);
+    }
+
+    const split_alignment_segment&
+    operator[](const unsigned index) const
+    {
+        return _segments[index];
+    }
+
+private:
+    void
+    parse_segment(
+        const char* segment_begin,
+        const char* segment_end,
+        const std::map<std::string, int32_t>& chrom_to_index);
+
+    unsigned _segment_count = 0;
+
+    /// segments beyond _segment_count are retained to reuse their storage
+    std::vector<split_alignment_segment> _segments;
+
+    /// reused buffer for chromosome name lookup
+    std::string _chrom;
+};
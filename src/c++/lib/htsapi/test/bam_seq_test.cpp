@@ -0,0 +1,103 @@
+//
+// Manta - Structural Variant and Indel Caller
+// Copyright (c) 2013-2017 Illumina, Inc.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+//
+
+#include "htsapi/bam_seq.hh"
+
+#include "boost/test/unit_test.hpp"
+
+#include <vector>
+
+
+
+BOOST_AUTO_TEST_SUITE( test_bam_seq )
+
+/// pack an ascii sequence into the 4-bit bam sequence format
+static
+std::vector<uint8_t>
+pack_bam_seq(const std::string& seq)
+{
+    std::vector<uint8_t> packed((seq.size()+1)/2,0);
+    for (unsigned i(0); i<seq.size(); ++i)
+    {
+        packed[i/2] |= (get_bam_seq_code(seq[i]) << 4*(1-(i%2)));
+    }
+    return packed;
+}
+
+
+static
+std::string
+reverse_complement(const std::string& seq)
+{
+    std::string rc(seq.rbegin(),seq.rend());
+    for (char& c : rc)
+    {
+        c = get_bam_seq_complement_char(get_bam_seq_code(c));
+    }
+    return rc;
+}
+
+
+BOOST_AUTO_TEST_CASE( test_bam_seq_decode )
+{
+    static const std::string seq("ACGTNACCGGTTAN=GA");
+    const std::vector<uint8_t> packed(pack_bam_seq(seq));
+
+    // test all combinations of odd/even offset and size:
+    for (unsigned offset(0); offset<4; ++offset)
+    {
+        for (unsigned size(0); (offset+size)<=seq.size(); ++size)
+        {
+            const bam_seq bs(packed.data(),size,offset);
+            const std::string expect(seq.substr(offset,size));
+            BOOST_REQUIRE_EQUAL(bs.get_string(), expect);
+            BOOST_REQUIRE_EQUAL(bs.get_rc_string(), reverse_complement(expect));
+        }
+    }
+}
+
+
+BOOST_AUTO_TEST_CASE( test_bam_seq_decode_long )
+{
+    // packed sequence covering every 4-bit base code, long enough to test block decoding:
+    std::vector<uint8_t> packed(100);
+    for (unsigned i(0); i<packed.size(); ++i)
+    {
+        packed[i] = static_cast<uint8_t>((i*37+11) % 256);
+    }
+
+    for (unsigned offset(0); offset<4; ++offset)
+    {
+        for (unsigned size(0); (offset+size)<=(packed.size()*2); ++size)
+        {
+            const bam_seq bs(packed.data(),size,offset);
+            std::string expect, expectRC;
+            for (unsigned i(0); i<size; ++i)
+            {
+                expect.push_back(bs.get_char(i));
+                expectRC.push_back(bs.get_complement_char(size-1-i));
+            }
+            BOOST_REQUIRE_EQUAL(bs.get_string(), expect);
+            BOOST_REQUIRE_EQUAL(bs.get_rc_string(), expectRC);
+        }
+    }
+}
+
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,228 @@
+//
+// Manta - Structural Variant and Indel Caller
+// Copyright (c) 2013-2017 Illumina, Inc.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+//
+
+#include "test_config.h"
+
+#include "htsapi/bam_streamer_pool.hh"
+
+#include "boost/test/unit_test.hpp"
+
+
+
+BOOST_AUTO_TEST_SUITE( test_bam_streamer_pool )
+
+
+static
+unsigned
+getMappedRegionReadCount(
+    bam_streamer& stream,
+    const char* region)
+{
+    stream.resetRegion(region);
+    unsigned count(0);
+    while (stream.next())
+    {
+        const bam_record& read(*(stream.get_record_ptr()));
+        if (! read.is_unmapped()) count++;
+    }
+    return count;
+}
+
+
+BOOST_AUTO_TEST_CASE( test_bam_streamer_pool_shared_stream )
+{
+    const std::string testBamPath(std::string(TEST_DATA_PATH) + "/alignment_test.bam");
+    const std::string testCramPath(std::string(TEST_DATA_PATH) + "/alignment_test.cram");
+    const std::string testRefPath(std::string(TEST_DATA_PATH) + "/alignment_test.fasta");
+
+    bam_streamer_pool pool({testBamPath, testCramPath}, testRefPath);
+    BOOST_REQUIRE_EQUAL(pool.size(), 2u);
+
+    // files are only opened on demand:
+    BOOST_REQUIRE_EQUAL(pool.openFileCount(), 0u);
+
+    const bam_streamer_pool::stream_ptr stream1(pool.getStream(0));
+    BOOST_REQUIRE_EQUAL(getMappedRegionReadCount(*stream1, "chrA"), 2u);
+    BOOST_REQUIRE_EQUAL(pool.openFileCount(), 1u);
+
+    // repeated requests share the same stream:
+    const bam_streamer_pool::stream_ptr stream2(pool.getStream(0));
+    BOOST_REQUIRE_EQUAL(stream1.get(), stream2.get());
+    BOOST_REQUIRE_EQUAL(getMappedRegionReadCount(*stream2, "chrA"), 2u);
+
+    BOOST_REQUIRE_EQUAL(getMappedRegionReadCount(*pool.getStream(1), "chrA"), 2u);
+    BOOST_REQUIRE_EQUAL(pool.openFileCount(), 2u);
+    BOOST_REQUIRE_EQUAL(pool.totalFileOpenCount(), 2u);
+}
+
+
+BOOST_AUTO_TEST_CASE( test_bam_streamer_pool_max_open_files )
+{
+    const std::string testBamPath(std::string(TEST_DATA_PATH) + "/alignment_test.bam");
+    const std::string testCramPath(std::string(TEST_DATA_PATH) + "/alignment_test.cram");
+    const std::string testRefPath(std::string(TEST_DATA_PATH) + "/alignment_test.fasta");
+
+    bam_streamer_pool pool({testBamPath, testCramPath, testBamPath}, testRefPath, 2);
+
+    // retain a pointer to the first stream after it is closed by the pool:
+    const bam_streamer_pool::stream_ptr stream0(pool.getStream(0));
+    pool.getStream(1);
+    pool.getStream(0);
+    pool.getStream(2);
+    BOOST_REQUIRE_EQUAL(pool.openFileCount(), 2u);
+    BOOST_REQUIRE_EQUAL(pool.totalFileOpenCount(), 3u);
+
+    // file 1 is least recently used, so it is closed and reopened on request:
+    pool.getStream(1);
+    BOOST_REQUIRE_EQUAL(pool.openFileCount(), 2u);
+    BOOST_REQUIRE_EQUAL(pool.totalFileOpenCount(), 4u);
+
+    // file 0 has been closed by the pool, but is still valid for the client holding it:
+    BOOST_REQUIRE_EQUAL(getMappedRegionReadCount(*stream0, "chrA"), 2u);
+    BOOST_REQUIRE(stream0.get() != pool.getStream(0).get());
+
+    // headers are available after a file is closed:
+    BOOST_REQUIRE_EQUAL(pool.getHeader(1).n_targets, 2);
+    BOOST_REQUIRE_EQUAL(pool.totalFileOpenCount(), 5u);
+}
+
+
+BOOST_AUTO_TEST_CASE( test_bam_streamer_pool_open_stream )
+{
+    const std::string testBamPath(std::string(TEST_DATA_PATH) + "/alignment_test.bam");
+    const std::string testCramPath(std::string(TEST_DATA_PATH) + "/alignment_test.cram");
+    const std::string testRefPath(std::string(TEST_DATA_PATH) + "/alignment_test.fasta");
+
+    bam_streamer_pool pool({testBamPath, testCramPath, testBamPath}, testRefPath, 2);
+
+    // files are not opened on request for an open stream:
+    BOOST_REQUIRE(! pool.getOpenStream(0));
+    BOOST_REQUIRE_EQUAL(pool.openFileCount(), 0u);
+
+    const bam_streamer_pool::stream_ptr stream0(pool.getStream(0));
+    pool.getStream(1);
+    BOOST_REQUIRE_EQUAL(pool.getOpenStream(0).get(), stream0.get());
+
+    // the open stream request does not mark file 0 as recently used, so it is closed first:
+    pool.getStream(2);
+    BOOST_REQUIRE(! pool.getOpenStream(0));
+    BOOST_REQUIRE(pool.getOpenStream(1));
+    BOOST_REQUIRE(pool.getOpenStream(2));
+    BOOST_REQUIRE_EQUAL(pool.totalFileOpenCount(), 3u);
+}
+
+
+/// \return count of mapped reads in region, and whether the region was read from buffered records
+static
+unsigned
+getMappedRegionReadCount(
+    bam_streamer& stream,
+    const bam_streamer::region_t& region,
+    bool& isBuffered)
+{
+    stream.resetRegion(region.referenceContigId, region.beginPos, region.endPos);
+    isBuffered = stream.isBufferedRegion();
+    unsigned count(0);
+    while (stream.next())
+    {
+        const bam_record& read(*(stream.get_record_ptr()));
+        if (! read.is_unmapped()) count++;
+    }
+    return count;
+}
+
+
+BOOST_AUTO_TEST_CASE( test_bam_streamer_pool_buffer_regions )
+{
+    const std::string testBamPath(std::string(TEST_DATA_PATH) + "/alignment_test.bam");
+    const std::string testCramPath(std::string(TEST_DATA_PATH) + "/alignment_test.cram");
+    const std::string testRefPath(std::string(TEST_DATA_PATH) + "/alignment_test.fasta");
+
+    // use 2 buffer threads to test buffering in multiple batches:
+    bam_streamer_pool pool({testBamPath, testCramPath, testBamPath}, testRefPath, 0, 2);
+
+    const std::vector<bam_streamer::region_t> regions = { bam_streamer::region_t(0, 0, 10), bam_streamer::region_t(1, 0, 14) };
+    const std::vector<bool> isFileSelected = {true, false, true};
+    pool.bufferRegions(regions, isFileSelected);
+    const unsigned bufferOpenCount(pool.totalFileOpenCount());
+
+    for (unsigned fileIndex(0); fileIndex<pool.size(); ++fileIndex)
+    {
+        const bam_streamer_pool::stream_ptr stream(pool.getStream(fileIndex));
+        bool isBuffered(false);
+        BOOST_REQUIRE_EQUAL(getMappedRegionReadCount(*stream, regions[0], isBuffered), 2u);
+        BOOST_REQUIRE_EQUAL(isBuffered, isFileSelected[fileIndex]);
+        BOOST_REQUIRE_EQUAL(getMappedRegionReadCount(*stream, regions[1], isBuffered), 2u);
+        BOOST_REQUIRE_EQUAL(isBuffered, isFileSelected[fileIndex]);
+
+        // buffered records are released by the client after each scan:
+        stream->clearBufferedRegions();
+        getMappedRegionReadCount(*stream, regions[0], isBuffered);
+        BOOST_REQUIRE(! isBuffered);
+    }
+
+    // only the unselected file is opened after buffering:
+    BOOST_REQUIRE_EQUAL(pool.totalFileOpenCount(), (bufferOpenCount+1));
+
+    // buffer a separate region for each file:
+    const std::vector<bam_streamer::region_t> fileRegions = { regions[0], regions[1], regions[1] };
+    pool.bufferFileRegions(fileRegions);
+    for (unsigned fileIndex(0); fileIndex<pool.size(); ++fileIndex)
+    {
+        const bam_streamer_pool::stream_ptr stream(pool.getStream(fileIndex));
+        bool isBuffered(false);
+        BOOST_REQUIRE_EQUAL(getMappedRegionReadCount(*stream, fileRegions[fileIndex], isBuffered), 2u);
+        BOOST_REQUIRE(isBuffered);
+    }
+    BOOST_REQUIRE_EQUAL(pool.totalFileOpenCount(), 3u);
+}
+
+
+BOOST_AUTO_TEST_CASE( test_bam_streamer_pool_buffer_regions_max_open_files )
+{
+    const std::string testBamPath(std::string(TEST_DATA_PATH) + "/alignment_test.bam");
+    const std::string testCramPath(std::string(TEST_DATA_PATH) + "/alignment_test.cram");
+    const std::string testRefPath(std::string(TEST_DATA_PATH) + "/alignment_test.fasta");
+
+    // the open file limit is less than the file count:
+    bam_streamer_pool pool({testBamPath, testCramPath, testBamPath}, testRefPath, 2, 4);
+
+    const bam_streamer::region_t region(0, 0, 10);
+    pool.bufferRegions({region});
+
+    // only the files which can be held open are buffered:
+    BOOST_REQUIRE_EQUAL(pool.openFileCount(), 2u);
+    BOOST_REQUIRE_EQUAL(pool.totalFileOpenCount(), 2u);
+
+    // scan all files in order, the buffered files are not closed before they are scanned:
+    for (unsigned fileIndex(0); fileIndex<pool.size(); ++fileIndex)
+    {
+        const bam_streamer_pool::stream_ptr stream(pool.getStream(fileIndex));
+        bool isBuffered(false);
+        BOOST_REQUIRE_EQUAL(getMappedRegionReadCount(*stream, region, isBuffered), 2u);
+        BOOST_REQUIRE_EQUAL(isBuffered, (fileIndex < 2));
+        stream->clearBufferedRegions();
+    }
+
+    // only the unbuffered file is opened during the scan:
+    BOOST_REQUIRE_EQUAL(pool.totalFileOpenCount(), 3u);
+}
+
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -23,6 +23,8 @@
 
 #include "boost/test/unit_test.hpp"
 
+#include <vector>
+
 
 
 BOOST_AUTO_TEST_SUITE( test_bam_streamer )
@@ -92,4 +94,78 @@ BOOST_AUTO_TEST_CASE( test_bam_streamer_cram_read )
 }
 
 
+BOOST_AUTO_TEST_CASE( test_bam_streamer_buffered_region )
+{
+    const std::string testBamPath(std::string(TEST_DATA_PATH) + "/alignment_test.bam");
+
+    bam_streamer stream(testBamPath.c_str(), nullptr);
+
+    auto getRegionReadNames = [&](const bam_streamer::region_t& region)
+    {
+        stream.resetRegion(region.referenceContigId, region.beginPos, region.endPos);
+        std::vector<std::string> readNames;
+        while (stream.next())
+        {
+            readNames.push_back(stream.get_record_ptr()->qname());
+        }
+        return readNames;
+    };
+
+    const bam_streamer::region_t regionA(0, 0, 10);
+    const bam_streamer::region_t regionB(1, 0, 14);
+    const std::vector<std::string> fileReadNamesA(getRegionReadNames(regionA));
+    const std::vector<std::string> fileReadNamesB(getRegionReadNames(regionB));
+    BOOST_REQUIRE_EQUAL(fileReadNamesA.size(), 2u);
+
+    stream.bufferRegion(regionA);
+    stream.bufferRegion(regionB);
+
+    // buffered regions can be iterated in any order, and more than once:
+    for (unsigned repeatIndex(0); repeatIndex<2; ++repeatIndex)
+    {
+        BOOST_REQUIRE(getRegionReadNames(regionB) == fileReadNamesB);
+        BOOST_REQUIRE(getRegionReadNames(regionA) == fileReadNamesA);
+    }
+
+    // regions which don't exactly match a buffered region are read from the file:
+    BOOST_REQUIRE_EQUAL(getRegionReadNames(bam_streamer::region_t(0, 0, 9)).size(), 2u);
+
+    stream.clearBufferedRegions();
+    BOOST_REQUIRE(getRegionReadNames(regionA) == fileReadNamesA);
+}
+
+
+
+BOOST_AUTO_TEST_CASE( test_bam_streamer_region_file_ranges )
+{
+    const std::string testBamPath(std::string(TEST_DATA_PATH) + "/alignment_test.bam");
+    const std::string testCramPath(std::string(TEST_DATA_PATH) + "/alignment_test.cram");
+    const std::string testRefPath(std::string(TEST_DATA_PATH) + "/alignment_test.fasta");
+
+    std::vector<std::pair<uint64_t,uint64_t>> fileRanges;
+    {
+        bam_streamer stream(testBamPath.c_str(), nullptr);
+        BOOST_REQUIRE(stream.getRegionFileRanges(0, 0, 10, fileRanges));
+        BOOST_REQUIRE(! fileRanges.empty());
+
+        uint64_t dataSize(0);
+        for (const auto& fileRange : fileRanges)
+        {
+            BOOST_REQUIRE(fileRange.first <= fileRange.second);
+            dataSize += (fileRange.second - fileRange.first);
+        }
+
+        uint64_t estimatedDataSize(0);
+        BOOST_REQUIRE(stream.estimateRegionDataSize(0, 0, 10, estimatedDataSize));
+        BOOST_REQUIRE_EQUAL(dataSize, estimatedDataSize);
+    }
+
+    {
+        bam_streamer stream(testCramPath.c_str(), testRefPath.c_str());
+        BOOST_REQUIRE(! stream.getRegionFileRanges(0, 0, 10, fileRanges));
+        BOOST_REQUIRE(fileRanges.empty());
+    }
+}
+
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,66 @@
+//
+// Manta - Structural Variant and Indel Caller
+// Copyright (c) 2013-2017 Illumina, Inc.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+//
+
+#include "htsapi/bgzf_dumper.hh"
+#include "htsapi/vcf_streamer.hh"
+
+#include "boost/test/unit_test.hpp"
+
+#include <cstdio>
+
+#include <string>
+
+
+BOOST_AUTO_TEST_SUITE( test_bgzf_dumper )
+
+
+// test that a VCF written and indexed by bgzf_dumper can be read by region
+BOOST_AUTO_TEST_CASE( test_bgzf_dumper_vcf_index )
+{
+    const std::string testFilename("bgzf_dumper_test.vcf.gz");
+    const std::string testIndexFilename(testFilename + ".tbi");
+
+    {
+        bgzf_dumper bgzfd(testFilename.c_str(), 2);
+        bgzfd.put_text("##fileformat=VCFv4.1\n"
+                       "##contig=<ID=chr1,length=1000>\n"
+                       "##contig=<ID=chr2,length=1000>\n"
+                       "#CHROM\tPOS\tID\tREF\tALT\tQUAL\tFILTER\tINFO\n");
+        bgzfd.put_text("chr1\t100\t.\tA\tC\t.\tPASS\t.\n");
+        bgzfd.put_text("chr2\t200\t.\tG\tT\t.\tPASS\t.\n");
+        bgzfd.close();
+    }
+    build_vcf_tabix_index(testFilename.c_str());
+
+    {
+        vcf_streamer vcfs(testFilename.c_str(), "chr2");
+        BOOST_REQUIRE( vcfs.next() );
+        const vcf_record* vptr(vcfs.get_record_ptr());
+        assert(vptr != nullptr);
+        BOOST_REQUIRE_EQUAL(vptr->chrom, "chr2");
+        BOOST_REQUIRE_EQUAL(vptr->pos, 200);
+        BOOST_REQUIRE( ! vcfs.next() );
+    }
+
+    std::remove(testFilename.c_str());
+    std::remove(testIndexFilename.c_str());
+}
+
+
+BOOST_AUTO_TEST_SUITE_END()
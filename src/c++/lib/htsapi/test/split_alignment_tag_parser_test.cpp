@@ -0,0 +1,84 @@
+//
+// Manta - Structural Variant and Indel Caller
+// Copyright (c) 2013-2017 Illumina, Inc.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+//
+
+#include "htsapi/split_alignment_tag_parser.hh"
+
+#include "boost/test/unit_test.hpp"
+
+
+
+BOOST_AUTO_TEST_SUITE( test_split_alignment_tag_parser )
+
+static
+std::map<std::string, int32_t>
+get_test_chrom_to_index()
+{
+    std::map<std::string, int32_t> chrom_to_index;
+    chrom_to_index["chr1"] = 0;
+    chrom_to_index["HLA-A*01:01:01:02N"] = 1;
+    return chrom_to_index;
+}
+
+
+BOOST_AUTO_TEST_CASE( test_split_alignment_tag_parse )
+{
+    const std::map<std::string, int32_t> chrom_to_index(get_test_chrom_to_index());
+
+    split_alignment_tag_parser parser;
+    parser.parse("HLA-A*01:01:01:02N,101,-,20S30M,60,2;chr1,1001,+,30H20M,7,0;", chrom_to_index);
+
+    BOOST_REQUIRE_EQUAL(parser.size(), 2u);
+
+    BOOST_REQUIRE_EQUAL(parser[0].align.tid, 1);
+    BOOST_REQUIRE_EQUAL(parser[0].align.pos, 100);
+    BOOST_REQUIRE(! parser[0].align.is_fwd_strand);
+    BOOST_REQUIRE_EQUAL(apath_to_cigar(parser[0].align.path), "20S30M");
+    BOOST_REQUIRE_EQUAL(parser[0].mapq, 60u);
+
+    BOOST_REQUIRE_EQUAL(parser[1].align.tid, 0);
+    BOOST_REQUIRE_EQUAL(parser[1].align.pos, 1000);
+    BOOST_REQUIRE(parser[1].align.is_fwd_strand);
+    BOOST_REQUIRE_EQUAL(apath_to_cigar(parser[1].align.path), "30H20M");
+    BOOST_REQUIRE_EQUAL(parser[1].mapq, 7u);
+
+    // segment storage is reused, and a trailing separator is optional:
+    parser.parse("chr1,51,+,10M,20,0", chrom_to_index);
+    BOOST_REQUIRE_EQUAL(parser.size(), 1u);
+    BOOST_REQUIRE_EQUAL(parser[0].align.pos, 50);
+    BOOST_REQUIRE_EQUAL(apath_to_cigar(parser[0].align.path), "10M");
+
+    parser.parse("", chrom_to_index);
+    BOOST_REQUIRE(parser.empty());
+}
+
+
+BOOST_AUTO_TEST_CASE( test_split_alignment_tag_parse_errors )
+{
+    const std::map<std::string, int32_t> chrom_to_index(get_test_chrom_to_index());
+
+    split_alignment_tag_parser parser;
+    BOOST_REQUIRE_THROW(parser.parse("chr2,101,-,20S30M,60,2;", chrom_to_index), std::exception);
+    BOOST_REQUIRE_THROW(parser.parse("chr1,101,-,20S30M,60;", chrom_to_index), std::exception);
+    BOOST_REQUIRE_THROW(parser.parse("chr1,101,-,20S30M,60,2,1;", chrom_to_index), std::exception);
+    BOOST_REQUIRE_THROW(parser.parse("chr1,101,*,20S30M,60,2;", chrom_to_index), std::exception);
+    BOOST_REQUIRE_THROW(parser.parse("chr1,101x,-,20S30M,60,2;", chrom_to_index), std::exception);
+}
+
+
+BOOST_AUTO_TEST_SUITE_END()
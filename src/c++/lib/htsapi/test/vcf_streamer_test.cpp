@@ -248,5 +248,28 @@ BOOST_AUTO_TEST_CASE( test_vcf_streamer_region )
 }
 
 
+
+// test that all records are streamed in file order if no region is given
+BOOST_AUTO_TEST_CASE( test_vcf_streamer_whole_file )
+{
+    vcf_streamer vcfs(getTestpath(), nullptr, true, false);
+
+    BOOST_REQUIRE( vcfs.next() );
+    const vcf_record* vptr(vcfs.get_record_ptr());
+    assert(vptr != nullptr);
+    BOOST_REQUIRE_EQUAL(vptr->chrom, "chr1");
+    BOOST_REQUIRE_EQUAL(vptr->pos, 54712);
+
+    // without the normalization check, records which are not normalized are streamed without an exception:
+    unsigned recordCount(1);
+    while (vcfs.next())
+    {
+        recordCount++;
+    }
+    BOOST_REQUIRE_EQUAL(recordCount, 20u);
+}
+
+
+
 BOOST_AUTO_TEST_SUITE_END()
 
@@ -77,10 +77,12 @@ vcf_streamer::
 vcf_streamer(
     const char* filename,
     const char* region,
-    const bool isRequireNormalized) :
+    const bool isRequireNormalized,
+    const bool isCheckNormalized) :
     hts_streamer(filename,region),
     _hdr(nullptr),
-    _isRequireNormalized(isRequireNormalized)
+    _isRequireNormalized(isRequireNormalized),
+    _isCheckNormalized(isCheckNormalized)
 {
     //
     // note with the switch to samtools 1.X vcf/bcf still involve predominantly separate
@@ -111,11 +113,11 @@ bool
 vcf_streamer::
 next()
 {
-    if (_is_stream_end || (nullptr==_hfp) || (nullptr==_titr)) return false;
+    if (_is_stream_end || (nullptr==_hfp)) return false;
 
     while (true)
     {
-        if (tbx_itr_next(_hfp, _tidx, _titr, &_kstr) < 0)
+        if (_read_line() < 0)
         {
             _is_stream_end=true;
         }
@@ -137,7 +139,7 @@ next()
             exit(EXIT_FAILURE);
         }
 
-        if (_vcfrec.isSimpleVariantLocus())
+        if (_isCheckNormalized && _vcfrec.isSimpleVariantLocus())
         {
             if (!_vcfrec.is_normalized())
             {
@@ -33,10 +33,13 @@ struct vcf_streamer : public hts_streamer
 {
     /// \param[in] isRequireNormalized if true an exception is thrown for any input variant records which are not
     ///                                left shifted
+    /// \param[in] isCheckNormalized if false, input variant records are not checked for normalization, so that all
+    ///                              records are streamed without modification
     vcf_streamer(
         const char* filename,
         const char* region,
-        const bool isRequireNormalized = true);
+        const bool isRequireNormalized = true,
+        const bool isCheckNormalized = true);
 
     ~vcf_streamer();
 
@@ -79,4 +82,5 @@ private:
     unsigned _sampleCount;
     vcf_record _vcfrec;
     bool _isRequireNormalized;
+    bool _isCheckNormalized;
 };
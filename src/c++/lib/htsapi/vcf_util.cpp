@@ -24,8 +24,15 @@
 #include "htsapi/vcf_util.hh"
 
 #include "blt_util/blt_exception.hh"
+
+extern "C" {
+#include "htslib/hts.h"
+#include "htslib/kseq.h"
+}
+
 #include <cassert>
 #include <cctype>
+#include <cstdlib>
 #include <ctime>
 
 #include <iostream>
@@ -49,6 +56,36 @@ vcf_fileDate(std::ostream& os)
 
 
 
+void
+read_vcf_header_lines(
+    const char* filename,
+    std::vector<std::string>& headerLines)
+{
+    assert(nullptr != filename);
+
+    headerLines.clear();
+
+    htsFile* hfp(hts_open(filename, "r"));
+    if (nullptr == hfp)
+    {
+        std::ostringstream oss;
+        oss << "Failed to open VCF file: '" << filename << "'";
+        throw blt_exception(oss.str().c_str());
+    }
+
+    kstring_t kstr = {0,0,0};
+    while (hts_getline(hfp, KS_SEP_LINE, &kstr) >= 0)
+    {
+        if ((kstr.l == 0) || (kstr.s[0] != '#')) break;
+        headerLines.emplace_back(kstr.s, kstr.l);
+    }
+
+    if (nullptr != kstr.s) free(kstr.s);
+    hts_close(hfp);
+}
+
+
+
 void
 write_vcf_filter(
     std::ostream& os,
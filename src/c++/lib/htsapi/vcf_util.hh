@@ -28,6 +28,7 @@
 
 #include <cstring>
 #include <iosfwd>
+#include <string>
 #include <vector>
 
 
@@ -71,6 +72,16 @@ write_vcf_filter(
     const char* desc);
 
 
+/// read all header lines of a VCF file without modification
+///
+/// the header parsed by htslib is normalized, so this is used where the header must be reproduced exactly
+///
+void
+read_vcf_header_lines(
+    const char* filename,
+    std::vector<std::string>& headerLines);
+
+
 /// look for 'key' in vcf FORMAT field, provide index of key or return
 /// false
 ///
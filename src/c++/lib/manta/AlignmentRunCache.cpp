@@ -0,0 +1,335 @@
+//
+// Manta - Structural Variant and Indel Caller
+// Copyright (c) 2013-2017 Illumina, Inc.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+//
+
+/// \file
+/// \author Chris Saunders
+///
+
+#include "manta/AlignmentRunCache.hh"
+
+#include "blt_util/log.hh"
+#include "htsapi/bam_streamer.hh"
+#include "manta/ReadGroupStatsUtil.hh"
+
+#include "boost/filesystem.hpp"
+
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <fstream>
+#include <iomanip>
+#include <limits>
+#include <sstream>
+
+
+/// Increment this whenever the cached results or their file format change, so that older cache entries are not used
+static const char cacheFormatVersion[] = "1";
+
+
+
+namespace
+{
+
+/// \brief 64-bit FNV-1a hash, used because it is stable across platforms and library versions
+struct CacheKeyHash
+{
+    void
+    add(
+        const char* data,
+        const size_t size)
+    {
+        for (size_t i(0); i<size; ++i)
+        {
+            _hash ^= static_cast<uint8_t>(data[i]);
+            _hash *= 0x100000001b3ULL;
+        }
+    }
+
+    /// add a string field, including the terminating null so that adjacent fields are separated
+    void
+    add(const std::string& field)
+    {
+        add(field.c_str(), field.size()+1);
+    }
+
+    std::string
+    getHexValue() const
+    {
+        std::ostringstream oss;
+        oss << std::hex << std::setw(16) << std::setfill('0') << _hash;
+        return oss.str();
+    }
+
+private:
+    uint64_t _hash = 0xcbf29ce484222325ULL;
+};
+
+}
+
+
+
+/// \return the index filename of an alignment file following the search order of bam_streamer, or an empty string
+///         if no index is found
+static
+std::string
+getAlignmentIndexFilename(const std::string& alignmentFilename)
+{
+    namespace bfs = boost::filesystem;
+
+    for (const char* indexExt : { ".bai", ".csi", ".crai" })
+    {
+        const std::string indexFilename(alignmentFilename + indexExt);
+        if (bfs::exists(indexFilename)) return indexFilename;
+    }
+
+    static const std::string bamExt(".bam");
+    const size_t baseSize(alignmentFilename.size() - std::min(alignmentFilename.size(), bamExt.size()));
+    if (alignmentFilename.compare(baseSize, std::string::npos, bamExt) == 0)
+    {
+        const std::string indexFilename(alignmentFilename.substr(0, baseSize) + ".bai");
+        if (bfs::exists(indexFilename)) return indexFilename;
+    }
+    return "";
+}
+
+
+
+AlignmentRunCache::
+AlignmentRunCache(const std::string& cacheDir) :
+    _cacheDir(cacheDir)
+{
+    if (! isEnabled()) return;
+
+    boost::system::error_code ec;
+    boost::filesystem::create_directories(_cacheDir, ec);
+    if (ec)
+    {
+        log_os << "WARNING: Can't create run cache directory '" << _cacheDir << "', cache is disabled: "
+               << ec.message() << "\n";
+        _cacheDir.clear();
+    }
+}
+
+
+
+std::string
+AlignmentRunCache::
+getEntryFilename(
+    const std::string& referenceFilename,
+    const std::string& alignmentFilename,
+    const std::string& entryType,
+    const std::string& entryLabel,
+    const char* entrySuffix) const
+{
+    namespace bfs = boost::filesystem;
+
+    CacheKeyHash keyHash;
+    keyHash.add(cacheFormatVersion);
+    keyHash.add(entryType);
+    keyHash.add(entryLabel);
+
+    try
+    {
+        keyHash.add(std::to_string(bfs::file_size(alignmentFilename)));
+
+        const std::string indexFilename(getAlignmentIndexFilename(alignmentFilename));
+        if (! indexFilename.empty())
+        {
+            keyHash.add(std::to_string(bfs::file_size(indexFilename)));
+            keyHash.add(std::to_string(bfs::last_write_time(indexFilename)));
+        }
+
+        const bam_streamer bamStream(alignmentFilename.c_str(), referenceFilename.c_str());
+        const bam_hdr_t& header(bamStream.get_header());
+        keyHash.add(header.text, header.l_text);
+        for (int32_t tid(0); tid<header.n_targets; ++tid)
+        {
+            keyHash.add(header.target_name[tid]);
+            keyHash.add(std::to_string(header.target_len[tid]));
+        }
+    }
+    catch (const std::exception& e)
+    {
+        log_os << "WARNING: Can't compute run cache key for alignment file '" << alignmentFilename << "': "
+               << e.what() << "\n";
+        return "";
+    }
+
+    return (bfs::path(_cacheDir) / (keyHash.getHexValue() + entrySuffix)).string();
+}
+
+
+
+void
+AlignmentRunCache::
+writeEntry(
+    const std::string& entryFilename,
+    const std::function<bool(const std::string&)>& writeFunc) const
+{
+    static std::atomic<unsigned> tmpIndex(0);
+
+    std::ostringstream tmpOss;
+    tmpOss << entryFilename << ".tmp." << getpid() << "." << tmpIndex++;
+    const std::string tmpFilename(tmpOss.str());
+
+    std::string errorMsg;
+    try
+    {
+        if (writeFunc(tmpFilename))
+        {
+            boost::filesystem::rename(tmpFilename, entryFilename);
+            return;
+        }
+        errorMsg = "error writing temporary file '" + tmpFilename + "'";
+    }
+    catch (const std::exception& e)
+    {
+        errorMsg = e.what();
+    }
+
+    log_os << "WARNING: Can't write run cache entry '" << entryFilename << "': " << errorMsg << "\n";
+    boost::system::error_code ec;
+    boost::filesystem::remove(tmpFilename, ec);
+}
+
+
+
+/// \brief Load cached read group stats and relabel them with the alignment filename of the current run
+///
+/// \return true if the stats were loaded
+static
+bool
+loadCachedReadGroupStats(
+    const std::string& entryFilename,
+    const std::string& alignmentFilename,
+    ReadGroupStatsSet& fileStats)
+{
+    if (! boost::filesystem::exists(entryFilename)) return false;
+
+    ReadGroupStatsSet cachedStats;
+    try
+    {
+        cachedStats.load(entryFilename.c_str());
+    }
+    catch (const std::exception& e)
+    {
+        log_os << "WARNING: Can't read run cache entry '" << entryFilename << "': " << e.what() << "\n";
+        return false;
+    }
+
+    const unsigned groupCount(cachedStats.size());
+    for (unsigned groupIndex(0); groupIndex<groupCount; ++groupIndex)
+    {
+        fileStats.setStats(ReadGroupLabel(alignmentFilename.c_str(), cachedStats.getKey(groupIndex).rgLabel),
+                           cachedStats.getStats(groupIndex));
+    }
+    return true;
+}
+
+
+
+void
+AlignmentRunCache::
+getReadGroupStats(
+    const std::string& referenceFilename,
+    const std::string& alignmentFilename,
+    ReadGroupStatsSet& rstats) const
+{
+    getReadGroupStats(referenceFilename, alignmentFilename, [&](ReadGroupStatsSet& fileStats)
+    {
+        extractReadGroupStatsFromAlignmentFile(referenceFilename, alignmentFilename, fileStats);
+    }, rstats);
+}
+
+
+
+void
+AlignmentRunCache::
+getReadGroupStats(
+    const std::string& referenceFilename,
+    const std::string& alignmentFilename,
+    const std::function<void(ReadGroupStatsSet&)>& statsFunc,
+    ReadGroupStatsSet& rstats) const
+{
+    std::string entryFilename;
+    if (isEnabled())
+    {
+        entryFilename = getEntryFilename(referenceFilename, alignmentFilename, "alignmentStats", "",
+                                         ".alignmentStats.xml");
+    }
+
+    ReadGroupStatsSet fileStats;
+    if (entryFilename.empty() || (! loadCachedReadGroupStats(entryFilename, alignmentFilename, fileStats)))
+    {
+        statsFunc(fileStats);
+        if (! entryFilename.empty())
+        {
+            writeEntry(entryFilename, [&](const std::string& tmpFilename)
+            {
+                fileStats.save(tmpFilename.c_str());
+
+                // the stats archive doesn't report stream errors on completion, so check the written entry:
+                ReadGroupStatsSet writtenStats;
+                writtenStats.load(tmpFilename.c_str());
+                return (writtenStats.size() == fileStats.size());
+            });
+        }
+    }
+    rstats.merge(fileStats);
+}
+
+
+
+double
+AlignmentRunCache::
+getChromDepth(
+    const std::string& referenceFilename,
+    const std::string& alignmentFilename,
+    const std::string& chromName,
+    const std::function<double()>& depthFunc) const
+{
+    std::string entryFilename;
+    if (isEnabled())
+    {
+        entryFilename = getEntryFilename(referenceFilename, alignmentFilename, "chromDepth", chromName,
+                                         ".chromDepth.txt");
+    }
+
+    if (! entryFilename.empty())
+    {
+        std::ifstream ifs(entryFilename);
+        double depth(0);
+        if (ifs >> depth) return depth;
+    }
+
+    const double depth(depthFunc());
+    if (! entryFilename.empty())
+    {
+        writeEntry(entryFilename, [&](const std::string& tmpFilename)
+        {
+            std::ofstream ofs(tmpFilename);
+            ofs << std::setprecision(std::numeric_limits<double>::max_digits10) << depth << "\n";
+            ofs.close();
+            return (! ofs.fail());
+        });
+    }
+    return depth;
+}
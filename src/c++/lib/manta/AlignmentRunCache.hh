@@ -0,0 +1,108 @@
+//
+// Manta - Structural Variant and Indel Caller
+// Copyright (c) 2013-2017 Illumina, Inc.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+//
+
+/// \file
+/// \author Chris Saunders
+///
+
+#pragma once
+
+#include "manta/ReadGroupStatsSet.hh"
+
+#include <functional>
+#include <string>
+
+
+/// \brief Persistent local cache of alignment file statistics shared between runs
+///
+/// Read group statistics and chromosome depth only depend on the content of an alignment file, so these are cached
+/// under a key computed from the alignment file header, the alignment file size, and the size and modification time
+/// of the alignment file index. Any later run on the same alignment file reuses the cached result instead of
+/// rescanning the alignments, independent of the run's other options, regions or version.
+///
+/// Each cache entry is written to a temporary file and renamed into place, so that concurrent processes sharing one
+/// cache directory never read a partial entry. Cache read and write errors are logged and the result is computed
+/// as if the cache was disabled.
+///
+struct AlignmentRunCache
+{
+    /// \param[in] cacheDir cache directory, created if it does not exist. An empty string disables the cache.
+    explicit
+    AlignmentRunCache(const std::string& cacheDir);
+
+    bool
+    isEnabled() const
+    {
+        return (! _cacheDir.empty());
+    }
+
+    /// \brief Add read group statistics of a single alignment file to rstats
+    ///
+    /// The statistics are read from the cache if present, otherwise they are computed from the alignment file
+    /// and written to the cache.
+    void
+    getReadGroupStats(
+        const std::string& referenceFilename,
+        const std::string& alignmentFilename,
+        ReadGroupStatsSet& rstats) const;
+
+    /// \brief Add read group statistics of a single alignment file to rstats
+    ///
+    /// As above, but on a cache miss the statistics are computed by statsFunc, which adds them to the empty set
+    /// passed to it.
+    void
+    getReadGroupStats(
+        const std::string& referenceFilename,
+        const std::string& alignmentFilename,
+        const std::function<void(ReadGroupStatsSet&)>& statsFunc,
+        ReadGroupStatsSet& rstats) const;
+
+    /// \brief Get the average depth of one chromosome in a single alignment file
+    ///
+    /// The depth is read from the cache if present, otherwise it is computed with depthFunc and written to the
+    /// cache.
+    double
+    getChromDepth(
+        const std::string& referenceFilename,
+        const std::string& alignmentFilename,
+        const std::string& chromName,
+        const std::function<double()>& depthFunc) const;
+
+private:
+    /// \return the cache entry filename for one result type of an alignment file, or an empty string if the
+    ///         cache key can't be computed
+    std::string
+    getEntryFilename(
+        const std::string& referenceFilename,
+        const std::string& alignmentFilename,
+        const std::string& entryType,
+        const std::string& entryLabel,
+        const char* entrySuffix) const;
+
+    /// \brief Write a cache entry with writeFunc, which is called with the name of a temporary file
+    ///
+    /// The temporary file is moved into place only if writeFunc returns true without throwing, any error is logged
+    /// and the entry is not written.
+    void
+    writeEntry(
+        const std::string& entryFilename,
+        const std::function<bool(const std::string&)>& writeFunc) const;
+
+    std::string _cacheDir;
+};
@@ -59,30 +59,21 @@ SVCandidateAssembler(
     const ReadScannerOptions& scanOpt,
     const AssemblerOptions& assembleOpt,
     const AlignmentFileOptions& alignFileOpt,
-    const std::string& referenceFilename,
-    const std::string& statsFilename,
+    const SVLocusScanner& readScanner,
+    bam_streamer_pool& bamStreams,
     const std::string& chromDepthFilename,
     const bam_header_info& bamHeader,
     const AllCounts& counts,
-    const bool isRNA,
-    TimeTracker& remoteTime) :
+    EdgeStageTracker& edgeStages) :
     _scanOpt(scanOpt),
     _assembleOpt(assembleOpt),
     _isAlignmentTumor(alignFileOpt.isAlignmentTumor),
     _dFilter(chromDepthFilename, scanOpt.maxDepthFactor, bamHeader),
     _dFilterRemoteReads(chromDepthFilename, scanOpt.maxDepthFactorRemoteReads, bamHeader),
-    _readScanner(_scanOpt, statsFilename, alignFileOpt.alignmentFilename, isRNA),
-    _remoteTime(remoteTime)
+    _readScanner(readScanner),
+    _bamStreams(bamStreams),
+    _edgeStages(edgeStages)
 {
-    // setup regionless bam_streams:
-    // setup all data for main analysis loop:
-    for (const std::string& alignmentFilename : alignFileOpt.alignmentFilename)
-    {
-        // avoid creating shared_ptr temporaries:
-        streamPtr tmp(new bam_streamer(alignmentFilename.c_str(), referenceFilename.c_str()));
-        _bamStreams.push_back(tmp);
-    }
-
     const unsigned bamSize(_bamStreams.size());
     _sampleBackgroundRemoteRate.resize(bamSize);
     for (unsigned bamIndex(0); bamIndex<bamSize; ++bamIndex)
@@ -99,22 +90,10 @@ static
 void
 addReadToDepthEst(
     const bam_record& bamRead,
-    const pos_t beginPos,
-    std::vector<unsigned>& depth)
+    depth_diff_buffer& depth)
 {
-    const pos_t endPos(beginPos+depth.size());
     const pos_t refStart(bamRead.pos()-1);
-
-    const pos_t readSize(bamRead.read_size());
-    for (pos_t readIndex(std::max(0,(beginPos-refStart))); readIndex<readSize; ++readIndex)
-    {
-        const pos_t refPos(refStart+readIndex);
-        if (refPos>=endPos) return;
-        const pos_t depthIndex(refPos-beginPos);
-        assert(depthIndex>=0);
-
-        depth[depthIndex]++;
-    }
+    depth.inc(refStart, refStart+bamRead.read_size());
 }
 
 
@@ -174,7 +153,8 @@ recoverRemoteReads(
     std::vector<RemoteReadInfo>& bamRemotes,
     SVCandidateAssembler::ReadIndexType& readIndex,
     AssemblyReadInput& reads,
-    RemoteReadCache& remoteReadsCache)
+    RemoteReadCache& remoteReadsCache,
+    EdgeStageTracker& edgeStages)
 {
     // figure out what we can handle in a single region query:
     std::sort(bamRemotes.begin(),bamRemotes.end());
@@ -252,6 +232,9 @@ recoverRemoteReads(
             // we've gone past the last case:
             if (bamRead.pos() > (remotes.back().pos+1)) break;
 
+            edgeStages.add(EDGE_WORK::READS_EXAMINED);
+            edgeStages.add(EDGE_WORK::BAM_BYTES, bamRead.data_size());
+
             if (bamRead.isNonStrictSupplement()) continue;
 
             for (RemoteReadInfo& remote : remotes)
@@ -281,6 +264,8 @@ recoverRemoteReads(
                 const bool isInserted = insertAssemblyRead(assembleOpt.minQval, bamIndexStr, bamRead, isReversed, readIndex, reads);
                 if (! isInserted) break;
 
+                edgeStages.add(EDGE_WORK::READS_RETAINED);
+
                 /// add to the remote read cache used during PE scoring:
                 remoteReadsCache[remote.qname] = RemoteReadPayload(bamRead.read_no(), reads.back());
 
@@ -384,7 +369,7 @@ getBreakendReads(
     }
     const pos_t searchBeginPos(searchRange.begin_pos());
     const pos_t searchEndPos(searchRange.end_pos());
-    std::vector<unsigned> normalDepthBuffer(searchRange.size(),0);
+    _normalDepthBuffer.reset(searchBeginPos,searchEndPos);
 
     bool isFirstTumor(false);
 
@@ -406,6 +391,10 @@ getBreakendReads(
     CircularCounter tumorRemoteRate(countWindow);
 #endif
 
+    // The search interval is not read from all samples concurrently in cohort scan mode, because the assembly read
+    // limit is shared by all samples and both breakends. Once the limit is reached the remaining samples are not
+    // scanned, so buffering them would only add memory use.
+
     for (unsigned bamIndex(0); bamIndex < bamCount; ++bamIndex)
     {
         const bool isTumor(_isAlignmentTumor[bamIndex]);
@@ -417,7 +406,8 @@ getBreakendReads(
 
         const std::string bamIndexStr(boost::lexical_cast<std::string>(bamIndex));
 
-        bam_streamer& bamStream(*_bamStreams[bamIndex]);
+        const bam_streamer_pool::stream_ptr bamStreamPtr(_bamStreams.getStream(bamIndex));
+        bam_streamer& bamStream(*bamStreamPtr);
 
         // set bam stream to new search interval:
         bamStream.resetRegion(bp.interval.tid, searchBeginPos, searchEndPos);
@@ -449,6 +439,9 @@ getBreakendReads(
             const pos_t refPos(bamRead.pos()-1);
             if (refPos >= searchEndPos) break;
 
+            _edgeStages.add(EDGE_WORK::READS_EXAMINED);
+            _edgeStages.add(EDGE_WORK::BAM_BYTES, bamRead.data_size());
+
             // Filter reads which won't be used in assembly:
             //
             if (isMaxDepth)
@@ -459,7 +452,7 @@ getBreakendReads(
                     // depth estimates:
                     if (! bamRead.is_unmapped())
                     {
-                        addReadToDepthEst(bamRead, searchBeginPos, normalDepthBuffer);
+                        addReadToDepthEst(bamRead, _normalDepthBuffer);
                     }
                 }
             }
@@ -472,14 +465,17 @@ getBreakendReads(
             if (isMaxDepth)
             {
                 assert(refPos<searchEndPos);
-                const pos_t depthOffset(refPos - searchBeginPos);
-                if ((depthOffset >= 0) && (normalDepthBuffer[depthOffset] > maxDepthRemoteReads))
+                if (refPos >= searchBeginPos)
                 {
-                    isMaxDepthRemoteReadsTriggered=true;
-                }
-                if ((depthOffset >= 0) && (normalDepthBuffer[depthOffset] > maxDepth))
-                {
-                    continue;
+                    const unsigned depth(_normalDepthBuffer.val(refPos));
+                    if (depth > maxDepthRemoteReads)
+                    {
+                        isMaxDepthRemoteReadsTriggered=true;
+                    }
+                    if (depth > maxDepth)
+                    {
+                        continue;
+                    }
                 }
             }
 
@@ -638,7 +634,10 @@ getBreakendReads(
                 }
             }
 
-            insertAssemblyRead(getAssembleOpt().minQval, bamIndexStr, bamRead, isReversed, readIndex, reads);
+            if (insertAssemblyRead(getAssembleOpt().minQval, bamIndexStr, bamRead, isReversed, readIndex, reads))
+            {
+                _edgeStages.add(EDGE_WORK::READS_RETAINED);
+            }
         }
 
 #ifdef DEBUG_ASBL
@@ -731,7 +730,7 @@ getBreakendReads(
 
     if (isRecoverRemotes)
     {
-        const TimeScoper remoteTIme(_remoteTime);
+        const EdgeStageScoper remoteStage(_edgeStages, EDGE_STAGE::REMOTE);
         for (unsigned bamIndex(0); bamIndex < bamCount; ++bamIndex)
         {
 #ifdef DEBUG_REMOTES
@@ -739,13 +738,14 @@ getBreakendReads(
 #endif
             const std::string bamIndexStr(boost::lexical_cast<std::string>(bamIndex));
 
-            bam_streamer& bamStream(*_bamStreams[bamIndex]);
+            const bam_streamer_pool::stream_ptr bamStreamPtr(_bamStreams.getStream(bamIndex));
+            bam_streamer& bamStream(*bamStreamPtr);
 
             std::vector<RemoteReadInfo>& bamRemotes(remoteReads[bamIndex]);
             recoverRemoteReads(
                 getAssembleOpt(),
                 maxNumReads, isLocusReversed, bamIndexStr, bamStream,
-                bamRemotes, readIndex, reads, remoteReadsCache);
+                bamRemotes, readIndex, reads, remoteReadsCache, _edgeStages);
         }
     }
 }
@@ -767,7 +767,8 @@ assembleSingleSVBreakend(
     getBreakendReads(bp, isBpReversed, refSeq, isSearchRemoteInsertionReads, remoteReads, readIndex, reads);
     AssemblyReadOutput readInfo;
 
-    runIterativeAssembler(_assembleOpt, reads, readInfo, as);
+    const unsigned wordLengthCount(runIterativeAssembler(_assembleOpt, reads, readInfo, as));
+    _edgeStages.add(EDGE_WORK::ASSEMBLY_ITERATIONS, wordLengthCount);
 }
 
 
@@ -794,6 +795,7 @@ assembleSVBreakends(
     readRev.resize(reads.size(),isBp2Reversed);
     AssemblyReadOutput readInfo;
 
-    runIterativeAssembler(_assembleOpt, reads, readInfo, as);
+    const unsigned wordLengthCount(runIterativeAssembler(_assembleOpt, reads, readInfo, as));
+    _edgeStages.add(EDGE_WORK::ASSEMBLY_ITERATIONS, wordLengthCount);
 
 }
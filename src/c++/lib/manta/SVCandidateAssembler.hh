@@ -24,10 +24,11 @@
 #pragma once
 
 #include "applications/GenerateSVCandidates/GSCOptions.hh"
+#include "appstats/EdgeStageTracker.hh"
 #include "assembly/IterativeAssembler.hh"
 #include "assembly/SmallAssembler.hh"
-#include "blt_util/time_util.hh"
-#include "htsapi/bam_streamer.hh"
+#include "blt_util/depth_diff_buffer.hh"
+#include "htsapi/bam_streamer_pool.hh"
 #include "manta/ChromDepthFilterUtil.hh"
 #include "manta/SVCandidate.hh"
 #include "manta/SVCandidateAssemblyData.hh"
@@ -47,13 +48,12 @@ struct SVCandidateAssembler
         const ReadScannerOptions& scanOpt,
         const AssemblerOptions& assembleOpt,
         const AlignmentFileOptions& alignFileOpt,
-        const std::string& referenceFilename,
-        const std::string& statsFilename,
+        const SVLocusScanner& readScanner,
+        bam_streamer_pool& bamStreams,
         const std::string& chromDepthFilename,
         const bam_header_info& bamHeader,
         const AllCounts& counts,
-        const bool isRNA,
-        TimeTracker& remoteTIme);
+        EdgeStageTracker& edgeStages);
 
     /**
      * @brief Performs a de-novo assembly of a set of reads crossing a breakpoint.
@@ -90,8 +90,6 @@ struct SVCandidateAssembler
     typedef std::map<std::string,unsigned> ReadIndexType;
 
 private:
-    typedef std::shared_ptr<bam_streamer> streamPtr;
-
     /// Collect reads crossing an SV breakpoint and add them to 'reads'
     ///
     /// \param[in] isReversed if true revcomp all reads on input
@@ -116,9 +114,15 @@ private:
     const ChromDepthFilterUtil _dFilterRemoteReads;
 
     // contains functions to detect/classify anomalous reads
-    SVLocusScanner _readScanner;
-    std::vector<streamPtr> _bamStreams;
-    TimeTracker& _remoteTime;
+    const SVLocusScanner& _readScanner;
+    bam_streamer_pool& _bamStreams;
+
+    /// read and assembly work counts are added to the current edge stage, and remote read recovery is
+    /// tracked as a separate stage:
+    EdgeStageTracker& _edgeStages;
 
     std::vector<double> _sampleBackgroundRemoteRate;
+
+    /// this is only here as syscall cache:
+    mutable depth_diff_buffer _normalDepthBuffer;
 };
@@ -140,6 +140,7 @@ struct SVCandidateAssemblyData
         bp2ref.clear();
         svs.clear();
         isOverlapSkip=false;
+        isEdgeBudgetSkip=false;
     }
 
     typedef AlignmentResult<int> SmallAlignmentResultType;
@@ -177,4 +178,7 @@ struct SVCandidateAssemblyData
 
     /// if true, assembly was skipped for this case because of an overlapping assembly
     bool isOverlapSkip = false;
+
+    /// if true, assembly was skipped for this case because the edge processing budget was exceeded
+    bool isEdgeBudgetSkip = false;
 };
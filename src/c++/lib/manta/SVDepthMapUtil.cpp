@@ -0,0 +1,56 @@
+//
+// Manta - Structural Variant and Indel Caller
+// Copyright (c) 2013-2017 Illumina, Inc.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+//
+
+/// \file
+/// \author Chris Saunders
+///
+
+#include "manta/SVDepthMapUtil.hh"
+#include "common/Exceptions.hh"
+
+#include <sstream>
+
+
+
+std::unique_ptr<const depth_pyramid>
+loadDepthMap(
+    const std::string& depthMapFilename,
+    const bam_header_info& header)
+{
+    using namespace illumina::common;
+
+    std::unique_ptr<const depth_pyramid> depthMapPtr(new depth_pyramid(depthMapFilename));
+    const depth_pyramid& depthMap(*depthMapPtr);
+
+    bool isMatch(depthMap.contig_count() == header.chrom_data.size());
+    for (unsigned contigIndex(0); isMatch && (contigIndex<depthMap.contig_count()); ++contigIndex)
+    {
+        const bam_header_info::chrom_info& cdata(header.chrom_data[contigIndex]);
+        isMatch = ((depthMap.get_contig_name(contigIndex) == cdata.label) &&
+                   (depthMap.get_contig_length(contigIndex) == static_cast<pos_t>(cdata.length)));
+    }
+
+    if (! isMatch)
+    {
+        std::ostringstream oss;
+        oss << "ERROR: Chromosomes in depth map '" << depthMapFilename << "' do not match the bam header.\n";
+        BOOST_THROW_EXCEPTION(LogicException(oss.str()));
+    }
+    return depthMapPtr;
+}
@@ -0,0 +1,248 @@
+//
+// Manta - Structural Variant and Indel Caller
+// Copyright (c) 2013-2017 Illumina, Inc.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+//
+
+/// \file
+/// \author Chris Saunders
+///
+
+#include "manta/SVEvidenceReadIndex.hh"
+
+#include "blt_util/log.hh"
+#include "common/Exceptions.hh"
+
+#include "blt_util/thirdparty_push.h"
+
+#include "boost/archive/binary_iarchive.hpp"
+#include "boost/archive/binary_oarchive.hpp"
+
+#include "blt_util/thirdparty_pop.h"
+
+#include <cassert>
+
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+
+
+std::ostream&
+operator<<(std::ostream& os, const SVEvidenceReadRecord& rec)
+{
+    os << "tid: " << rec.tid << " [" << rec.beginPos << "," << rec.endPos << ")";
+    return os;
+}
+
+
+
+void
+SVEvidenceReadIndex::
+setSampleCount(const unsigned sampleCount)
+{
+    _samples.clear();
+    _samples.resize(sampleCount);
+    _maxSpan.clear();
+    _maxSpan.resize(sampleCount,0);
+    _isFinalized = true;
+}
+
+
+
+unsigned long
+SVEvidenceReadIndex::
+size() const
+{
+    unsigned long totalSize(0);
+    for (const records_t& records : _samples)
+    {
+        totalSize += records.size();
+    }
+    return totalSize;
+}
+
+
+
+void
+SVEvidenceReadIndex::
+add(
+    const unsigned sampleIndex,
+    const int32_t tid,
+    const pos_t beginPos,
+    const pos_t endPos)
+{
+    assert(sampleIndex < _samples.size());
+    assert(beginPos < endPos);
+
+    records_t& records(_samples[sampleIndex]);
+    const SVEvidenceReadRecord rec(tid,beginPos,endPos);
+
+    // records are typically added in sorted order, so only track the sort state:
+    if (_isFinalized && (! records.empty()))
+    {
+        if (rec < records.back()) _isFinalized = false;
+    }
+    records.push_back(rec);
+    _maxSpan[sampleIndex] = std::max(_maxSpan[sampleIndex],(endPos-beginPos));
+}
+
+
+
+void
+SVEvidenceReadIndex::
+merge(const SVEvidenceReadIndex& rhs)
+{
+    using namespace illumina::common;
+
+    if (empty())
+    {
+        setSampleCount(rhs.getSampleCount());
+    }
+    else if (getSampleCount() != rhs.getSampleCount())
+    {
+        std::ostringstream oss;
+        oss << "Can't merge SV evidence read indices with different sample counts: "
+            << getSampleCount() << " " << rhs.getSampleCount();
+        BOOST_THROW_EXCEPTION(LogicException(oss.str()));
+    }
+
+    const unsigned sampleCount(getSampleCount());
+    for (unsigned sampleIndex(0); sampleIndex<sampleCount; ++sampleIndex)
+    {
+        records_t& records(_samples[sampleIndex]);
+        const records_t& rhsRecords(rhs._samples[sampleIndex]);
+        if (rhsRecords.empty()) continue;
+
+        if ((! records.empty()) && (rhsRecords.front() < records.back())) _isFinalized = false;
+        records.insert(records.end(),rhsRecords.begin(),rhsRecords.end());
+        _maxSpan[sampleIndex] = std::max(_maxSpan[sampleIndex],rhs._maxSpan[sampleIndex]);
+    }
+    if (! rhs._isFinalized) _isFinalized = false;
+}
+
+
+
+void
+SVEvidenceReadIndex::
+finalize()
+{
+    if (_isFinalized) return;
+
+    for (records_t& records : _samples)
+    {
+        std::sort(records.begin(),records.end());
+    }
+    _isFinalized = true;
+}
+
+
+
+pos_t
+SVEvidenceReadIndex::
+getLastEvidencePos(
+    const unsigned sampleIndex,
+    const GenomeInterval& interval) const
+{
+    assert(_isFinalized);
+    assert(sampleIndex < _samples.size());
+
+    const records_t& records(_samples[sampleIndex]);
+    const pos_t searchBeginPos(interval.range.begin_pos());
+    const pos_t searchEndPos(interval.range.end_pos());
+    const pos_t minBeginPos(searchBeginPos - _maxSpan[sampleIndex]);
+
+    // walk back from the last record starting before the end of the interval, until no
+    // record can overlap the interval:
+    records_t::const_iterator iter(std::lower_bound(records.begin(),records.end(),
+                                                    SVEvidenceReadRecord(interval.tid,searchEndPos,searchEndPos)));
+    while (iter != records.begin())
+    {
+        --iter;
+        if ((iter->tid != interval.tid) || (iter->beginPos < minBeginPos)) break;
+        if (iter->endPos > searchBeginPos) return iter->beginPos;
+    }
+    return -1;
+}
+
+
+
+void
+SVEvidenceReadIndex::
+save(const char* filename) const
+{
+    using namespace boost::archive;
+
+    assert(nullptr != filename);
+    assert(_isFinalized);
+
+    std::ofstream ofs(filename, std::ios::binary);
+    binary_oarchive oa(ofs);
+
+    const unsigned sampleCount(getSampleCount());
+    oa << sampleCount;
+    for (unsigned sampleIndex(0); sampleIndex<sampleCount; ++sampleIndex)
+    {
+        const records_t& records(_samples[sampleIndex]);
+        const unsigned long recordCount(records.size());
+        oa << _maxSpan[sampleIndex];
+        oa << recordCount;
+        for (const SVEvidenceReadRecord& rec : records)
+        {
+            oa << rec;
+        }
+    }
+}
+
+
+
+void
+SVEvidenceReadIndex::
+load(const char* filename)
+{
+    using namespace boost::archive;
+
+    assert(nullptr != filename);
+
+    try
+    {
+        std::ifstream ifs(filename, std::ios::binary);
+        binary_iarchive ia(ifs);
+
+        unsigned sampleCount(0);
+        ia >> sampleCount;
+        setSampleCount(sampleCount);
+        for (unsigned sampleIndex(0); sampleIndex<sampleCount; ++sampleIndex)
+        {
+            records_t& records(_samples[sampleIndex]);
+            unsigned long recordCount(0);
+            ia >> _maxSpan[sampleIndex];
+            ia >> recordCount;
+            records.resize(recordCount);
+            for (SVEvidenceReadRecord& rec : records)
+            {
+                ia >> rec;
+            }
+        }
+    }
+    catch (...)
+    {
+        log_os << "ERROR: Exception caught while attempting to deserialize Manta SV evidence read index file:\n"
+               << "'" << filename << "'" << "\n";
+        throw;
+    }
+}
@@ -0,0 +1,151 @@
+//
+// Manta - Structural Variant and Indel Caller
+// Copyright (c) 2013-2017 Illumina, Inc.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+//
+
+/// \file
+/// \author Chris Saunders
+///
+
+#pragma once
+
+#include "blt_util/blt_types.hh"
+#include "svgraph/GenomeInterval.hh"
+
+#include <cstdint>
+
+#include <iosfwd>
+#include <vector>
+
+
+/// \brief Reference span of a single SV evidence read
+///
+struct SVEvidenceReadRecord
+{
+    SVEvidenceReadRecord(
+        const int32_t initTid = 0,
+        const pos_t initBeginPos = 0,
+        const pos_t initEndPos = 0) :
+        tid(initTid),
+        beginPos(initBeginPos),
+        endPos(initEndPos)
+    {}
+
+    bool
+    operator<(const SVEvidenceReadRecord& rhs) const
+    {
+        if (tid != rhs.tid) return (tid < rhs.tid);
+        if (beginPos != rhs.beginPos) return (beginPos < rhs.beginPos);
+        return (endPos < rhs.endPos);
+    }
+
+    bool
+    operator==(const SVEvidenceReadRecord& rhs) const
+    {
+        return ((tid == rhs.tid) && (beginPos == rhs.beginPos) && (endPos == rhs.endPos));
+    }
+
+    template<class Archive>
+    void serialize(Archive& ar, const unsigned /* version */)
+    {
+        ar& tid& beginPos& endPos;
+    }
+
+    int32_t tid;
+    pos_t beginPos;
+    pos_t endPos;
+};
+
+std::ostream&
+operator<<(std::ostream& os, const SVEvidenceReadRecord& rec);
+
+
+/// \brief Per-sample index of the positions of all reads classified as SV evidence
+///
+/// The index is built during SV locus graph construction, where every read is already
+/// screened with SVLocusScanner::isSVEvidence, so that candidate generation can skip BAM
+/// intervals which are known to contain no evidence reads.
+///
+/// Records can be added in any order, but the index must be finalized before it is
+/// queried or saved.
+///
+struct SVEvidenceReadIndex
+{
+    bool
+    empty() const
+    {
+        return _samples.empty();
+    }
+
+    unsigned
+    getSampleCount() const
+    {
+        return _samples.size();
+    }
+
+    void
+    setSampleCount(const unsigned sampleCount);
+
+    /// \brief Total number of evidence records over all samples
+    unsigned long
+    size() const;
+
+    /// \brief Add an evidence read for sample sampleIndex spanning [beginPos,endPos) on chromosome tid
+    void
+    add(
+        const unsigned sampleIndex,
+        const int32_t tid,
+        const pos_t beginPos,
+        const pos_t endPos);
+
+    /// \brief Merge the contents of another index into this one
+    ///
+    /// If this index is empty, it takes the sample count of rhs, otherwise the sample
+    /// counts must match.
+    void
+    merge(const SVEvidenceReadIndex& rhs);
+
+    /// \brief Sort all records and compute the search metadata required for queries
+    void
+    finalize();
+
+    /// \brief Find the start position of the last evidence read in a sample which overlaps interval
+    ///
+    /// \return The largest begin position of all evidence reads overlapping interval, or -1
+    ///         if no evidence read overlaps interval
+    pos_t
+    getLastEvidencePos(
+        const unsigned sampleIndex,
+        const GenomeInterval& interval) const;
+
+    void
+    save(const char* filename) const;
+
+    void
+    load(const char* filename);
+
+private:
+    typedef std::vector<SVEvidenceReadRecord> records_t;
+
+    /// evidence records for each sample
+    std::vector<records_t> _samples;
+
+    /// longest record span for each sample, used to bound the overlap search
+    std::vector<pos_t> _maxSpan;
+
+    bool _isFinalized = true;
+};
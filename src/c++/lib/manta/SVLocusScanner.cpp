@@ -24,17 +24,17 @@
 ///
 
 #include "blt_util/align_path_util.hh"
-#include "blt_util/parse_util.hh"
-#include "blt_util/string_util.hh"
 #include "common/Exceptions.hh"
 #include "htsapi/align_path_bam_util.hh"
 #include "htsapi/bam_record_util.hh"
+#include "htsapi/bam_streamer.hh"
 #include "htsapi/SimpleAlignment_bam_util.hh"
 #include "manta/RemoteMateReadUtil.hh"
 #include "manta/SVCandidateUtil.hh"
 #include "manta/SVLocusScanner.hh"
 #include "manta/SVLocusScannerSemiAligned.hh"
 
+#include <fstream>
 #include <iostream>
 
 //#define DEBUG_SCANNER
@@ -154,38 +154,35 @@ getSplitSVCandidate(
 
 
 
-/// determine, based on clipping in the cigar string, if this split alignment
-/// has its breakpoint on the downstream (right) end or the upstream (left) end
+/// \return The offset of the first aligned base of this split alignment segment, in read (ie. sequencing) order
 static
-bool
-isSplitOpenDownstream(
-    const ALIGNPATH::path_t& align)
+unsigned
+getTemplateReadOffset(
+    const SimpleAlignment& align)
 {
     using namespace ALIGNPATH;
-    ///TODO replace this heuristic with a better check (looking at all SA alignments at once)
-    return (apath_clip_lead_size(align) < apath_clip_trail_size(align));
+    return (align.is_fwd_strand ? apath_clip_lead_size(align.path) : apath_clip_trail_size(align.path));
 }
 
 
 
+/// \param[in] isSplitDownstream if true, the split is downstream (ie. on the right side) of this alignment
+///                              segment in reference coordinates
 static
 void
 updateSABreakend(
     const ReadScannerDerivOptions& dopt,
     const SimpleAlignment& align,
+    const bool isSplitDownstream,
     SVBreakend& breakend,
     const bam_header_info& bamHeader)
 {
-    // Need to use the match descriptors to determine if the split is upstream (i.e. 5' assuming fwd strand)
-    // of the current alignment (i.e. we are clipped on the left side) or downstream
-    // Below is the logic to convert these  to breakend candidates (everything is relative to the forward strand):
+    // Convert the split direction to a breakend candidate (everything is relative to the forward strand):
     //
     // DownStream => RIGHT_OPEN
     // Upstream => LEFT_OPEN
     //
 
-    const bool isSplitDownstream(isSplitOpenDownstream(align.path));
-
     if (isSplitDownstream)
     {
         breakend.state = SVBreakendState::RIGHT_OPEN;
@@ -214,6 +211,7 @@ updateSABreakend(
 
 /// \brief Convert details from one of \p localRead's SA-tag split-read alignments into an SVObservation.
 ///
+/// \param[in] isRemoteAfterLocal if true, the remote alignment segment follows the local segment in read order
 /// \param[in] dnaFragmentSVEvidenceSource The source of SV evidence within the read fragment (read1, read2, etc..)
 static
 SVObservation
@@ -222,6 +220,7 @@ getSplitSACandidate(
     const bam_record& localRead,
     const SimpleAlignment& localAlign,
     const SimpleAlignment& remoteAlign,
+    const bool isRemoteAfterLocal,
     const SourceOfSVEvidenceInDNAFragment::index_t dnaFragmentSVEvidenceSource,
     const bam_header_info& bamHeader)
 {
@@ -239,12 +238,16 @@ getSplitSACandidate(
     // reverse edge. this protects against double-count:
     localBreakend.lowresEvidence.add(svSource);
 
-    updateSABreakend(dopt, localAlign, localBreakend, bamHeader);
-    updateSABreakend(dopt, remoteAlign, remoteBreakend, bamHeader);
+    // The split is at the end of the local segment in read order if the remote segment follows it, and this
+    // is the downstream (right) end of the local segment when it is aligned to the forward strand. The remote
+    // segment is split from the opposite end in read order:
+    const bool isSplitDownstream(isRemoteAfterLocal == localAlign.is_fwd_strand);
+    const bool isRemoteSplitDownstream(isRemoteAfterLocal != remoteAlign.is_fwd_strand);
+    updateSABreakend(dopt, localAlign, isSplitDownstream, localBreakend, bamHeader);
+    updateSABreakend(dopt, remoteAlign, isRemoteSplitDownstream, remoteBreakend, bamHeader);
 
     // If the local (bp1) alignment is split downstream (on the right side) then this read goes from bp1 -> bp2.
     // If it is a forward read (e.g. read1 on + strand), this means it's a forward read for this event.
-    const bool isSplitDownstream(isSplitOpenDownstream(localAlign.path));
     const bool isReadFw = (localRead.is_first() == localRead.is_fwd_strand());
     if (dopt.isTranscriptStrandKnown)
     {
@@ -262,115 +265,20 @@ getSplitSACandidate(
 
 
 
-typedef std::map<std::string, int32_t> chromMap_t;
-
-
-
-/// \brief Enumerate the fields for each split alignment segment as described in the BAM spec "SA" tag entry
-namespace SAFields
-{
-enum index_t
-{
-    CHROM,
-    POS,
-    STRAND,
-    CIGAR,
-    MAPQ,
-    NM,
-    SIZE
-};
-}
-
-
-static
-void
-parseSACandidatesFromRead(
-    const ReadScannerOptions& opt,
-    const bam_record& bamRead,
-    const chromMap_t& chromToIndex,
-    std::vector<SimpleAlignment>& splitAlignments)
-{
-    using namespace illumina::common;
-    using namespace ALIGNPATH;
-
-    splitAlignments.clear();
-
-    std::vector<std::string> splitAlignmentSegmentStrings;
-    {
-        static const char splitAlignmentTag[] = {'S','A'};
-        const char* splitAlignmentString(bamRead.get_string_tag(splitAlignmentTag));
-        if (nullptr == splitAlignmentString) return;
-
-        split_string(splitAlignmentString, ';', splitAlignmentSegmentStrings);
-        if ( (! splitAlignmentSegmentStrings.empty()) && splitAlignmentSegmentStrings.back().empty())
-        {
-            splitAlignmentSegmentStrings.pop_back();
-        }
-    }
-
-    // Only handle a single split alignment segment right now (meaning the read is split into 2 parts).
-    // In the future we could sort the SA tags by order on the template, possibly
-    // also removing segments that map to two different areas.
-    if (splitAlignmentSegmentStrings.size() > 1) return;
-
-    for (const std::string& splitAlignmentSegmentString : splitAlignmentSegmentStrings)
-    {
-#ifdef DEBUG_SCANNER
-        log_os << __FUNCTION__ << ": splitAlignmentSegmentString: " << splitAlignmentSegmentString << "\n";
-#endif
-        std::vector<std::string> splitAlignmentSegmentFields;
-        split_string(splitAlignmentSegmentString, ',', splitAlignmentSegmentFields);
-
-        if (splitAlignmentSegmentFields.size() != SAFields::SIZE)
-        {
-            std::ostringstream oss;
-            oss << "ERROR: Unexpected format in the split alignment segment: '" << splitAlignmentSegmentString << "'\n";
-            BOOST_THROW_EXCEPTION(LogicException(oss.str()));
-        }
-
-        /// filter split reads with low MappingQuality:
-        const unsigned splitAlignmentMappingQuality(
-            illumina::blt_util::parse_unsigned_str(splitAlignmentSegmentFields[SAFields::MAPQ]));
-        if (splitAlignmentMappingQuality < opt.minMapq) continue;
-
-        const std::string& splitAlignmentChrom(splitAlignmentSegmentFields[SAFields::CHROM]);
-        const chromMap_t::const_iterator ci(chromToIndex.find(splitAlignmentChrom));
-
-        if (ci == chromToIndex.end())
-        {
-            std::ostringstream oss;
-            oss << "ERROR: Split alignment segment maps to an unknown chromosome: '" << splitAlignmentChrom << "'\n";
-            BOOST_THROW_EXCEPTION(LogicException(oss.str()));
-        }
-
-        splitAlignments.emplace_back();
-        SimpleAlignment& sal(splitAlignments.back());
-        sal.tid=(ci->second); // convert chr to int32_t via new bam header map
-        sal.pos = (illumina::blt_util::parse_int_str(splitAlignmentSegmentFields[SAFields::POS])-1);
-        {
-            const char splitAlignmentStrand(splitAlignmentSegmentFields[SAFields::STRAND][0]); // convert to char
-            if (! ((splitAlignmentStrand=='-') || (splitAlignmentStrand=='+')))
-            {
-                std::ostringstream oss;
-                oss << "ERROR: Unexpected strand entry in split alignment segment: '" << splitAlignmentSegmentString << "'\n";
-                BOOST_THROW_EXCEPTION(LogicException(oss.str()));
-            }
-            sal.is_fwd_strand = (splitAlignmentStrand == '+');
-        }
-
-        cigar_to_apath(splitAlignmentSegmentFields[SAFields::CIGAR].c_str(), sal.path);
-    }
-}
-
-
 /// \brief Find all 'SA' formatted split read sub-alignments in a single read alignment record, and convert these
 ///        into SVObservation objects.
 ///
-/// Convert each BAM "SA" sub-alignment record in a read into an SVObservation object. The method currently only
-/// returns an SVObservation object if the read contains exactly one "SA" sub-alignment record, but the interface
-/// supports parsing out any number of split alignments, and this function may be updated to do so in the future.
+/// The local alignment and all "SA" sub-alignments are ordered along the read, and an SVObservation is created
+/// for each sub-alignment adjacent to the local alignment in this order, so that a read split into N segments
+/// yields an observation for each of its N-1 junctions over the split read records of the template. Each of these
+/// observations only adds evidence to the local breakend, the remote side of each junction is counted when the
+/// corresponding split read record is scanned.
+///
+/// Sub-alignments adjacent to the local alignment are skipped if they have low mapping quality, or if their read
+/// order relative to the local alignment can't be determined.
 ///
 /// \param[in] dnaFragmentSVEvidenceSource The source of SV evidence within the read fragment (read1, read2, etc..)
+/// \param[in,out] saParser Parser for the read's SA tag, storage is reused between reads
 /// \param[in,out] candidates New SVObservation objects are appended to this vector. Contents of the vector are preserved
 ///                        but not read.
 static
@@ -382,27 +290,78 @@ getSACandidatesFromRead(
     const SimpleAlignment& localAlign,
     const SourceOfSVEvidenceInDNAFragment::index_t dnaFragmentSVEvidenceSource,
     const bam_header_info& bamHeader,
+    split_alignment_tag_parser& saParser,
     std::vector<SVObservation>& candidates)
 {
-    using namespace ALIGNPATH;
-
-    std::vector<SimpleAlignment> remoteAlign;
-    parseSACandidatesFromRead(opt, localRead, bamHeader.chrom_to_index, remoteAlign);
+    static const char splitAlignmentTag[] = {'S','A'};
+    const char* splitAlignmentString(localRead.get_string_tag(splitAlignmentTag));
+    if (nullptr == splitAlignmentString) return;
 
-    if (remoteAlign.empty()) return;
+    saParser.parse(splitAlignmentString, bamHeader.chrom_to_index);
 
-    // Only handle a single split alignment right now. In the future we should sort the SA tags by order on the
-    // template, possibly also removing segments that map to two different areas.
-    if (remoteAlign.size() > 1) return;
+    // find the segments immediately before and after the local alignment in read order:
+    static const int noSegment(-1);
+    int prevSegmentIndex(noSegment);
+    int nextSegmentIndex(noSegment);
+    {
+        const unsigned localOffset(getTemplateReadOffset(localAlign));
+        unsigned prevOffset(0);
+        unsigned nextOffset(0);
+        bool isAmbiguousPrev(false);
+        bool isAmbiguousNext(false);
+        const unsigned segmentCount(saParser.size());
+        for (unsigned segmentIndex(0); segmentIndex<segmentCount; ++segmentIndex)
+        {
+            const unsigned offset(getTemplateReadOffset(saParser[segmentIndex].align));
+            if (offset < localOffset)
+            {
+                if ((prevSegmentIndex == noSegment) || (offset > prevOffset))
+                {
+                    prevSegmentIndex = segmentIndex;
+                    prevOffset = offset;
+                    isAmbiguousPrev = false;
+                }
+                else if (offset == prevOffset)
+                {
+                    isAmbiguousPrev = true;
+                }
+            }
+            else if (offset > localOffset)
+            {
+                if ((nextSegmentIndex == noSegment) || (offset < nextOffset))
+                {
+                    nextSegmentIndex = segmentIndex;
+                    nextOffset = offset;
+                    isAmbiguousNext = false;
+                }
+                else if (offset == nextOffset)
+                {
+                    isAmbiguousNext = true;
+                }
+            }
+        }
+        if (isAmbiguousPrev) prevSegmentIndex = noSegment;
+        if (isAmbiguousNext) nextSegmentIndex = noSegment;
+    }
 
-    for (const auto& ral : remoteAlign)
+    auto addCandidate = [&](const int segmentIndex, const bool isRemoteAfterLocal)
     {
+        if (segmentIndex == noSegment) return;
+        const split_alignment_segment& segment(saParser[segmentIndex]);
+
+        /// filter split reads with low MappingQuality:
+        if (segment.mapq < opt.minMapq) return;
+
         candidates.push_back(
-            getSplitSACandidate(dopt, localRead, localAlign, ral, dnaFragmentSVEvidenceSource, bamHeader));
+            getSplitSACandidate(dopt, localRead, localAlign, segment.align, isRemoteAfterLocal,
+                                dnaFragmentSVEvidenceSource, bamHeader));
 #ifdef DEBUG_SCANNER
         log_os << __FUNCTION__ << ": evaluating SA sv for inclusion: " << candidates.back() << "\n";
 #endif
-    }
+    };
+
+    addCandidate(prevSegmentIndex, false);
+    addCandidate(nextSegmentIndex, true);
 }
 
 
@@ -1088,6 +1047,7 @@ getSingleReadSVCandidates(
     const SimpleAlignment& localAlign,
     const bam_header_info& bamHeader,
     const reference_contig_segment& refSeq,
+    split_alignment_tag_parser& saParser,
     std::vector<SVObservation>& candidates)
 {
     using namespace illumina::common;
@@ -1107,7 +1067,7 @@ getSingleReadSVCandidates(
     // be very rare.
     if (localRead.isSASplit())
     {
-        getSACandidatesFromRead(opt, dopt, localRead, localAlign, fragSource, bamHeader, candidates);
+        getSACandidatesFromRead(opt, dopt, localRead, localAlign, fragSource, bamHeader, saParser, candidates);
 #ifdef DEBUG_SCANNER
         log_os << __FUNCTION__ << ": post-split read candidate_size: " << candidates.size() << "\n";
 #endif
@@ -1142,6 +1102,7 @@ getReadBreakendsImpl(
     const bam_header_info& bamHeader,
     const reference_contig_segment& localRefSeq,
     const reference_contig_segment* remoteRefSeqPtr,
+    split_alignment_tag_parser& saParser,
     std::vector<SVObservation>& candidates,
     known_pos_range2& localEvidenceRange)
 {
@@ -1151,7 +1112,7 @@ getReadBreakendsImpl(
     log_os << __FUNCTION__ << ": Starting read: " << localRead.qname() << "\n";
 #endif
 
-    const chromMap_t& chromToIndex(bamHeader.chrom_to_index);
+    const auto& chromToIndex(bamHeader.chrom_to_index);
 
     candidates.clear();
 
@@ -1161,7 +1122,7 @@ getReadBreakendsImpl(
     try
     {
         getSingleReadSVCandidates(opt, dopt, localRead, localAlign, bamHeader,
-                                  localRefSeq, candidates);
+                                  localRefSeq, saParser, candidates);
 
         // run the same check on the read's mate if we have access to it
         if (nullptr != remoteReadPtr)
@@ -1176,7 +1137,7 @@ getReadBreakendsImpl(
             }
             getSingleReadSVCandidates(opt, dopt, remoteRead, remoteAlign,
                                       bamHeader, (*remoteRefSeqPtr),
-                                      candidates);
+                                      saParser, candidates);
         }
 
         // process shadows:
@@ -1293,6 +1254,8 @@ getReadBreakendsImpl(
 /// multiple suggested loci from one read is more of a theoretical possibility than an
 /// expectation.
 ///
+/// \param[in] spliceJunctionsPtr If not nullptr, candidates fully explained by these annotated splice junctions are
+///                               not added to the graph
 static
 void
 getSVLociImpl(
@@ -1302,6 +1265,8 @@ getSVLociImpl(
     const bam_record& bamRead,
     const bam_header_info& bamHeader,
     const reference_contig_segment& refSeq,
+    split_alignment_tag_parser& saParser,
+    const SpliceJunctionIndex* spliceJunctionsPtr,
     std::vector<SVLocus>& loci,
     SampleEvidenceCounts& eCounts)
 {
@@ -1312,7 +1277,7 @@ getSVLociImpl(
     known_pos_range2 localEvidenceRange;
 
     getReadBreakendsImpl(opt, dopt, rstats, bamRead, nullptr, bamHeader,
-                         refSeq, nullptr, candidates, localEvidenceRange);
+                         refSeq, nullptr, saParser, candidates, localEvidenceRange);
 
 #ifdef DEBUG_SCANNER
     log_os << __FUNCTION__ << ": candidate_size: " << candidates.size() << "\n";
@@ -1344,6 +1309,14 @@ getSVLociImpl(
             eCounts.eType[i] += localBreakend.lowresEvidence.getVal(i);
         }
 
+        if ((nullptr != spliceJunctionsPtr) && spliceJunctionsPtr->isKnownSplice(cand))
+        {
+#ifdef DEBUG_SCANNER
+            log_os << __FUNCTION__ << ": skipping candidate explained by annotated splice junction\n";
+#endif
+            continue;
+        }
+
         // determine the evidence weight of this candidate:
         unsigned localEvidenceWeight(0);
         unsigned remoteEvidenceWeight(0);
@@ -1430,7 +1403,7 @@ SVLocusScanner::
 SVLocusScanner(
     const ReadScannerOptions& opt,
     const std::string& statsFilename,
-    const std::vector<std::string>& /*alignmentFilename*/,
+    const std::vector<std::string>& alignmentFilename,
     const bool isRNA,
     const bool isTranscriptStrandKnown) :
     _opt(opt),
@@ -1438,10 +1411,34 @@ SVLocusScanner(
 {
     using namespace illumina::common;
 
+    if (isRNA && (! _opt.spliceJunctionAnnotationFilename.empty()))
+    {
+        // annotation chromosome names are translated using the header of the first alignment file, all
+        // alignment file headers are assumed to be compatible:
+        assert(! alignmentFilename.empty());
+        const bam_streamer bamStream(alignmentFilename.front().c_str(), nullptr);
+        const bam_header_info bamHeader(bamStream.get_header());
+
+        std::ifstream annotationStream(_opt.spliceJunctionAnnotationFilename);
+        if (! annotationStream)
+        {
+            std::ostringstream oss;
+            oss << "Can't open splice junction annotation file: '" << _opt.spliceJunctionAnnotationFilename << "'";
+            BOOST_THROW_EXCEPTION(LogicException(oss.str()));
+        }
+
+        std::shared_ptr<SpliceJunctionIndex> spliceJunctions(new SpliceJunctionIndex);
+        spliceJunctions->loadAnnotation(annotationStream, bamHeader);
+        _spliceJunctions = spliceJunctions;
+    }
+
     // pull in insert stats:
     _rss.load(statsFilename.c_str());
 
     // precompute frequently used insert stats for each read group:
+    //
+    // the quantile queries below also complete the lazily computed statistics of each fragment size
+    // distribution, so that the scanner is not modified after construction
     const unsigned readGroupCount(_rss.size());
     for (unsigned readGroupIndex(0); readGroupIndex<readGroupCount; readGroupIndex++)
     {
@@ -1604,6 +1601,28 @@ isLocalAssemblyEvidence(
 
 
 
+namespace
+{
+
+/// \brief Scratch storage used by the read scanner, kept per-thread so that a single read scanner can
+/// be shared between threads
+struct ReadScannerWorkspace
+{
+    SimpleAlignment bamAlign;
+    split_alignment_tag_parser saParser;
+};
+
+ReadScannerWorkspace&
+getReadScannerWorkspace()
+{
+    static thread_local ReadScannerWorkspace workspace;
+    return workspace;
+}
+
+}
+
+
+
 bool
 SVLocusScanner::
 isSVEvidence(
@@ -1615,9 +1634,10 @@ isSVEvidence(
     // exclude innie read pairs which are anomalously short:
     const bool isAnom(isNonCompressedAnomalousReadPair(bamRead, defaultReadGroupIndex));
     const bool isSplit(bamRead.isSASplit());
-    getAlignment(bamRead,_bamAlign);
-    const bool isIndel(isLocalIndelEvidence(_bamAlign));
-    const bool isAssm((_dopt.isSmallCandidates) && ((!isSplit) && isSemiAlignedEvidence(bamRead, _bamAlign, refSeq)));
+    SimpleAlignment& bamAlign(getReadScannerWorkspace().bamAlign);
+    getAlignment(bamRead,bamAlign);
+    const bool isIndel(isLocalIndelEvidence(bamAlign));
+    const bool isAssm((_dopt.isSmallCandidates) && ((!isSplit) && isSemiAlignedEvidence(bamRead, bamAlign, refSeq)));
 
     const bool isEvidence(isAnom || isSplit || isIndel || isAssm);
 
@@ -1647,6 +1667,103 @@ isSVEvidence(
 
 
 
+namespace
+{
+
+/// \brief Cigar string features used by the SV evidence pre-filter, found in a single pass over the raw cigar
+struct CigarSignature
+{
+    /// Length of the largest insertion or deletion segment
+    unsigned maxIndelLength = 0;
+
+    /// Total read length implied by the alignment
+    unsigned readLength = 0;
+
+    /// True if the alignment is a single match segment, with optional soft-clipping on either edge
+    bool isSimpleMatch = false;
+
+    /// Length of the soft-clipped segment on the leading edge of the alignment
+    unsigned leadingSoftClipLength = 0;
+};
+
+}
+
+
+
+static
+void
+getCigarSignature(
+    const bam_record& bamRead,
+    CigarSignature& signature)
+{
+    using namespace ALIGNPATH;
+
+    signature = CigarSignature();
+
+    // track the alignment pattern [soft-clip] match+ [soft-clip]:
+    enum { LEADING_EDGE, MATCH, TRAILING_EDGE, COMPLEX } state(LEADING_EDGE);
+
+    const uint32_t* cigar(bamRead.raw_cigar());
+    const unsigned cigarSize(bamRead.n_cigar());
+    for (unsigned cigarIndex(0); cigarIndex<cigarSize; ++cigarIndex)
+    {
+        const unsigned length(cigar[cigarIndex]>>BAM_CIGAR_SHIFT);
+        const align_t type(static_cast<align_t>(1+(cigar[cigarIndex]&BAM_CIGAR_MASK)));
+        if (is_segment_type_indel(type)) signature.maxIndelLength = std::max(signature.maxIndelLength, length);
+        if (is_segment_type_read_length(type)) signature.readLength += length;
+
+        if (is_segment_align_match(type))
+        {
+            if (state == LEADING_EDGE) state = MATCH;
+            else if (state != MATCH) state = COMPLEX;
+        }
+        else if (type == SOFT_CLIP)
+        {
+            if (state == LEADING_EDGE) signature.leadingSoftClipLength += length;
+            else if (state == MATCH) state = TRAILING_EDGE;
+            else state = COMPLEX;
+        }
+        else
+        {
+            state = COMPLEX;
+        }
+    }
+
+    signature.isSimpleMatch = ((state == MATCH) || (state == TRAILING_EDGE));
+}
+
+
+
+bool
+SVLocusScanner::
+isPreFilteredNonEvidence(
+    const bam_record& bamRead,
+    const unsigned defaultReadGroupIndex,
+    const reference_contig_segment& refSeq) const
+{
+    // The tests below mirror each evidence type in isSVEvidence, in order of increasing cost:
+    if (isNonCompressedAnomalousReadPair(bamRead, defaultReadGroupIndex)) return false;
+
+    CigarSignature signature;
+    getCigarSignature(bamRead, signature);
+    if (signature.maxIndelLength >= _opt.minCandidateVariantSize) return false;
+
+    if (bamRead.isSASplit()) return false;
+
+    if (! _dopt.isSmallCandidates) return true;
+
+    // Semi-aligned evidence is never reported for possible adapter read-through pairs:
+    if (is_possible_adapter_pair(bamRead)) return true;
+
+    if (! signature.isSimpleMatch) return false;
+    if (signature.readLength != static_cast<unsigned>(bamRead.read_size())) return false;
+
+    const pos_t matchBeginPos((bamRead.pos()-1) - static_cast<pos_t>(signature.leadingSoftClipLength));
+    return isSimpleMatchReadWellAligned(bamRead, matchBeginPos, refSeq, _opt.minSemiAlignedMismatchLen);
+}
+
+
+
 void
 SVLocusScanner::
 getSVLoci(
@@ -1660,8 +1777,8 @@ getSVLoci(
     loci.clear();
 
     const CachedReadGroupStats& rstats(_stats[defaultReadGroupIndex]);
-    getSVLociImpl(_opt, _dopt, rstats, bamRead, bamHeader, refSeq, loci,
-                  eCounts);
+    getSVLociImpl(_opt, _dopt, rstats, bamRead, bamHeader, refSeq, getReadScannerWorkspace().saParser,
+                  _spliceJunctions.get(), loci, eCounts);
 }
 
 
@@ -1683,5 +1800,5 @@ getBreakendPair(
     known_pos_range2 evidenceRange;
     getReadBreakendsImpl(_opt, _dopt, rstats, localRead, remoteReadPtr,
                          bamHeader, localRefSeq, remoteRefSeqPtr,
-                         candidates, evidenceRange);
+                         getReadScannerWorkspace().saParser, candidates, evidenceRange);
 }
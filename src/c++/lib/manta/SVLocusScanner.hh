@@ -30,14 +30,17 @@
 #include "htsapi/bam_record_util.hh"
 #include "htsapi/bam_header_info.hh"
 #include "htsapi/align_path_bam_util.hh"
+#include "htsapi/split_alignment_tag_parser.hh"
 #include "manta/ReadGroupStatsSet.hh"
 #include "manta/SVCandidate.hh"
 #include "manta/SVLocusEvidenceCount.hh"
+#include "manta/SpliceJunctionIndex.hh"
 #include "svgraph/SVLocus.hh"
 #include "svgraph/SVLocusSampleCounts.hh"
 #include "options/ReadScannerOptions.hh"
 #include "common/Exceptions.hh"
 
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -113,6 +116,10 @@ struct ReadScannerDerivOptions
 /// are using the same logic to process read pairs into SV evidence. This class is
 /// responsible for the shared logic
 ///
+/// The scanner is immutable after construction, and all scratch storage used by its methods is kept
+/// per-thread, so that a single scanner, with its loaded alignment statistics, can be shared by all
+/// worker threads of a process.
+///
 struct SVLocusScanner
 {
     SVLocusScanner(
@@ -263,6 +270,22 @@ struct SVLocusScanner
         const reference_contig_segment& refSeq,
         SVLocusEvidenceCount* incountsPtr = nullptr) const;
 
+    /// \brief A pre-filter for isSVEvidence which cheaply rejects the majority of reads without SV evidence
+    ///
+    /// Reads are tested using the fixed-size BAM record core fields, a single pass over the raw cigar string and
+    /// the SA tag. In small candidate discovery mode, reads aligned as a single match segment with optional edge
+    /// soft-clipping are also tested for semi-aligned evidence by scanning only the start of each read edge.
+    ///
+    /// A read rejected by this method would also be rejected by isSVEvidence. A read which is not rejected must still
+    /// be tested with isSVEvidence.
+    ///
+    /// \return True if \p bamRead is certain not to provide evidence for an SV or indel
+    bool
+    isPreFilteredNonEvidence(
+        const bam_record& bamRead,
+        const unsigned defaultReadGroupIndex,
+        const reference_contig_segment& refSeq) const;
+
     /// return zero to many SVLocus objects if the read supports any
     /// structural variant(s) (detectable by manta)
     ///
@@ -379,6 +402,14 @@ struct SVLocusScanner
         return _dopt.isUseOverlappingPairs;
     }
 
+    /// \return True if a splice junction annotation was provided in RNA mode, and \p sv is fully explained by
+    ///         splicing between annotated exons
+    bool
+    isKnownSplice(const SVCandidate& sv) const
+    {
+        return (_spliceJunctions && _spliceJunctions->isKnownSplice(sv));
+    }
+
 private:
 
     /// \brief Classify read pair fragment sizes into a pre-defined size category.
@@ -411,7 +442,7 @@ private:
     /// extreme 5th-95th percentiles over all read groups:
     Range _fifthPerc;
 
-    // cached temporary to reduce syscalls:
-    mutable SimpleAlignment _bamAlign;
+    /// annotated splice junctions, only set in RNA mode when an annotation is provided
+    std::shared_ptr<const SpliceJunctionIndex> _spliceJunctions;
 };
 
@@ -39,6 +39,11 @@
 
 
 
+/// Length of the contiguous block of basecall matches which ends a poorly aligned read edge
+static const unsigned edgeContiguousMatchCount(5);
+
+
+
 /// \brief Base matching criteria for the purpose of finding poorly aligned read edge lengths.
 ///
 /// For this application we treat all ambiguous bases as matching. Note that, more generally, we usually want
@@ -235,8 +240,6 @@ getSVBreakendCandidateSemiAligned(
     const uint8_t minBasecallQuality,
     const float minHighBasecallQualityFraction)
 {
-    static const unsigned contiguousMatchCount(5);
-
     leadingEdgePoorAlignmentLength = 0;
     leadingEdgeRefPos = 0;
     trailingEdgePoorAlignmentLength = 0;
@@ -263,7 +266,7 @@ getSVBreakendCandidateSemiAligned(
     // Get the poorly aligned length for the leading and trailing edge of the input read
     unsigned leadingEdgePoorAlignmentLengthTmp(0);
     unsigned trailingEdgePoorAlignmentLengthTmp(0);
-    edgePoorAlignmentLength(matchedAlignment, querySeq, refSeq, contiguousMatchCount,
+    edgePoorAlignmentLength(matchedAlignment, querySeq, refSeq, edgeContiguousMatchCount,
                             leadingEdgePoorAlignmentLengthTmp, leadingEdgeRefPos,
                             trailingEdgePoorAlignmentLengthTmp, trailingEdgeRefPos);
 
@@ -320,3 +323,52 @@ getSVBreakendCandidateSemiAligned(
 #endif
     }
 }
+
+
+
+/// \brief Test whether one edge of a read aligned as a single match segment has a poorly aligned length below maxPoorLength
+///
+/// This scans only the bases required to find a contiguous matching block which begins within \p maxPoorLength
+/// bases of the read edge.
+static
+bool
+isSimpleMatchEdgeWellAligned(
+    const bam_seq& querySeq,
+    const reference_contig_segment& refSeq,
+    const pos_t matchBeginPos,
+    const bool isLeadingEdge,
+    const unsigned maxPoorLength)
+{
+    const pos_t readSize(querySeq.size());
+    const pos_t scanSize(std::min(readSize, static_cast<pos_t>(maxPoorLength+edgeContiguousMatchCount-1)));
+
+    unsigned matchLength(0);
+    for (pos_t edgeOffset(0); edgeOffset<scanSize; ++edgeOffset)
+    {
+        const pos_t readIndex(isLeadingEdge ? edgeOffset : (readSize-1-edgeOffset));
+        if (isBaseMatchForPoorAlignmentTest(querySeq.get_char(readIndex), refSeq.get_base(matchBeginPos+readIndex)))
+        {
+            matchLength++;
+            if (matchLength>=edgeContiguousMatchCount) return true;
+        }
+        else
+        {
+            matchLength=0;
+        }
+    }
+    return false;
+}
+
+
+
+bool
+isSimpleMatchReadWellAligned(
+    const bam_record& bamRead,
+    const pos_t matchBeginPos,
+    const reference_contig_segment& refSeq,
+    const unsigned minMismatchLen)
+{
+    const bam_seq querySeq(bamRead.get_bam_read());
+    if (! isSimpleMatchEdgeWellAligned(querySeq, refSeq, matchBeginPos, true, minMismatchLen)) return false;
+    return isSimpleMatchEdgeWellAligned(querySeq, refSeq, matchBeginPos, false, minMismatchLen);
+}
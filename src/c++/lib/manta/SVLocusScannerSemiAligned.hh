@@ -117,3 +117,24 @@ getSVBreakendCandidateSemiAlignedSimple(
         leadingMismatchLen, leadingRefPos,
         trailingMismatchLen, trailingRefPos);
 }
+
+
+
+/// \brief Fast test for reads which can't be semi-aligned evidence
+///
+/// This test applies only to reads aligned as a single match segment after any edge soft-clipping is unrolled to
+/// the match state. Each read edge is only scanned as far as needed to find its first contiguous matching block,
+/// and no alignment objects are constructed.
+///
+/// \param[in] matchBeginPos Reference position of the first read base, after edge soft-clipping is unrolled
+/// \param[in] minMismatchLen Minimum poorly aligned edge length required for semi-aligned evidence
+///
+/// \return True if ::getSVBreakendCandidateSemiAligned is certain to report poorly aligned lengths below
+///         \p minMismatchLen on both edges of \p bamRead
+bool
+isSimpleMatchReadWellAligned(
+    const bam_record& bamRead,
+    const pos_t matchBeginPos,
+    const reference_contig_segment& refSeq,
+    const unsigned minMismatchLen);
+
@@ -21,6 +21,7 @@
 /// \author Chris Saunders
 ///
 
+#include "blt_util/packed_reference.hh"
 #include "common/Exceptions.hh"
 #include "htsapi/samtools_fasta_util.hh"
 #include "manta/SVReferenceUtil.hh"
@@ -129,26 +130,42 @@ getBpReferenceInterval(
 
 
 /// given a reference extraction interval, produce the corresponding ref contig segment
+///
+/// if isAllowPackedView is set and a packed image of the reference is registered, the segment
+/// is a view of the image rather than a copy of the sequence
 static
 void
 getIntervalReferenceSegment(
     const std::string& referenceFilename,
     const bam_header_info& header,
     const GenomeInterval& refInterval,
-    reference_contig_segment& intervalRefSeq)
+    reference_contig_segment& intervalRefSeq,
+    const bool isAllowPackedView)
 {
     const bam_header_info::chrom_info& chromInfo(header.chrom_data[refInterval.tid]);
     const std::string& chrom(chromInfo.label);
 
     // get REF
     const known_pos_range2& range(refInterval.range);
-    intervalRefSeq.set_offset(range.begin_pos());
+    intervalRefSeq.clear();
 
-    // note: begin and end pos follow Manta's closed-open bpInterval conventions (a la bedtools,
-    // but the ref function below takes closed-closed endpoints, so we subtract one from endPos
-    get_standardized_region_seq(referenceFilename, chrom, range.begin_pos(), (range.end_pos()-1), intervalRefSeq.seq());
+    const packed_reference* packedRefPtr(isAllowPackedView ? get_packed_reference(referenceFilename) : nullptr);
+    const int packedContigIndex(packedRefPtr ? packedRefPtr->get_contig_index(chrom) : -1);
+    if (packedContigIndex >= 0)
+    {
+        intervalRefSeq.set_packed_view(*packedRefPtr, packedContigIndex, range.begin_pos(), range.end_pos());
+    }
+    else
+    {
+        intervalRefSeq.set_offset(range.begin_pos());
+
+        // note: begin and end pos follow Manta's closed-open bpInterval conventions (a la bedtools,
+        // but the ref function below takes closed-closed endpoints, so we subtract one from endPos
+        get_standardized_region_seq(referenceFilename, chrom, range.begin_pos(), (range.end_pos()-1), intervalRefSeq.seq());
+    }
 
-    if (intervalRefSeq.seq().size() != range.size())
+    const pos_t refSize(intervalRefSeq.end()-intervalRefSeq.get_offset());
+    if (refSize != static_cast<pos_t>(range.size()))
     {
         using namespace illumina::common;
 
@@ -160,7 +177,7 @@ getIntervalReferenceSegment(
             << "\n";
 
         oss << "\texpected_size: " << range.size()
-            << "\treturned_size: " << intervalRefSeq.seq().size()
+            << "\treturned_size: " << refSize
             << "\n";
 
         BOOST_THROW_EXCEPTION(LogicException(oss.str()));
@@ -177,12 +194,13 @@ getIntervalReferenceSegment(
     const GenomeInterval& bpInterval,
     reference_contig_segment& intervalRefSeq,
     unsigned& leadingTrim,
-    unsigned& trailingTrim)
+    unsigned& trailingTrim,
+    const bool isAllowPackedView)
 {
     GenomeInterval refInterval;
     getBpReferenceInterval(header, extraRefEdgeSize, bpInterval, refInterval, leadingTrim, trailingTrim);
 
-    getIntervalReferenceSegment(referenceFilename, header, refInterval, intervalRefSeq);
+    getIntervalReferenceSegment(referenceFilename, header, refInterval, intervalRefSeq, isAllowPackedView);
 }
 
 
@@ -58,6 +58,9 @@ isRefRegionValid(
 ///              front of the requested interval (with edge buffer)
 /// \param[out] trailingTrim indicates how much was cut from the
 ///              end of the requested interval (with edge buffer)
+/// \param[in] isAllowPackedView if true and a packed reference image is registered for
+///             referenceFilename, intervalRef is set to a view of the image instead of a copy
+///             of the sequence. The view supports base and substring access only.
 ///
 void
 getIntervalReferenceSegment(
@@ -67,7 +70,8 @@ getIntervalReferenceSegment(
     const GenomeInterval& interval,
     reference_contig_segment& intervalRef,
     unsigned& leadingTrim,
-    unsigned& trailingTrim);
+    unsigned& trailingTrim,
+    const bool isAllowPackedView = false);
 
 
 /// alternate interface to getIntervalReferenceSegment for applications
@@ -79,11 +83,12 @@ getIntervalReferenceSegment(
     const bam_header_info& header,
     const pos_t extraRefEdgeSize,
     const GenomeInterval& interval,
-    reference_contig_segment& intervalRef)
+    reference_contig_segment& intervalRef,
+    const bool isAllowPackedView = false)
 {
     unsigned leadingTrim;
     unsigned trailingTrim;
-    getIntervalReferenceSegment(referenceFilename, header, extraRefEdgeSize, interval, intervalRef,leadingTrim, trailingTrim);
+    getIntervalReferenceSegment(referenceFilename, header, extraRefEdgeSize, interval, intervalRef,leadingTrim, trailingTrim, isAllowPackedView);
 }
 
 
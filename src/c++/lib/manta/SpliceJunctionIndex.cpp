@@ -0,0 +1,262 @@
+//
+// Manta - Structural Variant and Indel Caller
+// Copyright (c) 2013-2017 Illumina, Inc.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+//
+
+/// \file
+/// \author Chris Saunders
+///
+
+#include "manta/SpliceJunctionIndex.hh"
+
+#include "blt_util/parse_util.hh"
+#include "blt_util/string_util.hh"
+#include "common/Exceptions.hh"
+
+#include <algorithm>
+#include <cassert>
+#include <iostream>
+#include <map>
+#include <sstream>
+
+
+
+/// \brief Parse exons from one BED12 record
+static
+void
+getBed12Exons(
+    const std::vector<std::string>& words,
+    std::vector<known_pos_range2>& exons)
+{
+    using namespace illumina::blt_util;
+
+    const pos_t transcriptBeginPos(parse_int_str(words[1]));
+    const unsigned blockCount(parse_unsigned_str(words[9]));
+
+    std::vector<std::string> blockSizes;
+    std::vector<std::string> blockStarts;
+    static const bool isSkipEmpty(true);
+    split_string(words[10], ',', blockSizes, isSkipEmpty);
+    split_string(words[11], ',', blockStarts, isSkipEmpty);
+    if ((blockSizes.size() != blockCount) || (blockStarts.size() != blockCount))
+    {
+        throw std::invalid_argument("Inconsistent BED12 block count");
+    }
+
+    exons.clear();
+    for (unsigned blockIndex(0); blockIndex<blockCount; ++blockIndex)
+    {
+        const pos_t exonBeginPos(transcriptBeginPos + parse_int_str(blockStarts[blockIndex]));
+        exons.emplace_back(exonBeginPos, exonBeginPos + parse_int_str(blockSizes[blockIndex]));
+    }
+}
+
+
+
+/// \return The value of the transcript_id attribute in a GTF attribute field, or an empty string if not found
+static
+std::string
+getGtfTranscriptId(
+    const std::string& attributes)
+{
+    static const std::string key("transcript_id \"");
+    const size_t keyPos(attributes.find(key));
+    if (keyPos == std::string::npos) return "";
+    const size_t valueBeginPos(keyPos + key.size());
+    const size_t valueEndPos(attributes.find('"', valueBeginPos));
+    if (valueEndPos == std::string::npos) return "";
+    return attributes.substr(valueBeginPos, (valueEndPos - valueBeginPos));
+}
+
+
+
+void
+SpliceJunctionIndex::
+loadAnnotation(
+    std::istream& annotationStream,
+    const bam_header_info& bamHeader)
+{
+    using namespace illumina::blt_util;
+
+    // GTF exons are grouped by chromosome and transcript_id before they can be added:
+    std::map<std::pair<int32_t,std::string>,std::vector<known_pos_range2>> gtfTranscripts;
+
+    std::string line;
+    std::vector<std::string> words;
+    std::vector<known_pos_range2> exons;
+    unsigned lineNumber(0);
+    while (std::getline(annotationStream, line))
+    {
+        lineNumber++;
+        if (line.empty() || (line[0] == '#')) continue;
+        if ((line.compare(0, 5, "track") == 0) || (line.compare(0, 7, "browser") == 0)) continue;
+
+        split_string(line, '\t', words);
+        try
+        {
+            if (words.size() == 9)
+            {
+                if (words[2] != "exon") continue;
+                const auto chromIter(bamHeader.chrom_to_index.find(words[0]));
+                if (chromIter == bamHeader.chrom_to_index.end()) continue;
+
+                const std::string transcriptId(getGtfTranscriptId(words[8]));
+                if (transcriptId.empty())
+                {
+                    throw std::invalid_argument("GTF exon record has no transcript_id attribute");
+                }
+
+                // convert from 1-indexed fully closed GTF coordinates:
+                const pos_t exonBeginPos(parse_int_str(words[3])-1);
+                const pos_t exonEndPos(parse_int_str(words[4]));
+                gtfTranscripts[std::make_pair(chromIter->second, transcriptId)].emplace_back(exonBeginPos, exonEndPos);
+            }
+            else if (words.size() >= 12)
+            {
+                const auto chromIter(bamHeader.chrom_to_index.find(words[0]));
+                if (chromIter == bamHeader.chrom_to_index.end()) continue;
+
+                getBed12Exons(words, exons);
+                addTranscript(chromIter->second, exons);
+            }
+            else
+            {
+                throw std::invalid_argument("Record is not in GTF or BED12 format");
+            }
+        }
+        catch (const std::exception& e)
+        {
+            using namespace illumina::common;
+
+            std::ostringstream oss;
+            oss << "Can't parse transcript annotation line " << lineNumber << ": " << e.what() << "\n"
+                << "\tline: '" << line << "'";
+            BOOST_THROW_EXCEPTION(LogicException(oss.str()));
+        }
+    }
+
+    for (auto& transcript : gtfTranscripts)
+    {
+        addTranscript(transcript.first.first, transcript.second);
+    }
+
+    finalize();
+}
+
+
+
+void
+SpliceJunctionIndex::
+addTranscript(
+    const int32_t tid,
+    std::vector<known_pos_range2> exons)
+{
+    assert(tid >= 0);
+    if (exons.size() < 2) return;
+
+    std::sort(exons.begin(), exons.end(),
+              [](const known_pos_range2& lhs, const known_pos_range2& rhs)
+    {
+        return (lhs.begin_pos() < rhs.begin_pos());
+    });
+
+    if (_chromIntrons.size() <= static_cast<unsigned>(tid)) _chromIntrons.resize(tid+1);
+    std::vector<Intron>& introns(_chromIntrons[tid]);
+
+    const unsigned transcriptIndex(_transcriptAcceptors.size());
+    _transcriptAcceptors.emplace_back();
+    std::vector<pos_t>& acceptors(_transcriptAcceptors.back());
+
+    const unsigned exonCount(exons.size());
+    for (unsigned exonIndex(1); exonIndex<exonCount; ++exonIndex)
+    {
+        const pos_t donorPos(exons[exonIndex-1].end_pos());
+        const pos_t acceptorPos(exons[exonIndex].begin_pos());
+
+        // skip overlapping or abutting exons, which do not define an intron:
+        if (acceptorPos <= donorPos) continue;
+
+        introns.push_back(Intron({donorPos, transcriptIndex, static_cast<unsigned>(acceptors.size())}));
+        acceptors.push_back(acceptorPos);
+        _intronCount++;
+    }
+
+    _isFinalized = false;
+}
+
+
+
+void
+SpliceJunctionIndex::
+finalize()
+{
+    for (std::vector<Intron>& introns : _chromIntrons)
+    {
+        std::sort(introns.begin(), introns.end());
+    }
+    _isFinalized = true;
+}
+
+
+
+bool
+SpliceJunctionIndex::
+isKnownSplice(
+    const SVCandidate& sv) const
+{
+    assert(_isFinalized);
+
+    if (sv.bp1.interval.tid != sv.bp2.interval.tid) return false;
+    const int32_t tid(sv.bp1.interval.tid);
+    if ((tid < 0) || (static_cast<unsigned>(tid) >= _chromIntrons.size())) return false;
+
+    // find the donor (right-open) and acceptor (left-open) side breakends:
+    const SVBreakend* donorBreakendPtr(nullptr);
+    const SVBreakend* acceptorBreakendPtr(nullptr);
+    if ((sv.bp1.state == SVBreakendState::RIGHT_OPEN) && (sv.bp2.state == SVBreakendState::LEFT_OPEN))
+    {
+        donorBreakendPtr = &(sv.bp1);
+        acceptorBreakendPtr = &(sv.bp2);
+    }
+    else if ((sv.bp1.state == SVBreakendState::LEFT_OPEN) && (sv.bp2.state == SVBreakendState::RIGHT_OPEN))
+    {
+        donorBreakendPtr = &(sv.bp2);
+        acceptorBreakendPtr = &(sv.bp1);
+    }
+    else
+    {
+        return false;
+    }
+
+    const known_pos_range2& donorRange(donorBreakendPtr->interval.range);
+    const known_pos_range2& acceptorRange(acceptorBreakendPtr->interval.range);
+
+    const std::vector<Intron>& introns(_chromIntrons[tid]);
+    const Intron searchIntron({donorRange.begin_pos(), 0, 0});
+    for (auto intronIter(std::lower_bound(introns.begin(), introns.end(), searchIntron));
+         intronIter != introns.end(); ++intronIter)
+    {
+        if (intronIter->donorPos >= donorRange.end_pos()) break;
+
+        // check for an acceptor of this or any downstream intron in the acceptor breakend region:
+        const std::vector<pos_t>& acceptors(_transcriptAcceptors[intronIter->transcriptIndex]);
+        const auto acceptorIter(std::lower_bound(acceptors.begin() + intronIter->intronIndex, acceptors.end(),
+                                                 acceptorRange.begin_pos()));
+        if ((acceptorIter != acceptors.end()) && (*acceptorIter < acceptorRange.end_pos())) return true;
+    }
+    return false;
+}
@@ -0,0 +1,118 @@
+//
+// Manta - Structural Variant and Indel Caller
+// Copyright (c) 2013-2017 Illumina, Inc.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+//
+
+/// \file
+/// \author Chris Saunders
+///
+
+#pragma once
+
+#include "blt_util/blt_types.hh"
+#include "blt_util/known_pos_range2.hh"
+#include "htsapi/bam_header_info.hh"
+#include "manta/SVCandidate.hh"
+
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+
+/// \brief Index of the introns of annotated transcripts, used to find RNA-Seq SV evidence which is fully explained
+///        by known splicing
+///
+/// Each intron is stored as the (donor,acceptor) pair of reference positions it spans, where donor is the first
+/// intron position and acceptor is the first position of the downstream exon. Introns are indexed by donor
+/// position on each chromosome, and link back to their transcript so that evidence spanning several consecutive
+/// introns of one transcript can also be recognized.
+///
+struct SpliceJunctionIndex
+{
+    /// \brief Add all transcripts from a transcript annotation in GTF or BED12 format
+    ///
+    /// The format of each line is detected by its column count. In GTF input only 'exon' features are used and
+    /// these are grouped into transcripts by the 'transcript_id' attribute. Annotation on chromosomes not found in
+    /// \p bamHeader is ignored.
+    void
+    loadAnnotation(
+        std::istream& annotationStream,
+        const bam_header_info& bamHeader);
+
+    /// \brief Add one transcript from its exon intervals
+    ///
+    /// finalize() must be called after all transcripts are added and before any junction queries.
+    ///
+    /// \param[in] exons Exon ranges in zero-indexed reference coordinates, in any order
+    void
+    addTranscript(
+        const int32_t tid,
+        std::vector<known_pos_range2> exons);
+
+    /// \brief Sort the intron index after transcripts have been added
+    void
+    finalize();
+
+    /// \return True if no introns are indexed
+    bool
+    empty() const
+    {
+        return (_intronCount == 0);
+    }
+
+    /// \return Total number of indexed introns
+    unsigned
+    intronCount() const
+    {
+        return _intronCount;
+    }
+
+    /// \brief Test whether \p sv is a deletion-like junction which could be fully explained by splicing from one
+    ///        exon of an annotated transcript to any downstream exon of the same transcript
+    ///
+    /// This is true when some annotated intron donor falls in the right-open breakend region and an acceptor of
+    /// the same or a later intron of that transcript falls in the left-open breakend region.
+    bool
+    isKnownSplice(
+        const SVCandidate& sv) const;
+
+private:
+
+    struct Intron
+    {
+        bool
+        operator<(const Intron& rhs) const
+        {
+            return (donorPos < rhs.donorPos);
+        }
+
+        pos_t donorPos;
+        unsigned transcriptIndex;
+
+        /// index of this intron within its transcript
+        unsigned intronIndex;
+    };
+
+    /// introns on each chromosome, sorted by donor position
+    std::vector<std::vector<Intron>> _chromIntrons;
+
+    /// acceptor position of each intron, in transcript order, for each transcript
+    std::vector<std::vector<pos_t>> _transcriptAcceptors;
+
+    unsigned _intronCount = 0;
+    bool _isFinalized = true;
+};
@@ -0,0 +1,224 @@
+//
+// Manta - Structural Variant and Indel Caller
+// Copyright (c) 2013-2017 Illumina, Inc.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+//
+
+#include "boost/filesystem.hpp"
+#include "boost/test/unit_test.hpp"
+
+#include "manta/AlignmentRunCache.hh"
+
+#include <unistd.h>
+
+#include <fstream>
+
+
+BOOST_AUTO_TEST_SUITE( test_AlignmentRunCache )
+
+
+namespace bfs = boost::filesystem;
+
+
+/// Create a header-only SAM alignment file with an index placeholder, the cache key only depends on the
+/// alignment file header and the size of both files and the mtime of the index
+static
+void
+createTestAlignmentFile(const std::string& filename)
+{
+    {
+        std::ofstream ofs(filename);
+        ofs << "@HD\tVN:1.4\tSO:coordinate\n"
+            << "@SQ\tSN:chr1\tLN:1000\n"
+            << "@SQ\tSN:chr2\tLN:2000\n";
+    }
+    {
+        std::ofstream ofs(filename + ".bai");
+        ofs << "index";
+    }
+}
+
+
+struct AlignmentRunCacheFixture
+{
+    AlignmentRunCacheFixture() :
+        testDir(bfs::unique_path("testAlignmentRunCache-%%%%-%%%%")),
+        cacheDir((testDir / "cache").string()),
+        alignmentFilename((testDir / "sample.sam").string())
+    {
+        bfs::create_directories(testDir);
+        createTestAlignmentFile(alignmentFilename);
+    }
+
+    ~AlignmentRunCacheFixture()
+    {
+        boost::system::error_code ec;
+        bfs::permissions(testDir, bfs::owner_all, ec);
+        bfs::remove_all(testDir, ec);
+    }
+
+    double
+    getChromDepth(
+        const AlignmentRunCache& runCache,
+        const std::string& filename,
+        unsigned& depthFuncCount) const
+    {
+        return runCache.getChromDepth("", filename, "chr1", [&]()
+        {
+            depthFuncCount++;
+            return 12.345678901234;
+        });
+    }
+
+    const bfs::path testDir;
+    const std::string cacheDir;
+    const std::string alignmentFilename;
+};
+
+
+
+BOOST_FIXTURE_TEST_CASE( test_AlignmentRunCacheChromDepth, AlignmentRunCacheFixture )
+{
+    const AlignmentRunCache runCache(cacheDir);
+    BOOST_REQUIRE(runCache.isEnabled());
+
+    // a miss computes the depth and writes an entry, and the next request hits this entry:
+    unsigned depthFuncCount(0);
+    BOOST_REQUIRE_EQUAL(getChromDepth(runCache, alignmentFilename, depthFuncCount), 12.345678901234);
+    BOOST_REQUIRE_EQUAL(depthFuncCount, 1u);
+    BOOST_REQUIRE(! bfs::is_empty(cacheDir));
+
+    BOOST_REQUIRE_EQUAL(getChromDepth(runCache, alignmentFilename, depthFuncCount), 12.345678901234);
+    BOOST_REQUIRE_EQUAL(depthFuncCount, 1u);
+
+    // other chromosomes have their own entries:
+    BOOST_REQUIRE_EQUAL(runCache.getChromDepth("", alignmentFilename, "chr2", []() { return 3.; }), 3.);
+
+    // a disabled cache always computes the depth:
+    const AlignmentRunCache disabledCache("");
+    BOOST_REQUIRE(! disabledCache.isEnabled());
+    BOOST_REQUIRE_EQUAL(getChromDepth(disabledCache, alignmentFilename, depthFuncCount), 12.345678901234);
+    BOOST_REQUIRE_EQUAL(depthFuncCount, 2u);
+}
+
+
+
+BOOST_FIXTURE_TEST_CASE( test_AlignmentRunCacheIndexKey, AlignmentRunCacheFixture )
+{
+    const AlignmentRunCache runCache(cacheDir);
+    const std::string indexFilename(alignmentFilename + ".bai");
+
+    unsigned depthFuncCount(0);
+    getChromDepth(runCache, alignmentFilename, depthFuncCount);
+    BOOST_REQUIRE_EQUAL(depthFuncCount, 1u);
+
+    // a change in index mtime changes the key:
+    bfs::last_write_time(indexFilename, bfs::last_write_time(indexFilename) + 100);
+    getChromDepth(runCache, alignmentFilename, depthFuncCount);
+    BOOST_REQUIRE_EQUAL(depthFuncCount, 2u);
+    getChromDepth(runCache, alignmentFilename, depthFuncCount);
+    BOOST_REQUIRE_EQUAL(depthFuncCount, 2u);
+
+    // a change in index size changes the key:
+    const std::time_t indexTime(bfs::last_write_time(indexFilename));
+    {
+        std::ofstream ofs(indexFilename, std::ios::app);
+        ofs << "X";
+    }
+    bfs::last_write_time(indexFilename, indexTime);
+    getChromDepth(runCache, alignmentFilename, depthFuncCount);
+    BOOST_REQUIRE_EQUAL(depthFuncCount, 3u);
+}
+
+
+
+BOOST_FIXTURE_TEST_CASE( test_AlignmentRunCacheStatsRelabel, AlignmentRunCacheFixture )
+{
+    const AlignmentRunCache runCache(cacheDir);
+
+    unsigned statsFuncCount(0);
+    auto statsFunc = [&](const std::string& filename)
+    {
+        return [&statsFuncCount,filename](ReadGroupStatsSet& fileStats)
+        {
+            statsFuncCount++;
+            ReadGroupStats rgStats;
+            rgStats.fragStats.addObservation(300);
+            rgStats.fragStats.addObservation(310);
+            fileStats.setStats(ReadGroupLabel(filename.c_str(), ""), rgStats);
+        };
+    };
+
+    ReadGroupStatsSet rstats;
+    runCache.getReadGroupStats("", alignmentFilename, statsFunc(alignmentFilename), rstats);
+    BOOST_REQUIRE_EQUAL(statsFuncCount, 1u);
+    BOOST_REQUIRE_EQUAL(rstats.size(), 1u);
+
+    // copy the alignment file to a new path with the same index mtime, the cached stats are relabeled to the new path:
+    const std::string movedFilename((testDir / "renamed.sam").string());
+    bfs::copy_file(alignmentFilename, movedFilename);
+    bfs::copy_file(alignmentFilename + ".bai", movedFilename + ".bai");
+    bfs::last_write_time(movedFilename + ".bai", bfs::last_write_time(alignmentFilename + ".bai"));
+
+    ReadGroupStatsSet movedStats;
+    runCache.getReadGroupStats("", movedFilename, statsFunc(movedFilename), movedStats);
+    BOOST_REQUIRE_EQUAL(statsFuncCount, 1u);
+    BOOST_REQUIRE_EQUAL(movedStats.size(), 1u);
+    BOOST_REQUIRE_EQUAL(std::string(movedStats.getKey(0).bamLabel), movedFilename);
+    BOOST_REQUIRE_EQUAL(movedStats.getStats(0).fragStats.totalObservations(), 2u);
+    BOOST_REQUIRE(! movedStats.getGroupIndex(ReadGroupLabel(alignmentFilename.c_str(), "")));
+}
+
+
+
+BOOST_FIXTURE_TEST_CASE( test_AlignmentRunCacheUnwritable, AlignmentRunCacheFixture )
+{
+    // permissions don't restrict root, so use a read-only filesystem directory in this case:
+    std::string readOnlyDir(cacheDir);
+    if (geteuid() == 0)
+    {
+        readOnlyDir = "/proc/self";
+    }
+    else
+    {
+        bfs::create_directories(readOnlyDir);
+        bfs::permissions(readOnlyDir, bfs::owner_read | bfs::owner_exe);
+    }
+
+    const AlignmentRunCache runCache(readOnlyDir);
+
+    // entry write errors fall back to computing the result:
+    unsigned depthFuncCount(0);
+    BOOST_REQUIRE_EQUAL(getChromDepth(runCache, alignmentFilename, depthFuncCount), 12.345678901234);
+    BOOST_REQUIRE_EQUAL(getChromDepth(runCache, alignmentFilename, depthFuncCount), 12.345678901234);
+    BOOST_REQUIRE_EQUAL(depthFuncCount, 2u);
+
+    ReadGroupStatsSet rstats;
+    runCache.getReadGroupStats("", alignmentFilename, [&](ReadGroupStatsSet& fileStats)
+    {
+        fileStats.setStats(ReadGroupLabel(alignmentFilename.c_str(), ""), ReadGroupStats());
+    }, rstats);
+    BOOST_REQUIRE_EQUAL(rstats.size(), 1u);
+
+    // a cache directory which can't be created disables the cache:
+    const AlignmentRunCache invalidCache(alignmentFilename + "/cache");
+    BOOST_REQUIRE(! invalidCache.isEnabled());
+    BOOST_REQUIRE_EQUAL(getChromDepth(invalidCache, alignmentFilename, depthFuncCount), 12.345678901234);
+    BOOST_REQUIRE_EQUAL(depthFuncCount, 3u);
+}
+
+
+BOOST_AUTO_TEST_SUITE_END()
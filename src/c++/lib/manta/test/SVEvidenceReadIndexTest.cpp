@@ -0,0 +1,102 @@
+//
+// Manta - Structural Variant and Indel Caller
+// Copyright (c) 2013-2017 Illumina, Inc.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+//
+
+#include "boost/archive/tmpdir.hpp"
+#include "boost/test/unit_test.hpp"
+
+#include "manta/SVEvidenceReadIndex.hh"
+
+
+BOOST_AUTO_TEST_SUITE( test_SVEvidenceReadIndex )
+
+
+BOOST_AUTO_TEST_CASE( test_SVEvidenceReadIndexQuery )
+{
+    SVEvidenceReadIndex index;
+    index.setSampleCount(2);
+    index.add(0,1,100,200);
+    index.add(0,1,150,160);
+    index.add(0,1,1000,1100);
+    index.add(0,2,50,60);
+    index.add(1,1,500,510);
+    index.finalize();
+
+    BOOST_REQUIRE_EQUAL(index.size(),5u);
+
+    // the long record starting at 100 overlaps this interval but the record at 150 does not:
+    BOOST_REQUIRE_EQUAL(index.getLastEvidencePos(0,GenomeInterval(1,170,300)),100);
+    BOOST_REQUIRE_EQUAL(index.getLastEvidencePos(0,GenomeInterval(1,0,2000)),1000);
+    BOOST_REQUIRE_EQUAL(index.getLastEvidencePos(0,GenomeInterval(1,200,1000)),-1);
+    BOOST_REQUIRE_EQUAL(index.getLastEvidencePos(0,GenomeInterval(2,0,55)),50);
+    BOOST_REQUIRE_EQUAL(index.getLastEvidencePos(0,GenomeInterval(0,0,2000)),-1);
+    BOOST_REQUIRE_EQUAL(index.getLastEvidencePos(1,GenomeInterval(1,0,2000)),500);
+    BOOST_REQUIRE_EQUAL(index.getLastEvidencePos(1,GenomeInterval(1,0,500)),-1);
+}
+
+
+BOOST_AUTO_TEST_CASE( test_SVEvidenceReadIndexMerge )
+{
+    // merged indices from out-of-order regions should be queryable after finalization:
+    SVEvidenceReadIndex index1;
+    index1.setSampleCount(1);
+    index1.add(0,1,1000,1100);
+
+    SVEvidenceReadIndex index2;
+    index2.setSampleCount(1);
+    index2.add(0,1,100,200);
+
+    SVEvidenceReadIndex merged;
+    merged.merge(index1);
+    merged.merge(index2);
+    merged.finalize();
+
+    BOOST_REQUIRE_EQUAL(merged.getSampleCount(),1u);
+    BOOST_REQUIRE_EQUAL(merged.getLastEvidencePos(0,GenomeInterval(1,0,500)),100);
+    BOOST_REQUIRE_EQUAL(merged.getLastEvidencePos(0,GenomeInterval(1,0,2000)),1000);
+
+    SVEvidenceReadIndex index3;
+    index3.setSampleCount(2);
+    BOOST_REQUIRE_THROW(merged.merge(index3),std::exception);
+}
+
+
+BOOST_AUTO_TEST_CASE( test_SVEvidenceReadIndexSerialize )
+{
+    SVEvidenceReadIndex index;
+    index.setSampleCount(2);
+    index.add(0,1,100,200);
+    index.add(1,3,500,510);
+    index.finalize();
+
+    std::string filename(boost::archive::tmpdir());
+    filename += "/testEvidenceIndex.bin";
+
+    index.save(filename.c_str());
+
+    SVEvidenceReadIndex indexCopy;
+    indexCopy.load(filename.c_str());
+
+    BOOST_REQUIRE_EQUAL(indexCopy.getSampleCount(),2u);
+    BOOST_REQUIRE_EQUAL(indexCopy.size(),2u);
+    BOOST_REQUIRE_EQUAL(indexCopy.getLastEvidencePos(0,GenomeInterval(1,150,160)),100);
+    BOOST_REQUIRE_EQUAL(indexCopy.getLastEvidencePos(1,GenomeInterval(3,0,1000)),500);
+}
+
+
+BOOST_AUTO_TEST_SUITE_END()
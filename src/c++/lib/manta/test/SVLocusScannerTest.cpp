@@ -460,4 +460,133 @@ BOOST_AUTO_TEST_CASE( test_getSVCandidatesFromReadIndels )
     BOOST_REQUIRE(candidates[0].bp2.interval.range.is_pos_intersect(2100));
 }
 
+// Test that a read split into three segments yields an observation for the junction on each side of
+// the middle segment
+BOOST_AUTO_TEST_CASE( test_MultiSegmentSplitRead ) {
+
+    const bam_header_info bamHeader(buildBamHeader());
+    const ReadScannerOptions opt;
+    const ReadScannerDerivOptions dopt(opt, false, false);
+
+    // the middle segment of the read is aligned here, and the SA tag provides the first and last segments:
+    bam_record splitRead;
+    buildBamRecord(splitRead, 0, 1000, 0, 5000, 150, 60, "50S50M50S");
+    addSupplementaryEvidence(splitRead, "chrM,5001,+,100S50M,60,0;chrM,2001,+,50M100S,60,0;");
+    const SimpleAlignment splitAlign(getAlignment(splitRead));
+
+    split_alignment_tag_parser saParser;
+    std::vector<SVObservation> candidates;
+    getSACandidatesFromRead(opt, dopt, splitRead, splitAlign, SourceOfSVEvidenceInDNAFragment::READ1, bamHeader,
+                            saParser, candidates);
+    BOOST_REQUIRE_EQUAL(candidates.size(), 2u);
+
+    // junction from the end of the first segment to the start of the middle segment:
+    BOOST_REQUIRE_EQUAL(candidates[0].bp1.state, SVBreakendState::LEFT_OPEN);
+    BOOST_REQUIRE(candidates[0].bp1.interval.range.is_pos_intersect(1000));
+    BOOST_REQUIRE_EQUAL(candidates[0].bp2.state, SVBreakendState::RIGHT_OPEN);
+    BOOST_REQUIRE(candidates[0].bp2.interval.range.is_pos_intersect(2050));
+
+    // junction from the end of the middle segment to the start of the last segment:
+    BOOST_REQUIRE_EQUAL(candidates[1].bp1.state, SVBreakendState::RIGHT_OPEN);
+    BOOST_REQUIRE(candidates[1].bp1.interval.range.is_pos_intersect(1050));
+    BOOST_REQUIRE_EQUAL(candidates[1].bp2.state, SVBreakendState::LEFT_OPEN);
+    BOOST_REQUIRE(candidates[1].bp2.interval.range.is_pos_intersect(5000));
+
+    // low mapping quality segments are skipped, but still define the read order of the other segments:
+    bam_record lowMapqSplitRead;
+    buildBamRecord(lowMapqSplitRead, 0, 1000, 0, 5000, 150, 60, "50S50M50S");
+    addSupplementaryEvidence(lowMapqSplitRead, "chrM,2001,+,50M100S,60,0;chrM,5001,+,100S50M,0,0;");
+    getSACandidatesFromRead(opt, dopt, lowMapqSplitRead, splitAlign, SourceOfSVEvidenceInDNAFragment::READ1, bamHeader,
+                            saParser, candidates);
+    BOOST_REQUIRE_EQUAL(candidates.size(), 3u);
+    BOOST_REQUIRE_EQUAL(candidates[2].bp1.state, SVBreakendState::LEFT_OPEN);
+    BOOST_REQUIRE(candidates[2].bp2.interval.range.is_pos_intersect(2050));
+}
+
+// The evidence pre-filter must only reject reads which isSVEvidence also rejects.
+BOOST_AUTO_TEST_CASE( test_isPreFilteredNonEvidence )
+{
+    static const pos_t alignPos(500);
+
+    const bam_header_info bamHeader(buildBamHeader());
+    std::unique_ptr<SVLocusScanner> scanner(buildSVLocusScanner(bamHeader));
+
+    reference_contig_segment ref = reference_contig_segment();
+    static const char refSeq[] =       "AACCTTTTTTCATCACACACAAGAGTCCAGAGACCGACTTCCCCCCAAAA";
+    static const char semiQuerySeq[] = "AACCCACAAACATCACACACAAGAGTCCAGAGACCGACTTTTTTCTAAAA";
+    ref.seq() = refSeq;
+    ref.set_offset(alignPos);
+
+    // check the pre-filter invariant and return the pre-filter result:
+    auto isPreFiltered = [&](const bam_record& bamRead)
+    {
+        const bool isPreFilteredRead(scanner->isPreFilteredNonEvidence(bamRead, 0, ref));
+        if (isPreFilteredRead)
+        {
+            BOOST_REQUIRE(! scanner->isSVEvidence(bamRead, 0, ref));
+        }
+        return isPreFilteredRead;
+    };
+
+    auto buildTestRead = [&](bam_record& bamRead, const char* cigar, const char* querySeq)
+    {
+        buildBamRecord(bamRead, 0, alignPos, 0, alignPos+200, 50, 15, cigar, querySeq);
+        changeTemplateSize(bamRead, 100);
+    };
+
+    // a clean full match is pre-filtered:
+    bam_record matchRead;
+    buildTestRead(matchRead, "50M", refSeq);
+    BOOST_REQUIRE(! scanner->isSVEvidence(matchRead, 0, ref));
+    BOOST_REQUIRE(isPreFiltered(matchRead));
+
+    // soft-clipped reads:
+    bam_record softClipRead;
+    buildTestRead(softClipRead, "10S40M", refSeq);
+    isPreFiltered(softClipRead);
+
+    bam_record mismatchSoftClipRead;
+    buildTestRead(mismatchSoftClipRead, "40M10S", semiQuerySeq);
+    isPreFiltered(mismatchSoftClipRead);
+
+    // a fully matched read with a semi-aligned mismatch tail is evidence:
+    bam_record semiRead;
+    buildTestRead(semiRead, "50M", semiQuerySeq);
+    BOOST_REQUIRE(scanner->isSVEvidence(semiRead, 0, ref));
+    BOOST_REQUIRE(! isPreFiltered(semiRead));
+
+    // an SA-tagged read is evidence:
+    bam_record splitRead;
+    buildTestRead(splitRead, "50M", refSeq);
+    addSupplementaryEvidence(splitRead);
+    BOOST_REQUIRE(scanner->isSVEvidence(splitRead, 0, ref));
+    BOOST_REQUIRE(! isPreFiltered(splitRead));
+
+    // indels below the candidate size are only evidence if the read is otherwise semi-aligned:
+    bam_record smallIndelRead;
+    buildTestRead(smallIndelRead, "20M2D30M", refSeq);
+    isPreFiltered(smallIndelRead);
+
+    bam_record smallInsertRead;
+    buildTestRead(smallInsertRead, "20M2I28M", refSeq);
+    isPreFiltered(smallInsertRead);
+
+    bam_record largeIndelRead;
+    buildTestRead(largeIndelRead, "20M10D30M", refSeq);
+    BOOST_REQUIRE(scanner->isSVEvidence(largeIndelRead, 0, ref));
+    BOOST_REQUIRE(! isPreFiltered(largeIndelRead));
+
+    // anomalous pairs are evidence:
+    bam_record largePairRead;
+    buildTestRead(largePairRead, "50M", refSeq);
+    changeTemplateSize(largePairRead, 1000);
+    BOOST_REQUIRE(scanner->isSVEvidence(largePairRead, 0, ref));
+    BOOST_REQUIRE(! isPreFiltered(largePairRead));
+
+    bam_record interChromRead;
+    buildBamRecord(interChromRead, 0, alignPos, 1, alignPos+200, 50, 15, "50M", refSeq);
+    BOOST_REQUIRE(scanner->isSVEvidence(interChromRead, 0, ref));
+    BOOST_REQUIRE(! isPreFiltered(interChromRead));
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,123 @@
+//
+// Manta - Structural Variant and Indel Caller
+// Copyright (c) 2013-2017 Illumina, Inc.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+//
+
+#include "boost/test/unit_test.hpp"
+
+#include "manta/SpliceJunctionIndex.hh"
+#include "testUtil.hh"
+
+#include <sstream>
+
+
+BOOST_AUTO_TEST_SUITE( test_SpliceJunctionIndex )
+
+
+/// Create a deletion-like candidate with right-open and left-open breakend ranges on chromosome \p tid
+static
+SVCandidate
+getDeletionCandidate(
+    const int32_t tid,
+    const pos_t donorBeginPos,
+    const pos_t donorEndPos,
+    const pos_t acceptorBeginPos,
+    const pos_t acceptorEndPos)
+{
+    SVCandidate sv;
+    sv.bp1.state = SVBreakendState::RIGHT_OPEN;
+    sv.bp1.interval = GenomeInterval(tid, donorBeginPos, donorEndPos);
+    sv.bp2.state = SVBreakendState::LEFT_OPEN;
+    sv.bp2.interval = GenomeInterval(tid, acceptorBeginPos, acceptorEndPos);
+    return sv;
+}
+
+
+BOOST_AUTO_TEST_CASE( test_SpliceJunctionIndexQuery )
+{
+    // one transcript with exons [100,200) [300,400) [500,600)
+    SpliceJunctionIndex spliceJunctions;
+    spliceJunctions.addTranscript(0, {known_pos_range2(500,600), known_pos_range2(100,200), known_pos_range2(300,400)});
+    spliceJunctions.finalize();
+    BOOST_REQUIRE_EQUAL(spliceJunctions.intronCount(), 2u);
+
+    // single intron:
+    BOOST_REQUIRE(spliceJunctions.isKnownSplice(getDeletionCandidate(0, 190, 210, 290, 310)));
+
+    // breakend order is not important:
+    SVCandidate swapSV(getDeletionCandidate(0, 190, 210, 290, 310));
+    std::swap(swapSV.bp1, swapSV.bp2);
+    BOOST_REQUIRE(spliceJunctions.isKnownSplice(swapSV));
+
+    // consecutive introns of the same transcript:
+    BOOST_REQUIRE(spliceJunctions.isKnownSplice(getDeletionCandidate(0, 190, 210, 490, 510)));
+
+    // acceptor upstream of the donor:
+    BOOST_REQUIRE(! spliceJunctions.isKnownSplice(getDeletionCandidate(0, 390, 410, 290, 310)));
+
+    // novel junction:
+    BOOST_REQUIRE(! spliceJunctions.isKnownSplice(getDeletionCandidate(0, 150, 170, 290, 310)));
+
+    // wrong chromosome:
+    BOOST_REQUIRE(! spliceJunctions.isKnownSplice(getDeletionCandidate(1, 190, 210, 290, 310)));
+
+    // not deletion-like:
+    SVCandidate inversionSV(getDeletionCandidate(0, 190, 210, 290, 310));
+    inversionSV.bp2.state = SVBreakendState::RIGHT_OPEN;
+    BOOST_REQUIRE(! spliceJunctions.isKnownSplice(inversionSV));
+}
+
+
+BOOST_AUTO_TEST_CASE( test_SpliceJunctionIndexMultiTranscript )
+{
+    // acceptors from another transcript sharing the same donor should not be combined across transcripts:
+    SpliceJunctionIndex spliceJunctions;
+    spliceJunctions.addTranscript(0, {known_pos_range2(100,200), known_pos_range2(300,400)});
+    spliceJunctions.addTranscript(0, {known_pos_range2(1000,1100), known_pos_range2(1300,1400)});
+    spliceJunctions.finalize();
+
+    BOOST_REQUIRE(spliceJunctions.isKnownSplice(getDeletionCandidate(0, 1090, 1110, 1290, 1310)));
+    BOOST_REQUIRE(! spliceJunctions.isKnownSplice(getDeletionCandidate(0, 190, 210, 1290, 1310)));
+}
+
+
+BOOST_AUTO_TEST_CASE( test_SpliceJunctionIndexLoadAnnotation )
+{
+    const bam_header_info bamHeader(buildBamHeader());
+
+    std::istringstream annotation(
+        "track name=test\n"
+        "chrM\t99\t600\ttx1\t0\t+\t99\t600\t0\t3\t101,100,100,\t0,201,401,\n"
+        "chrX\t99\t600\ttx2\t0\t+\t99\t600\t0\t2\t101,100,\t0,401,\n"
+        "#comment\n"
+        "chrT\ttest\texon\t101\t200\t.\t+\t.\tgene_id \"g1\"; transcript_id \"tx3\";\n"
+        "chrT\ttest\tCDS\t101\t150\t.\t+\t0\tgene_id \"g1\"; transcript_id \"tx3\";\n"
+        "chrT\ttest\texon\t301\t400\t.\t+\t.\tgene_id \"g1\"; transcript_id \"tx3\";\n");
+
+    SpliceJunctionIndex spliceJunctions;
+    spliceJunctions.loadAnnotation(annotation, bamHeader);
+    BOOST_REQUIRE_EQUAL(spliceJunctions.intronCount(), 3u);
+
+    BOOST_REQUIRE(spliceJunctions.isKnownSplice(getDeletionCandidate(0, 195, 205, 295, 305)));
+    BOOST_REQUIRE(spliceJunctions.isKnownSplice(getDeletionCandidate(1, 195, 205, 295, 305)));
+
+    std::istringstream badAnnotation("chrM\t99\t600\n");
+    BOOST_REQUIRE_THROW(spliceJunctions.loadAnnotation(badAnnotation, bamHeader), illumina::common::LogicException);
+}
+
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -19,6 +19,8 @@
 
 #pragma once
 
+#include <string>
+
 
 struct ReadScannerOptions
 {
@@ -106,4 +108,10 @@ struct ReadScannerOptions
     ///
     /// 'depth factor' is the locus' multiple of the expected chromosome depth.
     float maxDepthFactorRemoteReads = 7;
+
+    /// \brief Optional transcript annotation in GTF or BED12 format
+    ///
+    /// In RNA mode, SV evidence which is fully explained by splicing between annotated exons is discarded before
+    /// it is used to build the SV locus graph or candidate SVs.
+    std::string spliceJunctionAnnotationFilename;
 };
@@ -18,6 +18,7 @@
 //
 
 #include "options/ReadScannerOptionsParser.hh"
+#include "options/optionsUtil.hh"
 
 
 boost::program_options::options_description
@@ -35,6 +36,9 @@ getOptionsDescription(ReadScannerOptions& opt)
     ("ignore-anom-proper-pair", po::value(&opt.isIgnoreAnomProperPair)->zero_tokens(),
      "Disregard anomalous fragment sizes if the BAM record has the proper pair bit set. "
      "This flag is typically set for RNA-SEQ analysis where the proper-pair bit is used to indicate an intron-spanning read pair.")
+    ("splice-junction-annotation", po::value(&opt.spliceJunctionAnnotationFilename),
+     "Transcript annotation file in GTF or BED12 format. In RNA mode, SV evidence fully explained by splicing "
+     "between annotated exons is discarded (optional)")
     ;
 
     return desc;
@@ -53,6 +57,10 @@ parseOptions(
     {
         errorMsg="edge-prob argument is restricted to (0,1)";
     }
+    else if (! opt.spliceJunctionAnnotationFilename.empty())
+    {
+        checkStandardizeInputFile(opt.spliceJunctionAnnotationFilename, "splice junction annotation", errorMsg);
+    }
 
     return (! errorMsg.empty());
 }
@@ -0,0 +1,200 @@
+//
+// Manta - Structural Variant and Indel Caller
+// Copyright (c) 2013-2017 Illumina, Inc.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+//
+
+/// \file
+/// \author Chris Saunders
+///
+
+#include "svgraph/SVLocusCoalescingBuffer.hh"
+
+#include <cassert>
+
+#include <limits>
+
+
+
+/// \return true if locus is a single node with a self-edge, or a pair of nodes linked only to each other
+static
+bool
+isCoalescableShape(const SVLocus& locus)
+{
+    const unsigned nodeCount(locus.size());
+    if ((nodeCount < 1) || (nodeCount > 2)) return false;
+    for (NodeIndexType nodeIndex(0); nodeIndex<nodeCount; ++nodeIndex)
+    {
+        const SVLocusNode& node(locus.getNode(nodeIndex));
+        if (node.size() != 1) return false;
+        if (! node.isEdge(nodeCount-1-nodeIndex)) return false;
+    }
+    return true;
+}
+
+
+
+/// \return true if every node of locus2 intersects the corresponding node of locus1, and the coalesced nodes would
+///         not overlap each other
+///
+/// Both loci must already satisfy isCoalescableShape
+static
+bool
+isCoalescable(
+    const SVLocus& locus1,
+    const SVLocus& locus2)
+{
+    const unsigned nodeCount(locus1.size());
+    if (locus2.size() != nodeCount) return false;
+    for (NodeIndexType nodeIndex(0); nodeIndex<nodeCount; ++nodeIndex)
+    {
+        if (! locus1.getNode(nodeIndex).getInterval().isIntersect(locus2.getNode(nodeIndex).getInterval())) return false;
+    }
+
+    if (nodeCount == 2)
+    {
+        GenomeInterval interval0(locus1.getNode(0).getInterval());
+        GenomeInterval interval1(locus1.getNode(1).getInterval());
+        interval0.range.merge_range(locus2.getNode(0).getInterval().range);
+        interval1.range.merge_range(locus2.getNode(1).getInterval().range);
+        if (interval0.isIntersect(interval1)) return false;
+    }
+    return true;
+}
+
+
+
+/// Add edge counts, saturating at the max count value
+static
+unsigned
+addEdgeCount(
+    const unsigned count1,
+    const unsigned count2)
+{
+    static const unsigned maxCount(std::numeric_limits<unsigned>::max());
+    if (count1 > (maxCount-count2)) return maxCount;
+    return (count1+count2);
+}
+
+
+
+/// Combine node evidence ranges following the same rule used by SVLocus::mergeNode
+static
+known_pos_range2
+mergeEvidenceRange(
+    const SVLocusNode& node1,
+    const SVLocusNode& node2)
+{
+    const bool isCount1(node1.isOutCount());
+    const bool isCount2(node2.isOutCount());
+    if (isCount1 && (! isCount2)) return node1.getEvidenceRange();
+    if (isCount2 && (! isCount1)) return node2.getEvidenceRange();
+    return merge_range(node1.getEvidenceRange(),node2.getEvidenceRange());
+}
+
+
+
+/// Coalesce locus2 into locus1
+///
+/// Both loci must already satisfy isCoalescable
+static
+void
+coalesceLocus(
+    SVLocus& locus1,
+    const SVLocus& locus2)
+{
+    const unsigned nodeCount(locus1.size());
+
+    SVLocus coalesced;
+    const SVLocus& clocus1(locus1);
+    for (NodeIndexType nodeIndex(0); nodeIndex<nodeCount; ++nodeIndex)
+    {
+        const SVLocusNode& node1(clocus1.getNode(nodeIndex));
+        const SVLocusNode& node2(locus2.getNode(nodeIndex));
+        GenomeInterval interval(node1.getInterval());
+        interval.range.merge_range(node2.getInterval().range);
+        coalesced.addNode(interval);
+        coalesced.setNodeEvidence(nodeIndex,mergeEvidenceRange(node1,node2));
+    }
+
+    const NodeIndexType toIndex(nodeCount-1);
+    const unsigned fromCount(addEdgeCount(clocus1.getEdge(0,toIndex).getCount(),
+                                          locus2.getEdge(0,toIndex).getCount()));
+    unsigned toCount(0);
+    if (nodeCount == 2)
+    {
+        toCount = addEdgeCount(clocus1.getEdge(toIndex,0).getCount(),
+                               locus2.getEdge(toIndex,0).getCount());
+    }
+    coalesced.linkNodes(0,toIndex,fromCount,toCount);
+
+    locus1 = coalesced;
+}
+
+
+
+void
+SVLocusCoalescingBuffer::
+add(
+    const pos_t pos,
+    const SVLocus& locus)
+{
+    assert(_buffer.empty() || (pos >= _buffer.back().pos));
+
+    _inputCount++;
+
+    if (isCoalescableShape(locus))
+    {
+        // search from the most recent locus, which is the most likely to overlap the input:
+        for (auto iter(_buffer.rbegin()); iter != _buffer.rend(); ++iter)
+        {
+            const SVLocus& bufferedLocus(iter->locus);
+            if (! isCoalescableShape(bufferedLocus)) continue;
+            if (! isCoalescable(bufferedLocus,locus)) continue;
+            coalesceLocus(iter->locus,locus);
+            return;
+        }
+    }
+
+    _buffer.push_back(BufferedLocus());
+    _buffer.back().pos = pos;
+    _buffer.back().locus = locus;
+}
+
+
+
+void
+SVLocusCoalescingBuffer::
+flush(
+    const pos_t maxPos,
+    SVLocusSet& set)
+{
+    while ((! _buffer.empty()) && (_buffer.front().pos <= maxPos))
+    {
+        set.merge(_buffer.front().locus);
+        _outputCount++;
+        _buffer.pop_front();
+    }
+}
+
+
+
+void
+SVLocusCoalescingBuffer::
+flush(SVLocusSet& set)
+{
+    flush(std::numeric_limits<pos_t>::max(),set);
+}
@@ -0,0 +1,103 @@
+//
+// Manta - Structural Variant and Indel Caller
+// Copyright (c) 2013-2017 Illumina, Inc.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+//
+
+/// \file
+/// \author Chris Saunders
+///
+
+#pragma once
+
+#include "svgraph/SVLocusSet.hh"
+
+#include <deque>
+
+
+/// \brief Position-ordered staging buffer which coalesces similar SV loci before they are merged into an SV locus graph
+///
+/// Each SVLocusSet::merge call searches the graph index, moves nodes between loci and checks the graph state, but
+/// read evidence from the same event tends to produce a long run of nearly identical loci. This buffer holds each
+/// input locus for a short positional window, during which any later input locus with the same shape is summed into
+/// it, so that the graph only sees one merge call for the whole group.
+///
+/// Two loci have the same shape if they are both either (1) a single node with a self-edge or (2) a pair of nodes
+/// linked to each other, and each node of one locus intersects the corresponding node of the other. Coalesced nodes
+/// take the union of the node intervals, edge counts are summed, and evidence ranges are combined following the
+/// same rules as SVLocus node merging. Loci with any other structure are passed through without coalescing.
+///
+/// Loci are released to the graph in the order they were first added.
+///
+struct SVLocusCoalescingBuffer
+{
+    /// \brief Add a locus to the buffer
+    ///
+    /// \param[in] pos Position of the read evidence used to create this locus. Positions must be non-decreasing
+    ///                over all calls to add() between flushes.
+    void
+    add(
+        const pos_t pos,
+        const SVLocus& locus);
+
+    /// \brief Merge all buffered loci added at or below \p maxPos into \p set
+    void
+    flush(
+        const pos_t maxPos,
+        SVLocusSet& set);
+
+    /// \brief Merge all buffered loci into \p set
+    void
+    flush(SVLocusSet& set);
+
+    bool
+    empty() const
+    {
+        return _buffer.empty();
+    }
+
+    /// Number of loci currently buffered
+    unsigned
+    size() const
+    {
+        return _buffer.size();
+    }
+
+    /// Total number of loci input to this buffer
+    unsigned long
+    inputCount() const
+    {
+        return _inputCount;
+    }
+
+    /// Total number of loci merged into the graph by this buffer
+    unsigned long
+    outputCount() const
+    {
+        return _outputCount;
+    }
+
+private:
+    struct BufferedLocus
+    {
+        pos_t pos;
+        SVLocus locus;
+    };
+
+    std::deque<BufferedLocus> _buffer;
+    unsigned long _inputCount = 0;
+    unsigned long _outputCount = 0;
+};
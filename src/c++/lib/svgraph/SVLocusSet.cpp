@@ -35,9 +35,67 @@
 #include "blt_util/thirdparty_pop.h"
 
 #include <algorithm>
+#include <atomic>
+#include <exception>
 #include <fstream>
 #include <iostream>
 #include <sstream>
+#include <thread>
+
+
+
+/// \brief Call func(threadIndex, beginIndex, endIndex) over consecutive chunks of [0,itemCount), using threadCount threads
+///
+/// Chunks are handed out to threads on demand, so that a few very large loci do not delay the other threads. If func
+/// throws, the exception from the lowest chunk index is rethrown after all threads complete.
+template <typename Func>
+static
+void
+runParallelChunks(
+    const unsigned itemCount,
+    const unsigned threadCount,
+    Func func)
+{
+    static const unsigned chunkSize(256);
+    const unsigned chunkCount((itemCount+chunkSize-1)/chunkSize);
+
+    std::vector<std::exception_ptr> chunkExceptions(chunkCount);
+    std::atomic<unsigned> nextChunkIndex(0);
+
+    auto runChunks = [&](const unsigned threadIndex)
+    {
+        while (true)
+        {
+            const unsigned chunkIndex(nextChunkIndex++);
+            if (chunkIndex >= chunkCount) return;
+            const unsigned beginIndex(chunkIndex*chunkSize);
+            const unsigned endIndex(std::min(itemCount, beginIndex+chunkSize));
+            try
+            {
+                func(threadIndex, beginIndex, endIndex);
+            }
+            catch (...)
+            {
+                chunkExceptions[chunkIndex] = std::current_exception();
+            }
+        }
+    };
+
+    std::vector<std::thread> threads;
+    for (unsigned threadIndex(0); threadIndex<threadCount; ++threadIndex)
+    {
+        threads.emplace_back(runChunks, threadIndex);
+    }
+    for (std::thread& thread : threads)
+    {
+        thread.join();
+    }
+
+    for (const std::exception_ptr& chunkException : chunkExceptions)
+    {
+        if (chunkException) std::rethrow_exception(chunkException);
+    }
+}
 
 
 
@@ -1089,15 +1147,51 @@ mergeNodePtr(NodeAddressType fromPtr,
 
 void
 SVLocusSet::
-clean()
+clean(const unsigned threadCount)
 {
-    for (SVLocus& locus : _loci)
+    if (threadCount < 2)
     {
-        if (locus.empty()) continue;
-        _totalCleaned += locus.clean(getMinMergeEdgeCount(), this);
+        for (SVLocus& locus : _loci)
+        {
+            if (locus.empty()) continue;
+            _totalCleaned += locus.clean(getMinMergeEdgeCount(), this);
 
-        // if true, this locus is newly empty after cleaning:
-        if (locus.empty()) _emptyLoci.insert(locus.getIndex());
+            // if true, this locus is newly empty after cleaning:
+            if (locus.empty()) _emptyLoci.insert(locus.getIndex());
+        }
+    }
+    else
+    {
+        // Loci are cleaned without node index updates, which are not thread-safe. The index is rebuilt afterwards:
+        std::vector<unsigned> threadTotalCleaned(threadCount,0);
+        runParallelChunks(_loci.size(), threadCount,
+                          [&](const unsigned threadIndex, const unsigned beginIndex, const unsigned endIndex)
+        {
+            for (unsigned locusIndex(beginIndex); locusIndex<endIndex; ++locusIndex)
+            {
+                SVLocus& locus(_loci[locusIndex]);
+                if (locus.empty()) continue;
+                threadTotalCleaned[threadIndex] += locus.clean(getMinMergeEdgeCount(), nullptr);
+            }
+        });
+
+        for (const unsigned totalCleaned : threadTotalCleaned)
+        {
+            _totalCleaned += totalCleaned;
+        }
+
+        if (_isIndexed)
+        {
+            reconstructIndex();
+        }
+        else
+        {
+            const unsigned locusCount(_loci.size());
+            for (LocusIndexType locusIndex(0); locusIndex<locusCount; ++locusIndex)
+            {
+                if (_loci[locusIndex].empty()) _emptyLoci.insert(locusIndex);
+            }
+        }
     }
 #ifdef DEBUG_SVL
     checkForOverlapNodes(true);
@@ -1267,70 +1361,105 @@ dumpStats(
 }
 
 
+static const char locusStatsSep('\t');
+
+
+
+static
 void
-SVLocusSet::
-dumpLocusStats(std::ostream& os) const
+writeLocusStatsHeader(std::ostream& os)
 {
-    static const char sep('\t');
-
     os << "locusIndex"
-       << sep << "nodeCount"
-       << sep << "nodeObsCount"
-       << sep << "maxNodeObsCount"
-       << sep << "regionSize"
-       << sep << "maxRegionSize"
-       << sep << "edgeCount"
-       << sep << "maxEdgeCount"
-       << sep << "edgeObsCount"
-       << sep << "maxEdgeObsCount"
+       << locusStatsSep << "nodeCount"
+       << locusStatsSep << "nodeObsCount"
+       << locusStatsSep << "maxNodeObsCount"
+       << locusStatsSep << "regionSize"
+       << locusStatsSep << "maxRegionSize"
+       << locusStatsSep << "edgeCount"
+       << locusStatsSep << "maxEdgeCount"
+       << locusStatsSep << "edgeObsCount"
+       << locusStatsSep << "maxEdgeObsCount"
        << '\n';
+}
 
-    LocusIndexType locusIndex(0);
-    for (const SVLocus& locus : _loci)
+
+
+static
+void
+writeLocusStats(
+    std::ostream& os,
+    const LocusIndexType locusIndex,
+    const SVLocus& locus)
+{
+    unsigned locusNodeObsCount(0), maxNodeObsCount(0);
+    unsigned locusRegionSize(0), maxRegionSize(0);
+    unsigned locusEdgeCount(0), maxEdgeCount(0), locusEdgeObsCount(0), maxEdgeObsCount(0);
+    for (const SVLocusNode& node : locus)
     {
-        unsigned locusNodeObsCount(0), maxNodeObsCount(0);
-        unsigned locusRegionSize(0), maxRegionSize(0);
-        unsigned locusEdgeCount(0), maxEdgeCount(0), locusEdgeObsCount(0), maxEdgeObsCount(0);
-        for (const SVLocusNode& node : locus)
+        // nodes:
+        const unsigned nodeObsCount(node.outCount());
+        maxNodeObsCount = std::max(maxNodeObsCount,nodeObsCount);
+        locusNodeObsCount += nodeObsCount;
+
+        // regions:
+        const unsigned regionSize(node.getInterval().range.size());
+        maxRegionSize = std::max(maxRegionSize,regionSize);
+        locusRegionSize += regionSize;
+
+        // edges:
+        maxEdgeCount = std::max(maxEdgeCount,node.size());
+        locusEdgeCount += node.size();
+        const SVLocusEdgeManager edgeMap(node.getEdgeManager());
+        for (const SVLocusEdgesType::value_type& edge : edgeMap.getMap())
         {
-            // nodes:
-            const unsigned nodeObsCount(node.outCount());
-            maxNodeObsCount = std::max(maxNodeObsCount,nodeObsCount);
-            locusNodeObsCount += nodeObsCount;
-
-            // regions:
-            const unsigned regionSize(node.getInterval().range.size());
-            maxRegionSize = std::max(maxRegionSize,regionSize);
-            locusRegionSize += regionSize;
-
-            // edges:
-            maxEdgeCount = std::max(maxEdgeCount,node.size());
-            locusEdgeCount += node.size();
-            const SVLocusEdgeManager edgeMap(node.getEdgeManager());
-            for (const SVLocusEdgesType::value_type& edge : edgeMap.getMap())
-            {
-                const unsigned edgeObsCount(edge.second.getCount());
-                maxEdgeObsCount = std::max(maxEdgeObsCount,edgeObsCount);
-                locusEdgeObsCount += edgeObsCount;
-            }
+            const unsigned edgeObsCount(edge.second.getCount());
+            maxEdgeObsCount = std::max(maxEdgeObsCount,edgeObsCount);
+            locusEdgeObsCount += edgeObsCount;
         }
-        os << locusIndex
-           << sep << locus.size()
-           << sep << locusNodeObsCount
-           << sep << maxNodeObsCount
-           << sep << locusRegionSize
-           << sep << maxRegionSize
-           << sep << locusEdgeCount
-           << sep << maxEdgeCount
-           << sep << locusEdgeObsCount
-           << sep << maxEdgeObsCount
-           << "\n";
+    }
+    os << locusIndex
+       << locusStatsSep << locus.size()
+       << locusStatsSep << locusNodeObsCount
+       << locusStatsSep << maxNodeObsCount
+       << locusStatsSep << locusRegionSize
+       << locusStatsSep << maxRegionSize
+       << locusStatsSep << locusEdgeCount
+       << locusStatsSep << maxEdgeCount
+       << locusStatsSep << locusEdgeObsCount
+       << locusStatsSep << maxEdgeObsCount
+       << "\n";
+}
+
+
+
+void
+SVLocusSet::
+dumpLocusStats(std::ostream& os) const
+{
+    writeLocusStatsHeader(os);
+
+    LocusIndexType locusIndex(0);
+    for (const SVLocus& locus : _loci)
+    {
+        writeLocusStats(os, locusIndex, locus);
         locusIndex++;
     }
 }
 
 
 
+void
+SVLocusSet::
+dumpLocusStats(
+    std::ostream& os,
+    const LocusIndexType locusIndex) const
+{
+    writeLocusStatsHeader(os);
+    writeLocusStats(os, locusIndex, getLocus(locusIndex));
+}
+
+
+
 void
 SVLocusSet::
 save(const char* filename) const
@@ -1433,6 +1562,29 @@ load(
 
 
 
+void
+SVLocusSet::
+removeEmptyLoci()
+{
+    LocusIndexType nextLocusIndex(0);
+    const unsigned locusCount(_loci.size());
+    for (LocusIndexType locusIndex(0); locusIndex<locusCount; ++locusIndex)
+    {
+        if (_loci[locusIndex].empty()) continue;
+        if (locusIndex != nextLocusIndex)
+        {
+            _loci[nextLocusIndex] = _loci[locusIndex];
+            _loci[nextLocusIndex].updateIndex(nextLocusIndex);
+        }
+        nextLocusIndex++;
+    }
+    _loci.erase(_loci.begin()+nextLocusIndex, _loci.end());
+
+    reconstructIndex();
+}
+
+
+
 void
 SVLocusSet::
 reconstructIndex()
@@ -1446,6 +1598,10 @@ reconstructIndex()
     log_os << "reconstructIndex cleared\n";
 #endif
 
+    // the index is built in bulk from a sorted node list, which is much faster than inserting nodes in locus order:
+    std::vector<NodeAddressType> nodeAddresses;
+    nodeAddresses.reserve(totalNodeCount());
+
     LocusIndexType locusIndex(0);
     for (SVLocus& locus : _loci)
     {
@@ -1453,13 +1609,19 @@ reconstructIndex()
         for (NodeIndexType nodeIndex(0); nodeIndex<nodeCount; ++nodeIndex)
         {
             const NodeAddressType addy(std::make_pair(locusIndex,nodeIndex));
-            _inodes.data().insert(addy);
+            nodeAddresses.push_back(addy);
             updateMaxRegionSize(getNode(addy).getInterval());
         }
         if (locus.empty()) _emptyLoci.insert(locusIndex);
         locusIndex++;
     }
 
+    std::sort(nodeAddresses.begin(), nodeAddresses.end(), NodeAddressSorter(*this));
+    for (const NodeAddressType& addy : nodeAddresses)
+    {
+        _inodes.data().insert(_inodes.data().end(), addy);
+    }
+
     _isIndexed=true;
 
 #ifdef DEBUG_SVL
@@ -1485,55 +1647,87 @@ dumpIndex(std::ostream& os) const
 #endif
 
 
-void
+unsigned
 SVLocusSet::
-checkState(
-    const bool isCheckOverlap,
+checkLocusState(
+    const LocusIndexType locusIndex,
     const bool isCheckLocusConnected) const
 {
     using namespace illumina::common;
 
-    assert(_isIndexed);
+    const SVLocus& locus(getLocus(locusIndex));
+    locus.checkState(isCheckLocusConnected);
 
-    unsigned locusIndex(0);
-    unsigned checkStateTotalNodeCount(0);
-    for (const SVLocus& locus : _loci)
-    {
-        locus.checkState(isCheckLocusConnected);
+    const unsigned nodeCount(locus.size());
 
-        const unsigned nodeCount(locus.size());
-        checkStateTotalNodeCount += nodeCount;
+    if (nodeCount == 0)
+    {
+        if (_emptyLoci.count(locusIndex) == 0)
+        {
+            std::ostringstream oss;
+            oss << "ERROR: empty locus is not updated in the empty index. Locus index: " << locusIndex << "\n";
+            BOOST_THROW_EXCEPTION(LogicException(oss.str()));
+        }
+    }
 
-        if (nodeCount == 0)
+    for (NodeIndexType nodeIndex(0); nodeIndex<nodeCount; ++nodeIndex)
+    {
+        LocusSetIndexerType::const_iterator citer(_inodes.data().find(std::make_pair(locusIndex,nodeIndex)));
+        if (citer == _inodes.data().end())
         {
-            if (_emptyLoci.count(locusIndex) == 0)
-            {
-                std::ostringstream oss;
-                oss << "ERROR: empty locus is not updated in the empty index. Locus index: " << locusIndex << "\n";
-                BOOST_THROW_EXCEPTION(LogicException(oss.str()));
-            }
+            std::ostringstream oss;
+            oss << "ERROR: locus node is missing from node index\n"
+                << "\tNode index: " << locusIndex << " node: " << getNode(std::make_pair(locusIndex,nodeIndex));
+            BOOST_THROW_EXCEPTION(LogicException(oss.str()));
+        }
+        if ((citer->first != locusIndex) || (citer->second != nodeIndex))
+        {
+            std::ostringstream oss;
+            oss << "ERROR: locus node has conflicting index number in node index\n"
+                << "\tinode index_value: " << citer->first << ":" << citer->second << "\n"
+                << "\tNode index: " << locusIndex << ":" << locusIndex << " node: " << getNode(std::make_pair(locusIndex,nodeIndex));
+            BOOST_THROW_EXCEPTION(LogicException(oss.str()));
         }
+    }
+    return nodeCount;
+}
 
-        for (NodeIndexType nodeIndex(0); nodeIndex<nodeCount; ++nodeIndex)
+
+
+void
+SVLocusSet::
+checkState(
+    const bool isCheckOverlap,
+    const bool isCheckLocusConnected,
+    const unsigned threadCount) const
+{
+    assert(_isIndexed);
+
+    const unsigned locusCount(_loci.size());
+    unsigned checkStateTotalNodeCount(0);
+    if (threadCount < 2)
+    {
+        for (LocusIndexType locusIndex(0); locusIndex<locusCount; ++locusIndex)
         {
-            LocusSetIndexerType::const_iterator citer(_inodes.data().find(std::make_pair(locusIndex,nodeIndex)));
-            if (citer == _inodes.data().end())
-            {
-                std::ostringstream oss;
-                oss << "ERROR: locus node is missing from node index\n"
-                    << "\tNode index: " << locusIndex << " node: " << getNode(std::make_pair(locusIndex,nodeIndex));
-                BOOST_THROW_EXCEPTION(LogicException(oss.str()));
-            }
-            if ((citer->first != locusIndex) || (citer->second != nodeIndex))
+            checkStateTotalNodeCount += checkLocusState(locusIndex, isCheckLocusConnected);
+        }
+    }
+    else
+    {
+        std::vector<unsigned> threadTotalNodeCount(threadCount,0);
+        runParallelChunks(locusCount, threadCount,
+                          [&](const unsigned threadIndex, const unsigned beginIndex, const unsigned endIndex)
+        {
+            for (LocusIndexType locusIndex(beginIndex); locusIndex<endIndex; ++locusIndex)
             {
-                std::ostringstream oss;
-                oss << "ERROR: locus node has conflicting index number in node index\n"
-                    << "\tinode index_value: " << citer->first << ":" << citer->second << "\n"
-                    << "\tNode index: " << locusIndex << ":" << locusIndex << " node: " << getNode(std::make_pair(locusIndex,nodeIndex));
-                BOOST_THROW_EXCEPTION(LogicException(oss.str()));
+                threadTotalNodeCount[threadIndex] += checkLocusState(locusIndex, isCheckLocusConnected);
             }
+        });
+
+        for (const unsigned totalNodeCount : threadTotalNodeCount)
+        {
+            checkStateTotalNodeCount += totalNodeCount;
         }
-        locusIndex++;
     }
 
     if (checkStateTotalNodeCount != _inodes.data().size())
@@ -185,21 +185,32 @@ struct SVLocusSet : public flyweight_observer<SVLocusNodeMoveMessage>
     }
 
     /// Indicate that the set is complete
+    ///
+    /// \param[in] threadCount Number of threads used to clean the set, see clean()
     void
-    finalize()
+    finalize(const unsigned threadCount = 1)
     {
-        clean();
+        clean(threadCount);
         _isFinalized=true;
     }
 
     /// Remove all existing edges with less than minMergeEdgeCount support:
+    ///
+    /// \param[in] threadCount If 2 or more, loci are cleaned in parallel on this many threads, and the node index is
+    ///                        rebuilt after all loci are cleaned. The cleaned set is the same for any thread count.
     void
-    clean();
+    clean(const unsigned threadCount = 1);
 
     /// Remove all existing edges with less than minMergeEdgeCount
     void
     cleanRegion(const GenomeInterval interval);
 
+    /// Remove all empty loci and renumber the remaining loci in their existing order
+    ///
+    /// This provides the same locus indices as a graph which has been saved and loaded again.
+    void
+    removeEmptyLoci();
+
     /// Return the number of nodes that have been removed from Locus objects by the clean and cleanRegion operations
     unsigned
     totalCleaned() const
@@ -237,6 +248,12 @@ struct SVLocusSet : public flyweight_observer<SVLocusNodeMoveMessage>
     void
     dumpLocusStats(std::ostream& os) const;
 
+    /// Debug stats on one locus in tsv format, with the same header as the all-locus version.
+    void
+    dumpLocusStats(
+        std::ostream& os,
+        const LocusIndexType locusIndex) const;
+
     /// Return a debug string of the source of the SVLocusSet.
     const std::string&
     getSource() const
@@ -321,10 +338,14 @@ struct SVLocusSet : public flyweight_observer<SVLocusNodeMoveMessage>
 
     /// Check that internal data-structures are in
     /// a consistent state, throw on error
+    ///
+    /// \param[in] threadCount If 2 or more, loci are checked in parallel on this many threads. If more than one locus
+    ///                        fails the check, the error from the lowest failing locus index is thrown.
     void
     checkState(
         const bool isCheckOverlap = false,
-        const bool isCheckLocusConnected = false) const;
+        const bool isCheckLocusConnected = false,
+        const unsigned threadCount = 1) const;
 
     /// Updater gets direct access to read counts:
     AllCounts&
@@ -682,6 +703,14 @@ private:
     void
     reconstructIndex();
 
+    /// Check the state of one locus and its node index entries, throw on error
+    ///
+    /// \return The locus node count
+    unsigned
+    checkLocusState(
+        const LocusIndexType locusIndex,
+        const bool isCheckLocusConnected) const;
+
     void
     clearIndex()
     {
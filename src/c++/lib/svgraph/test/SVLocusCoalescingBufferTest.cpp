@@ -0,0 +1,138 @@
+//
+// Manta - Structural Variant and Indel Caller
+// Copyright (c) 2013-2017 Illumina, Inc.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+//
+
+#include "boost/test/unit_test.hpp"
+
+#include "svgraph/SVLocusCoalescingBuffer.hh"
+
+#include "SVLocusTestUtil.hh"
+
+
+BOOST_AUTO_TEST_SUITE( test_SVLocusCoalescingBuffer )
+
+
+// Test that overlapping two-node loci are summed into a single locus before the graph merge
+BOOST_AUTO_TEST_CASE( test_CoalesceOverlappingPairs )
+{
+    SVLocus locus1;
+    locusAddPair(locus1,1,10,20,2,30,40,false,3);
+    SVLocus locus2;
+    locusAddPair(locus2,1,15,25,2,35,45,false,3);
+
+    SVLocusCoalescingBuffer buffer;
+    buffer.add(10,locus1);
+    buffer.add(15,locus2);
+    BOOST_REQUIRE_EQUAL(buffer.size(),1u);
+
+    SVLocusSetOptions sopt;
+    sopt.minMergeEdgeObservations = 1;
+    SVLocusSet set1(sopt);
+    buffer.flush(set1);
+    BOOST_REQUIRE(buffer.empty());
+    BOOST_REQUIRE_EQUAL(buffer.inputCount(),2u);
+    BOOST_REQUIRE_EQUAL(buffer.outputCount(),1u);
+
+    TestSVLocusSetProperties(set1,1,1,2,2);
+    const SVLocus& locus(static_cast<const SVLocusSet&>(set1).getLocus(0));
+    BOOST_REQUIRE_EQUAL(locus.getNode(0).getInterval(),GenomeInterval(1,10,25));
+    BOOST_REQUIRE_EQUAL(locus.getNode(1).getInterval(),GenomeInterval(2,30,45));
+    BOOST_REQUIRE_EQUAL(locus.getEdge(0,1).getCount(),6u);
+    BOOST_REQUIRE_EQUAL(locus.getEdge(1,0).getCount(),0u);
+
+    // the remote node has no evidence count, so its evidence range is merged, while the local
+    // node evidence range combines the evidence from both inputs:
+    BOOST_REQUIRE_EQUAL(locus.getNode(0).getEvidenceRange(),known_pos_range2(10,25));
+}
+
+
+// Test that loci with a different shape or non-overlapping nodes are not coalesced
+BOOST_AUTO_TEST_CASE( test_NoCoalesce )
+{
+    SVLocus locus1;
+    locusAddPair(locus1,1,10,20,2,30,40);
+
+    // remote node does not intersect:
+    SVLocus locus2;
+    locusAddPair(locus2,1,15,25,2,50,60);
+
+    // single node with self-edge:
+    SVLocus locus3;
+    {
+        const NodeIndexType nodeIndex(locus3.addNode(GenomeInterval(1,10,20)));
+        locus3.linkNodes(nodeIndex,nodeIndex);
+    }
+
+    // coalesced nodes would overlap each other:
+    SVLocus locus4;
+    locusAddPair(locus4,2,15,35,1,15,25);
+
+    SVLocusCoalescingBuffer buffer;
+    buffer.add(10,locus1);
+    buffer.add(15,locus2);
+    buffer.add(15,locus3);
+    buffer.add(15,locus4);
+    BOOST_REQUIRE_EQUAL(buffer.size(),4u);
+}
+
+
+// Test that single-node loci with self-edges are coalesced
+BOOST_AUTO_TEST_CASE( test_CoalesceSelfEdge )
+{
+    SVLocusCoalescingBuffer buffer;
+    for (pos_t pos(10); pos<20; ++pos)
+    {
+        SVLocus locus;
+        const NodeIndexType nodeIndex(locus.addNode(GenomeInterval(1,pos,pos+10)));
+        locus.linkNodes(nodeIndex,nodeIndex);
+        buffer.add(pos,locus);
+    }
+    BOOST_REQUIRE_EQUAL(buffer.size(),1u);
+
+    SVLocusSet set1;
+    buffer.flush(set1);
+    TestSVLocusSetProperties(set1,1,1,1,1);
+    const SVLocus& locus(static_cast<const SVLocusSet&>(set1).getLocus(0));
+    BOOST_REQUIRE_EQUAL(locus.getNode(0).getInterval(),GenomeInterval(1,10,29));
+    BOOST_REQUIRE_EQUAL(locus.getEdge(0,0).getCount(),10u);
+}
+
+
+// Test that loci are only released up to the flush position
+BOOST_AUTO_TEST_CASE( test_FlushToPos )
+{
+    SVLocus locus1;
+    locusAddPair(locus1,1,10,20,2,30,40);
+    SVLocus locus2;
+    locusAddPair(locus2,1,100,120,2,130,140);
+
+    SVLocusCoalescingBuffer buffer;
+    buffer.add(10,locus1);
+    buffer.add(100,locus2);
+
+    SVLocusSet set1;
+    buffer.flush(99,set1);
+    BOOST_REQUIRE_EQUAL(buffer.size(),1u);
+    BOOST_REQUIRE_EQUAL(set1.size(),1u);
+
+    buffer.flush(100,set1);
+    BOOST_REQUIRE(buffer.empty());
+    BOOST_REQUIRE_EQUAL(set1.size(),2u);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
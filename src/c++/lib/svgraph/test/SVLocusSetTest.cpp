@@ -1578,5 +1578,121 @@ BOOST_AUTO_TEST_CASE( test_SVLocusSet_DumpLoci )
 
 
 
+BOOST_AUTO_TEST_CASE( test_SVLocusNoiseParallelClean )
+{
+    // create enough loci for several parallel chunks, where every third locus is below the merge threshold:
+    static const unsigned locusCount(1000);
+    std::vector<SVLocus> loci(locusCount);
+    for (unsigned locusIndex(0); locusIndex<locusCount; ++locusIndex)
+    {
+        const int32_t pos(locusIndex*100);
+        const int count((locusIndex%3) ? 2 : 1);
+        locusAddPair(loci[locusIndex],1,pos,pos+10,2,pos,pos+10,false,count);
+    }
+
+    SVLocusSetOptions sopt;
+    sopt.minMergeEdgeObservations = 2;
+    SVLocusSet serialSet(sopt);
+    SVLocusSet parallelSet(sopt);
+    for (const SVLocus& locus : loci)
+    {
+        serialSet.merge(locus);
+        parallelSet.merge(locus);
+    }
+
+    serialSet.finalize();
+    parallelSet.finalize(4);
+
+    parallelSet.checkState(true,true,4);
+    BOOST_REQUIRE(serialSet.totalCleaned() > 0);
+    BOOST_REQUIRE_EQUAL(serialSet.totalCleaned(), parallelSet.totalCleaned());
+    BOOST_REQUIRE_EQUAL(serialSet.nonEmptySize(), parallelSet.nonEmptySize());
+    BOOST_REQUIRE_EQUAL(serialSet.totalNodeCount(), parallelSet.totalNodeCount());
+
+    std::ostringstream serialDump, parallelDump;
+    serialSet.dump(serialDump);
+    parallelSet.dump(parallelDump);
+    BOOST_REQUIRE_EQUAL(serialDump.str(), parallelDump.str());
+
+    // the rebuilt index must support region queries:
+    std::ostringstream serialRegionDump, parallelRegionDump;
+    serialSet.dumpRegion(serialRegionDump, GenomeInterval(1,1000,50000));
+    parallelSet.dumpRegion(parallelRegionDump, GenomeInterval(1,1000,50000));
+    BOOST_REQUIRE_EQUAL(serialRegionDump.str(), parallelRegionDump.str());
+}
+
+
+BOOST_AUTO_TEST_CASE( test_SVLocusSet_RemoveEmptyLoci )
+{
+    // every third locus is below the merge threshold and is emptied when the set is finalized:
+    static const unsigned locusCount(30);
+    SVLocusSetOptions sopt;
+    sopt.minMergeEdgeObservations = 2;
+    SVLocusSet set1(sopt);
+    for (unsigned locusIndex(0); locusIndex<locusCount; ++locusIndex)
+    {
+        SVLocus locus;
+        const int32_t pos(locusIndex*100);
+        const int count((locusIndex%3) ? 2 : 1);
+        locusAddPair(locus,1,pos,pos+10,2,pos,pos+10,false,count);
+        set1.merge(locus);
+    }
+    set1.finalize();
+    BOOST_REQUIRE(set1.nonEmptySize() < set1.size());
+
+    const char* testSaveLoadFileName = "testRemoveEmptyLoci.bin";
+    set1.save(testSaveLoadFileName);
+    SVLocusSet loadedSet(sopt);
+    loadedSet.load(testSaveLoadFileName);
+    std::remove(testSaveLoadFileName);
+
+    set1.removeEmptyLoci();
+    set1.checkState(true,true);
+    BOOST_REQUIRE_EQUAL(set1.size(), set1.nonEmptySize());
+    BOOST_REQUIRE_EQUAL(set1.size(), loadedSet.size());
+
+    std::ostringstream dump, loadedDump;
+    set1.dump(dump);
+    loadedSet.dump(loadedDump);
+    BOOST_REQUIRE_EQUAL(dump.str(), loadedDump.str());
+}
+
+
+BOOST_AUTO_TEST_CASE( test_SVLocusSet_DumpSingleLocusStats )
+{
+    SVLocus locus1;
+    locusAddPair(locus1,1,10,20,2,30,40);
+    SVLocus locus2;
+    locusAddPair(locus2,3,10,20,4,30,40);
+    SVLocus locus3;
+    locusAddPair(locus3,3,100,200,5,30,40,true,3);
+
+    SVLocusSetOptions sopt;
+    sopt.minMergeEdgeObservations = 1;
+    SVLocusSet set1(sopt);
+    set1.merge(locus1);
+    set1.merge(locus2);
+    set1.merge(locus3);
+
+    std::ostringstream allStats;
+    set1.dumpLocusStats(allStats);
+    std::vector<std::string> allLines;
+    {
+        std::istringstream iss(allStats.str());
+        std::string line;
+        while (std::getline(iss,line)) allLines.push_back(line);
+    }
+    BOOST_REQUIRE_EQUAL(allLines.size(), (set1.size()+1));
+
+    // single locus stats should match the header and corresponding line from the all locus output:
+    for (LocusIndexType locusIndex(0); locusIndex<set1.size(); ++locusIndex)
+    {
+        std::ostringstream locusStats;
+        set1.dumpLocusStats(locusStats, locusIndex);
+        BOOST_REQUIRE_EQUAL(locusStats.str(), (allLines[0] + "\n" + allLines[locusIndex+1] + "\n"));
+    }
+}
+
+
 BOOST_AUTO_TEST_SUITE_END()
 
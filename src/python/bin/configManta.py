@@ -60,6 +60,10 @@ You must specify a BAM or CRAM file for at least one sample.
                          help="Set options for RNA-Seq input. Must specify exactly one bam input file")
         group.add_option("--unstrandedRNA", dest="isUnstrandedRNA", action="store_true",
                          help="Set if RNA-Seq input is unstranded: Allows splice-junctions on either strand")
+        group.add_option("--spliceJunctionAnnotation", type="string", dest="spliceJunctionAnnotation", metavar="FILE",
+                         help="Transcript annotation in GTF or BED12 format. In RNA mode, SV evidence fully explained "
+                              "by splicing between annotated exons is discarded before locus graph and candidate "
+                              "generation. [optional] (no default)")
         group.add_option("--outputContig", dest="isOutputContig", action="store_true",
                          help="Output assembled contig sequences in VCF file")
 
@@ -83,6 +87,25 @@ You must specify a BAM or CRAM file for at least one sample.
         group.add_option("--generateEvidenceBam",
                          dest="isGenerateSupportBam", action="store_true",
                          help="Generate a bam of supporting reads for all SVs")
+        group.add_option("--useEvidenceIndex",
+                         dest="isEvidenceIndex", action="store_true",
+                         help="Index SV evidence read positions during locus graph construction, and use this "
+                              "index to skip alignment regions without evidence during candidate generation")
+        group.add_option("--usePackedReference",
+                         dest="isPackedReference", action="store_true",
+                         help="Build a 2-bit packed reference image once at the start of the workflow, and share it "
+                              "read-only between all locus graph and candidate generation tasks in place of the "
+                              "reference fasta")
+        group.add_option("--useDepthMap",
+                         dest="isDepthMap", action="store_true",
+                         help="Map read depth during locus graph construction, and use this map to find high depth "
+                              "regions and breakend depth during candidate generation and scoring, in place of "
+                              "alignment scans")
+        group.add_option("--runCacheDir",
+                         dest="runCacheDir", metavar="DIR",
+                         help="Reuse alignment statistics and chromosome depth cached in this directory by earlier "
+                              "runs on the same alignment files, and add new results to the cache. "
+                              "(default: %default)")
 
         MantaWorkflowOptionsBase.addExtendedGroupOptions(self,group)
 
@@ -100,6 +123,9 @@ You must specify a BAM or CRAM file for at least one sample.
             'useExistingChromDepths' : False,
             'isRetainTempFiles' : False,
             'isGenerateSupportBam' : False,
+            'isEvidenceIndex' : False,
+            'isPackedReference' : False,
+            'isDepthMap' : False,
             'nonlocalWorkBins' : 256
                           })
         return defaults
@@ -130,10 +156,18 @@ You must specify a BAM or CRAM file for at least one sample.
         else :
             if options.isUnstrandedRNA :
                 raise OptParseException("Unstranded only applied for RNA inputs")
+            if options.spliceJunctionAnnotation is not None :
+                raise OptParseException("Splice junction annotation only applied for RNA inputs")
+
+        if options.spliceJunctionAnnotation is not None :
+            options.spliceJunctionAnnotation=validateFixExistingFileArg(options.spliceJunctionAnnotation,"splice junction annotation")
 
         if options.existingAlignStatsFile is not None :
             options.existingAlignStatsFile=validateFixExistingFileArg(options.existingAlignStatsFile,"existing align stats")
 
+        if options.runCacheDir :
+            options.runCacheDir=os.path.abspath(options.runCacheDir)
+
         groomBamList(options.normalBamList,"normal sample")
         groomBamList(options.tumorBamList, "tumor sample")
 
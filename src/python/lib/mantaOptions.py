@@ -93,18 +93,19 @@ class MantaWorkflowOptionsBase(ConfigureWorkflowOptions) :
         mantaStatsBin=joinFile(libexecDir,exeFile("GetAlignmentStats"))
         mantaMergeStatsBin=joinFile(libexecDir,exeFile("MergeAlignmentStats"))
         getChromDepthBin=joinFile(libexecDir,exeFile("GetChromDepth"))
+        getGenomeSegmentsBin=joinFile(libexecDir,exeFile("GetGenomeSegments"))
+        buildPackedReferenceBin=joinFile(libexecDir,exeFile("BuildPackedReference"))
         mantaGraphBin=joinFile(libexecDir,exeFile("EstimateSVLoci"))
         mantaGraphMergeBin=joinFile(libexecDir,exeFile("MergeSVLoci"))
         mantaStatsMergeBin=joinFile(libexecDir,exeFile("MergeEdgeStats"))
         mantaGraphCheckBin=joinFile(libexecDir,exeFile("CheckSVLoci"))
         mantaHyGenBin=joinFile(libexecDir,exeFile("GenerateSVCandidates"))
         mantaGraphStatsBin=joinFile(libexecDir,exeFile("SummarizeSVLoci"))
+        mantaPostProcessBin=joinFile(libexecDir,exeFile("PostProcessSVCalls"))
         mantaStatsSummaryBin=joinFile(libexecDir,exeFile("SummarizeAlignmentStats"))
 
         mergeChromDepth=joinFile(libexecDir,"mergeChromDepth.py")
         mantaSortVcf=joinFile(libexecDir,"sortVcf.py")
-        mantaExtraSmallVcf=joinFile(libexecDir,"extractSmallIndelCandidates.py")
-        mantaPloidyFilter=joinFile(libexecDir,"ploidyFilter.py")
         mantaSortEdgeLogs=joinFile(libexecDir,"sortEdgeLogs.py")
         catScript=joinFile(libexecDir,"cat.py")
         vcfCmdlineSwapper=joinFile(libexecDir,"vcfCmdlineSwapper.py")
@@ -35,12 +35,13 @@ pyflowDir=os.path.join(scriptDir,"pyflow")
 sys.path.append(os.path.abspath(pyflowDir))
 
 from configBuildTimeInfo import workflowVersion
+from configureUtil import safeSetBool
 from pyflow import WorkflowRunner
 from sharedWorkflow import getMkdirCmd, getMvCmd, getRmCmd, getRmdirCmd, \
                            getDepthFromAlignments
 from workflowUtil import checkFile, ensureDir, preJoin, \
                         getGenomeSegmentGroups, getFastaChromOrderSize, \
-                        getCallRegions, cleanPyEnv
+                        getCallRegions, getScanRegions, cleanPyEnv
 
 
 __version__ = workflowVersion
@@ -84,6 +85,8 @@ def runStats(self,taskPrefix="",dependencies=None) :
         cmd.extend(["--ref", self.params.referenceFasta])
         cmd.extend(["--output-file",tmpStatsFiles[-1]])
         cmd.extend(["--align-file",bamPath])
+        if self.params.runCacheDir :
+            cmd.extend(["--cache-dir",self.params.runCacheDir])
 
         statsTasks.add(self.addTask(preJoin(taskPrefix,"generateStats_"+indexStr),cmd,dependencies=dirTask))
 
@@ -105,6 +108,19 @@ def runStats(self,taskPrefix="",dependencies=None) :
 
 
 
+def buildPackedReference(self,taskPrefix="",dependencies=None):
+    """
+    Write the 2-bit packed reference image shared by all locus graph and candidate generation tasks
+    """
+
+    cmd = [ self.params.buildPackedReferenceBin ]
+    cmd.extend(["--ref", self.params.referenceFasta])
+    cmd.extend(["--output-file", self.paths.getPackedReferencePath()])
+    packTask = self.addTask(preJoin(taskPrefix,"buildPackedReference"),cmd,dependencies=dependencies)
+    return set([packTask])
+
+
+
 def mantaGetDepthFromAlignments(self,taskPrefix="getChromDepth",dependencies=None):
     bamList=[]
     if len(self.params.normalBamList) :
@@ -119,12 +135,92 @@ def mantaGetDepthFromAlignments(self,taskPrefix="getChromDepth",dependencies=Non
 
 
 
+class locusGraphSegmentsWorkflow(WorkflowRunner) :
+    """
+    creates an SV locus graph for each genome segment group, and the list files enumerating these graphs
+    as input to the merge step
+
+    This is run as a sub-workflow so that the segments can be read from a segment file created earlier in the
+    workflow.
+    """
+
+    def __init__(self2, params, paths, segmentFile) :
+        self2.params = params
+        self2.paths = paths
+        self2.segmentFile = segmentFile
+
+    def workflow(self2) :
+        statsPath=self2.paths.getStatsPath()
+
+        tmpGraphFiles = []
+        tmpEvidenceIndexFiles = []
+        tmpDepthMapFiles = []
+        graphTasks = set()
+
+        for gsegGroup in getGenomeSegmentGroups(self2.params, segmentFile=self2.segmentFile) :
+            assert(len(gsegGroup) != 0)
+            gid=gsegGroup[0].id
+            if len(gsegGroup) > 1 :
+                gid += "_to_"+gsegGroup[-1].id
+            tmpGraphFiles.append(self2.paths.getTmpGraphFile(gid))
+            graphCmd = [ self2.params.mantaGraphBin ]
+            graphCmd.extend(["--output-file", tmpGraphFiles[-1]])
+            if self2.params.isEvidenceIndex :
+                tmpEvidenceIndexFiles.append(self2.paths.getTmpEvidenceIndexFile(gid))
+                graphCmd.extend(["--evidence-index-output", tmpEvidenceIndexFiles[-1]])
+            if self2.params.isDepthMap :
+                tmpDepthMapFiles.append(self2.paths.getTmpDepthMapFile(gid))
+                graphCmd.extend(["--depth-map-output", tmpDepthMapFiles[-1]])
+            graphCmd.extend(["--align-stats",statsPath])
+            for gseg in gsegGroup :
+                graphCmd.extend(["--region",gseg.bamRegion])
+            graphCmd.extend(["--min-candidate-sv-size", self2.params.minCandidateVariantSize])
+            graphCmd.extend(["--min-edge-observations", self2.params.minEdgeObservations])
+            graphCmd.extend(["--ref",self2.params.referenceFasta])
+            if self2.params.isPackedReference :
+                graphCmd.extend(["--packed-ref",self2.paths.getPackedReferencePath()])
+            for bamPath in self2.params.normalBamList :
+                graphCmd.extend(["--align-file",bamPath])
+            for bamPath in self2.params.tumorBamList :
+                graphCmd.extend(["--tumor-align-file",bamPath])
+
+            if self2.params.isHighDepthFilter :
+                graphCmd.extend(["--chrom-depth", self2.paths.getChromDepth()])
+
+            if self2.params.isIgnoreAnomProperPair :
+                graphCmd.append("--ignore-anom-proper-pair")
+            if self2.params.isRNA :
+                graphCmd.append("--rna")
+                if self2.params.spliceJunctionAnnotation is not None :
+                    graphCmd.extend(["--splice-junction-annotation", self2.params.spliceJunctionAnnotation])
+
+            graphTask="makeLocusGraph_"+gid
+            graphTasks.add(self2.addTask(graphTask,graphCmd,memMb=self2.params.estimateMemMb))
+
+        if len(tmpGraphFiles) == 0 :
+            raise Exception("No SV Locus graphs to create. Possible target region parse error.")
+
+        self2.addWorkflowTask("mergeLocusGraphInputList",
+                              listFileWorkflow(self2.paths.getTmpGraphFileListPath(),tmpGraphFiles),
+                              dependencies=graphTasks)
+
+        if self2.params.isEvidenceIndex :
+            self2.addWorkflowTask("mergeEvidenceIndexInputList",
+                                  listFileWorkflow(self2.paths.getTmpEvidenceIndexFileListPath(),tmpEvidenceIndexFiles),
+                                  dependencies=graphTasks)
+
+        if self2.params.isDepthMap :
+            self2.addWorkflowTask("mergeDepthMapInputList",
+                                  listFileWorkflow(self2.paths.getTmpDepthMapFileListPath(),tmpDepthMapFiles),
+                                  dependencies=graphTasks)
+
+
+
 def runLocusGraph(self,taskPrefix="",dependencies=None):
     """
     Create the full SV locus graph
     """
 
-    statsPath=self.paths.getStatsPath()
     graphPath=self.paths.getGraphPath()
     graphStatsPath=self.paths.getGraphStatsPath()
 
@@ -135,57 +231,57 @@ def runLocusGraph(self,taskPrefix="",dependencies=None):
     makeTmpGraphDirCmd = getMkdirCmd() + [tmpGraphDir]
     dirTask = self.addTask(preJoin(taskPrefix,"makeGraphTmpDir"), makeTmpGraphDirCmd, dependencies=dependencies, isForceLocal=True)
 
-    tmpGraphFiles = []
-    graphTasks = set()
-
-    for gsegGroup in getGenomeSegmentGroups(self.params) :
-        assert(len(gsegGroup) != 0)
-        gid=gsegGroup[0].id
-        if len(gsegGroup) > 1 :
-            gid += "_to_"+gsegGroup[-1].id
-        tmpGraphFiles.append(self.paths.getTmpGraphFile(gid))
-        graphCmd = [ self.params.mantaGraphBin ]
-        graphCmd.extend(["--output-file", tmpGraphFiles[-1]])
-        graphCmd.extend(["--align-stats",statsPath])
-        for gseg in gsegGroup :
-            graphCmd.extend(["--region",gseg.bamRegion])
-        graphCmd.extend(["--min-candidate-sv-size", self.params.minCandidateVariantSize])
-        graphCmd.extend(["--min-edge-observations", self.params.minEdgeObservations])
-        graphCmd.extend(["--ref",self.params.referenceFasta])
+    segmentFile = None
+    segmentDependencies = dirTask
+    if self.params.enableAdaptiveSegmentation :
+        segmentFile = self.paths.getGenomeSegmentsPath()
+        segmentCmd = [ self.params.getGenomeSegmentsBin ]
+        segmentCmd.extend(["--ref",self.params.referenceFasta])
+        segmentCmd.extend(["--output-file", segmentFile])
+        segmentCmd.extend(["--target-segment-size", str(self.params.scanSizeMb * 1000000)])
+        for (_, chromLabel, start, end, _) in getScanRegions(self.params) :
+            segmentCmd.extend(["--region", "%s:%i-%i" % (chromLabel, start, end)])
         for bamPath in self.params.normalBamList :
-            graphCmd.extend(["--align-file",bamPath])
+            segmentCmd.extend(["--align-file",bamPath])
         for bamPath in self.params.tumorBamList :
-            graphCmd.extend(["--tumor-align-file",bamPath])
-
+            segmentCmd.extend(["--tumor-align-file",bamPath])
         if self.params.isHighDepthFilter :
-            graphCmd.extend(["--chrom-depth", self.paths.getChromDepth()])
-
-        if self.params.isIgnoreAnomProperPair :
-            graphCmd.append("--ignore-anom-proper-pair")
-        if self.params.isRNA :
-            graphCmd.append("--rna")
-
-        graphTask=preJoin(taskPrefix,"makeLocusGraph_"+gid)
-        graphTasks.add(self.addTask(graphTask,graphCmd,dependencies=dirTask,memMb=self.params.estimateMemMb))
+            segmentCmd.extend(["--chrom-depth", self.paths.getChromDepth()])
+        segmentDependencies = self.addTask(preJoin(taskPrefix,"getGenomeSegments"), segmentCmd, dependencies=dirTask)
 
-    if len(tmpGraphFiles) == 0 :
-        raise Exception("No SV Locus graphs to create. Possible target region parse error.")
+    # the segment file is not available until the workflow is running, so all tasks which depend on the
+    # genome segmentation are added from a sub-workflow:
+    graphSegmentsTask = preJoin(taskPrefix,"makeSegmentLocusGraphs")
+    self.addWorkflowTask(graphSegmentsTask, locusGraphSegmentsWorkflow(self.params, self.paths, segmentFile), dependencies=segmentDependencies)
+    mergeDependencies = set([graphSegmentsTask])
 
-    tmpGraphFileList = self.paths.getTmpGraphFileListPath()
-    tmpGraphFileListTask = preJoin(taskPrefix,"mergeLocusGraphInputList")
-    self.addWorkflowTask(tmpGraphFileListTask,listFileWorkflow(tmpGraphFileList,tmpGraphFiles),dependencies=graphTasks)
+    graphMergeThreadCount = self.limitNCores(self.params.graphMergeThreads)
 
     mergeCmd = [ self.params.mantaGraphMergeBin ]
     mergeCmd.extend(["--output-file", graphPath])
-    mergeCmd.extend(["--graph-file-list",tmpGraphFileList])
-    mergeTask = self.addTask(preJoin(taskPrefix,"mergeLocusGraph"),mergeCmd,dependencies=tmpGraphFileListTask,memMb=self.params.mergeMemMb)
+    mergeCmd.extend(["--graph-file-list",self.paths.getTmpGraphFileListPath()])
+
+    if self.params.isEvidenceIndex :
+        mergeCmd.extend(["--evidence-index-output-file", self.paths.getEvidenceIndexPath()])
+        mergeCmd.extend(["--evidence-index-file-list",self.paths.getTmpEvidenceIndexFileListPath()])
+
+    if self.params.isDepthMap :
+        mergeCmd.extend(["--depth-map-output-file", self.paths.getDepthMapPath()])
+        mergeCmd.extend(["--depth-map-file-list",self.paths.getTmpDepthMapFileListPath()])
+
+    mergeCmd.extend(["--threads", str(graphMergeThreadCount)])
+
+    mergeTask = self.addTask(preJoin(taskPrefix,"mergeLocusGraph"),mergeCmd,dependencies=mergeDependencies,
+                             nCores=graphMergeThreadCount,memMb=self.params.mergeMemMb)
 
     # Run a separate process to rigorously check that the final graph is valid, the sv candidate generators will check as well, but
     # this makes the check much more clear:
 
     checkCmd = [ self.params.mantaGraphCheckBin ]
     checkCmd.extend(["--graph-file", graphPath])
-    checkTask = self.addTask(preJoin(taskPrefix,"checkLocusGraph"),checkCmd,dependencies=mergeTask,memMb=self.params.mergeMemMb)
+    checkCmd.extend(["--threads", str(graphMergeThreadCount)])
+    checkTask = self.addTask(preJoin(taskPrefix,"checkLocusGraph"),checkCmd,dependencies=mergeTask,
+                             nCores=graphMergeThreadCount,memMb=self.params.mergeMemMb)
 
     if not self.params.isRetainTempFiles :
         rmGraphTmpCmd = getRmdirCmd() + [tmpGraphDir]
@@ -255,16 +351,23 @@ def sortAllVcfs(self, taskPrefix="", dependencies=None) :
         if isCandidate:
             cmd += " -a"
 
-        # apply the ploidy filter to diploid variants
-        if isDiploid:
-            tempVcf = self.paths.getTempDiploidPath()
+        # apply the ploidy filter to diploid variants and extract small indels from candidates, in a single
+        # post-processing pass which also compresses and indexes the output
+        if isDiploid or isCandidate :
+            tempVcf = self.paths.getTempDiploidPath() if isDiploid else self.paths.getTempCandidatePath()
             cmd += " > \"%s\"" % (tempVcf)
-            cmd += " && \"%s\" -E \"%s\" \"%s\"" % (sys.executable, self.params.mantaPloidyFilter, tempVcf)
-
-        cmd += " | \"%s\" -c > \"%s\"" % (self.params.bgzipBin, outPath)
+            cmd += " && \"%s\" --vcf-file \"%s\" --output-file \"%s\"" % (self.params.mantaPostProcessBin, tempVcf, outPath)
+            if isDiploid:
+                cmd += " --ploidy-filter"
+            if isCandidate:
+                maxSize = int(self.params.minScoredVariantSize) - 1
+                if maxSize >= 1 :
+                    cmd += " --small-indel-output-file \"%s\"" % (self.paths.getSortedCandidateSmallIndelsPath())
+                    cmd += " --max-small-indel-size %i" % (maxSize)
+            cmd += " && " + " ".join(getRmCmd()) + " \"%s\"" % (tempVcf)
+        else :
+            cmd += " | \"%s\" -c > \"%s\"" % (self.params.bgzipBin, outPath)
 
-        if isDiploid:
-            cmd += " && " + " ".join(getRmCmd()) + " \"%s\"" % (self.paths.getTempDiploidPath())
         return cmd
 
     def getVcfTabixCmd(vcfPath) :
@@ -292,14 +395,18 @@ def sortAllVcfs(self, taskPrefix="", dependencies=None) :
         sortCmd = getVcfSortCmd(vcfListFile, outPath, isDiploid, isCandidate)
         sortTask=self.addTask(preJoin(taskPrefix,"sort_"+label),sortCmd,dependencies=inputVcfTask)
 
-        nextStepWait.add(self.addTask(preJoin(taskPrefix,"tabix_"+label),getVcfTabixCmd(outPath),dependencies=sortTask,isForceLocal=True))
+        # post-processed output is indexed in the sort task:
+        if isDiploid or isCandidate :
+            nextStepWait.add(sortTask)
+        else :
+            nextStepWait.add(self.addTask(preJoin(taskPrefix,"tabix_"+label),getVcfTabixCmd(outPath),dependencies=sortTask,isForceLocal=True))
         return sortTask
 
 
-    candSortTask = sortVcfs(self.candidateVcfPaths,
-                            self.paths.getSortedCandidatePath(),
-                            "sortCandidateSV",
-                            isCandidate=True)
+    sortVcfs(self.candidateVcfPaths,
+             self.paths.getSortedCandidatePath(),
+             "sortCandidateSV",
+             isCandidate=True)
     sortVcfs(self.diploidVcfPaths,
              self.paths.getSortedDiploidPath(),
              "sortDiploidSV",
@@ -314,21 +421,6 @@ def sortAllVcfs(self, taskPrefix="", dependencies=None) :
              self.paths.getSortedRnaPath(),
              "sortRnaSV")
 
-    def getExtractSmallCmd(maxSize, inPath, outPath) :
-        cmd  = "\"%s\" -dc \"%s\"" % (self.params.bgzipBin, inPath)
-        cmd += " | \"%s\" -E \"%s\" --maxSize %i" % (sys.executable, self.params.mantaExtraSmallVcf, maxSize)
-        cmd += " | \"%s\" -c > \"%s\"" % (self.params.bgzipBin, outPath)
-        return cmd
-
-    def extractSmall(inPath, outPath) :
-        maxSize = int(self.params.minScoredVariantSize) - 1
-        if maxSize < 1 : return
-        smallCmd = getExtractSmallCmd(maxSize, inPath, outPath)
-        smallTask=self.addTask(preJoin(taskPrefix,"extractSmallIndels"), smallCmd, dependencies=candSortTask, isForceLocal=True)
-        nextStepWait.add(self.addTask(smallTask+"_tabix", getVcfTabixCmd(outPath), dependencies=smallTask, isForceLocal=True))
-
-    extractSmall(self.paths.getSortedCandidatePath(), self.paths.getSortedCandidateSmallIndelsPath())
-
     return nextStepWait
 
 
@@ -430,7 +522,15 @@ def runHyGen(self, taskPrefix="", dependencies=None) :
         hygenCmd.extend(["--min-candidate-sv-size", self.params.minCandidateVariantSize])
         hygenCmd.extend(["--min-candidate-spanning-count", self.params.minCandidateSpanningCount])
         hygenCmd.extend(["--min-scored-sv-size", self.params.minScoredVariantSize])
+        hygenCmd.extend(["--edge-budget-seconds", self.params.edgeBudgetSeconds])
+        hygenCmd.extend(["--edge-budget-reads-retained", self.params.edgeBudgetReadsRetained])
+        hygenCmd.extend(["--edge-budget-assembly-word-lengths", self.params.edgeBudgetAssemblyWordLengths])
+        hygenCmd.extend(["--edge-budget-dp-cells", self.params.edgeBudgetDPCells])
+        hygenCmd.extend(["--cohort-scan-threads", self.params.cohortScanThreads])
+        hygenCmd.extend(["--read-ahead-edges", self.params.readAheadEdges])
         hygenCmd.extend(["--ref",self.params.referenceFasta])
+        if self.params.isPackedReference :
+            hygenCmd.extend(["--packed-ref",self.paths.getPackedReferencePath()])
         hygenCmd.extend(["--candidate-output-file", self.candidateVcfPaths[-1]])
 
         # tumor-only mode
@@ -454,6 +554,10 @@ def runHyGen(self, taskPrefix="", dependencies=None) :
 
         if self.params.isHighDepthFilter :
             hygenCmd.extend(["--chrom-depth", self.paths.getChromDepth()])
+        if self.params.isEvidenceIndex :
+            hygenCmd.extend(["--evidence-index", self.paths.getEvidenceIndexPath()])
+        if self.params.isDepthMap :
+            hygenCmd.extend(["--depth-map", self.paths.getDepthMapPath()])
 
         edgeRuntimeLogPaths.append(self.paths.getHyGenEdgeRuntimeLogPath(binStr))
         hygenCmd.extend(["--edge-runtime-log", edgeRuntimeLogPaths[-1]])
@@ -475,10 +579,15 @@ def runHyGen(self, taskPrefix="", dependencies=None) :
             hygenCmd.append("--rna")
             if self.params.isUnstrandedRNA :
                 hygenCmd.append("--unstranded")
+            if self.params.spliceJunctionAnnotation is not None :
+                hygenCmd.extend(["--splice-junction-annotation", self.params.spliceJunctionAnnotation])
 
         if self.params.isOutputContig :
             hygenCmd.append("--output-contigs")
 
+        if self.params.enableLocalityEdgeOrder :
+            hygenCmd.append("--locality-edge-order")
+
         hygenTask = preJoin(taskPrefix,"generateCandidateSV_"+binStr)
         hygenTasks.add(self.addTask(hygenTask,hygenCmd,dependencies=dirTask, memMb=hyGenMemMb))
 
@@ -574,6 +683,12 @@ class PathInfo:
     def getChromDepth(self) :
         return os.path.join(self.params.workDir,"chromDepth.txt")
 
+    def getGenomeSegmentsPath(self) :
+        return os.path.join(self.params.workDir,"genomeSegments.txt")
+
+    def getPackedReferencePath(self) :
+        return os.path.join(self.params.workDir,"referenceImage.2bit")
+
     def getGraphPath(self) :
         return os.path.join(self.params.workDir,"svLocusGraph.bin")
 
@@ -583,6 +698,18 @@ class PathInfo:
     def getTmpGraphFile(self, gid) :
         return os.path.join(self.getTmpGraphDir(),"svLocusGraph.%s.bin" % (gid))
 
+    def getEvidenceIndexPath(self) :
+        return os.path.join(self.params.workDir,"svEvidenceIndex.bin")
+
+    def getTmpEvidenceIndexFile(self, gid) :
+        return os.path.join(self.getTmpGraphDir(),"svEvidenceIndex.%s.bin" % (gid))
+
+    def getDepthMapPath(self) :
+        return os.path.join(self.params.workDir,"depthMap.bin")
+
+    def getTmpDepthMapFile(self, gid) :
+        return os.path.join(self.getTmpGraphDir(),"depthMap.%s.bin" % (gid))
+
     def getHyGenDir(self) :
         return os.path.join(self.params.workDir,"svHyGen")
 
@@ -601,6 +728,9 @@ class PathInfo:
     def getTempDiploidPath(self) :
         return os.path.join(self.getHyGenDir(),"diploidSV.vcf.temp")
 
+    def getTempCandidatePath(self) :
+        return os.path.join(self.getHyGenDir(),"candidateSV.vcf.temp")
+
     def getSortedDiploidPath(self) :
         return os.path.join(self.params.variantsDir,"diploidSV.vcf.gz")
 
@@ -681,6 +811,12 @@ class PathInfo:
     def getTmpGraphFileListPath(self) :
         return os.path.join(self.getTmpGraphDir(),"list.svLocusGraph.txt")
 
+    def getTmpEvidenceIndexFileListPath(self) :
+        return os.path.join(self.getTmpGraphDir(),"list.svEvidenceIndex.txt")
+
+    def getTmpDepthMapFileListPath(self) :
+        return os.path.join(self.getTmpGraphDir(),"list.depthMap.txt")
+
     def getVcfListPath(self, label) :
         return os.path.join(self.getHyGenDir(),"list.%s.txt" % (label))
 
@@ -749,6 +885,9 @@ class MantaWorkflow(WorkflowRunner) :
         self.params.isHighDepthFilter = (not (self.params.isExome or self.params.isRNA))
         self.params.isIgnoreAnomProperPair = (self.params.isRNA)
 
+        safeSetBool(self.params,"enableAdaptiveSegmentation")
+        safeSetBool(self.params,"enableLocalityEdgeOrder")
+
 
 
     def getSuccessMessage(self) :
@@ -778,6 +917,9 @@ class MantaWorkflow(WorkflowRunner) :
             depthTasks = mantaGetDepthFromAlignments(self)
             graphTaskDependencies |= depthTasks
 
+        if self.params.isPackedReference :
+            graphTaskDependencies |= buildPackedReference(self)
+
         graphTasks = runLocusGraph(self,dependencies=graphTaskDependencies)
 
         hygenTasks = runHyGen(self,dependencies=graphTasks)
@@ -179,6 +179,8 @@ def getDepthFromAlignments(self, bamList, outputPath, taskPrefix="", dependencie
             cmd = [self.params.getChromDepthBin,"--ref", self.params.referenceFasta, "--align-file", bamFile, "--output", tmpFiles[-1]]
             for (chromIndex,chromLabel) in chromGroup :
                 cmd.extend(["--chrom",chromLabel])
+            if getattr(self.params,"runCacheDir",None) :
+                cmd.extend(["--cache-dir",self.params.runCacheDir])
             scatterTasks.add(self.addTask(preJoin(taskPrefix,"estimateChromDepth_"+cid),cmd,dependencies=dirTask))
 
         assert(len(tmpFiles) != 0)
@@ -182,17 +182,16 @@ def getFastaChromOrderSize(faiFile) :
 
 
 
-def getChromIntervals(chromOrder,chromSizes,segmentSize, genomeRegion = None) :
+def getChromRegions(chromOrder,chromSizes, genomeRegion = None) :
     """
-    generate chromosome intervals no greater than segmentSize
+    generate the chromosome regions covered by genomeRegion
 
     chromOrder - iterable object of chromosome names
     chromSizes - a hash of chrom sizes
-    genomeRegionList - optionally restrict chrom intervals to only cover a list of specified chromosome region
+    genomeRegion - optionally restrict chrom regions to only cover a specified chromosome region
 
-    return chromIndex,chromLabel,start,end,chromSegment
-    where start and end are formatted for use with samtools
-    chromSegment is 0-indexed number of segment along each chromosome
+    return chromIndex,chromLabel,start,end
+    where start and end are 1-indexed closed
     """
 
     for (chromIndex, chromLabel) in enumerate(chromOrder) :
@@ -208,6 +207,24 @@ def getChromIntervals(chromOrder,chromSizes,segmentSize, genomeRegion = None) :
                 if genomeRegion["end"] is not None :
                     chromEnd=genomeRegion["end"]
 
+        yield (chromIndex,chromLabel,chromStart,chromEnd)
+
+
+
+def getChromIntervals(chromOrder,chromSizes,segmentSize, genomeRegion = None) :
+    """
+    generate chromosome intervals no greater than segmentSize
+
+    chromOrder - iterable object of chromosome names
+    chromSizes - a hash of chrom sizes
+    genomeRegionList - optionally restrict chrom intervals to only cover a list of specified chromosome region
+
+    return chromIndex,chromLabel,start,end,chromSegment
+    where start and end are formatted for use with samtools
+    chromSegment is 0-indexed number of segment along each chromosome
+    """
+
+    for (chromIndex,chromLabel,chromStart,chromEnd) in getChromRegions(chromOrder,chromSizes,genomeRegion) :
         chromSize=(chromEnd-chromStart+1)
         chromSegments=1+((chromSize-1)/segmentSize)
         segmentBaseSize=chromSize/chromSegments
@@ -438,14 +455,67 @@ class GenomeSegment(object) :
         return (self.endPos-self.beginPos)+1
 
 
-def getNextGenomeSegment(params) :
+def getScanRegions(params) :
+    """
+    generator which iterates through all regions scanned by the workflow, prior to dividing these into genomic segments
+
+    return chromIndex,chromLabel,start,end,genomeRegion
+    where start and end are 1-indexed closed
+    """
+
+    if len(params.callRegionList) == 0 :
+        for regionval in getChromRegions(params.chromOrder,params.chromSizes) :
+            yield regionval + (None,)
+    else :
+        for genomeRegion in params.callRegionList :
+            for regionval in getChromRegions(params.chromOrder,params.chromSizes, genomeRegion) :
+                yield regionval + (genomeRegion,)
+
+
+
+def readGenomeSegmentFile(params, segmentFile) :
+    """
+    generator which iterates through the genomic segments planned by GetGenomeSegments
+
+    Each line of segmentFile describes one segment as "regionIndex chromLabel beginPos endPos", where regionIndex
+    refers to the order of regions produced by getScanRegions
+    """
+
+    scanRegions = list(getScanRegions(params))
+    lastRegionIndex = None
+    binId = 0
+    for line in open(segmentFile) :
+        if line.startswith("#") : continue
+        word = line.strip().split('\t')
+        if len(word) != 4 :
+            raise Exception("Unexpected line format in genome segment file: '%s'" % (line.strip()))
+        regionIndex = int(word[0])
+        (chromIndex, chromLabel, _, _, genomeRegion) = scanRegions[regionIndex]
+        assert(word[1] == chromLabel)
+        if regionIndex != lastRegionIndex :
+            binId = 0
+            lastRegionIndex = regionIndex
+        yield GenomeSegment(chromIndex, chromLabel, int(word[2]), int(word[3]), binId, genomeRegion)
+        binId += 1
+
+
+
+def getNextGenomeSegment(params, segmentFile = None) :
     """
     generator which iterates through all genomic segments and
     returns a segmentValues object for each one.
 
     This segment generator understands callRegionList that accounts for both genomeRegionList and the callRegions bed file.
+
+    @param segmentFile if defined, read segments from this GetGenomeSegments output instead of dividing
+                       each region into segments of the standard scan size
     """
 
+    if segmentFile is not None :
+        for gseg in readGenomeSegmentFile(params, segmentFile) :
+            yield gseg
+        return
+
     MEGABASE = 1000000
     scanSize = params.scanSizeMb * MEGABASE
 
@@ -458,13 +528,14 @@ def getNextGenomeSegment(params) :
                 yield GenomeSegment(*segval)
 
 
-def getGenomeSegmentGroups(params, excludedContigs = None) :
+def getGenomeSegmentGroups(params, excludedContigs = None, segmentFile = None) :
     """
     Iterate segment groups and 'clump' small contigs together
 
     @param genomeSegmentIterator any object which will iterate through ungrouped genome segments)
     @param excludedContigs defines a set of contigs which are excluded from grouping
                            (useful when a particular contig, eg. chrM, is called with contig-specific parameters)
+    @param segmentFile optional GetGenomeSegments output used to define the genome segments
     @return yields a series of segment group lists
 
     Note this function will not reorder segments. This means that grouping will be suboptimal if small segments are
@@ -480,7 +551,7 @@ def getGenomeSegmentGroups(params, excludedContigs = None) :
     headSize = 0
     isLastSegmentGroupEligible = True
 
-    genomeSegmentIterator = getNextGenomeSegment(params)
+    genomeSegmentIterator = getNextGenomeSegment(params, segmentFile)
     for gseg in genomeSegmentIterator :
         isSegmentGroupEligible = isGroupEligible(gseg)
         if (isSegmentGroupEligible and isLastSegmentGroupEligible) and (headSize+gseg.size() <= minSegmentGroupSize) :